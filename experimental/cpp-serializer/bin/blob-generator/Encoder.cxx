@@ -0,0 +1,223 @@
+#include "Encoder.h"
+
+#include <cstring>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    be (std::string & out_, uint64_t value_, size_t width_) {
+        for (auto shift = 8 * width_ ; shift ; shift -= 8) {
+            out_ += static_cast<char>((value_ >> (shift - 8)) & 0xff);
+        }
+    }
+
+    void
+    be (char * out_, uint64_t value_, size_t width_) {
+        for (size_t i { 0 } ; i < width_ ; ++i) {
+            out_[i] = static_cast<char>((value_ >> (8 * (width_ - i - 1))) & 0xff);
+        }
+    }
+
+    /**
+     * The constructor, size prefix and content of a string, symbol or
+     * binary, using the compact form if it will fit
+     */
+    void
+    variable (std::string & out_, uint8_t code_, std::string_view value_) {
+        if (value_.size() < 256) {
+            out_ += static_cast<char>(code_);
+            be (out_, value_.size(), 1);
+        } else {
+            out_ += static_cast<char>(code_ | 0x10);
+            be (out_, value_.size(), 4);
+        }
+
+        out_.append (value_);
+    }
+
+    /**
+     * Constructor, four byte size and four byte count
+     */
+    const size_t wide { 9 };
+
+    /**
+     * Constructor, one byte size and one byte count
+     */
+    const size_t narrow { 3 };
+
+}
+
+/******************************************************************************/
+
+Encoder::Encoder (std::string & out_)
+    : m_out (out_)
+{ }
+
+/******************************************************************************/
+
+void
+Encoder::described() {
+    m_out += '\x00';
+}
+
+/******************************************************************************/
+
+void
+Encoder::null() {
+    m_out += '\x40';
+}
+
+/******************************************************************************/
+
+void
+Encoder::boolean (bool value_) {
+    m_out += value_ ? '\x41' : '\x42';
+}
+
+/******************************************************************************/
+
+void
+Encoder::int8 (int8_t value_) {
+    m_out += '\x51';
+    be (m_out, static_cast<uint8_t>(value_), 1);
+}
+
+/******************************************************************************/
+
+void
+Encoder::int32 (int32_t value_) {
+    if (value_ >= -128 && value_ <= 127) {
+        m_out += '\x54';
+        be (m_out, static_cast<uint8_t>(value_), 1);
+    } else {
+        m_out += '\x71';
+        be (m_out, static_cast<uint32_t>(value_), 4);
+    }
+}
+
+/******************************************************************************/
+
+void
+Encoder::int64 (int64_t value_) {
+    if (value_ >= -128 && value_ <= 127) {
+        m_out += '\x55';
+        be (m_out, static_cast<uint8_t>(value_), 1);
+    } else {
+        m_out += '\x81';
+        be (m_out, static_cast<uint64_t>(value_), 8);
+    }
+}
+
+/******************************************************************************/
+
+void
+Encoder::uint64 (uint64_t value_) {
+    m_out += '\x80';
+    be (m_out, value_, 8);
+}
+
+/******************************************************************************/
+
+void
+Encoder::float64 (double value_) {
+    uint64_t bits;
+    std::memcpy (&bits, &value_, sizeof (bits));
+
+    m_out += '\x82';
+    be (m_out, bits, 8);
+}
+
+/******************************************************************************/
+
+void
+Encoder::timestamp (int64_t value_) {
+    m_out += '\x83';
+    be (m_out, static_cast<uint64_t>(value_), 8);
+}
+
+/******************************************************************************/
+
+void
+Encoder::uuid (const char * value_) {
+    m_out += '\x98';
+    m_out.append (value_, 16);
+}
+
+/******************************************************************************/
+
+void
+Encoder::string (std::string_view value_) {
+    variable (m_out, 0xa1, value_);
+}
+
+/******************************************************************************/
+
+void
+Encoder::symbol (std::string_view value_) {
+    variable (m_out, 0xa3, value_);
+}
+
+/******************************************************************************/
+
+void
+Encoder::binary (std::string_view value_) {
+    variable (m_out, 0xa0, value_);
+}
+
+/******************************************************************************/
+
+size_t
+Encoder::list() {
+    auto at = m_out.size();
+
+    m_out += '\xd0';
+    m_out.append (wide - 1, '\0');
+
+    return at;
+}
+
+/******************************************************************************/
+
+size_t
+Encoder::map() {
+    auto at = m_out.size();
+
+    m_out += '\xd1';
+    m_out.append (wide - 1, '\0');
+
+    return at;
+}
+
+/******************************************************************************/
+
+void
+Encoder::end (size_t at_, size_t count_) {
+    auto body = m_out.size() - at_ - wide;
+
+    if (body + 1 < 256 && count_ < 256) {
+        auto data = &m_out[at_];
+
+        data[0] = static_cast<char>(static_cast<uint8_t>(data[0]) & ~0x10);
+        be (data + 1, body + 1, 1);
+        be (data + 2, count_, 1);
+
+        std::memmove (data + narrow, data + wide, body);
+        m_out.resize (m_out.size() - (wide - narrow));
+
+        return;
+    }
+
+    if (body + 4 > UINT32_MAX || count_ > UINT32_MAX) {
+        throw std::runtime_error (
+            "Compound of " + std::to_string (body)
+                + " bytes is too large to encode");
+    }
+
+    be (&m_out[at_ + 1], body + 4, 4);
+    be (&m_out[at_ + 5], count_, 4);
+}
+
+/******************************************************************************/
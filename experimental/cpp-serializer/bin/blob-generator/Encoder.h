@@ -0,0 +1,67 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+/**
+ * Writes AMQP values straight into a byte buffer, without building a
+ * tree of them first as proton's encoder does, so a blob of any size
+ * costs no more memory than its own encoding.
+ *
+ * Lists and maps are opened with [list] or [map], which leave room for
+ * the widest size and count, and closed with [end] once their contents
+ * have been written. A compound whose contents turn out to fit is then
+ * shuffled down into the compact form, as Corda would have written it.
+ * A described value is [described] followed by its descriptor and then
+ * the value itself.
+ */
+class Encoder {
+    private :
+        std::string & m_out;
+
+    public :
+        explicit Encoder (std::string &);
+
+        void described();
+
+        void null();
+        void boolean (bool);
+        void int8 (int8_t);
+        void int32 (int32_t);
+        void int64 (int64_t);
+        void uint64 (uint64_t);
+        void float64 (double);
+
+        /**
+         * Milliseconds from the epoch
+         */
+        void timestamp (int64_t);
+
+        /**
+         * The 16 bytes at the pointer
+         */
+        void uuid (const char *);
+
+        void string (std::string_view);
+        void symbol (std::string_view);
+        void binary (std::string_view);
+
+        /**
+         * Open a list or map, returning where it starts for [end]
+         */
+        size_t list();
+        size_t map();
+
+        /**
+         * Close the compound opened at [at_] holding [count_] values, for
+         * a map each key and each value counting as one
+         */
+        void end (size_t at_, size_t count_);
+};
+
+/******************************************************************************/
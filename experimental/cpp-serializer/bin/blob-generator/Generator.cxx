@@ -0,0 +1,1067 @@
+#include "Generator.h"
+
+#include <map>
+#include <utility>
+#include <stdexcept>
+
+#include "Encoder.h"
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+struct Generator::Type {
+    enum Kind {
+        int_e, long_e, boolean_e, double_e, string_e, binary_e,
+        byte_e, timestamp_e, uuid_e, any_e,
+        enum_e, list_e, array_e, map_e, composite_e, described_e
+    };
+
+    Kind        kind;
+    std::string name;
+    std::string descriptor;
+
+    /**
+     * The elements of a list or array, the values of a map, whose keys
+     * are always ints, or the primitive a described type is written as
+     */
+    size_t element { 0 };
+
+    /**
+     * The constants of an enum
+     */
+    size_t constants { 0 };
+
+    /**
+     * The properties of a class or, for an interface, the classes that
+     * implement it
+     */
+    std::vector<std::pair<std::string, size_t>> fields;
+};
+
+/******************************************************************************/
+
+struct Generator::Model {
+    std::vector<Type> types;
+    size_t            root { 0 };
+
+    /**
+     * The encoded schema section, the same for every blob of the model
+     */
+    std::string       schema;
+};
+
+/******************************************************************************/
+
+namespace {
+
+    using Type = Generator::Type;
+    using Model = Generator::Model;
+
+    uint64_t
+    mix (uint64_t x_) {
+        x_ += 0x9e3779b97f4a7c15ULL;
+        x_ = (x_ ^ (x_ >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x_ = (x_ ^ (x_ >> 27)) * 0x94d049bb133111ebULL;
+
+        return x_ ^ (x_ >> 31);
+    }
+
+    /**
+     * splitmix64, chosen over the standard library's engines and
+     * distributions so the same seed gives the same blobs everywhere
+     */
+    class Random {
+        private :
+            uint64_t m_state;
+
+        public :
+            explicit Random (uint64_t seed_) : m_state (seed_) { }
+
+            uint64_t next() {
+                m_state += 0x9e3779b97f4a7c15ULL;
+                return mix (m_state - 0x9e3779b97f4a7c15ULL);
+            }
+
+            size_t below (size_t n_) {
+                return n_ ? next() % n_ : 0;
+            }
+
+            size_t in (const Generator::Range & range_) {
+                return range_.min + below (range_.max - range_.min + 1);
+            }
+    };
+
+    uint64_t
+    descriptor (int id_) {
+        return static_cast<uint64_t>(id_)
+            | amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS;
+    }
+
+    /**
+     * A stand in for the fingerprint Corda would give a type, the base64
+     * of 128 bits derived from its name
+     */
+    std::string
+    fingerprint (const std::string & name_) {
+        static const char alphabet[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        uint64_t hash { 0xcbf29ce484222325ULL };
+        for (auto c : name_) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+        }
+
+        uint8_t bytes[18] { };
+        uint64_t words[2] { mix (hash), mix (~hash) };
+
+        for (size_t i { 0 } ; i < 16 ; ++i) {
+            bytes[i] = static_cast<uint8_t>(words[i / 8] >> (8 * (i % 8)));
+        }
+
+        std::string rtn { "net.corda:" };
+
+        for (size_t i { 0 } ; i < 18 ; i += 3) {
+            uint32_t group = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+
+            rtn += alphabet[(group >> 18) & 0x3f];
+            rtn += alphabet[(group >> 12) & 0x3f];
+            rtn += alphabet[(group >> 6) & 0x3f];
+            rtn += alphabet[group & 0x3f];
+        }
+
+        // 16 bytes encode to 22 characters and two of padding
+        rtn.resize (rtn.size() - 2);
+
+        return rtn + "==";
+    }
+
+    /******************************************************************************/
+
+    /**
+     * Generates the classes of one model
+     */
+    class Builder {
+        private :
+            const Generator::Shape &   m_shape;
+            Random                     m_random;
+            std::string                m_package;
+            Model &                    m_model;
+            std::map<std::string, size_t> m_named;
+            size_t                     m_classes;
+            size_t                     m_enums;
+
+            size_t add (Type type_) {
+                type_.descriptor = fingerprint (type_.name);
+                m_model.types.push_back (std::move (type_));
+
+                return m_model.types.size() - 1;
+            }
+
+            /**
+             * The one type of each name a model has, primitives and
+             * collections of them being shared by every property of the
+             * type
+             */
+            size_t named (Type::Kind kind_, std::string name_, size_t element_ = 0) {
+                auto it = m_named.find (name_);
+
+                if (it != m_named.end()) {
+                    return it->second;
+                }
+
+                Type type { kind_, name_, "" };
+                type.element = element_;
+
+                return m_named[name_] = add (std::move (type));
+            }
+
+            size_t primitive (Type::Kind kind_) {
+                static const char * names[] = {
+                    "int", "long", "boolean", "double", "string", "binary",
+                    "byte", "timestamp", "uuid" };
+
+                return named (kind_, names[kind_]);
+            }
+
+            size_t leaf() {
+                switch (m_random.below (10)) {
+                    case 0 : return primitive (Type::int_e);
+                    case 1 : return primitive (Type::long_e);
+                    case 2 : return primitive (Type::boolean_e);
+                    case 3 : return primitive (Type::double_e);
+                    case 4 : return primitive (Type::string_e);
+                    case 5 : {
+                        Type type { Type::enum_e,
+                            m_package + ".E" + std::to_string (m_enums++), "" };
+                        type.constants = m_shape.enums;
+
+                        return add (std::move (type));
+                    }
+                    case 6 : return list (primitive (Type::int_e));
+                    case 7 : return list (primitive (Type::string_e));
+                    case 8 : return named (
+                            Type::array_e, "int[]", primitive (Type::int_e));
+                    default : {
+                        auto value = primitive (Type::string_e);
+                        return named (Type::map_e,
+                            "java.util.Map<int, " + m_model.types[value].name + ">",
+                            value);
+                    }
+                }
+            }
+
+            size_t list (size_t element_) {
+                return named (Type::list_e,
+                    "java.util.List<" + m_model.types[element_].name + ">",
+                    element_);
+            }
+
+        public :
+            Builder (
+                const Generator::Shape & shape_,
+                uint64_t seed_,
+                size_t index_,
+                Model & model_
+            ) : m_shape (shape_)
+              , m_random (mix (seed_) ^ mix (~index_))
+              , m_package ("net.corda.generated.s" + std::to_string (index_))
+              , m_model (model_)
+              , m_classes (0)
+              , m_enums (0)
+            { }
+
+            size_t composite (size_t depth_) {
+                auto index = add ({ Type::composite_e,
+                    m_package + ".C" + std::to_string (m_classes++), "" });
+
+                std::vector<std::pair<std::string, size_t>> fields;
+
+                for (size_t i { 0 } ; i < std::max<size_t> (1, m_shape.width) ; ++i) {
+                    size_t type;
+
+                    if (i == 0 && depth_) {
+                        auto nested = composite (depth_ - 1);
+                        type = m_random.below (2) ? list (nested) : nested;
+                    } else {
+                        type = leaf();
+                    }
+
+                    fields.emplace_back ("f" + std::to_string (i), type);
+                }
+
+                m_model.types[index].fields = std::move (fields);
+
+                return index;
+            }
+    };
+
+    /******************************************************************************/
+
+    /**
+     * The schema entries, as Corda writes them
+     */
+    void
+    typeDescriptor (Encoder & encoder_, const Type & type_) {
+        encoder_.described();
+        encoder_.uint64 (descriptor (amqp::schema::descriptors::OBJECT));
+
+        auto at = encoder_.list();
+        encoder_.symbol (type_.descriptor);
+        encoder_.null();
+        encoder_.end (at, 2);
+    }
+
+    void
+    field (Encoder & encoder_, const std::string & name_, const Type & type_) {
+        encoder_.described();
+        encoder_.uint64 (descriptor (amqp::schema::descriptors::FIELD));
+
+        auto at = encoder_.list();
+
+        encoder_.string (name_);
+
+        /*
+         * Properties of a collection type or an interface name it as the
+         * one type they require
+         */
+        if (type_.kind == Type::list_e
+            || type_.kind == Type::map_e
+            || type_.kind == Type::any_e)
+        {
+            encoder_.string ("*");
+
+            auto requires = encoder_.list();
+            encoder_.string (type_.name);
+            encoder_.end (requires, 1);
+        } else {
+            encoder_.string (type_.name);
+            encoder_.end (encoder_.list(), 0);
+        }
+
+        encoder_.null();            // default
+        encoder_.null();            // label
+        encoder_.boolean (true);    // mandatory
+        encoder_.boolean (false);   // multiple
+
+        encoder_.end (at, 7);
+    }
+
+    void
+    composite (Encoder & encoder_, const Model & model_, const Type & type_) {
+        encoder_.described();
+        encoder_.uint64 (descriptor (amqp::schema::descriptors::COMPOSITE_TYPE));
+
+        auto at = encoder_.list();
+
+        encoder_.string (type_.name);
+        encoder_.null();
+        encoder_.end (encoder_.list(), 0);
+
+        typeDescriptor (encoder_, type_);
+
+        auto fields = encoder_.list();
+        for (const auto & [name, type] : type_.fields) {
+            field (encoder_, name, model_.types[type]);
+        }
+        encoder_.end (fields, type_.fields.size());
+
+        encoder_.end (at, 5);
+    }
+
+    void
+    restricted (Encoder & encoder_, const Model & model_, const Type & type_) {
+        encoder_.described();
+        encoder_.uint64 (descriptor (amqp::schema::descriptors::RESTRICTED_TYPE));
+
+        auto at = encoder_.list();
+
+        // an array of ints is named for the boxed type, as the JVM has it
+        encoder_.string (type_.kind == Type::array_e
+            ? "java.lang.Integer[]"
+            : type_.name);
+        encoder_.null();
+        encoder_.end (encoder_.list(), 0);
+
+        // a described primitive's source is the primitive
+        if (type_.kind == Type::described_e) {
+            encoder_.string (model_.types[type_.element].name);
+        } else {
+            encoder_.string (type_.kind == Type::map_e ? "map" : "list");
+        }
+
+        typeDescriptor (encoder_, type_);
+
+        auto choices = encoder_.list();
+
+        for (size_t i { 0 } ; i < type_.constants ; ++i) {
+            encoder_.described();
+            encoder_.uint64 (descriptor (amqp::schema::descriptors::CHOICE));
+
+            auto choice = encoder_.list();
+            encoder_.string ("C" + std::to_string (i));
+            encoder_.string (std::to_string (i));
+            encoder_.end (choice, 2);
+        }
+
+        encoder_.end (choices, type_.constants);
+
+        encoder_.end (at, 6);
+    }
+
+    /**
+     * Every type reachable from [type_], each ahead of the types it uses.
+     * The schema's dependency sort only looks at a type's immediate
+     * neighbours as it's inserted, and given a nested class ahead of
+     * the list holding it will settle on an order the readers can't be
+     * built in, so the types are handed to it as Corda would, outermost
+     * first.
+     */
+    void
+    dependentsFirst (
+        const Model & model_,
+        size_t type_,
+        std::vector<size_t> & order_,
+        std::vector<bool> & seen_
+    ) {
+        if (seen_[type_]) {
+            return;
+        }
+
+        seen_[type_] = true;
+        order_.push_back (type_);
+
+        const auto & type = model_.types[type_];
+
+        if (type.kind == Type::composite_e || type.kind == Type::any_e) {
+            for (const auto & field : type.fields) {
+                dependentsFirst (model_, field.second, order_, seen_);
+            }
+        } else if (type.kind >= Type::list_e) {
+            dependentsFirst (model_, type.element, order_, seen_);
+        }
+    }
+
+    void
+    schema (Encoder & encoder_, const Model & model_) {
+        encoder_.described();
+        encoder_.uint64 (descriptor (amqp::schema::descriptors::SCHEMA));
+
+        auto at = encoder_.list();
+        auto types = encoder_.list();
+        size_t count { 0 };
+
+        std::vector<size_t> order;
+        std::vector<bool> seen (model_.types.size());
+
+        dependentsFirst (model_, model_.root, order, seen);
+
+        for (auto index : order) {
+            const auto & type = model_.types[index];
+
+            if (type.kind == Type::composite_e) {
+                composite (encoder_, model_, type);
+            } else if (type.kind >= Type::enum_e) {
+                restricted (encoder_, model_, type);
+            } else {
+                continue;
+            }
+
+            ++count;
+        }
+
+        encoder_.end (types, count);
+        encoder_.end (at, 1);
+    }
+
+    /******************************************************************************/
+
+    void
+    value (
+        Encoder & encoder_,
+        const Generator::Shape & shape_,
+        const Model & model_,
+        size_t type_,
+        Random & random_
+    ) {
+        const auto & type = model_.types[type_];
+
+        switch (type.kind) {
+            case Type::int_e :
+                encoder_.int32 (static_cast<int32_t>(random_.next()));
+                break;
+            case Type::long_e :
+                encoder_.int64 (static_cast<int64_t>(random_.next()));
+                break;
+            case Type::boolean_e :
+                encoder_.boolean (random_.next() & 1);
+                break;
+            case Type::double_e :
+                encoder_.float64 (
+                    static_cast<double>(random_.next() >> 11) / (1ULL << 43));
+                break;
+            case Type::string_e : {
+                static const char alphabet[] =
+                    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+                std::string str (random_.in (shape_.string), ' ');
+
+                for (auto & c : str) {
+                    c = alphabet[random_.below (sizeof (alphabet) - 1)];
+                }
+
+                encoder_.string (str);
+                break;
+            }
+            case Type::binary_e : {
+                std::string bytes (random_.in (shape_.string), ' ');
+
+                for (auto & c : bytes) {
+                    c = static_cast<char>(random_.next());
+                }
+
+                encoder_.binary (bytes);
+                break;
+            }
+            case Type::byte_e :
+                encoder_.int8 (static_cast<int8_t>(random_.next()));
+                break;
+            case Type::timestamp_e :
+                encoder_.timestamp (static_cast<int64_t>(random_.below (4102444800000)));
+                break;
+            case Type::uuid_e : {
+                char bytes[16];
+
+                for (auto & c : bytes) {
+                    c = static_cast<char>(random_.next());
+                }
+
+                encoder_.uuid (bytes);
+                break;
+            }
+            case Type::enum_e : {
+                auto constant = random_.below (type.constants);
+
+                encoder_.described();
+                encoder_.symbol (type.descriptor);
+
+                auto at = encoder_.list();
+                encoder_.string ("C" + std::to_string (constant));
+                encoder_.int32 (static_cast<int32_t>(constant));
+                encoder_.end (at, 2);
+                break;
+            }
+            case Type::list_e :
+            case Type::array_e : {
+                auto elements = random_.in (shape_.list);
+
+                encoder_.described();
+                encoder_.symbol (type.descriptor);
+
+                auto at = encoder_.list();
+                for (size_t i { 0 } ; i < elements ; ++i) {
+                    value (encoder_, shape_, model_, type.element, random_);
+                }
+                encoder_.end (at, elements);
+                break;
+            }
+            case Type::map_e : {
+                auto entries = random_.in (shape_.map);
+
+                encoder_.described();
+                encoder_.symbol (type.descriptor);
+
+                auto at = encoder_.map();
+                for (size_t i { 0 } ; i < entries ; ++i) {
+                    encoder_.int32 (static_cast<int32_t>(i));
+                    value (encoder_, shape_, model_, type.element, random_);
+                }
+                encoder_.end (at, 2 * entries);
+                break;
+            }
+            case Type::composite_e : {
+                encoder_.described();
+                encoder_.symbol (type.descriptor);
+
+                auto at = encoder_.list();
+                for (const auto & field : type.fields) {
+                    value (encoder_, shape_, model_, field.second, random_);
+                }
+                encoder_.end (at, type.fields.size());
+                break;
+            }
+            case Type::described_e : {
+                encoder_.described();
+                encoder_.symbol (type.descriptor);
+
+                value (encoder_, shape_, model_, type.element, random_);
+                break;
+            }
+            case Type::any_e : {
+                const auto & implementation = type.fields[
+                    random_.below (type.fields.size())];
+
+                value (encoder_, shape_, model_, implementation.second, random_);
+                break;
+            }
+        }
+    }
+
+    /******************************************************************************/
+
+    /**
+     * A blob of [model_] whose object [object_] writes
+     */
+    template<typename Object>
+    void
+    envelope (std::string & out_, const Model & model_, Object && object_) {
+        out_.assign (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end());
+        out_ += static_cast<char>(amqp::DATA_AND_STOP);
+
+        Encoder encoder (out_);
+
+        encoder.described();
+        encoder.uint64 (descriptor (amqp::schema::descriptors::ENVELOPE));
+
+        auto at = encoder.list();
+
+        object_ (encoder);
+
+        out_.append (model_.schema);
+
+        // no transforms
+        encoder.described();
+        encoder.uint64 (descriptor (amqp::schema::descriptors::TRANSFORM_SCHEMA));
+        encoder.end (encoder.map(), 0);
+
+        encoder.end (at, 3);
+    }
+
+    /**
+     * Start an object of [type_], returning where its list starts for
+     * [Encoder::end]
+     */
+    size_t
+    open (Encoder & encoder_, const Type & type_) {
+        encoder_.described();
+        encoder_.symbol (type_.descriptor);
+
+        return encoder_.list();
+    }
+
+    size_t
+    declare (Model & model_, Type type_) {
+        type_.descriptor = fingerprint (type_.name);
+        model_.types.push_back (std::move (type_));
+
+        return model_.types.size() - 1;
+    }
+
+    /**
+     * The classes a transaction is written with, as far as its id needs
+     * them. Corda's signed transaction carries its signatures as well and
+     * its wire transaction a digest service, neither of which we write.
+     */
+    struct Transactions {
+        Model  wire;
+        size_t opaque;
+        size_t components;
+        size_t group;
+        size_t groups;
+        size_t salt;
+
+        Model  outer;
+        size_t serialized;
+
+        Transactions() {
+            auto binary = declare (wire, { Type::binary_e, "binary", "" });
+            auto integer = declare (wire, { Type::int_e, "int", "" });
+
+            opaque = declare (wire, { Type::composite_e,
+                "net.corda.core.utilities.OpaqueBytes", "", 0, 0,
+                { { "bytes", binary } } });
+
+            components = declare (wire, { Type::list_e,
+                "java.util.List<net.corda.core.utilities.OpaqueBytes>", "", opaque });
+
+            group = declare (wire, { Type::composite_e,
+                "net.corda.core.contracts.ComponentGroup", "", 0, 0,
+                { { "groupIndex", integer }, { "components", components } } });
+
+            groups = declare (wire, { Type::list_e,
+                "java.util.List<net.corda.core.contracts.ComponentGroup>", "", group });
+
+            salt = declare (wire, { Type::composite_e,
+                "net.corda.core.contracts.PrivacySalt", "", 0, 0,
+                { { "bytes", binary } } });
+
+            wire.root = declare (wire, { Type::composite_e,
+                "net.corda.core.transactions.WireTransaction", "", 0, 0,
+                { { "componentGroups", groups }, { "privacySalt", salt } } });
+
+            binary = declare (outer, { Type::binary_e, "binary", "" });
+
+            serialized = declare (outer, { Type::composite_e,
+                "net.corda.core.serialization.SerializedBytes", "", 0, 0,
+                { { "bytes", binary } } });
+
+            outer.root = declare (outer, { Type::composite_e,
+                "net.corda.core.transactions.SignedTransaction", "", 0, 0,
+                { { "txBits", serialized } } });
+
+            Encoder w (wire.schema);
+            schema (w, wire);
+
+            Encoder o (outer.schema);
+            schema (o, outer);
+        }
+    };
+
+    /**
+     * A class holding the JDK types Corda writes with custom serializers,
+     * the java.time ones as the proxies it writes for them
+     */
+    struct Natives {
+        Model  model;
+        size_t instant;
+        size_t date;
+        size_t time;
+        size_t decimal;
+        size_t currency;
+        size_t key;
+        size_t decimals;
+
+        Natives() {
+            auto int8 = declare (model, { Type::byte_e, "byte", "" });
+            auto int32 = declare (model, { Type::int_e, "int", "" });
+            auto int64 = declare (model, { Type::long_e, "long", "" });
+            auto string = declare (model, { Type::string_e, "string", "" });
+            auto binary = declare (model, { Type::binary_e, "binary", "" });
+            auto timestamp = declare (model, { Type::timestamp_e, "timestamp", "" });
+            auto uuid = declare (model, { Type::uuid_e, "uuid", "" });
+
+            instant = declare (model, { Type::composite_e,
+                "java.time.Instant", "", 0, 0,
+                { { "epochSeconds", int64 }, { "nanos", int32 } } });
+
+            date = declare (model, { Type::composite_e,
+                "java.time.LocalDate", "", 0, 0,
+                { { "year", int32 }, { "month", int8 }, { "day", int8 } } });
+
+            time = declare (model, { Type::composite_e,
+                "java.time.LocalTime", "", 0, 0,
+                { { "hour", int8 }, { "minute", int8 }, { "second", int8 }, { "nano", int32 } } });
+
+            decimal = declare (model, { Type::described_e, "java.math.BigDecimal", "", string });
+            currency = declare (model, { Type::described_e, "java.util.Currency", "", string });
+            key = declare (model, { Type::described_e, "java.security.PublicKey", "", binary });
+
+            decimals = declare (model, { Type::list_e,
+                "java.util.List<java.math.BigDecimal>", "", decimal });
+
+            model.root = declare (model, { Type::composite_e,
+                "net.corda.generated.Natives", "", 0, 0,
+                {
+                    { "issued", instant },
+                    { "maturity", date },
+                    { "cutoff", time },
+                    { "created", timestamp },
+                    { "id", uuid },
+                    { "amount", decimal },
+                    { "currency", currency },
+                    { "owner", key },
+                    { "rates", decimals }
+                } });
+
+            Encoder encoder (model.schema);
+            schema (encoder, model);
+        }
+    };
+
+    /**
+     * A class holding an interface, alone and in a list, with the classes
+     * implementing it written in its place. The interface itself isn't in
+     * the schema, as Corda leaves out any type it has no serializer for.
+     */
+    struct Polymorphic {
+        Model model;
+
+        Polymorphic() {
+            auto int32 = declare (model, { Type::int_e, "int", "" });
+            auto int64 = declare (model, { Type::long_e, "long", "" });
+            auto float64 = declare (model, { Type::double_e, "double", "" });
+            auto string = declare (model, { Type::string_e, "string", "" });
+
+            auto cash = declare (model, { Type::composite_e,
+                "net.corda.generated.Cash", "", 0, 0,
+                { { "owner", string }, { "amount", int64 } } });
+
+            auto bond = declare (model, { Type::composite_e,
+                "net.corda.generated.Bond", "", 0, 0,
+                { { "issuer", string }, { "coupon", float64 }, { "maturity", int32 } } });
+
+            auto token = declare (model, { Type::composite_e,
+                "net.corda.generated.Token", "", 0, 0,
+                { { "id", int32 } } });
+
+            auto state = declare (model, { Type::any_e,
+                "net.corda.generated.State", "", 0, 0,
+                { { "Cash", cash }, { "Bond", bond }, { "Token", token } } });
+
+            auto states = declare (model, { Type::list_e,
+                "java.util.List<net.corda.generated.State>", "", state });
+
+            model.root = declare (model, { Type::composite_e,
+                "net.corda.generated.Holder", "", 0, 0,
+                { { "state", state }, { "states", states } } });
+
+            Encoder encoder (model.schema);
+            schema (encoder, model);
+        }
+    };
+
+    /**
+     * Nanoseconds printed in none, 3, 6 or 9 digits as often as each other
+     */
+    int32_t
+    nanos (Random & random_) {
+        static const int32_t steps[] = { 1000000000, 1000000, 1000, 1 };
+
+        auto step = steps[random_.below (4)];
+
+        return static_cast<int32_t>(random_.below (1000000000)) / step * step;
+    }
+
+    std::string
+    decimal (Random & random_) {
+        auto cents = random_.below (10000000000);
+
+        return std::to_string (cents / 100) + "."
+            + static_cast<char>('0' + cents / 10 % 10)
+            + static_cast<char>('0' + cents % 10);
+    }
+
+}
+
+/******************************************************************************/
+
+Generator::Range
+Generator::Range::parse (const std::string & range_) {
+    auto colon = range_.find (':');
+
+    Range rtn;
+    rtn.min = std::stoul (range_.substr (0, colon));
+    rtn.max = colon == std::string::npos
+        ? rtn.min
+        : std::stoul (range_.substr (colon + 1));
+
+    if (rtn.max < rtn.min) {
+        throw std::runtime_error ("Empty range " + range_);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+Generator::Generator (Shape shape_, uint64_t seed_)
+    : m_shape (shape_)
+    , m_seed (seed_)
+    , m_models (std::max<size_t> (1, shape_.schemas))
+{
+    for (size_t i { 0 } ; i < m_models.size() ; ++i) {
+        auto & model = m_models[i];
+
+        model.root = Builder (m_shape, m_seed, i, model).composite (m_shape.depth);
+
+        Encoder encoder (model.schema);
+        schema (encoder, model);
+    }
+}
+
+/******************************************************************************/
+
+Generator::~Generator() = default;
+
+/******************************************************************************/
+
+size_t
+Generator::schemas() const {
+    return m_models.size();
+}
+
+/******************************************************************************/
+
+void
+Generator::blob (size_t index_, std::string & out_) const {
+    const auto & model = m_models[index_ % m_models.size()];
+
+    Random random (mix (m_seed) ^ mix (index_));
+
+    envelope (out_, model, [&](Encoder & encoder_) {
+        value (encoder_, m_shape, model, model.root, random);
+    });
+}
+
+/******************************************************************************/
+
+std::string
+Generator::blob (size_t index_) const {
+    std::string rtn;
+    blob (index_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+Generator::transaction (size_t index_, std::string & out_) const {
+    static const Transactions classes;
+
+    const auto & wire = classes.wire.types;
+    const auto & outer = classes.outer.types;
+
+    Random random (mix (~m_seed) ^ mix (index_));
+
+    std::string salt (32, '\0');
+    for (auto & c : salt) {
+        c = static_cast<char>(random.next());
+    }
+
+    std::string bytes;
+    std::string component;
+
+    envelope (bytes, classes.wire, [&](Encoder & encoder_) {
+        auto at = open (encoder_, wire[classes.wire.root]);
+        auto groups = open (encoder_, wire[classes.groups]);
+        size_t written { 0 };
+
+        /*
+         * Corda numbers its groups, inputs, outputs, commands and so on, up
+         * to nine of them. Every transaction has outputs, any of the others
+         * may be missing, and a missing group still has a place in the tree
+         */
+        for (int32_t index { 0 } ; index < 9 ; ++index) {
+            auto present = index == 1 || random.below (2);
+            auto count = random.in (m_shape.list);
+
+            if (!present || !count) {
+                continue;
+            }
+
+            auto group = open (encoder_, wire[classes.group]);
+            encoder_.int32 (index);
+
+            auto components = open (encoder_, wire[classes.components]);
+
+            for (size_t i { 0 } ; i < count ; ++i) {
+                blob (random.next(), component);
+
+                auto opaque = open (encoder_, wire[classes.opaque]);
+                encoder_.binary (component);
+                encoder_.end (opaque, 1);
+            }
+
+            encoder_.end (components, count);
+            encoder_.end (group, 2);
+
+            ++written;
+        }
+
+        encoder_.end (groups, written);
+
+        auto privacySalt = open (encoder_, wire[classes.salt]);
+        encoder_.binary (salt);
+        encoder_.end (privacySalt, 1);
+
+        encoder_.end (at, 2);
+    });
+
+    envelope (out_, classes.outer, [&](Encoder & encoder_) {
+        auto at = open (encoder_, outer[classes.outer.root]);
+
+        auto txBits = open (encoder_, outer[classes.serialized]);
+        encoder_.binary (bytes);
+        encoder_.end (txBits, 1);
+
+        encoder_.end (at, 1);
+    });
+}
+
+/******************************************************************************/
+
+std::string
+Generator::transaction (size_t index_) const {
+    std::string rtn;
+    transaction (index_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+Generator::natives (size_t index_, std::string & out_) const {
+    static const Natives classes;
+    static const char * currencies[] = { "GBP", "USD", "EUR", "CHF", "JPY" };
+
+    const auto & types = classes.model.types;
+
+    Random random (mix (m_seed + 1) ^ mix (~index_));
+
+    envelope (out_, classes.model, [&](Encoder & encoder_) {
+        auto at = open (encoder_, types[classes.model.root]);
+
+        auto instant = open (encoder_, types[classes.instant]);
+        encoder_.int64 (static_cast<int64_t>(random.below (4102444800)));
+        encoder_.int32 (nanos (random));
+        encoder_.end (instant, 2);
+
+        auto date = open (encoder_, types[classes.date]);
+        encoder_.int32 (static_cast<int32_t>(1970 + random.below (130)));
+        encoder_.int8 (static_cast<int8_t>(1 + random.below (12)));
+        encoder_.int8 (static_cast<int8_t>(1 + random.below (28)));
+        encoder_.end (date, 3);
+
+        auto time = open (encoder_, types[classes.time]);
+        encoder_.int8 (static_cast<int8_t>(random.below (24)));
+        encoder_.int8 (static_cast<int8_t>(random.below (60)));
+        encoder_.int8 (static_cast<int8_t>(random.below (60)));
+        encoder_.int32 (nanos (random));
+        encoder_.end (time, 4);
+
+        encoder_.timestamp (static_cast<int64_t>(random.below (4102444800000)));
+
+        char uuid[16];
+        for (auto & c : uuid) {
+            c = static_cast<char>(random.next());
+        }
+        encoder_.uuid (uuid);
+
+        encoder_.described();
+        encoder_.symbol (types[classes.decimal].descriptor);
+        encoder_.string (decimal (random));
+
+        encoder_.described();
+        encoder_.symbol (types[classes.currency].descriptor);
+        encoder_.string (currencies[random.below (5)]);
+
+        // an Ed25519 key's X.509 encoding
+        std::string key (44, '\0');
+        for (auto & c : key) {
+            c = static_cast<char>(random.next());
+        }
+
+        encoder_.described();
+        encoder_.symbol (types[classes.key].descriptor);
+        encoder_.binary (key);
+
+        auto rates = open (encoder_, types[classes.decimals]);
+        for (size_t i { 0 } ; i < 3 ; ++i) {
+            encoder_.described();
+            encoder_.symbol (types[classes.decimal].descriptor);
+            encoder_.string (decimal (random));
+        }
+        encoder_.end (rates, 3);
+
+        encoder_.end (at, 9);
+    });
+}
+
+/******************************************************************************/
+
+std::string
+Generator::natives (size_t index_) const {
+    std::string rtn;
+    natives (index_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+Generator::polymorphic (size_t index_, std::string & out_) const {
+    static const Polymorphic classes;
+
+    Random random (mix (m_seed + 2) ^ mix (~index_));
+
+    envelope (out_, classes.model, [&](Encoder & encoder_) {
+        value (encoder_, m_shape, classes.model, classes.model.root, random);
+    });
+}
+
+/******************************************************************************/
+
+std::string
+Generator::polymorphic (size_t index_) const {
+    std::string rtn;
+    polymorphic (index_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
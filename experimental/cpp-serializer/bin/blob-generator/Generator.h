@@ -0,0 +1,103 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * Synthetic blobs, each a valid Corda envelope carrying the schema of the
+ * classes its object was written from, of whatever shape a load or
+ * scaling test needs.
+ *
+ * Every blob's root class has [Shape::width] properties. While there's
+ * [Shape::depth] to go the first of them holds another generated class,
+ * or a list of them, and the rest are drawn from the primitives, enums,
+ * lists, arrays and maps. [Shape::schemas] sets of classes are generated
+ * under different packages and the blobs spread across them in turn.
+ *
+ * Everything follows from the seed. Blob [n] of a generator is the same
+ * bytes whenever it's asked for, whichever blobs were asked for before it,
+ * so a corpus can be written in any order or in parallel.
+ */
+class Generator {
+    public :
+        struct Range {
+            size_t min;
+            size_t max;
+
+            /**
+             * "n" or "min:max"
+             */
+            static Range parse (const std::string &);
+        };
+
+        struct Shape {
+            size_t width   { 4 };
+            size_t depth   { 1 };
+            Range  list    { 4, 4 };
+            Range  map     { 4, 4 };
+            Range  string  { 8, 32 };
+            size_t enums   { 4 };
+            size_t schemas { 1 };
+        };
+
+        struct Type;
+        struct Model;
+
+    private :
+        Shape              m_shape;
+        uint64_t           m_seed;
+        std::vector<Model> m_models;
+
+    public :
+        Generator (Shape, uint64_t seed_);
+        ~Generator();
+
+        size_t schemas() const;
+
+        /**
+         * Blob [index_], including its Corda header, written over [out_]
+         */
+        void blob (size_t index_, std::string & out_) const;
+
+        std::string blob (size_t index_) const;
+
+        /**
+         * Signed transaction [index_], including its Corda header, written
+         * over [out_]. Its wire transaction is a blob nested in its bytes
+         * and holds a salt and component groups whose components are
+         * blobs this generator writes, so ids can be computed over real
+         * looking components. Drawn from the same seed as the blobs but
+         * independent of them.
+         */
+        void transaction (size_t index_, std::string & out_) const;
+
+        std::string transaction (size_t index_) const;
+
+        /**
+         * Blob [index_] of a class whose properties are the JDK types Corda
+         * writes with custom serializers, Instant, LocalDate, LocalTime,
+         * Date, UUID, BigDecimal, Currency and PublicKey, for the decoders
+         * of those. Independent of the other blobs.
+         */
+        void natives (size_t index_, std::string & out_) const;
+
+        std::string natives (size_t index_) const;
+
+        /**
+         * Blob [index_] of a class with a property declared as an
+         * interface, alone and as a list, holding whichever of three
+         * classes implementing it, for readers of properties whose type
+         * the schema doesn't define. Independent of the other blobs.
+         */
+        void polymorphic (size_t index_, std::string & out_) const;
+
+        std::string polymorphic (size_t index_) const;
+};
+
+/******************************************************************************/
@@ -0,0 +1,208 @@
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+
+#include "Generator.h"
+
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * exe_) {
+        std::cerr
+            << "usage: " << exe_ << " [options]" << std::endl
+            << std::endl
+            << "  Generate a corpus of synthetic Corda blobs, the same corpus for"
+            << std::endl
+            << "  the same options, writing each to its own file or all of them"
+            << std::endl
+            << "  as hex to stdout in the csv vault-ingest reads" << std::endl
+            << std::endl
+            << "  --seed <n>            (default 0)" << std::endl
+            << "  --count <n>           blobs to write (default 1)" << std::endl
+            << "  --schemas <n>         distinct schemas to spread them over (default 1)"
+            << std::endl
+            << "  --width <n>           properties of each class (default 4)" << std::endl
+            << "  --depth <n>           classes nested inside the root (default 1)"
+            << std::endl
+            << "  --list <n|min:max>    elements of each list or array (default 4)"
+            << std::endl
+            << "  --map <n|min:max>     entries of each map (default 4)" << std::endl
+            << "  --string <n|min:max>  length of each string (default 8:32)"
+            << std::endl
+            << "  --enum <n>            constants of each enum (default 4)" << std::endl
+            << "  --out <dir>           write blob <n> to <dir>/<n>.blob (default .)"
+            << std::endl
+            << "  --csv                 write index,hex records to stdout instead"
+            << std::endl
+            << "  --transactions        write signed transactions whose components"
+            << std::endl
+            << "                        are blobs of the shape asked for" << std::endl
+            << "  --natives             write blobs of Instants, UUIDs, BigDecimals"
+            << std::endl
+            << "                        and the other types Corda serialises itself"
+            << std::endl
+            << "  --polymorphic         write blobs of properties declared as an"
+            << std::endl
+            << "                        interface and holding its implementations"
+            << std::endl;
+    }
+
+    /**
+     * A record of the csv vault-ingest reads, its blob column second
+     */
+    void
+    csv (std::string & out_, size_t index_, const std::string & blob_) {
+        static const char digits[] = "0123456789abcdef";
+
+        out_ += std::to_string (index_);
+        out_ += ',';
+
+        for (auto c : blob_) {
+            out_ += digits[static_cast<uint8_t>(c) >> 4];
+            out_ += digits[static_cast<uint8_t>(c) & 0xf];
+        }
+
+        out_ += '\n';
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    Generator::Shape shape;
+    uint64_t seed { 0 };
+    size_t count { 1 };
+    std::string out { "." };
+    bool toCsv { false };
+    bool transactions { false };
+    bool natives { false };
+    bool polymorphic { false };
+
+    try {
+        for (int i { 1 } ; i < argc ; ++i) {
+            std::string arg { argv[i] };
+
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error ("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--seed") {
+                seed = std::stoull (value());
+            } else if (arg == "--count") {
+                count = std::stoul (value());
+            } else if (arg == "--schemas") {
+                shape.schemas = std::stoul (value());
+            } else if (arg == "--width") {
+                shape.width = std::stoul (value());
+            } else if (arg == "--depth") {
+                shape.depth = std::stoul (value());
+            } else if (arg == "--list") {
+                shape.list = Generator::Range::parse (value());
+            } else if (arg == "--map") {
+                shape.map = Generator::Range::parse (value());
+            } else if (arg == "--string") {
+                shape.string = Generator::Range::parse (value());
+            } else if (arg == "--enum") {
+                shape.enums = std::stoul (value());
+            } else if (arg == "--out") {
+                out = value();
+            } else if (arg == "--csv") {
+                toCsv = true;
+            } else if (arg == "--transactions") {
+                transactions = true;
+            } else if (arg == "--natives") {
+                natives = true;
+            } else if (arg == "--polymorphic") {
+                polymorphic = true;
+            } else if (arg == "--help" || arg == "-h") {
+                usage (argv[0]);
+                return EXIT_SUCCESS;
+            } else {
+                throw std::runtime_error ("Unknown argument: " + arg);
+            }
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Generator generator (shape, seed);
+
+        if (!toCsv) {
+            std::filesystem::create_directories (out);
+        }
+
+        auto & pool = concurrency::ThreadPool::instance();
+
+        /*
+         * Blobs are generated a batch at a time, each participant reusing
+         * buffers of its own. Files can be written by whoever generated
+         * them, csv records are held until the batch is done so they come
+         * out in order.
+         */
+        const size_t batch { 4096 };
+
+        std::vector<std::string> blobs (pool.participants());
+        std::vector<std::string> records (toCsv ? batch : 0);
+
+        for (size_t first { 0 } ; first < count ; first += batch) {
+            auto n = std::min (batch, count - first);
+
+            pool.parallelFor (n, 1,
+                [&](size_t participant_, size_t begin_, size_t end_) {
+                    auto & blob = blobs[participant_];
+
+                    for (auto i = begin_ ; i < end_ ; ++i) {
+                        if (transactions) {
+                            generator.transaction (first + i, blob);
+                        } else if (natives) {
+                            generator.natives (first + i, blob);
+                        } else if (polymorphic) {
+                            generator.polymorphic (first + i, blob);
+                        } else {
+                            generator.blob (first + i, blob);
+                        }
+
+                        if (toCsv) {
+                            records[i].clear();
+                            csv (records[i], first + i, blob);
+                            continue;
+                        }
+
+                        auto file = out + "/" + std::to_string (first + i) + ".blob";
+                        std::ofstream f { file, std::ios::out | std::ios::binary | std::ios::trunc };
+
+                        if (!f.write (blob.data(), blob.size())) {
+                            throw std::runtime_error ("Cannot write " + file);
+                        }
+                    }
+                });
+
+            for (size_t i { 0 } ; toCsv && i < n ; ++i) {
+                std::cout << records[i];
+            }
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <cassert>
 
 #include "proton/codec.h"
 #include "proton/proton_wrapper.h"
@@ -11,63 +12,154 @@
 
 #include "amqp/CompositeFactory.h"
 #include "amqp/schema/described-types/Envelope.h"
+#include "amqp/reader/Document.h"
+#include "amqp/reader/JsonVisitor.h"
+#include "amqp/reader/VariantReader.h"
 
 /******************************************************************************/
 
-BlobInspector::BlobInspector (CordaBytes & cb_)
-    : m_data { pn_data (cb_.size()) }
+namespace {
+
+    /**
+     * Build the reader for the blob's object and hand it to [read_] with
+     * the tree's cursor on the object
+     */
+    template<typename Read>
+    void
+    read (
+        pn_data_t * data_,
+        BlobInspector::Dispatch dispatch_,
+        Read && read_
+    ) {
+        std::unique_ptr<amqp::internal::schema::Envelope> envelope;
+
+        if (pn_data_is_described (data_)) {
+            proton::auto_enter p (data_);
+
+            auto a = pn_data_get_ulong(data_);
+            auto it = amqp::internal::AMQPDescriptorRegistory.find (a);
+
+            if (it != amqp::internal::AMQPDescriptorRegistory.end()) {
+                envelope.reset (
+                        dynamic_cast<amqp::internal::schema::Envelope *> (
+                                it->second->build(data_).release()));
+            }
+        }
+
+        if (!envelope) {
+            throw std::runtime_error ("Blob does not contain an envelope");
+        }
+
+        amqp::internal::CompositeFactory cf;
+
+        cf.process (envelope->schema(), envelope->descriptor());
+
+        auto readers = cf.freeze();
+        auto reader = readers->byDescriptor (envelope->descriptor());
+
+        if (reader && dispatch_ == BlobInspector::variant_e) {
+            reader = amqp::internal::reader::VariantReader::compile (
+                dynamic_cast<const amqp::internal::reader::Reader &> (*reader));
+        }
+
+        if (!reader) {
+            throw std::runtime_error (
+                "No reader for descriptor " + envelope->descriptor());
+        }
+
+        // move to the actual blob entry in the tree - ideally we'd have
+        // saved this on the Envelope but that's not easily doable as we
+        // can't grab an actual copy of our data pointer
+        proton::auto_enter p (data_);
+        pn_data_next (data_);
+        proton::is_list (data_);
+        assert (pn_data_get_list (data_) == 3);
+        {
+            proton::auto_enter p (data_);
+
+            read_ (*reader, data_, envelope->schema());
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+BlobInspector::BlobInspector (
+    CordaBytes & cb_,
+    Dispatch dispatch_
+) : m_data { proton::DataPool::instance().acquire() }
+  , m_dispatch { dispatch_ }
 {
     // returns how many bytes we processed which right now we don't care
     // about but I assume there is a case where it doesn't process the
     // entire file
-    auto rtn = pn_data_decode (m_data, cb_.bytes(), cb_.size());
+    auto rtn = pn_data_decode (m_data.get(), cb_.bytes(), cb_.size());
+
+    if (rtn < 0) {
+        throw std::runtime_error ("Failed to decode AMQP stream");
+    }
+
     assert (rtn == cb_.size());
 }
 
 /******************************************************************************/
 
+BlobInspector::~BlobInspector() = default;
+
+/******************************************************************************/
+
 std::string
 BlobInspector::dump() {
-    std::unique_ptr<amqp::internal::schema::Envelope> envelope;
+    if (m_dispatch == visitor_e || m_dispatch == document_e) {
+        amqp::internal::reader::JsonVisitor json;
 
-    if (pn_data_is_described (m_data)) {
-        proton::auto_enter p (m_data);
+        json.onCompositeBegin ("", "");
+        json.onField ("Parsed");
 
-        auto a = pn_data_get_ulong(m_data);
+        if (m_dispatch == document_e) {
+            document().visit (json);
+        } else {
+            visit (json);
+        }
+
+        json.onCompositeEnd();
 
-        envelope.reset (
-                dynamic_cast<amqp::internal::schema::Envelope *> (
-                        amqp::internal::AMQPDescriptorRegistory[a]->build(m_data).release()));
+        return json.str();
     }
 
-    amqp::internal::CompositeFactory cf;
+    std::string rtn;
 
-    cf.process (envelope->schema());
+    read (m_data.get(), m_dispatch,
+        [&rtn](const auto & reader_, pn_data_t * data_, const auto & schema_) {
+            // We wrap our output like this to make sure it's valid JSON to
+            // facilitate easy pretty printing
+            rtn = "{ ";
+            reader_.dump ("Parsed", data_, schema_)->dump (rtn);
+            rtn += " }";
+        });
 
-    auto reader = cf.byDescriptor (envelope->descriptor());
-    assert (reader);
+    return rtn;
+}
 
-    {
-        // move to the actual blob entry in the tree - ideally we'd have
-        // saved this on the Envelope but that's not easily doable as we
-        // can't grab an actual copy of our data pointer
-        proton::auto_enter p (m_data);
-        pn_data_next (m_data);
-        proton::is_list (m_data);
-        assert (pn_data_get_list (m_data) == 3);
-        {
-            proton::auto_enter p (m_data);
+/******************************************************************************/
 
-            std::stringstream ss;
+void
+BlobInspector::visit (amqp::reader::IVisitor & visitor_) {
+    read (m_data.get(), m_dispatch,
+        [&visitor_](const auto & reader_, pn_data_t * data_, const auto & schema_) {
+            reader_.visit (data_, schema_, visitor_);
+        });
+}
 
-            // We wrap our output like this to make sure it's valid JSON to
-            // facilitate easy pretty printing
-            ss << reader->dump ("{ Parsed", m_data, envelope->schema())->dump()
-               << " }";
+/******************************************************************************/
 
-            return ss.str();
-        }
-    }
+amqp::internal::reader::Document
+BlobInspector::document (concurrency::Interner * interner_) {
+    amqp::internal::reader::Document::Builder builder (interner_);
+    visit (builder);
+
+    return builder.document();
 }
 
 /******************************************************************************/
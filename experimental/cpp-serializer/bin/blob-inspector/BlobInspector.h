@@ -2,22 +2,61 @@
 
 #include <iosfwd>
 #include "CordaBytes.h"
+#include "proton/DataPool.h"
 
 /******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::reader {
+    class IVisitor;
+}
+
+namespace amqp::internal::reader {
+    class Document;
+}
+
+namespace concurrency {
+    class Interner;
+}
 
 /******************************************************************************/
 
 class BlobInspector {
+    public :
+        /**
+         * Whether the blob is read by the reader graph's virtual calls or
+         * by a closed [amqp::internal::reader::VariantReader] compiled
+         * from it. With [visitor_e] the virtual readers raise events
+         * on a JSON visitor rather than building a tree of values to dump.
+         * With [document_e] they build a flat
+         * [amqp::internal::reader::Document] which is then written out.
+         */
+        enum Dispatch { virtual_e, variant_e, visitor_e, document_e };
+
     private :
-        pn_data_t * m_data;
+        proton::DataPool::Lease m_data;
+
+        Dispatch m_dispatch;
 
     public :
-        BlobInspector (CordaBytes &);
+        explicit BlobInspector (
+            CordaBytes &,
+            Dispatch = virtual_e);
+        ~BlobInspector();
 
         std::string dump();
 
+        /**
+         * Walk the blob's object, raising events on [visitor_]
+         */
+        void visit (amqp::reader::IVisitor & visitor_);
+
+        /**
+         * The blob's object as a [amqp::internal::reader::Document], its
+         * strings and names shared through [interner_] if there is one
+         */
+        amqp::internal::reader::Document document (
+            concurrency::Interner * interner_ = nullptr);
+
 };
 
 /******************************************************************************/
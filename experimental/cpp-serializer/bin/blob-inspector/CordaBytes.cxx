@@ -1,6 +1,8 @@
 #include "CordaBytes.h"
 
 #include <array>
+#include <cstring>
+#include <algorithm>
 #include <sys/stat.h>
 #include "amqp/AMQPHeader.h"
 
@@ -26,13 +28,38 @@ CordaBytes::CordaBytes (const std::string & file_)
         throw std::runtime_error ("Not a Corda stream");
     }
 
-    file.read (reinterpret_cast<char *>(&m_encoding), 1);
+    char encoding { };
+    file.read (&encoding, 1);
 
-    m_blob = new char[m_size];
+    m_encoding = static_cast<amqp::amqp_section_id_t>(encoding);
 
-    memset (m_blob, 0, m_size);
-    file.read (m_blob, m_size);
+    m_owned = std::make_unique<char[]> (m_size);
+
+    memset (m_owned.get(), 0, m_size);
+    file.read (m_owned.get(), m_size);
+
+    m_blob = m_owned.get();
 }
 
 /******************************************************************************/
 
+CordaBytes::CordaBytes (const char * bytes_, size_t size_)
+    : m_blob { nullptr }
+{
+    if (size_ < amqp::AMQP_HEADER.size() + 1
+        || !std::equal (
+                amqp::AMQP_HEADER.begin(),
+                amqp::AMQP_HEADER.end(),
+                bytes_))
+    {
+        throw std::runtime_error ("Not a Corda stream");
+    }
+
+    m_encoding = static_cast<amqp::amqp_section_id_t>(
+            bytes_[amqp::AMQP_HEADER.size()]);
+
+    m_size = size_ - (amqp::AMQP_HEADER.size() + 1);
+    m_blob = bytes_ + amqp::AMQP_HEADER.size() + 1;
+}
+
+/******************************************************************************/
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "string"
+#include <memory>
 #include <fstream>
 #include "amqp/AMQPSectionId.h"
 
@@ -10,14 +11,22 @@ class CordaBytes {
     private :
         amqp::amqp_section_id_t m_encoding;
         size_t m_size;
-        char * m_blob;
+
+        /**
+         * Only set when we've read the blob from a file ourselves, blobs
+         * handed to us from memory remain owned by the caller
+         */
+        std::unique_ptr<char[]> m_owned;
+        const char * m_blob;
 
     public :
         explicit CordaBytes (const std::string &);
 
-        ~CordaBytes() {
-            delete [] m_blob;
-        }
+        /**
+         * Wrap an in memory blob, including its Corda header, without
+         * taking a copy. The buffer must outlive this object.
+         */
+        CordaBytes (const char *, size_t);
 
         const decltype (m_encoding) & encoding() const {
             return m_encoding;
@@ -25,7 +34,7 @@ class CordaBytes {
 
         decltype (m_size) size() const { return m_size; }
 
-        const char * const bytes() const { return m_blob; }
+        const char * bytes() const { return m_blob; }
 };
 
 /******************************************************************************/
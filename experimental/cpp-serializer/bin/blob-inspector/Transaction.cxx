@@ -0,0 +1,325 @@
+#include "Transaction.h"
+
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "crypto/Merkle.h"
+#include "encoding/Hex.h"
+#include "amqp/reader/Nested.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/reader/JsonVisitor.h"
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string signedBytes { "net.corda.core.serialization.SerializedBytes" };
+    const std::string wireTransaction { "net.corda.core.transactions.WireTransaction" };
+    const std::string componentGroup { "net.corda.core.contracts.ComponentGroup" };
+    const std::string opaqueBytes { "net.corda.core.utilities.OpaqueBytes" };
+    const std::string privacySalt { "net.corda.core.contracts.PrivacySalt" };
+
+    /**
+     * Corda numbers a dozen or so component groups. The Merkle tree has a
+     * leaf for every index up to the highest, so a far higher one, which
+     * only a malformed transaction would have, is refused rather than
+     * allocated for.
+     */
+    constexpr int32_t maxGroupIndex { 255 };
+
+    /**
+     * Picks the salt and components out of a signed transaction as its
+     * readers walk it, following its serialised bytes into the wire
+     * transaction they hold. The serialised bytes are generic over the
+     * transaction and so are matched on their type's name alone.
+     */
+    class Collector : public amqp::reader::IVisitor {
+        private :
+            std::vector<Transaction::Group> & m_groups;
+            std::string &                     m_salt;
+
+            std::vector<std::string> m_types;
+            std::string              m_field;
+
+            bool m_wire { false };
+            bool m_group { false };
+            bool m_salted { false };
+
+        public :
+            Collector (std::vector<Transaction::Group> & groups_, std::string & salt_)
+                : m_groups (groups_)
+                , m_salt (salt_)
+            { }
+
+            bool wire() const { return m_wire; }
+            bool salted() const { return m_salted; }
+
+            void onCompositeBegin (std::string_view type_, std::string_view) override {
+                m_types.emplace_back (type_);
+
+                if (type_ == wireTransaction) {
+                    m_wire = true;
+                } else if (type_ == componentGroup && m_wire) {
+                    m_groups.push_back ({ 0, { }, { } });
+                    m_group = true;
+                }
+            }
+
+            void onCompositeEnd() override {
+                if (m_types.back() == componentGroup) {
+                    m_group = false;
+                }
+
+                m_types.pop_back();
+            }
+
+            void onField (std::string_view name_) override {
+                m_field = name_;
+            }
+
+            void onInt (int32_t value_) override {
+                if (m_group && m_types.back() == componentGroup && m_field == "groupIndex") {
+                    m_groups.back().index = value_;
+                }
+            }
+
+            void onBinary (std::string_view bytes_) override {
+                const auto & type = m_types.back();
+
+                if (!m_wire
+                    && type.compare (0, signedBytes.size(), signedBytes) == 0
+                    && amqp::internal::reader::Nested::is (bytes_))
+                {
+                    amqp::internal::reader::Nested::visit (bytes_, *this);
+                } else if (m_group && type == opaqueBytes) {
+                    m_groups.back().components.push_back ({ std::string (bytes_), { } });
+                } else if (m_wire && type == privacySalt) {
+                    m_salt = bytes_;
+                    m_salted = true;
+                }
+            }
+
+            void onListBegin (size_t) override { }
+            void onListEnd() override { }
+            void onMapBegin (size_t) override { }
+            void onMapEnd() override { }
+            void onLong (int64_t) override { }
+            void onBool (bool) override { }
+            void onDouble (double) override { }
+            void onString (std::string_view) override { }
+    };
+
+    void
+    be (uint8_t * out_, int32_t value_) {
+        auto u = static_cast<uint32_t>(value_);
+
+        out_[0] = static_cast<uint8_t>(u >> 24);
+        out_[1] = static_cast<uint8_t>(u >> 16);
+        out_[2] = static_cast<uint8_t>(u >> 8);
+        out_[3] = static_cast<uint8_t>(u);
+    }
+
+    /**
+     * The component's hash, under the nonce the salt gives its position
+     */
+    crypto::Digest
+    hash (const std::string & salt_, int32_t group_, int32_t index_, const std::string & bytes_) {
+        uint8_t position[8];
+        be (position, group_);
+        be (position + 4, index_);
+
+        auto salted = crypto::Sha256()
+            .update (salt_.data(), salt_.size())
+            .update (position, sizeof (position))
+            .digest();
+
+        auto nonce = crypto::sha256 (salted.data(), salted.size());
+
+        auto once = crypto::Sha256()
+            .update (nonce.data(), nonce.size())
+            .update (bytes_.data(), bytes_.size())
+            .digest();
+
+        return crypto::sha256 (once.data(), once.size());
+    }
+
+    void
+    hex (std::string & out_, const void * bytes_, size_t size_) {
+        out_ += '"';
+        encoding::hex::encode (out_, bytes_, size_);
+        out_ += '"';
+    }
+
+}
+
+/******************************************************************************/
+
+Transaction::Transaction (std::string_view blob_) {
+    if (!amqp::internal::reader::Nested::is (blob_)) {
+        throw std::runtime_error ("Not a Corda blob");
+    }
+
+    Collector collector (m_groups, m_salt);
+    amqp::internal::reader::Nested::visit (blob_, collector);
+
+    if (!collector.wire()) {
+        throw std::runtime_error ("Not a transaction");
+    }
+
+    if (!collector.salted()) {
+        throw std::runtime_error ("Transaction has no privacy salt");
+    }
+
+    if (m_groups.empty()) {
+        throw std::runtime_error ("Transaction has no component groups");
+    }
+
+    std::vector<std::pair<size_t, size_t>> components;
+    int32_t last { 0 };
+
+    for (size_t g { 0 } ; g < m_groups.size() ; ++g) {
+        if (m_groups[g].index < 0) {
+            throw std::runtime_error (
+                "Negative component group index " + std::to_string (m_groups[g].index));
+        }
+
+        if (m_groups[g].index > maxGroupIndex) {
+            throw std::runtime_error (
+                "Component group index " + std::to_string (m_groups[g].index)
+                    + " is out of range");
+        }
+
+        last = std::max (last, m_groups[g].index);
+
+        for (size_t c { 0 } ; c < m_groups[g].components.size() ; ++c) {
+            components.emplace_back (g, c);
+        }
+    }
+
+    concurrency::ThreadPool::instance().parallelFor (components.size(), 64,
+        [&](size_t, size_t begin_, size_t end_) {
+            for (auto i = begin_ ; i < end_ ; ++i) {
+                auto & group = m_groups[components[i].first];
+                auto & component = group.components[components[i].second];
+
+                component.hash = hash (
+                    m_salt,
+                    group.index,
+                    static_cast<int32_t>(components[i].second),
+                    component.bytes);
+            }
+        });
+
+    std::vector<crypto::Digest> roots (last + 1, crypto::merkle::ones());
+    std::vector<bool> seen (last + 1);
+
+    for (auto & group : m_groups) {
+        if (seen[group.index]) {
+            throw std::runtime_error (
+                "Duplicate component group " + std::to_string (group.index));
+        }
+
+        std::vector<crypto::Digest> leaves;
+        leaves.reserve (group.components.size());
+
+        for (const auto & component : group.components) {
+            leaves.push_back (component.hash);
+        }
+
+        group.root = crypto::merkle::root (std::move (leaves));
+
+        roots[group.index] = group.root;
+        seen[group.index] = true;
+    }
+
+    m_id = crypto::merkle::root (std::move (roots));
+}
+
+/******************************************************************************/
+
+const crypto::Digest &
+Transaction::id() const {
+    return m_id;
+}
+
+/******************************************************************************/
+
+const std::vector<Transaction::Group> &
+Transaction::groups() const {
+    return m_groups;
+}
+
+/******************************************************************************/
+
+std::string
+Transaction::json (bool decode_) const {
+    std::vector<std::string> values;
+
+    if (decode_) {
+        std::vector<const Component *> components;
+
+        for (const auto & group : m_groups) {
+            for (const auto & component : group.components) {
+                components.push_back (&component);
+            }
+        }
+
+        values.resize (components.size());
+
+        concurrency::ThreadPool::instance().parallelFor (components.size(), 1,
+            [&](size_t, size_t begin_, size_t end_) {
+                for (auto i = begin_ ; i < end_ ; ++i) {
+                    amqp::internal::reader::JsonVisitor json;
+                    json.onBinary (components[i]->bytes);
+
+                    values[i] = json.str();
+                }
+            });
+    }
+
+    std::string rtn { "{ \"id\" : " };
+    hex (rtn, m_id.data(), m_id.size());
+
+    rtn += ", \"privacySalt\" : ";
+    hex (rtn, m_salt.data(), m_salt.size());
+
+    rtn += ", \"componentGroups\" : [ ";
+
+    size_t value { 0 };
+
+    for (size_t g { 0 } ; g < m_groups.size() ; ++g) {
+        const auto & group = m_groups[g];
+
+        if (g) rtn += ", ";
+
+        rtn += "{ \"groupIndex\" : " + std::to_string (group.index) + ", \"root\" : ";
+        hex (rtn, group.root.data(), group.root.size());
+
+        rtn += ", \"components\" : [ ";
+
+        for (size_t c { 0 } ; c < group.components.size() ; ++c) {
+            const auto & component = group.components[c];
+
+            if (c) rtn += ", ";
+
+            rtn += "{ \"hash\" : ";
+            hex (rtn, component.hash.data(), component.hash.size());
+
+            if (decode_) {
+                rtn += ", \"value\" : " + values[value++];
+            }
+
+            rtn += " }";
+        }
+
+        rtn += " ] }";
+    }
+
+    rtn += " ] }";
+
+    return rtn;
+}
+
+/******************************************************************************/
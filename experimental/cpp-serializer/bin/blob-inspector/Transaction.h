@@ -0,0 +1,65 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "crypto/Sha256.h"
+
+/******************************************************************************/
+
+/**
+ * A signed transaction read from its raw storage, with the id Corda would
+ * give it recomputed from its components.
+ *
+ * The wire transaction is a blob nested in the signed transaction's
+ * bytes and each of its components a blob nested in that. Components are
+ * hashed under nonces derived from the transaction's privacy salt, each
+ * group's hashes are reduced to a Merkle root, the groups a transaction
+ * lacks are stood in for by [crypto::merkle::ones] and the id is the root
+ * over all of them. Hashing the components, and decoding them for [json],
+ * is shared out over the thread pool.
+ */
+class Transaction {
+    public :
+        struct Component {
+            std::string    bytes;
+            crypto::Digest hash;
+        };
+
+        struct Group {
+            int32_t                index;
+            std::vector<Component> components;
+            crypto::Digest         root;
+        };
+
+    private :
+        std::string        m_salt;
+        std::vector<Group> m_groups;
+        crypto::Digest     m_id;
+
+    public :
+        /**
+         * [blob_] is the signed transaction's bytes, Corda header and all
+         */
+        explicit Transaction (std::string_view blob_);
+
+        const crypto::Digest & id() const;
+
+        /**
+         * In the order they were written, which needn't be that of their
+         * indices
+         */
+        const std::vector<Group> & groups() const;
+
+        /**
+         * The id, salt and groups with each component's hash and, if
+         * [decode_], what it holds
+         */
+        std::string json (bool decode_) const;
+};
+
+/******************************************************************************/
@@ -0,0 +1,407 @@
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <string>
+#include <fstream>
+#include <iterator>
+
+#include "Generator.h"
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+#include "amqp/tape/Tape.h"
+#include "amqp/reader/Document.h"
+#include "amqp/reader/Elements.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/validate/Validate.h"
+#include "concurrency/Interner.h"
+
+/******************************************************************************/
+
+/**
+ * Dumping a blob through the virtual reader graph against the closed
+ * variant compiled from it. The blobs are test files with their longest
+ * list grown to the number of elements given as the second argument, so
+ * per blob overheads like processing the schema fade out as it grows.
+ * Both are set against the same walk raising events at a visitor that
+ * builds nothing, the JSON dump written by one, and validating the blob,
+ * which decodes it straight from its bytes.
+ *
+ * The generated blobs instead vary the shape of the object, its width
+ * and how deeply its classes nest, rather than the size of one list.
+ *
+ * The numeric blobs grow a list of ints, the same list widened to longs,
+ * and a list of doubles, for the cost of formatting numbers.
+ *
+ * Run from this directory, the test files are found relative to it.
+ */
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::tape::Tape;
+
+    const std::string filepath ("../../test-files/"); // NOLINT
+
+    const char * files[] = { "_Li_", "_L_i__" };
+
+    void
+    be32 (std::string & out_, size_t value_) {
+        for (int shift { 24 } ; shift >= 0 ; shift -= 8) {
+            out_ += static_cast<char>((value_ >> shift) & 0xff);
+        }
+    }
+
+    /**
+     * Re-encode [node_], the elements of [target_] repeated until there
+     * are [elements_] of them. If [widen_], ints are written as longs
+     * many times their size and the schema's lists of int as lists of
+     * long to match.
+     */
+    void
+    encode (
+        const Tape & tape_,
+        size_t node_,
+        size_t target_,
+        size_t elements_,
+        std::string & out_,
+        bool widen_ = false
+    ) {
+        switch (tape_.type (node_)) {
+            case PN_DESCRIBED :
+                out_ += '\0';
+                encode (tape_, node_ + 1, target_, elements_, out_, widen_);
+                encode (tape_, tape_.skip (node_ + 1), target_, elements_, out_, widen_);
+                break;
+            case PN_LIST :
+            case PN_MAP : {
+                auto original = tape_[node_].count;
+                auto count = node_ == target_ ? elements_ : original;
+
+                std::string body;
+                for (size_t i { 0 } ; i < count ; ++i) {
+                    encode (tape_, tape_.child (node_, i % original),
+                            target_, elements_, body, widen_);
+                }
+
+                out_ += tape_.type (node_) == PN_LIST ? '\xd0' : '\xd1';
+                be32 (out_, body.size() + 4);
+                be32 (out_, count);
+                out_ += body;
+                break;
+            }
+            case PN_INT : {
+                if (!widen_) {
+                    out_.append (tape_.bytes (node_));
+                    break;
+                }
+
+                auto payload = reinterpret_cast<const uint8_t *>(tape_.payload (node_));
+                int64_t value = tape_[node_].code == 0x54
+                    ? static_cast<int8_t>(payload[0])
+                    : static_cast<int32_t>((payload[0] << 24) | (payload[1] << 16)
+                        | (payload[2] << 8) | payload[3]);
+
+                auto wide = static_cast<uint64_t>(value * 1000000007LL);
+
+                out_ += '\x81';
+                be32 (out_, wide >> 32);
+                be32 (out_, wide & 0xffffffff);
+                break;
+            }
+            case PN_STRING :
+            case PN_SYMBOL : {
+                auto value = std::string (tape_.value (node_));
+                auto at = value.find ("<int>");
+
+                if (!widen_ || at == std::string::npos) {
+                    out_.append (tape_.bytes (node_));
+                    break;
+                }
+
+                value.replace (at, 5, "<long>");
+
+                out_ += static_cast<char>(tape_[node_].code & ~0x10);
+                out_ += static_cast<char>(value.size());
+                out_ += value;
+                break;
+            }
+            default :
+                out_.append (tape_.bytes (node_));
+        }
+    }
+
+    std::string
+    blob (const std::string & file_, size_t elements_, bool widen_ = false) {
+        std::ifstream f (filepath + file_, std::ios::binary);
+        std::string original ((std::istreambuf_iterator<char> (f)), { });
+
+        // the Corda header and encoding byte
+        const size_t header { 8 };
+
+        Tape tape (original.data() + header, original.size() - header);
+
+        /*
+         * The envelope is a described list whose first entry is the object,
+         * grow the longest list within that
+         */
+        auto object = tape.child (tape.child (0, 1), 0);
+        size_t target { 0 };
+
+        for (auto i = object ; i < tape.skip (object) ; ++i) {
+            if (tape.type (i) == PN_LIST
+                && (!target || tape[i].count > tape[target].count))
+            {
+                target = i;
+            }
+        }
+
+        auto rtn = original.substr (0, header);
+        encode (tape, 0, target, elements_, rtn, widen_);
+
+        return rtn;
+    }
+
+    template<BlobInspector::Dispatch Dispatch>
+    void
+    BM_Dump (benchmark::State & state_) {
+        using amqp::internal::reader::Elements;
+
+        auto bytes = blob (files[state_.range (0)], state_.range (1));
+        CordaBytes cb (bytes.data(), bytes.size());
+
+        // keep both on the calling thread, it's dispatch being measured
+        auto threshold = Elements::threshold();
+        Elements::threshold (std::numeric_limits<size_t>::max());
+
+        for (auto _ : state_) {
+            benchmark::DoNotOptimize (
+                BlobInspector (cb, Dispatch).dump());
+        }
+
+        Elements::threshold (threshold);
+
+        state_.SetItemsProcessed (state_.iterations() * state_.range (1));
+        state_.SetLabel (files[state_.range (0)]);
+    }
+
+    /**
+     * Everything a blob holds, seen and thrown away
+     */
+    class Sink : public amqp::reader::IVisitor {
+        public :
+            void onCompositeBegin (std::string_view, std::string_view) override { }
+            void onCompositeEnd() override { }
+            void onField (std::string_view) override { }
+            void onListBegin (size_t) override { }
+            void onListEnd() override { }
+            void onMapBegin (size_t) override { }
+            void onMapEnd() override { }
+            void onInt (int32_t v_) override { benchmark::DoNotOptimize (v_); }
+            void onLong (int64_t v_) override { benchmark::DoNotOptimize (v_); }
+            void onBool (bool v_) override { benchmark::DoNotOptimize (v_); }
+            void onDouble (double v_) override { benchmark::DoNotOptimize (v_); }
+            void onString (std::string_view v_) override {
+                benchmark::DoNotOptimize (v_.data());
+            }
+            void onBinary (std::string_view v_) override {
+                benchmark::DoNotOptimize (v_.data());
+            }
+    };
+
+    void
+    BM_Visit (benchmark::State & state_) {
+        auto bytes = blob (files[state_.range (0)], state_.range (1));
+        CordaBytes cb (bytes.data(), bytes.size());
+
+        Sink sink;
+
+        for (auto _ : state_) {
+            BlobInspector (cb).visit (sink);
+        }
+
+        state_.SetItemsProcessed (state_.iterations() * state_.range (1));
+        state_.SetLabel (files[state_.range (0)]);
+    }
+
+    /**
+     * Everything a blob holds, kept in a flat document and thrown away
+     */
+    void
+    BM_Document (benchmark::State & state_) {
+        auto bytes = blob (files[state_.range (0)], state_.range (1));
+        CordaBytes cb (bytes.data(), bytes.size());
+
+        for (auto _ : state_) {
+            benchmark::DoNotOptimize (
+                BlobInspector (cb).document().slots().size());
+        }
+
+        state_.SetItemsProcessed (state_.iterations() * state_.range (1));
+        state_.SetLabel (files[state_.range (0)]);
+    }
+
+    /**
+     * A batch of generated blobs kept resident as documents, with their
+     * strings interned or not. Their enum constants, names and
+     * descriptors repeat from one blob to the next; their strings don't.
+     */
+    void
+    BM_Resident (benchmark::State & state_) {
+        Generator::Shape shape;
+        shape.width = 16;
+        shape.string = { 2, 4 };
+
+        Generator generator (shape, 0);
+
+        std::vector<std::string> blobs;
+
+        for (size_t i { 0 } ; i < 256 ; ++i) {
+            blobs.push_back (generator.blob (i));
+        }
+
+        concurrency::Interner::Stats stats { };
+
+        for (auto _ : state_) {
+            concurrency::Interner interner;
+            std::vector<amqp::internal::reader::Document> documents;
+
+            for (auto & bytes : blobs) {
+                CordaBytes cb (bytes.data(), bytes.size());
+
+                documents.push_back (BlobInspector (cb).document (
+                    state_.range (0) ? &interner : nullptr));
+            }
+
+            stats = interner.stats();
+        }
+
+        state_.SetItemsProcessed (state_.iterations() * blobs.size());
+        state_.counters["hitRate"] = stats.hitRate();
+        state_.counters["internedBytes"] = stats.bytes;
+    }
+
+    /**
+     * Checking the blob could be read, which builds nothing
+     */
+    void
+    BM_Validate (benchmark::State & state_) {
+        auto bytes = blob (files[state_.range (0)], state_.range (1));
+
+        for (auto _ : state_) {
+            benchmark::DoNotOptimize (
+                amqp::validate (bytes.data(), bytes.size()));
+        }
+
+        state_.SetItemsProcessed (state_.iterations() * state_.range (1));
+        state_.SetLabel (files[state_.range (0)]);
+    }
+
+    template<BlobInspector::Dispatch Dispatch>
+    void
+    BM_Generated (benchmark::State & state_) {
+        Generator::Shape shape;
+        shape.width = state_.range (0);
+        shape.depth = state_.range (1);
+
+        auto bytes = Generator (shape, 0).blob (0);
+        CordaBytes cb (bytes.data(), bytes.size());
+
+        for (auto _ : state_) {
+            benchmark::DoNotOptimize (
+                BlobInspector (cb, Dispatch).dump());
+        }
+
+        state_.SetBytesProcessed (state_.iterations() * bytes.size());
+    }
+
+    void
+    BM_GeneratedValidate (benchmark::State & state_) {
+        Generator::Shape shape;
+        shape.width = state_.range (0);
+        shape.depth = state_.range (1);
+
+        auto bytes = Generator (shape, 0).blob (0);
+
+        for (auto _ : state_) {
+            benchmark::DoNotOptimize (
+                amqp::validate (bytes.data(), bytes.size()));
+        }
+
+        state_.SetBytesProcessed (state_.iterations() * bytes.size());
+    }
+
+    struct Numbers {
+        const char * file;
+        bool         widen;
+        const char * label;
+    };
+
+    const Numbers numbers[] = {
+        { "_Li_", false, "int" },
+        { "_Li_", true, "long" },
+        { "_ALd_", false, "double" } };
+
+    template<BlobInspector::Dispatch Dispatch>
+    void
+    BM_Numbers (benchmark::State & state_) {
+        using amqp::internal::reader::Elements;
+
+        const auto & numeric = numbers[state_.range (0)];
+
+        auto bytes = blob (numeric.file, state_.range (1), numeric.widen);
+        CordaBytes cb (bytes.data(), bytes.size());
+
+        auto threshold = Elements::threshold();
+        Elements::threshold (std::numeric_limits<size_t>::max());
+
+        for (auto _ : state_) {
+            benchmark::DoNotOptimize (
+                BlobInspector (cb, Dispatch).dump());
+        }
+
+        Elements::threshold (threshold);
+
+        state_.SetItemsProcessed (state_.iterations() * state_.range (1));
+        state_.SetLabel (numeric.label);
+    }
+
+    void
+    args (benchmark::internal::Benchmark * b_) {
+        for (int file { 0 } ; file < 2 ; ++file) {
+            for (int elements : { 16, 4096 }) {
+                b_->Args ({ file, elements });
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+BENCHMARK_TEMPLATE (BM_Dump, BlobInspector::virtual_e)->Apply (args); // NOLINT
+BENCHMARK_TEMPLATE (BM_Dump, BlobInspector::variant_e)->Apply (args); // NOLINT
+BENCHMARK_TEMPLATE (BM_Dump, BlobInspector::visitor_e)->Apply (args); // NOLINT
+BENCHMARK_TEMPLATE (BM_Dump, BlobInspector::document_e)->Apply (args); // NOLINT
+BENCHMARK (BM_Visit)->Apply (args); // NOLINT
+BENCHMARK (BM_Document)->Apply (args); // NOLINT
+BENCHMARK (BM_Resident)->Arg (0)->Arg (1); // NOLINT
+BENCHMARK (BM_Validate)->Apply (args); // NOLINT
+
+BENCHMARK_TEMPLATE (BM_Generated, BlobInspector::virtual_e) // NOLINT
+    ->ArgsProduct ({ { 4, 32 }, { 1, 4 } });
+BENCHMARK_TEMPLATE (BM_Generated, BlobInspector::variant_e) // NOLINT
+    ->ArgsProduct ({ { 4, 32 }, { 1, 4 } });
+BENCHMARK_TEMPLATE (BM_Numbers, BlobInspector::virtual_e) // NOLINT
+    ->ArgsProduct ({ { 0, 1, 2 }, { 4096 } });
+BENCHMARK_TEMPLATE (BM_Numbers, BlobInspector::variant_e) // NOLINT
+    ->ArgsProduct ({ { 0, 1, 2 }, { 4096 } });
+BENCHMARK_TEMPLATE (BM_Numbers, BlobInspector::visitor_e) // NOLINT
+    ->ArgsProduct ({ { 0, 1, 2 }, { 4096 } });
+BENCHMARK_TEMPLATE (BM_Numbers, BlobInspector::document_e) // NOLINT
+    ->ArgsProduct ({ { 0, 1, 2 }, { 4096 } });
+BENCHMARK (BM_GeneratedValidate)->ArgsProduct ({ { 4, 32 }, { 1, 4 } }); // NOLINT
+
+BENCHMARK_MAIN(); // NOLINT
+
+/******************************************************************************/
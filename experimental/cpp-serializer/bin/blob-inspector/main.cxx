@@ -1,5 +1,9 @@
+#include <array>
+#include <vector>
+#include <future>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
 #include <fstream>
 #include <cstddef>
 
@@ -19,8 +23,157 @@
 
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/tape/Sections.h"
+#include "amqp/stream/Blob.h"
+#include "amqp/reader/JsonVisitor.h"
+#include "amqp/validate/Validate.h"
+#include "encoding/Hex.h"
 #include "CordaBytes.h"
 #include "BlobInspector.h"
+#include "Transaction.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Print the blob read from [in_] as it arrives, decoding each chunk
+     * while the next is read, against the schema of the blob in
+     * [schemaFile_], one written from the same classes
+     */
+    int
+    stream (const char * schemaFile_, std::istream & in_) {
+        CordaBytes sibling (schemaFile_);
+
+        auto schema = amqp::internal::tape::schema (
+            amqp::internal::tape::sections (
+                sibling.bytes(), sibling.size()).schema);
+
+        amqp::internal::reader::JsonVisitor json;
+
+        json.onCompositeBegin ("", "");
+        json.onField ("Parsed");
+
+        amqp::internal::stream::Blob blob (*schema, json);
+
+        const size_t chunk { 1 << 16 };
+
+        std::array<std::vector<char>, 2> buffers {
+            std::vector<char> (chunk), std::vector<char> (chunk) };
+
+        auto read = [&in_](std::vector<char> & buffer_) {
+            in_.read (buffer_.data(), buffer_.size());
+            return static_cast<size_t>(in_.gcount());
+        };
+
+        auto status = amqp::internal::stream::Decoder::more_e;
+        auto pending = std::async (std::launch::async, read, std::ref (buffers[0]));
+
+        for (size_t i { 0 } ; ; ++i) {
+            auto n = pending.get();
+
+            if (n == 0) {
+                break;
+            }
+
+            pending = std::async (
+                std::launch::async, read, std::ref (buffers[(i + 1) % 2]));
+
+            status = blob.feed (buffers[i % 2].data(), n);
+        }
+
+        if (status != amqp::internal::stream::Decoder::done_e) {
+            std::cerr << "Blob truncated at offset "
+                << blob.decoder().offset() << std::endl;
+
+            return EXIT_FAILURE;
+        }
+
+        json.onCompositeEnd();
+
+        std::cout << json.str() << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    /**
+     * A line for each of [files_] saying whether it's a blob we could
+     * read and, if not, what's wrong with it and where
+     */
+    int
+    validate (char ** files_, int count_) {
+        int rtn { EXIT_SUCCESS };
+
+        for (int i { 0 } ; i < count_ ; ++i) {
+            std::ifstream f { files_[i], std::ios::in | std::ios::binary };
+
+            if (!f) {
+                std::cout << files_[i] << ": cannot open" << std::endl;
+                rtn = EXIT_FAILURE;
+                continue;
+            }
+
+            std::string bytes { std::istreambuf_iterator<char> (f), { } };
+
+            auto validation = amqp::validate (bytes.data(), bytes.size());
+
+            if (validation.valid()) {
+                std::cout << files_[i] << ": valid" << std::endl;
+                continue;
+            }
+
+            std::cout << files_[i] << ": invalid at offset " << validation.offset;
+
+            if (!validation.path.empty()) {
+                std::cout << " (" << validation.path << ")";
+            }
+
+            std::cout << ": " << validation.error << std::endl;
+
+            rtn = EXIT_FAILURE;
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Each of [files_] read as a signed transaction, either its id alone
+     * or, if [decode_], its id, groups and decoded components
+     */
+    int
+    transactions (char ** files_, int count_, bool decode_) {
+        int rtn { EXIT_SUCCESS };
+
+        for (int i { 0 } ; i < count_ ; ++i) {
+            try {
+                std::ifstream f { files_[i], std::ios::in | std::ios::binary };
+
+                if (!f) {
+                    throw std::runtime_error ("cannot open");
+                }
+
+                std::string bytes { std::istreambuf_iterator<char> (f), { } };
+
+                Transaction transaction (bytes);
+
+                if (decode_) {
+                    std::cout << transaction.json (true) << std::endl;
+                } else {
+                    const auto & id = transaction.id();
+
+                    std::cout << files_[i] << ": "
+                        << encoding::hex::encode (id.data(), id.size()) << std::endl;
+                }
+            } catch (const std::exception & e) {
+                std::cerr << files_[i] << ": " << e.what() << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+        }
+
+        return rtn;
+    }
+
+}
 
 /******************************************************************************/
 
@@ -28,6 +181,38 @@ int
 main (int argc, char **argv) {
     struct stat results { };
 
+    // --stream <blob> reads the blob from a file, or stdin if it's "-", as
+    // it arrives against the schema of another blob of the same classes
+    if (argc > 3 && strcmp (argv[1], "--stream") == 0) {
+        try {
+            if (strcmp (argv[3], "-") == 0) {
+                return stream (argv[2], std::cin);
+            }
+
+            std::ifstream in { argv[3], std::ios::in | std::ios::binary };
+
+            return stream (argv[2], in);
+        } catch (const std::exception & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // --validate <blob>... checks each blob could be read without reading it
+    if (argc > 2 && strcmp (argv[1], "--validate") == 0) {
+        return validate (argv + 2, argc - 2);
+    }
+
+    // --transaction <blob>... prints each signed transaction with the id
+    // recomputed from its components, --transaction-id <blob>... just the id
+    if (argc > 2 && strcmp (argv[1], "--transaction") == 0) {
+        return transactions (argv + 2, argc - 2, true);
+    }
+
+    if (argc > 2 && strcmp (argv[1], "--transaction-id") == 0) {
+        return transactions (argv + 2, argc - 2, false);
+    }
+
     if (stat(argv[1], &results) != 0) {
         return EXIT_FAILURE;
     }
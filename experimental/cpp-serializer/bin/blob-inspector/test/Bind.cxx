@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "CordaBytes.h"
+#include "amqp/bind/Bind.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string filepath ("../../test-files/"); // NOLINT
+
+    template<class Binding>
+    auto
+    decode (const Binding & binding_, const std::string & file_) {
+        CordaBytes cb (filepath + file_);
+
+        return binding_.decode (cb.bytes(), cb.size());
+    }
+
+    struct I { int a; };
+    struct L { long x; };
+    struct IS { int a; std::string b; };
+    struct I_IS { int a; IS b; };
+    struct LI { std::vector<int> a; };
+    struct L_I { std::vector<I> listy; };
+
+    /**
+     * Reads a composite with descriptor "d" whose properties [put_] writes
+     * through [binding_], returning what it failed with
+     */
+    template<class T, class Binding, typename Put>
+    std::string
+    malformed (const Binding & binding_, Put put_) {
+        auto data = pn_data (0);
+
+        pn_data_put_described (data);
+        pn_data_enter (data);
+        pn_data_put_symbol (data, pn_bytes (1, "d"));
+        pn_data_put_list (data);
+        pn_data_enter (data);
+        put_ (data);
+        pn_data_exit (data);
+        pn_data_exit (data);
+
+        pn_data_rewind (data);
+        pn_data_next (data);
+
+        std::string error;
+
+        try {
+            T value { };
+            binding_.read (data, value);
+        } catch (const std::runtime_error & e) {
+            error = e.what();
+        }
+
+        pn_data_free (data);
+
+        return error;
+    }
+
+    const auto i = amqp::bind<I> (AMQP_FIELD (I, a)); // NOLINT
+
+    const auto is = amqp::bind<IS> ( // NOLINT
+            AMQP_FIELD (IS, a),
+            AMQP_FIELD (IS, b));
+
+}
+
+/******************************************************************************/
+
+TEST (Bind, primitive) { // NOLINT
+    EXPECT_EQ (69, decode (i, "_i_").a);
+
+    auto l = amqp::bind<L> (AMQP_FIELD (L, x));
+
+    EXPECT_EQ (100000000000L, decode (l, "_l_").x);
+}
+
+/******************************************************************************/
+
+TEST (Bind, nested) { // NOLINT
+    auto i_is = amqp::bind<I_IS> (
+            AMQP_FIELD (I_IS, a),
+            AMQP_BOUND_FIELD (I_IS, b, is));
+
+    auto value = decode (i_is, "_i_is__");
+
+    EXPECT_EQ (1, value.a);
+    EXPECT_EQ (2, value.b.a);
+    EXPECT_EQ ("three", value.b.b);
+}
+
+/******************************************************************************/
+
+TEST (Bind, lists) { // NOLINT
+    auto li = amqp::bind<LI> (AMQP_FIELD (LI, a));
+
+    EXPECT_EQ ((std::vector<int> { 1, 2, 3, 4, 5, 6 }), decode (li, "_Li_").a);
+
+    auto l_i = amqp::bind<L_I> (AMQP_BOUND_FIELD (L_I, listy, i));
+
+    auto listy = decode (l_i, "_L_i__").listy;
+
+    ASSERT_EQ (3, listy.size());
+    EXPECT_EQ (1, listy[0].a);
+    EXPECT_EQ (2, listy[1].a);
+    EXPECT_EQ (3, listy[2].a);
+}
+
+/******************************************************************************/
+
+/**
+ * Members are matched to properties by name, not by the order they're
+ * bound in, and once verified the same binding keeps decoding
+ */
+TEST (Bind, order) { // NOLINT
+    auto si = amqp::bind<IS> (
+            AMQP_FIELD (IS, b),
+            AMQP_FIELD (IS, a));
+
+    auto i_is = amqp::bind<I_IS> (
+            AMQP_BOUND_FIELD (I_IS, b, si),
+            AMQP_FIELD (I_IS, a));
+
+    for (int n { 0 } ; n < 2 ; ++n) {
+        auto value = decode (i_is, "_i_is__");
+
+        EXPECT_EQ (1, value.a);
+        EXPECT_EQ (2, value.b.a);
+        EXPECT_EQ ("three", value.b.b);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Every difference is reported at once and, having failed, the binding
+ * hasn't learnt anything that would let a later decode through
+ */
+TEST (Bind, mismatch) { // NOLINT
+    struct Wrong { long a; std::string c; };
+
+    auto wrong = amqp::bind<Wrong> (
+            AMQP_FIELD (Wrong, a),
+            AMQP_FIELD (Wrong, c));
+
+    const std::string expected (
+        "Binding does not match net.corda.blobwriter._i_is__ in the blob's schema\n"
+        "  ~ net.corda.blobwriter._i_is__.a : int in the schema but bound as long\n"
+        "  + net.corda.blobwriter._i_is__.b : net.corda.blobwriter._is_ is not bound\n"
+        "  - net.corda.blobwriter._i_is__.c : string is bound but not in the schema");
+
+    for (int n { 0 } ; n < 2 ; ++n) {
+        try {
+            decode (wrong, "_i_is__");
+            FAIL() << "Expected the binding to be rejected";
+        } catch (const std::runtime_error & e) {
+            EXPECT_EQ (expected, e.what());
+        }
+    }
+
+    struct Deep { int a; I b; };
+
+    auto deep = amqp::bind<Deep> (
+            AMQP_FIELD (Deep, a),
+            AMQP_BOUND_FIELD (Deep, b, i));
+
+    EXPECT_THROW (decode (deep, "_i_is__"), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Once verified a binding trusts the order it learnt but not the values,
+ * a composite holding too few of them or ones of the wrong type failing
+ * rather than being read as zero
+ */
+TEST (Bind, malformed) { // NOLINT
+    auto bi = amqp::bind<I> (AMQP_FIELD (I, a));
+    bi.learn ("d", { 0 });
+
+    EXPECT_EQ ("Expected int but the blob holds PN_STRING",
+        malformed<I> (bi, [](pn_data_t * data_) {
+            pn_data_put_string (data_, pn_bytes (1, "x"));
+        }));
+
+    EXPECT_EQ ("Blob holds fewer values than its binding reads",
+        malformed<I> (bi, [](pn_data_t *) { }));
+
+    auto li = amqp::bind<LI> (AMQP_FIELD (LI, a));
+    li.learn ("d", { 0 });
+
+    EXPECT_EQ ("Expected int but the blob holds PN_LONG",
+        malformed<LI> (li, [](pn_data_t * data_) {
+            pn_data_put_described (data_);
+            pn_data_enter (data_);
+            pn_data_put_symbol (data_, pn_bytes (1, "l"));
+            pn_data_put_list (data_);
+            pn_data_enter (data_);
+            pn_data_put_int (data_, 1);
+            pn_data_put_long (data_, 2);
+            pn_data_exit (data_);
+            pn_data_exit (data_);
+        }));
+}
+
+/******************************************************************************/
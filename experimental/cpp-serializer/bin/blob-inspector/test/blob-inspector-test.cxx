@@ -1,9 +1,40 @@
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <iterator>
 #include "CordaBytes.h"
 #include "BlobInspector.h"
+#include "amqp/reader/Elements.h"
+#include "amqp/reader/Entries.h"
+#include "amqp/reader/Document.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/reader/Graph.h"
+#include "amqp/bind/Bind.h"
+#include "amqp/tape/Tape.h"
+#include "amqp/tape/Sections.h"
+#include "amqp/stream/Blob.h"
+#include "amqp/validate/Validate.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "concurrency/Interner.h"
+#include "concurrency/ThreadPool.h"
+#include "proton/proton_wrapper.h"
+#include "encoding/Hex.h"
 
 const std::string filepath ("../../test-files/"); // NOLINT
 
+/**
+ * Every test blob, for the checks that should hold of all of them
+ */
+const std::vector<std::string> testFiles { // NOLINT
+    "_i_", "_l_", "_Oi_", "_Ai_", "_Li_", "_L_i__", "_Le_", "_ALd_",
+    "_Ci_", "_e_", "_MiLs_", "_Mis_", "_Mi_is__", "_Pls_", "_i_is__",
+    "__i_LMis_l__" };
+
 /******************************************************************************
  *
  * mapType Tests
@@ -16,6 +47,18 @@ test (const std::string & file_, const std::string & result_) {
     CordaBytes cb (path);
     auto val = BlobInspector (cb).dump();
     ASSERT_EQ(result_, val);
+
+    auto variant = BlobInspector (
+            cb, BlobInspector::variant_e).dump();
+    ASSERT_EQ(result_, variant);
+
+    auto visitor = BlobInspector (
+            cb, BlobInspector::visitor_e).dump();
+    ASSERT_EQ(result_, visitor);
+
+    auto document = BlobInspector (
+            cb, BlobInspector::document_e).dump();
+    ASSERT_EQ(result_, document);
 }
 
 /******************************************************************************/
@@ -24,7 +67,7 @@ test (const std::string & file_, const std::string & result_) {
  * int
  */
 TEST (BlobInspector, _i_) { // NOLINT
-    test ("_i_", "{ Parsed : { a : 69 } }");
+    test ("_i_", R"({ "Parsed" : { "a" : 69 } })");
 }
 
 /******************************************************************************/
@@ -33,7 +76,7 @@ TEST (BlobInspector, _i_) { // NOLINT
  * long
  */
 TEST (BlobInspector, _l_) { // NOLINT
-    test ("_l_", "{ Parsed : { x : 100000000000 } }");
+    test ("_l_", R"({ "Parsed" : { "x" : 100000000000 } })");
 }
 
 /******************************************************************************/
@@ -42,7 +85,7 @@ TEST (BlobInspector, _l_) { // NOLINT
  * int
  */
 TEST (BlobInspector, _Oi_) { // NOLINT
-    test ("_Oi_", "{ Parsed : { a : 1 } }");
+    test ("_Oi_", R"({ "Parsed" : { "a" : 1 } })");
 }
 
 /******************************************************************************/
@@ -51,7 +94,7 @@ TEST (BlobInspector, _Oi_) { // NOLINT
  * int
  */
 TEST (BlobInspector, _Ai_) { // NOLINT
-    test ("_Ai_", "{ Parsed : { z : [ 1, 2, 3, 4, 5, 6 ] } }");
+    test ("_Ai_", R"({ "Parsed" : { "z" : [ 1, 2, 3, 4, 5, 6 ] } })");
 }
 
 /******************************************************************************/
@@ -60,7 +103,7 @@ TEST (BlobInspector, _Ai_) { // NOLINT
  * List of ints
  */
 TEST (BlobInspector, _Li_) { // NOLINT
-    test ("_Li_", "{ Parsed : { a : [ 1, 2, 3, 4, 5, 6 ] } }");
+    test ("_Li_", R"({ "Parsed" : { "a" : [ 1, 2, 3, 4, 5, 6 ] } })");
 }
 
 /******************************************************************************/
@@ -71,13 +114,13 @@ TEST (BlobInspector, _Li_) { // NOLINT
 TEST (BlobInspector, _L_i__) { // NOLINT
     test (
         "_L_i__",
-        "{ Parsed : { listy : [ { a : 1 }, { a : 2 }, { a : 3 } ] } }");
+        R"({ "Parsed" : { "listy" : [ { "a" : 1 }, { "a" : 2 }, { "a" : 3 } ] } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _Le_) { // NOLINT
-    test ("_Le_", "{ Parsed : { listy : [ A, B, C ] } }");
+    test ("_Le_", R"({ "Parsed" : { "listy" : [ "A", "B", "C" ] } })");
 }
 
 /******************************************************************************/
@@ -97,7 +140,7 @@ TEST (BlobInspector,_Le_2) { // NOLINT
  */
 TEST (BlobInspector, _Mis_) { // NOLINT
     test ("_Mis_",
-        R"({ Parsed : { a : { 1 : "two", 3 : "four", 5 : "six" } } })");
+        R"({ "Parsed" : { "a" : { "1" : "two", "3" : "four", "5" : "six" } } })");
 }
 
 /******************************************************************************/
@@ -107,7 +150,7 @@ TEST (BlobInspector, _Mis_) { // NOLINT
  */
 TEST (BlobInspector, _MiLs_) { // NOLINT
     test ("_MiLs_",
-        R"({ Parsed : { a : { 1 : [ "two", "three", "four" ], 5 : [ "six" ], 7 : [  ] } } })");
+        R"({ "Parsed" : { "a" : { "1" : [ "two", "three", "four" ], "5" : [ "six" ], "7" : [  ] } } })");
 }
 
 /******************************************************************************/
@@ -117,27 +160,27 @@ TEST (BlobInspector, _MiLs_) { // NOLINT
  */
 TEST (BlobInspector, _Mi_is__) { // NOLINT
     test ("_Mi_is__",
-        R"({ Parsed : { a : { 1 : { a : 2, b : "three" }, 4 : { a : 5, b : "six" }, 7 : { a : 8, b : "nine" } } } })");
+        R"({ "Parsed" : { "a" : { "1" : { "a" : 2, "b" : "three" }, "4" : { "a" : 5, "b" : "six" }, "7" : { "a" : 8, "b" : "nine" } } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector,_Pls_) { // NOLINT
     test ("_Pls_",
-            R"({ Parsed : { a : { first : 1, second : "two" } } })");
+            R"({ "Parsed" : { "a" : { "first" : 1, "second" : "two" } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _e_) { // NOLINT
-    test ("_e_", "{ Parsed : { e : A } }");
+    test ("_e_", R"({ "Parsed" : { "e" : "A" } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _i_is__) { // NOLINT
     test ("_i_is__",
-            R"({ Parsed : { a : 1, b : { a : 2, b : "three" } } })");
+            R"({ "Parsed" : { "a" : 1, "b" : { "a" : 2, "b" : "three" } } })");
 }
 
 /******************************************************************************/
@@ -145,7 +188,7 @@ TEST (BlobInspector, _i_is__) { // NOLINT
 // Array of unboxed integers
 TEST (BlobInspector, _Ci_) { // NOLINT
     test ("_Ci_",
-        R"({ Parsed : { z : [ 1, 2, 3 ] } })");
+        R"({ "Parsed" : { "z" : [ 1, 2, 3 ] } })");
 }
 
 /******************************************************************************/
@@ -158,14 +201,542 @@ TEST (BlobInspector, _Ci_) { // NOLINT
  */
 TEST (BlobInspector, __i_LMis_l__) { // NOLINT
     test ("__i_LMis_l__",
-        R"({ Parsed : { x : [ { 1 : "two", 3 : "four", 5 : "six" }, { 7 : "eight", 9 : "ten" } ], y : { x : 1000000 }, z : { a : 666 } } })");
+        R"({ "Parsed" : { "x" : [ { "1" : "two", "3" : "four", "5" : "six" }, { "7" : "eight", "9" : "ten" } ], "y" : { "x" : 1000000 }, "z" : { "a" : 666 } } })");
 }
 
 /******************************************************************************/
 
 TEST (BlobInspector, _ALd_) { // NOLINT
     test ("_ALd_",
-            R"({ Parsed : { a : [ [ 10.100000, 11.200000, 12.300000 ], [  ], [ 13.400000 ] ] } })");
+            R"({ "Parsed" : { "a" : [ [ 10.1, 11.2, 12.3 ], [  ], [ 13.4 ] ] } })");
+}
+
+/******************************************************************************/
+
+/**
+ * With every list decoded across the pool the output should be the same
+ * as decoding it in place
+ */
+TEST (BlobInspector, parallel) { // NOLINT
+    using amqp::internal::reader::Elements;
+
+    auto threshold = Elements::threshold();
+
+    concurrency::ThreadPool::resize (3);
+    Elements::threshold (2);
+
+    for (const auto & file : {
+        "_Ai_", "_Li_", "_L_i__", "_Le_", "_ALd_", "_Ci_", "__i_LMis_l__" })
+    {
+        CordaBytes cb (filepath + file);
+        auto parallel = BlobInspector (cb).dump();
+
+        Elements::threshold (threshold);
+        auto serial = BlobInspector (cb).dump();
+        Elements::threshold (2);
+
+        EXPECT_EQ (serial, parallel) << file;
+    }
+
+    // with no threshold at all even an empty list is shared out
+    Elements::threshold (0);
+
+    CordaBytes cb (filepath + "_ALd_");
+    EXPECT_EQ (
+        R"({ "Parsed" : { "a" : [ [ 10.1, 11.2, 12.3 ], [  ], [ 13.4 ] ] } })",
+        BlobInspector (cb).dump());
+
+    Elements::threshold (threshold);
+}
+
+/******************************************************************************/
+
+/**
+ * Readers frozen out of a factory sit in the graph's one allocation and
+ * keep working once both the factory and the graph handle are gone
+ */
+TEST (BlobInspector, frozen) { // NOLINT
+    CordaBytes cb (filepath + "__i_LMis_l__");
+
+    auto data = pn_data (0);
+    pn_data_decode (data, cb.bytes(), cb.size());
+
+    uPtr<amqp::internal::schema::Envelope> envelope;
+    {
+        proton::auto_enter p (data);
+
+        auto it = amqp::internal::AMQPDescriptorRegistory.find (
+                pn_data_get_ulong (data));
+
+        envelope.reset (dynamic_cast<amqp::internal::schema::Envelope *> (
+                it->second->build (data).release()));
+    }
+
+    sPtr<amqp::internal::reader::IReader> reader;
+    {
+        amqp::internal::CompositeFactory cf;
+        cf.process (envelope->schema());
+
+        auto graph = cf.freeze();
+        reader = graph->byDescriptor (envelope->descriptor());
+
+        ASSERT_TRUE (reader);
+        EXPECT_TRUE (graph->contains (reader.get()));
+        EXPECT_FALSE (graph->contains (
+                cf.byDescriptor (envelope->descriptor()).get()));
+        EXPECT_FALSE (graph->byType ("not.a.Type"));
+    }
+
+    std::string dumped;
+    {
+        proton::auto_enter p (data);
+        pn_data_next (data);
+        proton::auto_enter q (data);
+
+        dumped = "{ " + reader->dump (
+                "Parsed", data, envelope->schema())->dump() + " }";
+    }
+
+    EXPECT_EQ (BlobInspector (cb).dump(), dumped);
+
+    pn_data_free (data);
+}
+
+/******************************************************************************/
+
+/**
+ * A decoded map can be looked up by key as well as dumped
+ */
+TEST (BlobInspector, mapLookup) { // NOLINT
+    using namespace amqp::internal::reader;
+
+    CordaBytes cb (filepath + "_Mis_");
+
+    auto data = pn_data (0);
+    pn_data_decode (data, cb.bytes(), cb.size());
+
+    uPtr<amqp::internal::schema::Envelope> envelope;
+    {
+        proton::auto_enter p (data);
+
+        auto it = amqp::internal::AMQPDescriptorRegistory.find (
+                pn_data_get_ulong (data));
+
+        envelope.reset (dynamic_cast<amqp::internal::schema::Envelope *> (
+                it->second->build (data).release()));
+    }
+
+    amqp::internal::CompositeFactory cf;
+    cf.process (envelope->schema());
+
+    uPtr<amqp::reader::IValue> value;
+    {
+        proton::auto_enter p (data);
+        pn_data_next (data);
+        proton::auto_enter q (data);
+
+        value = cf.byDescriptor (envelope->descriptor())->dump (
+                "Parsed", data, envelope->schema());
+    }
+
+    pn_data_free (data);
+
+    const auto & fields = dynamic_cast<
+        const TypedPair<sVec<uPtr<amqp::reader::IValue>>> &> (*value).value();
+
+    const auto & map = dynamic_cast<
+        const TypedPair<Entries> &> (*fields.at (0)).value();
+
+    ASSERT_EQ (3, map.size());
+    EXPECT_TRUE (map.sorted());
+
+    for (auto lookup : { Entries::hash_e, Entries::sorted_e }) {
+        ASSERT_TRUE (map.find (3, lookup));
+        EXPECT_EQ ("\"four\"", map.find (3, lookup)->dump());
+        EXPECT_EQ ("\"six\"", map.find (5, lookup)->dump());
+        EXPECT_FALSE (map.find (2, lookup));
+    }
+}
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Writes each event down as it arrives
+     */
+    class Trace : public amqp::reader::IVisitor {
+        public :
+            std::string trace;
+
+            void onCompositeBegin (std::string_view type_, std::string_view) override {
+                trace += "{" + std::string (type_) + " ";
+            }
+            void onCompositeEnd() override { trace += "} "; }
+
+            void onField (std::string_view name_) override {
+                trace += std::string (name_) + ": ";
+            }
+
+            void onListBegin (size_t n_) override {
+                trace += "[" + std::to_string (n_) + " ";
+            }
+            void onListEnd() override { trace += "] "; }
+
+            void onMapBegin (size_t n_) override {
+                trace += "<" + std::to_string (n_) + " ";
+            }
+            void onMapEnd() override { trace += "> "; }
+
+            void onInt (int32_t v_) override { trace += "i" + std::to_string (v_) + " "; }
+            void onLong (int64_t v_) override { trace += "l" + std::to_string (v_) + " "; }
+            void onBool (bool v_) override { trace += v_ ? "true " : "false "; }
+            void onDouble (double v_) override { trace += "d" + std::to_string (v_) + " "; }
+            void onString (std::string_view v_) override {
+                trace += "'" + std::string (v_) + "' ";
+            }
+            void onBinary (std::string_view v_) override {
+                trace += "b" + encoding::hex::encode (v_.data(), v_.size()) + " ";
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * The events a blob raises, and that the compiled readers raise the same
+ */
+TEST (BlobInspector, visit) { // NOLINT
+    {
+        CordaBytes cb (filepath + "_i_is__");
+        Trace trace;
+
+        BlobInspector (cb).visit (trace);
+
+        EXPECT_EQ (
+            "{net.corda.blobwriter._i_is__ a: i1 "
+            "b: {net.corda.blobwriter._is_ a: i2 b: 'three' } } ",
+            trace.trace);
+    }
+
+    {
+        CordaBytes cb (filepath + "_MiLs_");
+        Trace trace;
+
+        BlobInspector (cb).visit (trace);
+
+        EXPECT_EQ (
+            "{net.corda.blobwriter._MiLs_ a: <3 "
+            "i1 [3 'two' 'three' 'four' ] i5 [1 'six' ] i7 [0 ] > } ",
+            trace.trace);
+    }
+
+    for (const auto & file : testFiles) {
+        CordaBytes cb (filepath + file);
+        Trace virtuals, variants;
+
+        BlobInspector (cb).visit (virtuals);
+        BlobInspector (cb, BlobInspector::variant_e)
+            .visit (variants);
+
+        EXPECT_EQ (virtuals.trace, variants.trace) << file;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * A document holds what the events carried, and walking it raises them
+ * again
+ */
+TEST (BlobInspector, document) { // NOLINT
+    using amqp::internal::reader::Document;
+
+    {
+        CordaBytes cb (filepath + "_Mi_is__");
+        auto document = BlobInspector (cb).document();
+
+        const auto & root = document.root();
+
+        ASSERT_EQ (Document::composite_e, root.kind);
+        ASSERT_EQ (1, document.size (root));
+        EXPECT_EQ ("net.corda.blobwriter._Mi_is__", document.type (root));
+        EXPECT_EQ ("a", document.field (root, 0));
+
+        const auto & map = document.child (root, 0);
+
+        ASSERT_EQ (Document::map_e, map.kind);
+        ASSERT_EQ (3, document.size (map));
+
+        const auto & key = document.child (map, 4);
+        const auto & value = document.child (map, 5);
+
+        ASSERT_EQ (Document::int_e, key.kind);
+        EXPECT_EQ (7, key.integer);
+
+        ASSERT_EQ (Document::composite_e, value.kind);
+        EXPECT_EQ ("b", document.field (value, 1));
+        EXPECT_EQ ("nine", document.bytes (document.child (value, 1)));
+
+        // the three values share one type
+        EXPECT_EQ (value.aux, document.child (map, 1).aux);
+        EXPECT_EQ (value.aux, document.child (map, 3).aux);
+
+        // the root, the map, three keys and three values of two properties
+        EXPECT_EQ (1 + 1 + 3 + 3 * 3, document.slots().size());
+    }
+
+    for (const auto & file : testFiles) {
+        CordaBytes cb (filepath + file);
+        Trace visited, replayed;
+
+        BlobInspector (cb).visit (visited);
+        BlobInspector (cb).document().visit (replayed);
+
+        EXPECT_EQ (visited.trace, replayed.trace) << file;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Documents built through one interner share their strings and names
+ */
+TEST (BlobInspector, interned) { // NOLINT
+    concurrency::Interner interner;
+
+    CordaBytes cb (filepath + "_Mi_is__");
+
+    auto first = BlobInspector (cb).document (&interner);
+    auto second = BlobInspector (cb).document (&interner);
+
+    EXPECT_EQ (BlobInspector (cb).document().json(), first.json());
+
+    const auto & a = first.child (first.child (first.root(), 0), 5);
+    const auto & b = second.child (second.child (second.root(), 0), 5);
+
+    EXPECT_EQ ("nine", first.bytes (first.child (a, 1)));
+    EXPECT_EQ (
+        first.bytes (first.child (a, 1)).data(),
+        second.bytes (second.child (b, 1)).data());
+    EXPECT_EQ (first.type (a).data(), second.type (b).data());
+    EXPECT_EQ (first.field (a, 0).data(), second.field (b, 0).data());
+
+    // two descriptors, two type names, the field names a and b, and the
+    // three strings
+    auto stats = interner.stats();
+
+    EXPECT_EQ (9, stats.strings);
+    EXPECT_EQ (18, stats.lookups);
+    EXPECT_DOUBLE_EQ (0.5, stats.hitRate());
+}
+
+/******************************************************************************/
+
+/**
+ * Fed a few bytes at a time against a schema it's handed up front, a blob
+ * raises the events reading the whole of it does
+ */
+TEST (BlobInspector, stream) { // NOLINT
+    using namespace amqp::internal;
+
+    for (const auto & file : testFiles) {
+        std::ifstream f (filepath + file, std::ios::in | std::ios::binary);
+        std::string bytes { std::istreambuf_iterator<char> (f), { } };
+
+        CordaBytes cb (filepath + file);
+        auto schema = tape::schema (tape::sections (cb.bytes(), cb.size()).schema);
+
+        Trace whole;
+        BlobInspector (cb).visit (whole);
+
+        for (size_t chunk : { 1, 5, 4096 }) {
+            Trace trace;
+            stream::Blob blob (*schema, trace);
+
+            auto status = stream::Decoder::more_e;
+
+            for (size_t at { 0 } ; at < bytes.size() ; at += chunk) {
+                status = blob.feed (
+                    bytes.data() + at, std::min (chunk, bytes.size() - at));
+            }
+
+            EXPECT_EQ (stream::Decoder::done_e, status) << file;
+            EXPECT_EQ (whole.trace, trace.trace) << file << " " << chunk;
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Finding a blob's sections by their sizes agrees with a full decode
+ */
+TEST (BlobInspector, sections) { // NOLINT
+    using namespace amqp::internal;
+
+    for (const auto & file : testFiles) {
+        CordaBytes cb (filepath + file);
+
+        auto sections = tape::sections (cb.bytes(), cb.size());
+
+        tape::Tape tape (cb.bytes(), cb.size());
+        auto envelope = tape.child (0, 1);
+
+        EXPECT_EQ (tape.bytes (tape.child (envelope, 0)), sections.object) << file;
+        EXPECT_EQ (tape.bytes (tape.child (envelope, 1)), sections.schema) << file;
+        EXPECT_EQ (
+            tape.value (tape.child (tape.child (envelope, 0), 0)),
+            sections.descriptor) << file;
+
+        bind::Blob blob (cb.bytes(), cb.size());
+        std::stringstream full, section;
+
+        full << blob.schema();
+        section << *tape::schema (sections.schema);
+
+        EXPECT_EQ (full.str(), section.str()) << file;
+    }
+
+    CordaBytes i (filepath + "_i_"), l (filepath + "_l_");
+
+    EXPECT_NE (
+        tape::hash (tape::sections (i.bytes(), i.size()).schema),
+        tape::hash (tape::sections (l.bytes(), l.size()).schema));
+
+    EXPECT_THROW ( // NOLINT
+        tape::sections (i.bytes() + 1, i.size() - 1), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/**
+ * Every test blob is valid, and the first thing wrong with a broken one
+ * is found where it lies
+ */
+TEST (BlobInspector, validate) { // NOLINT
+    auto contents = [](const std::string & file_) {
+        std::ifstream f (filepath + file_, std::ios::in | std::ios::binary);
+        return std::string { std::istreambuf_iterator<char> (f), { } };
+    };
+
+    for (const auto & file : testFiles) {
+        auto bytes = contents (file);
+        auto validation = amqp::validate (bytes.data(), bytes.size());
+
+        EXPECT_TRUE (validation.valid()) << file << " " << validation.error;
+    }
+
+    // _i_'s only property, a, is the small int at offset 61
+    auto i = contents ("_i_");
+
+    ASSERT_EQ (0x54, i[61]);
+
+    {
+        auto bad = i;
+        bad[2] = 'X';
+
+        auto validation = amqp::validate (bad.data(), bad.size());
+
+        EXPECT_FALSE (validation.valid());
+        EXPECT_EQ (2, validation.offset);
+    }
+
+    {
+        auto bad = i;
+        bad[7] = 1;
+
+        auto validation = amqp::validate (bad.data(), bad.size());
+
+        EXPECT_EQ ("Unsupported encoding 1", validation.error);
+        EXPECT_EQ (7, validation.offset);
+    }
+
+    {
+        // a small long where the schema says int
+        auto bad = i;
+        bad[61] = 0x55;
+
+        auto validation = amqp::validate (bad.data(), bad.size());
+
+        EXPECT_FALSE (validation.valid());
+        EXPECT_EQ (61, validation.offset);
+        EXPECT_EQ ("a", validation.path);
+    }
+
+    {
+        // and one no reader understands
+        auto bad = i;
+        bad[61] = 0x51;
+
+        auto validation = amqp::validate (bad.data(), bad.size());
+
+        EXPECT_FALSE (validation.valid());
+        EXPECT_EQ (61, validation.offset);
+    }
+
+    {
+        // an unknown format code
+        auto bad = i;
+        bad[61] = 0x3f;
+
+        auto validation = amqp::validate (bad.data(), bad.size());
+
+        EXPECT_FALSE (validation.valid());
+        EXPECT_EQ (61, validation.offset);
+        EXPECT_EQ ("a", validation.path);
+    }
+
+    {
+        // a property list cut short, its count saying there are none
+        auto bad = i;
+        bad[60] = 0;
+
+        auto validation = amqp::validate (bad.data(), bad.size());
+
+        EXPECT_FALSE (validation.valid());
+        EXPECT_EQ ("Missing property a of net.corda.blobwriter._i_", validation.error);
+        EXPECT_EQ ("a", validation.path);
+    }
+
+    {
+        // the schema's found by the envelope's sizes, so cutting the blob
+        // short leaves the envelope broken
+        auto validation = amqp::validate (i.data(), 62);
+
+        EXPECT_FALSE (validation.valid());
+        EXPECT_EQ (8, validation.offset);
+    }
+
+    {
+        // an envelope whose object is nothing but chained descriptors
+        std::string bad (i.data(), 8);
+        bad += std::string {
+            '\0', '\x80', 0, 0, '\xc5', 0x62, 0, 0, 0, 0x01,
+            '\xd0', 0, '\x1e', '\x84', '\x84', 0, 0, 0, 0x03 };
+        bad += std::string (2000000, '\0');
+
+        auto validation = amqp::validate (bad.data(), bad.size());
+
+        EXPECT_FALSE (validation.valid());
+        EXPECT_EQ (8, validation.offset);
+    }
+
+    // deeper in, the path leads to the property, here a symbol where
+    // the value of a map of int to string is expected
+    auto l = contents ("__i_LMis_l__");
+    auto eight = l.find ("\xa1\x05" "eight");
+
+    ASSERT_NE (std::string::npos, eight);
+
+    l[eight] = '\xa3';
+
+    auto validation = amqp::validate (l.data(), l.size());
+
+    EXPECT_FALSE (validation.valid());
+    EXPECT_EQ (eight, validation.offset);
+    EXPECT_EQ ("x[1][0].value", validation.path);
 }
 
 /******************************************************************************/
@@ -0,0 +1,315 @@
+#include "Catalog.h"
+
+#include <cstdio>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include "encoding/Json.h"
+#include "concurrency/ThreadPool.h"
+
+#include "amqp/AMQPSectionId.h"
+#include "amqp/tape/Sections.h"
+#include "amqp/schema/described-types/Schema.h"
+
+#include "CordaBytes.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    hex (uint64_t hash_) {
+        char rtn[17];
+        snprintf (rtn, sizeof (rtn), "%016llx",
+            static_cast<unsigned long long>(hash_));
+
+        return rtn;
+    }
+
+    /**
+     * The files named, with any directories replaced by every regular
+     * file beneath them
+     */
+    std::vector<std::string>
+    files (const std::vector<std::string> & paths_) {
+        namespace fs = std::filesystem;
+
+        std::vector<std::string> rtn;
+
+        for (const auto & path : paths_) {
+            if (!fs::is_directory (path)) {
+                rtn.push_back (path);
+                continue;
+            }
+
+            for (const auto & entry : fs::recursive_directory_iterator (path)) {
+                if (entry.is_regular_file()) {
+                    rtn.push_back (entry.path().string());
+                }
+            }
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+Catalog::Catalog()
+    : m_blobs (0)
+    , m_bytes (0)
+    , m_errors (0)
+{ }
+
+/******************************************************************************/
+
+bool
+Catalog::add (const std::string & name_, const char * bytes_, size_t size_) {
+    try {
+        CordaBytes cb (bytes_, size_);
+
+        if (cb.encoding() != amqp::DATA_AND_STOP) {
+            throw std::runtime_error ("Unsupported encoding");
+        }
+
+        auto section = amqp::internal::tape::sections (
+                cb.bytes(), cb.size()).schema;
+
+        auto & schema = m_schemas[amqp::internal::tape::hash (section)];
+
+        if (!schema.blobs) {
+            schema.example = name_;
+            schema.section.assign (section.data(), section.size());
+        }
+
+        ++schema.blobs;
+        schema.bytes += size_;
+    } catch (const std::exception &) {
+        ++m_errors;
+        return false;
+    }
+
+    ++m_blobs;
+    m_bytes += size_;
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
+Catalog::merge (Catalog && other_) {
+    for (auto & [hash, other] : other_.m_schemas) {
+        auto & schema = m_schemas[hash];
+
+        if (!schema.blobs) {
+            schema.example = std::move (other.example);
+            schema.section = std::move (other.section);
+            schema.types = std::move (other.types);
+        }
+
+        schema.blobs += other.blobs;
+        schema.bytes += other.bytes;
+    }
+
+    m_blobs += other_.m_blobs;
+    m_bytes += other_.m_bytes;
+    m_errors += other_.m_errors;
+}
+
+/******************************************************************************/
+
+io::Backend
+Catalog::scan (const std::vector<std::string> & paths_, io::Backend backend_) {
+    auto names = files (paths_);
+
+    auto & pool = concurrency::ThreadPool::instance();
+
+    /*
+     * Each participant keeps a catalog of its own, so nothing is shared
+     * until they're merged at the end
+     */
+    std::vector<Catalog> partials (pool.participants());
+
+    backend_ = io::read (names, backend_,
+        [&](size_t participant_, size_t index_, const char * bytes_, size_t size_) {
+            auto & partial = partials[participant_];
+
+            if (!bytes_) {
+                ++partial.m_errors;
+            } else {
+                partial.add (names[index_], bytes_, size_);
+            }
+        });
+
+    for (auto & partial : partials) {
+        merge (std::move (partial));
+    }
+
+    return backend_;
+}
+
+/******************************************************************************/
+
+void
+Catalog::resolve() {
+    for (auto & [hash, schema] : m_schemas) {
+        if (!schema.types.empty() || schema.section.empty()) {
+            continue;
+        }
+
+        try {
+            auto parsed = amqp::internal::tape::schema (schema.section);
+
+            for (const auto & level : *parsed) {
+                for (const auto & type : level) {
+                    schema.types.push_back ({
+                        type->name(),
+                        type->descriptor(),
+                        type->type() == amqp::internal::schema::AMQPTypeNotation::composite_t });
+                }
+            }
+        } catch (const std::exception &) {
+            // left without types, the blobs still count
+        }
+    }
+}
+
+/******************************************************************************/
+
+std::map<std::string, Catalog::Composite>
+Catalog::composites() const {
+    std::map<std::string, Composite> rtn;
+
+    for (const auto & [hash, schema] : m_schemas) {
+        for (const auto & type : schema.types) {
+            if (!type.composite) {
+                continue;
+            }
+
+            auto & composite = rtn[type.descriptor];
+
+            composite.name = type.name;
+            composite.blobs += schema.blobs;
+            composite.schemas.push_back (hash);
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+Catalog::write (std::ostream & out_) const {
+    using encoding::json::quote;
+
+    std::string line;
+
+    for (const auto & [hash, schema] : m_schemas) {
+        line = "{ \"schema\" : \"" + hex (hash) + "\", \"blobs\" : "
+            + std::to_string (schema.blobs) + ", \"bytes\" : "
+            + std::to_string (schema.bytes) + ", \"example\" : ";
+
+        quote (line, schema.example);
+
+        line += ", \"types\" : [ ";
+
+        for (size_t i { 0 } ; i < schema.types.size() ; ++i) {
+            const auto & type = schema.types[i];
+
+            line += i ? ", { \"name\" : " : "{ \"name\" : ";
+            quote (line, type.name);
+            line += ", \"descriptor\" : ";
+            quote (line, type.descriptor);
+            line += type.composite ? ", \"composite\" : true }" : " }";
+        }
+
+        line += " ] }\n";
+
+        out_ << line;
+    }
+
+    for (const auto & [descriptor, composite] : composites()) {
+        line = "{ \"composite\" : ";
+        quote (line, composite.name);
+        line += ", \"descriptor\" : ";
+        quote (line, descriptor);
+        line += ", \"blobs\" : " + std::to_string (composite.blobs)
+            + ", \"schemas\" : [ ";
+
+        for (size_t i { 0 } ; i < composite.schemas.size() ; ++i) {
+            line += (i ? ", \"" : "\"") + hex (composite.schemas[i]) + "\"";
+        }
+
+        line += " ] }\n";
+
+        out_ << line;
+    }
+}
+
+/******************************************************************************/
+
+void
+Catalog::summary (std::ostream & out_, size_t top_) const {
+    auto composites = this->composites();
+
+    out_ << m_blobs << " blobs, " << m_bytes << " bytes, "
+         << m_schemas.size() << " distinct schemas describing "
+         << composites.size() << " composite types";
+
+    if (m_errors) {
+        out_ << ", " << m_errors << " unreadable";
+    }
+
+    out_ << std::endl;
+
+    std::vector<std::pair<size_t, uint64_t>> schemas;
+
+    for (const auto & [hash, schema] : m_schemas) {
+        schemas.emplace_back (schema.blobs, hash);
+    }
+
+    std::sort (schemas.rbegin(), schemas.rend());
+
+    if (!schemas.empty()) {
+        out_ << std::endl << "Most common schemas" << std::endl;
+    }
+
+    for (size_t i { 0 } ; i < std::min (top_, schemas.size()) ; ++i) {
+        const auto & schema = m_schemas.at (schemas[i].second);
+
+        out_ << "  " << hex (schemas[i].second)
+             << " " << schema.blobs << " blobs, "
+             << schema.bytes << " bytes, "
+             << schema.types.size() << " types, e.g. " << schema.example
+             << std::endl;
+    }
+
+    std::vector<std::pair<size_t, std::string>> shared;
+
+    for (const auto & [descriptor, composite] : composites) {
+        if (composite.schemas.size() > 1) {
+            shared.emplace_back (composite.schemas.size(), descriptor);
+        }
+    }
+
+    std::sort (shared.rbegin(), shared.rend());
+
+    if (!shared.empty()) {
+        out_ << std::endl << "Composite types shared between schemas" << std::endl;
+    }
+
+    for (size_t i { 0 } ; i < std::min (top_, shared.size()) ; ++i) {
+        const auto & composite = composites.at (shared[i].second);
+
+        out_ << "  " << composite.name << " (" << shared[i].second << ") in "
+             << composite.schemas.size() << " schemas, "
+             << composite.blobs << " blobs" << std::endl;
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,102 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+
+#include "io/Reader.h"
+
+/******************************************************************************/
+
+/**
+ * A census of the schemas found across a corpus of blobs. Blobs are told
+ * apart by a hash of their schema section, found without decoding
+ * anything else, so each distinct schema is parsed only once however
+ * many blobs carry it.
+ *
+ * For each schema the catalog holds how many blobs carry it, their total
+ * size, one of them as an example and the types it describes. From those
+ * it can say which schemas, and so how many blobs, share each composite
+ * type.
+ */
+class Catalog {
+    public :
+        struct Type {
+            std::string name;
+            std::string descriptor;
+            bool        composite;
+        };
+
+        struct Schema {
+            size_t            blobs { 0 };
+            size_t            bytes { 0 };
+            std::string       example;
+            std::string       section;
+            std::vector<Type> types;
+        };
+
+        /**
+         * The schemas describing a composite type, keyed by its
+         * descriptor
+         */
+        struct Composite {
+            std::string           name;
+            size_t                blobs { 0 };
+            std::vector<uint64_t> schemas;
+        };
+
+    private :
+        std::map<uint64_t, Schema> m_schemas;
+
+        size_t m_blobs;
+        size_t m_bytes;
+        size_t m_errors;
+
+        void merge (Catalog &&);
+
+    public :
+        Catalog();
+
+        /**
+         * Add a blob, including its Corda header, returning false if it
+         * isn't one we can find a schema in
+         */
+        bool add (const std::string & name_, const char *, size_t);
+
+        /**
+         * Add every file named, reading and hashing them across the
+         * shared thread pool with [backend_], or the stream backend where
+         * it isn't available, returning which was used. Directories are
+         * walked for the files beneath them.
+         */
+        io::Backend scan (
+            const std::vector<std::string> &,
+            io::Backend backend_ = io::stream_t);
+
+        /**
+         * Parse every schema not yet parsed for the types it describes
+         */
+        void resolve();
+
+        const std::map<uint64_t, Schema> & schemas() const { return m_schemas; }
+
+        std::map<std::string, Composite> composites() const;
+
+        size_t blobs() const { return m_blobs; }
+        size_t bytes() const { return m_bytes; }
+        size_t errors() const { return m_errors; }
+
+        /**
+         * One JSON object per line, each schema followed by each
+         * composite type and the schemas that share it
+         */
+        void write (std::ostream &) const;
+
+        void summary (std::ostream &, size_t top_ = 10) const;
+};
+
+/******************************************************************************/
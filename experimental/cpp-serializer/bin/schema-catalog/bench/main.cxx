@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+#include "Catalog.h"
+#include "Generator.h"
+#include "io/Reader.h"
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+/**
+ * Cataloging a generated corpus of small blobs, one per file, read with
+ * an ifstream per file against io_uring. The argument is the number of
+ * files. Each corpus is written once to the temporary directory and left
+ * there for later runs, so only the first run of a size pays for it and
+ * the page cache is warm for the rest, leaving the system calls per file
+ * as the cost being measured.
+ *
+ * A million files is around 4GB on disk, more than the page cache of a
+ * small machine holds, in which case it's the disk that's measured.
+ */
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    corpus (size_t files_) {
+        namespace fs = std::filesystem;
+
+        auto dir = fs::temp_directory_path()
+            / ("schema-catalog-bench-" + std::to_string (files_));
+
+        auto done = dir / "complete";
+
+        if (fs::exists (done)) {
+            return dir.string();
+        }
+
+        fs::create_directories (dir);
+
+        Generator::Shape shape;
+        shape.schemas = 16;
+
+        Generator generator (shape, 0);
+
+        concurrency::ThreadPool::instance().parallelFor (files_, 1024,
+            [&](size_t, size_t begin_, size_t end_) {
+                std::string blob;
+
+                for (auto i = begin_ ; i < end_ ; ++i) {
+                    generator.blob (i, blob);
+
+                    std::ofstream (
+                        dir / (std::to_string (i) + ".blob"),
+                        std::ios::out | std::ios::binary | std::ios::trunc) << blob;
+                }
+            });
+
+        std::ofstream { done };
+
+        return dir.string();
+    }
+
+    template<io::Backend backend>
+    void
+    BM_Scan (benchmark::State & state_) {
+        if (!io::available (backend)) {
+            state_.SkipWithError ("unavailable");
+            return;
+        }
+
+        auto dir = corpus (state_.range (0));
+
+        for (auto _ : state_) {
+            Catalog catalog;
+
+            catalog.scan ({ dir }, backend);
+
+            benchmark::DoNotOptimize (catalog.blobs());
+        }
+
+        // the marker file's counted as an unreadable blob
+        state_.SetItemsProcessed (state_.iterations() * state_.range (0));
+    }
+
+}
+
+/******************************************************************************/
+
+BENCHMARK_TEMPLATE (BM_Scan, io::stream_t) // NOLINT
+    ->Arg (10000)->Arg (100000)->Arg (1000000)
+    ->Unit (benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE (BM_Scan, io::uring_t) // NOLINT
+    ->Arg (10000)->Arg (100000)->Arg (1000000)
+    ->Unit (benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN(); // NOLINT
+
+/******************************************************************************/
@@ -0,0 +1,114 @@
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "Catalog.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * exe_) {
+        std::cerr
+            << "usage: " << exe_ << " [options] <file|directory>..." << std::endl
+            << std::endl
+            << "  Catalog every distinct schema found in a corpus of blobs, writing"
+            << std::endl
+            << "  the catalog as one JSON object per line and printing a summary"
+            << std::endl
+            << std::endl
+            << "  --out <file>  where to write the catalog (default schema-catalog.ndjson)"
+            << std::endl
+            << "  --top <n>     schemas and shared types to list in the summary (default 10)"
+            << std::endl
+            << "  --io <how>    read files with io_uring or ifstream (default io_uring where"
+            << std::endl
+            << "                the kernel allows it, otherwise ifstream)"
+            << std::endl;
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    std::string out { "schema-catalog.ndjson" };
+    size_t top { 10 };
+    io::Backend backend { io::uring_t };
+    std::vector<std::string> paths;
+
+    try {
+        for (int i { 1 } ; i < argc ; ++i) {
+            std::string arg { argv[i] };
+
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error ("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--out") {
+                out = value();
+            } else if (arg == "--top") {
+                top = std::stoul (value());
+            } else if (arg == "--io") {
+                auto how = value();
+
+                if (how == io::name (io::uring_t)) {
+                    backend = io::uring_t;
+                } else if (how == io::name (io::stream_t)) {
+                    backend = io::stream_t;
+                } else {
+                    throw std::runtime_error ("Unknown reader: " + how);
+                }
+            } else if (arg == "--help" || arg == "-h") {
+                usage (argv[0]);
+                return EXIT_SUCCESS;
+            } else if (arg[0] != '-') {
+                paths.push_back (arg);
+            } else {
+                throw std::runtime_error ("Unknown argument: " + arg);
+            }
+        }
+
+        if (paths.empty()) {
+            throw std::runtime_error ("Nothing to catalog");
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Catalog catalog;
+
+        if (catalog.scan (paths, backend) != backend) {
+            std::cerr << io::name (backend) << " is unavailable, read with "
+                      << io::name (io::stream_t) << std::endl;
+        }
+
+        catalog.resolve();
+
+        std::ofstream f { out, std::ios::out | std::ios::trunc };
+
+        if (!f) {
+            throw std::runtime_error ("Cannot open " + out);
+        }
+
+        catalog.write (f);
+        catalog.summary (std::cout, top);
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
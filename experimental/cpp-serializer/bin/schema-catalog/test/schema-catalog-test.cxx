@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+
+#include "Catalog.h"
+#include "concurrency/ThreadPool.h"
+
+const std::string filepath ("../../test-files/"); // NOLINT
+
+/******************************************************************************/
+
+namespace {
+
+    const char * const files[] = {
+        "_i_", "_l_", "_Oi_", "_Ai_", "_Li_", "_L_i__", "_Le_", "_Le_2",
+        "_ALd_", "_Ci_", "_e_", "_MiLs_", "_Mis_", "_Mi_is__", "_Pls_",
+        "_i_is__", "__i_LMis_l__" };
+
+    std::string
+    contents (const std::string & file_) {
+        std::ifstream f { filepath + file_, std::ios::in | std::ios::binary };
+
+        return {
+            std::istreambuf_iterator<char> (f),
+            std::istreambuf_iterator<char>() };
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Catalog, add) { // NOLINT
+    Catalog catalog;
+
+    auto i = contents ("_i_");
+
+    EXPECT_TRUE (catalog.add ("a", i.data(), i.size()));
+    EXPECT_TRUE (catalog.add ("b", i.data(), i.size()));
+    EXPECT_FALSE (catalog.add ("c", i.data() + 1, i.size() - 1));
+
+    catalog.resolve();
+
+    EXPECT_EQ (2, catalog.blobs());
+    EXPECT_EQ (2 * i.size(), catalog.bytes());
+    EXPECT_EQ (1, catalog.errors());
+
+    ASSERT_EQ (1, catalog.schemas().size());
+
+    const auto & schema = catalog.schemas().begin()->second;
+
+    EXPECT_EQ (2, schema.blobs);
+    EXPECT_EQ ("a", schema.example);
+    ASSERT_EQ (1, schema.types.size());
+    EXPECT_EQ ("net.corda.blobwriter._i_", schema.types[0].name);
+    EXPECT_EQ ("net.corda:kVmzZ65V8U/SY+oISDlD7g==", schema.types[0].descriptor);
+    EXPECT_TRUE (schema.types[0].composite);
+}
+
+/******************************************************************************/
+
+/**
+ * Scanning the test files across a pool, the composites nested in other
+ * classes are shared between schemas
+ */
+TEST (Catalog, scan) { // NOLINT
+    concurrency::ThreadPool::resize (3);
+
+    Catalog catalog;
+
+    catalog.scan ({ filepath });
+    catalog.resolve();
+
+    EXPECT_EQ (std::size (files), catalog.blobs());
+    EXPECT_EQ (0, catalog.errors());
+
+    // _Le_2 is another blob of _Le_
+    EXPECT_EQ (std::size (files) - 1, catalog.schemas().size());
+
+    size_t bytes { 0 };
+    for (const auto & file : files) {
+        bytes += contents (file).size();
+    }
+    EXPECT_EQ (bytes, catalog.bytes());
+
+    auto composites = catalog.composites();
+
+    const auto & i = composites.at ("net.corda:kVmzZ65V8U/SY+oISDlD7g==");
+    EXPECT_EQ ("net.corda.blobwriter._i_", i.name);
+    EXPECT_EQ (3, i.schemas.size());
+    EXPECT_EQ (3, i.blobs);
+
+    const auto & is = composites.at ("net.corda:zTwEP2FLW2LjVmKWUorz+w==");
+    EXPECT_EQ (2, is.schemas.size());
+
+    const auto & le = composites.at ("net.corda:hbn90eWD7DrCnuxYDWUMpg==");
+    EXPECT_EQ (1, le.schemas.size());
+    EXPECT_EQ (2, le.blobs);
+
+    std::stringstream ss;
+    catalog.write (ss);
+
+    size_t lines { 0 };
+    for (std::string line ; std::getline (ss, line) ; ++lines) { }
+
+    EXPECT_EQ (catalog.schemas().size() + composites.size(), lines);
+}
+
+/******************************************************************************/
+
+/**
+ * Reading through io_uring, where the kernel allows it, catalogs the same
+ */
+TEST (Catalog, backends) { // NOLINT
+    concurrency::ThreadPool::resize (3);
+
+    Catalog stream, uring;
+
+    EXPECT_EQ (io::stream_t, stream.scan ({ filepath }, io::stream_t));
+    EXPECT_EQ (
+        io::available (io::uring_t) ? io::uring_t : io::stream_t,
+        uring.scan ({ filepath, filepath + "missing" }, io::uring_t));
+
+    EXPECT_EQ (stream.blobs(), uring.blobs());
+    EXPECT_EQ (stream.bytes(), uring.bytes());
+    EXPECT_EQ (1, uring.errors());
+
+    // which of a schema's blobs is its example depends on who read it
+    ASSERT_EQ (stream.schemas().size(), uring.schemas().size());
+
+    for (const auto & [hash, schema] : stream.schemas()) {
+        const auto & other = uring.schemas().at (hash);
+
+        EXPECT_EQ (schema.blobs, other.blobs);
+        EXPECT_EQ (schema.bytes, other.bytes);
+        EXPECT_EQ (schema.section, other.section);
+    }
+}
+
+/******************************************************************************/
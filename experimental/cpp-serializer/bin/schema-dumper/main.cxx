@@ -1,3 +1,5 @@
+#include <memory>
+#include <string>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -12,6 +14,7 @@
 
 #include "debug.h"
 
+#include "proton/DataPool.h"
 #include "proton/proton_wrapper.h"
 
 #include "amqp/AMQPHeader.h"
@@ -20,6 +23,7 @@
 
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/tape/Sections.h"
 
 /******************************************************************************/
 
@@ -39,16 +43,17 @@ printNode (pn_data_t * d_) {
 
 void
 data_and_stop(std::ifstream & f_, ssize_t sz) {
-    char * blob = new char[sz];
-    memset (blob, 0, sz);
-    f_.read(blob, sz);
+    std::unique_ptr<char[]> blob { new char[sz] };
+    memset (blob.get(), 0, sz);
+    f_.read(blob.get(), sz);
 
-    pn_data_t * d = pn_data(sz);
+    auto data = proton::DataPool::instance().acquire();
+    auto d = data.get();
 
     // returns how many bytes we processed which right now we don't care
     // about but I assume there is a case where it doesn't process the
     // entire file
-    auto rtn = pn_data_decode (d, blob, sz);
+    auto rtn = pn_data_decode (d, blob.get(), sz);
     assert (rtn == sz);
 
     printNode (d);
@@ -57,15 +62,61 @@ data_and_stop(std::ifstream & f_, ssize_t sz) {
 
 /******************************************************************************/
 
+/**
+ * Only the schema section is decoded, the object is stepped over by its
+ * encoded size
+ */
+void
+schema_only (std::ifstream & f_, ssize_t sz) {
+    std::unique_ptr<char[]> blob { new char[sz] };
+    f_.read(blob.get(), sz);
+
+    auto sections = amqp::internal::tape::sections (blob.get(), sz);
+
+    auto data = proton::DataPool::instance().acquire();
+    auto d = data.get();
+
+    auto rtn = pn_data_decode (d, sections.schema.data(), sections.schema.size());
+    assert (rtn == static_cast<ssize_t>(sections.schema.size()));
+
+    pn_data_rewind (d);
+    pn_data_next (d);
+
+    printNode (d);
+}
+
+/******************************************************************************/
+
+/**
+ * One line per blob of the descriptor of its object's class, a hash of
+ * its schema section and that section's size, nothing being decoded
+ */
+void
+fingerprint (std::ifstream & f_, ssize_t sz, const char * file_) {
+    std::unique_ptr<char[]> blob { new char[sz] };
+    f_.read(blob.get(), sz);
+
+    auto sections = amqp::internal::tape::sections (blob.get(), sz);
+
+    std::cout << sections.descriptor << " "
+        << std::hex << std::setw (16) << std::setfill ('0')
+        << amqp::internal::tape::hash (sections.schema)
+        << std::dec << " " << sections.schema.size()
+        << " " << file_ << std::endl;
+}
+
+/******************************************************************************/
+
 int
-main (int argc, char **argv) {
+dump (const char * file_, const std::string & mode_) {
     struct stat results { };
 
-    if (stat(argv[1], &results) != 0) {
+    if (stat(file_, &results) != 0) {
+        std::cerr << "Cannot stat " << file_ << std::endl;
         return EXIT_FAILURE;
     }
 
-    std::ifstream f (argv[1], std::ios::in | std::ios::binary);
+    std::ifstream f (file_, std::ios::in | std::ios::binary);
     std::array<char, 7> header { };
     f.read(header.data(), 7);
 
@@ -77,16 +128,66 @@ main (int argc, char **argv) {
     amqp::amqp_section_id_t encoding;
     f.read((char *)&encoding, 1);
 
-    if (encoding == amqp::DATA_AND_STOP) {
-        data_and_stop(f, results.st_size - 8);
-    } else {
+    if (encoding != amqp::DATA_AND_STOP) {
         std::cerr << "BAD ENCODING " << encoding << " != "
             << amqp::DATA_AND_STOP << std::endl;
 
         return EXIT_FAILURE;
     }
 
+    try {
+        if (mode_ == "--schema-only") {
+            schema_only (f, results.st_size - 8);
+        } else if (mode_ == "--fingerprint") {
+            fingerprint (f, results.st_size - 8, file_);
+        } else {
+            data_and_stop (f, results.st_size - 8);
+        }
+    } catch (const std::exception & e) {
+        std::cerr << file_ << ": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
 
 /******************************************************************************/
+
+/**
+ * schema-dumper [--schema-only | --fingerprint] <blob>...
+ *
+ * --schema-only prints the schema without decoding the object it
+ * describes, --fingerprint prints a line per blob of its class's
+ * descriptor and a hash and the size of its schema section
+ */
+int
+main (int argc, char **argv) {
+    std::string mode;
+
+    if (argc > 2 && argv[1][0] == '-') {
+        mode = argv[1];
+        ++argv;
+        --argc;
+
+        if (mode != "--schema-only" && mode != "--fingerprint") {
+            std::cerr << "Unknown argument: " << mode << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc < 2) {
+        return EXIT_FAILURE;
+    }
+
+    auto rtn = EXIT_SUCCESS;
+
+    for (int i { 1 } ; i < argc ; ++i) {
+        if (dump (argv[i], mode) != EXIT_SUCCESS) {
+            rtn = EXIT_FAILURE;
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
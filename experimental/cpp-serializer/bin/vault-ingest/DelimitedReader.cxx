@@ -0,0 +1,291 @@
+#include "DelimitedReader.h"
+
+#include <cctype>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr size_t BUFFER_SIZE = 1 << 20;
+
+}
+
+/******************************************************************************/
+
+DelimitedReader::Format
+DelimitedReader::formatFromString (const std::string & format_) {
+    if (format_ == "csv") return csv;
+    if (format_ == "tsv") return tsv;
+    if (format_ == "copy") return copy;
+
+    throw std::runtime_error ("Unknown input format: " + format_);
+}
+
+/******************************************************************************/
+
+DelimitedReader::DelimitedReader (
+    std::istream & stream_,
+    Format format_,
+    char delimiter_
+) : m_stream (stream_)
+  , m_format (format_)
+  , m_delimiter (delimiter_)
+  , m_buffer (BUFFER_SIZE)
+  , m_pos (0)
+  , m_end (0)
+  , m_records (0)
+{
+    if (!m_delimiter) {
+        m_delimiter = (m_format == csv) ? ',' : '\t';
+    }
+}
+
+/******************************************************************************/
+
+bool
+DelimitedReader::fill() {
+    m_stream.read (m_buffer.data(), m_buffer.size());
+    m_pos = 0;
+    m_end = m_stream.gcount();
+
+    return m_end != 0;
+}
+
+/******************************************************************************/
+
+inline int
+DelimitedReader::get() {
+    if (m_pos == m_end && !fill()) {
+        return EOF;
+    }
+
+    return static_cast<unsigned char>(m_buffer[m_pos++]);
+}
+
+/******************************************************************************/
+
+inline int
+DelimitedReader::peek() {
+    if (m_pos == m_end && !fill()) {
+        return EOF;
+    }
+
+    return static_cast<unsigned char>(m_buffer[m_pos]);
+}
+
+/******************************************************************************/
+
+void
+DelimitedReader::endField (size_t start_, bool null_) {
+    m_fields.emplace_back (start_, m_record.size() - start_);
+    m_nulls.push_back (null_);
+}
+
+/******************************************************************************/
+
+bool
+DelimitedReader::next() {
+    m_record.clear();
+    m_fields.clear();
+    m_nulls.clear();
+
+    bool rtn = (m_format == copy) ? nextCopy() : nextCsv();
+
+    if (rtn) {
+        ++m_records;
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+bool
+DelimitedReader::nextCsv() {
+    int c = get();
+
+    if (c == EOF) {
+        return false;
+    }
+
+    size_t start { 0 };
+    bool quoted { false };
+
+    for (;; c = get()) {
+        if (quoted) {
+            if (c == EOF) {
+                std::stringstream ss;
+                ss << "Unterminated quoted field in record " << m_records + 1;
+                throw std::runtime_error (ss.str());
+            }
+
+            if (c == '"') {
+                if (peek() == '"') {
+                    get();
+                    m_record.push_back ('"');
+                } else {
+                    quoted = false;
+                }
+            } else {
+                m_record.push_back (static_cast<char>(c));
+            }
+        } else if (c == m_delimiter) {
+            endField (start, false);
+            start = m_record.size();
+        } else if (c == '\n' || c == EOF) {
+            if (!m_record.empty() && m_record.back() == '\r') {
+                m_record.pop_back();
+            }
+
+            endField (start, false);
+
+            return true;
+        } else if (c == '"' && m_record.size() == start) {
+            quoted = true;
+        } else {
+            m_record.push_back (static_cast<char>(c));
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * One to three octal digits, the first of which has already been consumed
+ */
+int
+DelimitedReader::octal (int first_) {
+    int rtn { first_ - '0' };
+
+    for (int i { 0 } ; i < 2 && peek() >= '0' && peek() <= '7' ; ++i) {
+        rtn = (rtn << 3) | (get() - '0');
+    }
+
+    return rtn & 0xFF;
+}
+
+/******************************************************************************/
+
+/**
+ * One or two hex digits following a consumed "\x"
+ */
+int
+DelimitedReader::hex() {
+    auto digit = [](int c_) {
+        return (c_ <= '9') ? c_ - '0' : (tolower (c_) - 'a' + 10);
+    };
+
+    int rtn { digit (get()) };
+
+    if (isxdigit (peek())) {
+        rtn = (rtn << 4) | digit (get());
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+bool
+DelimitedReader::nextCopy() {
+    int c = get();
+
+    if (c == EOF) {
+        return false;
+    }
+
+    size_t start { 0 };
+    bool null { false };
+
+    for (;; c = get()) {
+        if (c == m_delimiter || c == '\n' || c == EOF) {
+            endField (start, null);
+
+            if (c != m_delimiter) {
+                return true;
+            }
+
+            start = m_record.size();
+            null = false;
+        } else if (c == '\\') {
+            c = get();
+
+            if (c >= '0' && c <= '7') {
+                m_record.push_back (static_cast<char>(octal (c)));
+                continue;
+            }
+
+            if (c == 'x' && isxdigit (peek())) {
+                m_record.push_back (static_cast<char>(hex()));
+                continue;
+            }
+
+            switch (c) {
+                case '.' : {
+                    // "\." on a line of its own marks the end of the data
+                    if (m_fields.empty() && m_record.size() == start
+                        && (peek() == '\n' || peek() == EOF))
+                    {
+                        get();
+                        m_fields.clear();
+                        return false;
+                    }
+                    m_record.push_back ('.');
+                    break;
+                }
+                case 'N' : null = true; break;
+                case 'b' : m_record.push_back ('\b'); break;
+                case 'f' : m_record.push_back ('\f'); break;
+                case 'n' : m_record.push_back ('\n'); break;
+                case 'r' : m_record.push_back ('\r'); break;
+                case 't' : m_record.push_back ('\t'); break;
+                case 'v' : m_record.push_back ('\v'); break;
+                case EOF : m_record.push_back ('\\'); break;
+                default  : m_record.push_back (static_cast<char>(c));
+            }
+        } else {
+            m_record.push_back (static_cast<char>(c));
+        }
+    }
+}
+
+/******************************************************************************/
+
+size_t
+DelimitedReader::columns() const {
+    return m_fields.size();
+}
+
+/******************************************************************************/
+
+std::string_view
+DelimitedReader::operator[] (size_t idx_) const {
+    if (idx_ >= m_fields.size()) {
+        std::stringstream ss;
+        ss << "Record " << m_records << " has no column " << idx_;
+        throw std::runtime_error (ss.str());
+    }
+
+    return std::string_view {
+        m_record.data() + m_fields[idx_].first,
+        m_fields[idx_].second };
+}
+
+/******************************************************************************/
+
+bool
+DelimitedReader::isNull (size_t idx_) const {
+    return idx_ < m_nulls.size() && m_nulls[idx_];
+}
+
+/******************************************************************************/
+
+size_t
+DelimitedReader::record() const {
+    return m_records;
+}
+
+/******************************************************************************/
@@ -0,0 +1,83 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <string_view>
+
+/******************************************************************************/
+
+/**
+ * Streaming reader for table dumps. Records are pulled from the underlying
+ * stream through a fixed size buffer one at a time, with the decoded field
+ * values written into a single record buffer that is reused from one
+ * record to the next. This keeps memory flat no matter how big the dump is.
+ *
+ * Supported formats
+ *   * csv  - RFC 4180, quoted fields may contain delimiters and newlines
+ *   * tsv  - as csv but tab delimited
+ *   * copy - PostgreSQL COPY text format, tab delimited with backslash
+ *            escapes and \N representing null
+ */
+class DelimitedReader {
+    public :
+        enum Format { csv, tsv, copy };
+
+        static Format formatFromString (const std::string &);
+
+    private :
+        std::istream & m_stream;
+        Format         m_format;
+        char           m_delimiter;
+
+        std::vector<char> m_buffer;
+        size_t            m_pos;
+        size_t            m_end;
+
+        std::string                            m_record;
+        std::vector<std::pair<size_t, size_t>> m_fields;
+        std::vector<bool>                      m_nulls;
+
+        size_t m_records;
+
+        bool fill();
+        int  get();
+        int  peek();
+
+        void endField (size_t, bool);
+
+        int octal (int);
+        int hex();
+
+        bool nextCsv();
+        bool nextCopy();
+
+    public :
+        DelimitedReader (std::istream &, Format, char delimiter_ = 0);
+
+        /**
+         * Advance to the next record, invalidating any views handed out
+         * for the previous one.
+         *
+         * @return false once the stream is exhausted
+         */
+        bool next();
+
+        size_t columns() const;
+
+        /**
+         * @return a view of the decoded field, valid until [next] is called
+         */
+        std::string_view operator[] (size_t) const;
+
+        bool isNull (size_t) const;
+
+        /**
+         * 1 based index of the current record within the stream
+         */
+        size_t record() const;
+};
+
+/******************************************************************************/
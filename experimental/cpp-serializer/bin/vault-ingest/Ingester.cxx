@@ -0,0 +1,267 @@
+#include "Ingester.h"
+
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "encoding/Hex.h"
+#include "encoding/Json.h"
+#include "encoding/Base64.h"
+
+#include "amqp/AMQPSectionId.h"
+#include "amqp/tape/Sections.h"
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+#include "Transaction.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Append [str_] as a JSON string. Text columns of a dump aren't
+     * guaranteed to be UTF-8, if this one isn't [out_] is left as it was
+     * and we return false.
+     */
+    bool
+    jsonString (std::string & out_, std::string_view str_) {
+        auto mark = out_.size();
+
+        try {
+            encoding::json::quote (out_, str_);
+            return true;
+        } catch (const std::runtime_error &) {
+            out_.resize (mark);
+            return false;
+        }
+    }
+
+    bool
+    looksLikeHex (std::string_view str_) {
+        if (str_.size() % 2 != 0) {
+            return false;
+        }
+
+        for (auto c : str_) {
+            if (!encoding::hex::isHexDigit (c)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}
+
+/******************************************************************************/
+
+Ingester::BlobEncoding
+Ingester::encodingFromString (const std::string & encoding_) {
+    if (encoding_ == "auto") return auto_e;
+    if (encoding_ == "hex") return hex_e;
+    if (encoding_ == "base64") return base64_e;
+
+    throw std::runtime_error ("Unknown blob encoding: " + encoding_);
+}
+
+/******************************************************************************/
+
+Ingester::Ingester (
+    std::ostream & out_,
+    size_t blobColumn_,
+    BlobEncoding encoding_,
+    Output output_
+) : m_out (out_)
+  , m_blobColumn (blobColumn_)
+  , m_encoding (encoding_)
+  , m_output (output_)
+  , m_rows (0)
+  , m_errors (0)
+{ }
+
+/******************************************************************************/
+
+void
+Ingester::header (const DelimitedReader & reader_) {
+    m_names.clear();
+
+    std::string scratch;
+
+    for (size_t i { 0 } ; i < reader_.columns() ; ++i) {
+        if (jsonString (scratch, reader_[i])) {
+            m_names.emplace_back (reader_[i]);
+        } else {
+            m_names.emplace_back ("col" + std::to_string (i));
+        }
+    }
+}
+
+/******************************************************************************/
+
+const std::string &
+Ingester::name (size_t idx_) {
+    while (m_names.size() <= idx_) {
+        m_names.emplace_back ("col" + std::to_string (m_names.size()));
+    }
+
+    return m_names[idx_];
+}
+
+/******************************************************************************/
+
+/**
+ * Decode the text form of the blob into our reusable buffer, growing it
+ * if this is the biggest blob we've seen so far.
+ */
+std::string_view
+Ingester::decode (std::string_view text_) {
+    auto skip = encoding::hex::prefix (text_.data(), text_.size());
+
+    auto encoding = m_encoding;
+
+    if (encoding == auto_e) {
+        encoding = (skip || looksLikeHex (text_)) ? hex_e : base64_e;
+    }
+
+    if (encoding == hex_e) {
+        text_.remove_prefix (skip);
+    }
+
+    auto required = (encoding == hex_e)
+            ? encoding::hex::decodedSize (text_.size())
+            : encoding::base64::decodedSize (text_.size());
+
+    if (m_blob.size() < required) {
+        m_blob.resize (required);
+    }
+
+    auto len = (encoding == hex_e)
+            ? encoding::hex::decode (text_.data(), text_.size(), m_blob.data())
+            : encoding::base64::decode (text_.data(), text_.size(), m_blob.data());
+
+    return std::string_view { m_blob.data(), len };
+}
+
+/******************************************************************************/
+
+void
+Ingester::schema (const CordaBytes & cb_) {
+    auto sections = amqp::internal::tape::sections (cb_.bytes(), cb_.size());
+
+    char hash[17];
+    snprintf (hash, sizeof (hash), "%016llx",
+        static_cast<unsigned long long>(
+            amqp::internal::tape::hash (sections.schema)));
+
+    m_line += "{ \"descriptor\" : ";
+
+    if (!jsonString (m_line, sections.descriptor)) {
+        m_line += "null";
+    }
+
+    m_line += ", \"schema\" : \"";
+    m_line += hash;
+    m_line += "\", \"schemaSize\" : ";
+    m_line += std::to_string (sections.schema.size());
+    m_line += " }";
+}
+
+/******************************************************************************/
+
+void
+Ingester::transaction (std::string_view blob_) {
+    Transaction transaction (blob_);
+
+    size_t components { 0 };
+    for (const auto & group : transaction.groups()) {
+        components += group.components.size();
+    }
+
+    m_line += "{ \"id\" : \"";
+    encoding::hex::encode (m_line, transaction.id().data(), transaction.id().size());
+    m_line += "\", \"groups\" : ";
+    m_line += std::to_string (transaction.groups().size());
+    m_line += ", \"components\" : ";
+    m_line += std::to_string (components);
+    m_line += " }";
+}
+
+/******************************************************************************/
+
+bool
+Ingester::row (const DelimitedReader & reader_) {
+    ++m_rows;
+
+    std::string error;
+
+    m_line.clear();
+    m_line += "{ ";
+
+    for (size_t i { 0 } ; i < reader_.columns() ; ++i) {
+        if (i == m_blobColumn) {
+            continue;
+        }
+
+        jsonString (m_line, name (i));
+        m_line += " : ";
+
+        if (reader_.isNull (i)) {
+            m_line += "null";
+        } else if (!jsonString (m_line, reader_[i])) {
+            m_line += "null";
+            error = "Column " + name (i) + " is not valid UTF-8";
+        }
+
+        m_line += ", ";
+    }
+
+    jsonString (m_line, name (m_blobColumn));
+    m_line += " : ";
+
+    try {
+        if (m_blobColumn >= reader_.columns() || reader_.isNull (m_blobColumn)) {
+            throw std::runtime_error ("No blob in record");
+        }
+
+        auto blob = decode (reader_[m_blobColumn]);
+
+        CordaBytes cb (blob.data(), blob.size());
+
+        if (cb.encoding() != amqp::DATA_AND_STOP) {
+            std::stringstream ss;
+            ss << "Unsupported encoding " << cb.encoding();
+            throw std::runtime_error (ss.str());
+        }
+
+        if (m_output == schema_e) {
+            schema (cb);
+        } else if (m_output == transaction_e) {
+            transaction (blob);
+        } else {
+            m_line += BlobInspector (cb).dump();
+        }
+    } catch (const std::exception & e) {
+        m_line += "null";
+        error = e.what();
+    }
+
+    if (!error.empty()) {
+        ++m_errors;
+
+        m_line += ", \"error\" : ";
+
+        if (!jsonString (m_line, error)) {
+            m_line += "\"Error message is not valid UTF-8\"";
+        }
+    }
+
+    m_line += " }\n";
+
+    m_out.write (m_line.data(), m_line.size());
+
+    return error.empty();
+}
+
+/******************************************************************************/
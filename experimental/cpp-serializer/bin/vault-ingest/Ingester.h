@@ -0,0 +1,86 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <string_view>
+
+#include "DelimitedReader.h"
+
+/******************************************************************************/
+
+class CordaBytes;
+
+/******************************************************************************/
+
+/**
+ * Takes records from a table dump, decodes the column holding the hex or
+ * base64 encoded blob and writes one line of JSON per record. Every other
+ * column is passed through as a string property, keyed by its header name
+ * where we have one.
+ *
+ * The decoded blob is written into a buffer owned by the ingester that is
+ * only ever grown, so once we've seen the largest blob in a dump no further
+ * allocation is needed for it.
+ */
+class Ingester {
+    public :
+        enum BlobEncoding { auto_e, hex_e, base64_e };
+
+        /**
+         * What's written for the blob, the whole of it or, for a census
+         * of the schemas in a vault, just the descriptor of its class and
+         * a hash and the size of its schema section. The latter never
+         * decodes the blob's object. For a table of signed transactions,
+         * the id recomputed from each one's components.
+         */
+        enum Output { dump_e, schema_e, transaction_e };
+
+        static BlobEncoding encodingFromString (const std::string &);
+
+    private :
+        std::ostream &           m_out;
+        size_t                   m_blobColumn;
+        BlobEncoding             m_encoding;
+        Output                   m_output;
+        std::vector<std::string> m_names;
+
+        std::vector<char> m_blob;
+        std::string       m_line;
+
+        size_t m_rows;
+        size_t m_errors;
+
+        std::string_view decode (std::string_view);
+
+        void schema (const CordaBytes &);
+        void transaction (std::string_view);
+
+        const std::string & name (size_t);
+
+    public :
+        Ingester (std::ostream &, size_t, BlobEncoding, Output = dump_e);
+
+        /**
+         * Use the fields of the given record as the names of the columns
+         * for every subsequent record, rather than "col<N>"
+         */
+        void header (const DelimitedReader &);
+
+        /**
+         * Emit a single line for the record. Failure to decode the blob, or
+         * a column that isn't valid UTF-8, is reported in an "error"
+         * property of that line rather than thrown so one bad row doesn't
+         * halt a scan of a multi GB dump
+         *
+         * @return true if the record was converted without error
+         */
+        bool row (const DelimitedReader &);
+
+        size_t rows() const { return m_rows; }
+        size_t errors() const { return m_errors; }
+};
+
+/******************************************************************************/
@@ -0,0 +1,180 @@
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "DelimitedReader.h"
+#include "Ingester.h"
+
+#include "proton/DataPool.h"
+#include "amqp/CompositeFactory.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * exe_) {
+        std::cerr
+            << "usage: " << exe_ << " [options] [file]" << std::endl
+            << std::endl
+            << "  Decode the hex or base64 encoded blobs held in one column of a"
+            << std::endl
+            << "  table dump, reading stdin when no file is given, and write"
+            << std::endl
+            << "  one JSON object per record to stdout" << std::endl
+            << std::endl
+            << "  --format csv|tsv|copy       input format (default csv)"
+            << std::endl
+            << "  --delimiter <c>             override the field delimiter"
+            << std::endl
+            << "  --header                    first record names the columns"
+            << std::endl
+            << "  --blob-column <idx|name>    column holding the blob (default 0)"
+            << std::endl
+            << "  --encoding auto|hex|base64  text encoding of the blob (default auto)"
+            << std::endl
+            << "  --schema-only               write the blob's class descriptor and a"
+            << std::endl
+            << "                              hash of its schema rather than decoding it"
+            << std::endl
+            << "  --transaction-id            write the id of the signed transaction the"
+            << std::endl
+            << "                              blob holds, recomputed from its components"
+            << std::endl;
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    auto format { DelimitedReader::csv };
+    auto encoding { Ingester::auto_e };
+    auto output { Ingester::dump_e };
+    char delimiter { 0 };
+    bool header { false };
+    std::string blobColumn { "0" };
+    std::string file;
+
+    try {
+        for (int i { 1 } ; i < argc ; ++i) {
+            std::string arg { argv[i] };
+
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error ("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--format") {
+                format = DelimitedReader::formatFromString (value());
+            } else if (arg == "--delimiter") {
+                auto d = value();
+                delimiter = (d == "\\t") ? '\t' : d.at (0);
+            } else if (arg == "--header") {
+                header = true;
+            } else if (arg == "--blob-column") {
+                blobColumn = value();
+            } else if (arg == "--encoding") {
+                encoding = Ingester::encodingFromString (value());
+            } else if (arg == "--schema-only") {
+                output = Ingester::schema_e;
+            } else if (arg == "--transaction-id") {
+                output = Ingester::transaction_e;
+            } else if (arg == "--help" || arg == "-h") {
+                usage (argv[0]);
+                return EXIT_SUCCESS;
+            } else if (file.empty() && arg[0] != '-') {
+                file = arg;
+            } else {
+                throw std::runtime_error ("Unknown argument: " + arg);
+            }
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        usage (argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream f;
+
+    if (!file.empty()) {
+        f.open (file, std::ios::in | std::ios::binary);
+
+        if (!f) {
+            std::cerr << "Cannot open " << file << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ios::sync_with_stdio (false);
+
+    try {
+        DelimitedReader reader (file.empty() ? std::cin : f, format, delimiter);
+
+        size_t column { 0 };
+        bool named { blobColumn.find_first_not_of ("0123456789") != std::string::npos };
+
+        if (!named) {
+            column = std::stoul (blobColumn);
+        }
+
+        std::unique_ptr<Ingester> ingester;
+
+        if (header) {
+            if (!reader.next()) {
+                return EXIT_SUCCESS;
+            }
+
+            if (named) {
+                for (column = 0 ; column < reader.columns() ; ++column) {
+                    if (reader[column] == blobColumn) break;
+                }
+
+                if (column == reader.columns()) {
+                    throw std::runtime_error ("No column named " + blobColumn);
+                }
+            }
+
+            ingester = std::make_unique<Ingester> (std::cout, column, encoding, output);
+            ingester->header (reader);
+        } else if (named) {
+            throw std::runtime_error ("Naming the blob column requires --header");
+        } else {
+            ingester = std::make_unique<Ingester> (std::cout, column, encoding, output);
+        }
+
+        while (reader.next()) {
+            // skip blank lines
+            if (reader.columns() == 1 && reader[0].empty()) {
+                continue;
+            }
+
+            ingester->row (reader);
+        }
+
+        std::cout.flush();
+
+        auto trees = proton::DataPool::instance().stats();
+        auto types = amqp::internal::CompositeFactory::stats();
+
+        std::cerr << ingester->rows() << " records, "
+                  << ingester->errors() << " failed to decode, "
+                  << trees.reused << " of " << trees.acquired
+                  << " AMQP trees reused (" << trees.highWater
+                  << " allocated), readers built for "
+                  << types.built << " of " << types.types
+                  << " schema types" << std::endl;
+
+        return ingester->errors() ? EXIT_FAILURE : EXIT_SUCCESS;
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <iterator>
+
+#include "DelimitedReader.h"
+#include "Ingester.h"
+
+const std::string filepath ("../../test-files/"); // NOLINT
+
+/******************************************************************************/
+
+namespace {
+
+    std::vector<std::string>
+    record (DelimitedReader & reader_) {
+        std::vector<std::string> rtn;
+        for (size_t i { 0 } ; i < reader_.columns() ; ++i) {
+            rtn.emplace_back (reader_[i]);
+        }
+        return rtn;
+    }
+
+    std::string
+    hexFile (const std::string & file_) {
+        static const char digits[] = "0123456789abcdef";
+
+        std::ifstream f { filepath + file_, std::ios::in | std::ios::binary };
+        std::string bytes {
+            std::istreambuf_iterator<char> (f),
+            std::istreambuf_iterator<char>() };
+
+        std::string rtn;
+        for (auto c : bytes) {
+            rtn.push_back (digits[(c >> 4) & 0xF]);
+            rtn.push_back (digits[c & 0xF]);
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * DelimitedReader Tests
+ *
+ ******************************************************************************/
+
+TEST (DelimitedReader, csv) { // NOLINT
+    std::stringstream ss { "a,b,c\r\n1,\"x,\"\"y\"\"\nz\",3\n" };
+    DelimitedReader reader (ss, DelimitedReader::csv);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_EQ ((std::vector<std::string> { "a", "b", "c" }), record (reader));
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_EQ ((std::vector<std::string> { "1", "x,\"y\"\nz", "3" }), record (reader));
+    EXPECT_EQ (2, reader.record());
+
+    EXPECT_FALSE (reader.next());
+}
+
+/******************************************************************************/
+
+TEST (DelimitedReader, noTrailingNewline) { // NOLINT
+    std::stringstream ss { "a\tb" };
+    DelimitedReader reader (ss, DelimitedReader::tsv);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_EQ ((std::vector<std::string> { "a", "b" }), record (reader));
+    EXPECT_FALSE (reader.next());
+}
+
+/******************************************************************************/
+
+TEST (DelimitedReader, copy) { // NOLINT
+    std::stringstream ss { "1\t\\N\t\\\\x0a0b\ta\\tb\\101\n\\.\n" };
+    DelimitedReader reader (ss, DelimitedReader::copy);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_EQ ((std::vector<std::string> { "1", "", "\\x0a0b", "a\tbA" }), record (reader));
+    EXPECT_FALSE (reader.isNull (0));
+    EXPECT_TRUE (reader.isNull (1));
+
+    EXPECT_FALSE (reader.next());
+}
+
+/******************************************************************************/
+
+TEST (DelimitedReader, unterminated) { // NOLINT
+    std::stringstream ss { "a,\"b\n" };
+    DelimitedReader reader (ss, DelimitedReader::csv);
+
+    EXPECT_THROW (reader.next(), std::runtime_error);
+}
+
+/******************************************************************************
+ *
+ * Ingester Tests
+ *
+ ******************************************************************************/
+
+TEST (Ingester, hex) { // NOLINT
+    std::stringstream in {
+        "tx_id,output_index,state\n"
+        "ABCD,0,\\x" + hexFile ("_i_") + "\n"
+        "EF01,1," + hexFile ("_l_") + "\n"
+    };
+    std::stringstream out;
+
+    DelimitedReader reader (in, DelimitedReader::csv);
+    Ingester ingester (out, 2, Ingester::auto_e);
+
+    ASSERT_TRUE (reader.next());
+    ingester.header (reader);
+
+    while (reader.next()) {
+        EXPECT_TRUE (ingester.row (reader));
+    }
+
+    EXPECT_EQ (
+        R"({ "tx_id" : "ABCD", "output_index" : "0", "state" : { "Parsed" : { "a" : 69 } } })" "\n"
+        R"({ "tx_id" : "EF01", "output_index" : "1", "state" : { "Parsed" : { "x" : 100000000000 } } })" "\n",
+        out.str());
+}
+
+/******************************************************************************/
+
+TEST (Ingester, base64) { // NOLINT
+    // the "_i_" test file, base64 encoded and line wrapped
+    std::stringstream in {
+        "\"Y29yZGEBAAAAgMViAAAAAAABwMIDAKMibmV0LmNvcmRhOmtWbXpaNjVWOFUvU1krb0lTRGxEN2c9\n"
+        "PcADAVRFAIDFYgAAAAAAAsB+AcB7AQCAxWIAAAAAAAXAbgWhGG5ldC5jb3JkYS5ibG9id3JpdGVy\n"
+        "Ll9pX0BFAIDFYgAAAAAAA8AmAqMibmV0LmNvcmRhOmtWbXpaNjVWOFUvU1krb0lTRGxEN2c9PUDA\n"
+        "HQEAgMViAAAAAAAEwBAHoQFhoQNpbnRFoQEwQEFCAIDFYgAAAAAACcEBAA==\"\n"
+    };
+    std::stringstream out;
+
+    DelimitedReader reader (in, DelimitedReader::csv);
+    Ingester ingester (out, 0, Ingester::auto_e);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_TRUE (ingester.row (reader));
+
+    EXPECT_EQ (R"({ "col0" : { "Parsed" : { "a" : 69 } } })" "\n", out.str());
+}
+
+/******************************************************************************/
+
+TEST (Ingester, error) { // NOLINT
+    std::stringstream in { "1\tnot a blob\n" };
+    std::stringstream out;
+
+    DelimitedReader reader (in, DelimitedReader::tsv);
+    Ingester ingester (out, 1, Ingester::hex_e);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_FALSE (ingester.row (reader));
+    EXPECT_EQ (1, ingester.errors());
+    EXPECT_EQ (0, out.str().find (R"({ "col0" : "1", "col1" : null, "error" : )"));
+}
+
+/******************************************************************************/
+
+/******************************************************************************/
+
+TEST (Ingester, utf8) { // NOLINT
+    std::stringstream in { "say \"hi\"\t\xff\t" + hexFile ("_i_") + "\n" };
+    std::stringstream out;
+
+    DelimitedReader reader (in, DelimitedReader::tsv);
+    Ingester ingester (out, 2, Ingester::hex_e);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_FALSE (ingester.row (reader));
+
+    EXPECT_EQ (
+        R"({ "col0" : "say \"hi\"", "col1" : null, "col2" : { "Parsed" : { "a" : 69 } }, )"
+        R"("error" : "Column col1 is not valid UTF-8" })" "\n",
+        out.str());
+}
+
+/******************************************************************************/
+
+TEST (Ingester, schemaOnly) { // NOLINT
+    std::stringstream in { "1," + hexFile ("_i_") + "\n" };
+    std::stringstream out;
+
+    DelimitedReader reader (in, DelimitedReader::csv);
+    Ingester ingester (out, 1, Ingester::hex_e, Ingester::schema_e);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_TRUE (ingester.row (reader));
+
+    EXPECT_EQ (
+        R"({ "col0" : "1", "col1" : { "descriptor" : "net.corda:kVmzZ65V8U/SY+oISDlD7g==", )"
+        R"("schema" : "e0c2dd6ee5953011", "schemaSize" : 138 } })" "\n",
+        out.str());
+}
+
+/******************************************************************************/
+
+TEST (Ingester, transactionId) { // NOLINT
+    std::stringstream in { "1," + hexFile ("_i_") + "\n" };
+    std::stringstream out;
+
+    DelimitedReader reader (in, DelimitedReader::csv);
+    Ingester ingester (out, 1, Ingester::hex_e, Ingester::transaction_e);
+
+    ASSERT_TRUE (reader.next());
+    EXPECT_FALSE (ingester.row (reader));
+
+    EXPECT_EQ (
+        R"({ "col0" : "1", "col1" : null, "error" : "Not a transaction" })" "\n",
+        out.str());
+}
+
+/******************************************************************************/
@@ -5,6 +5,7 @@
 #include <any>
 
 #include "amqp/AMQPDescribed.h"
+#include "amqp/reader/IVisitor.h"
 
 #include "amqp/schema/described-types/Schema.h"
 
@@ -33,6 +34,15 @@ namespace amqp::reader {
         public :
             virtual std::string dump() const = 0;
 
+            /**
+             * Append the dump to [out_], letting a whole tree be written
+             * into one buffer rather than each value building a string of
+             * its own for its parent to copy
+             */
+            virtual void dump (std::string & out_) const {
+                out_ += dump();
+            }
+
             virtual ~IValue() = default;
     };
 
@@ -68,6 +78,15 @@ namespace amqp::reader {
                     pn_data_t *,
                     const SchemaType &) const = 0;
 
+            /**
+             * Walk the value under the cursor, raising an event on
+             * [visitor_] for each part of it rather than building a
+             * tree, leaving the cursor on the next value
+             */
+            virtual void visit (
+                    pn_data_t *,
+                    const SchemaType &,
+                    IVisitor & visitor_) const = 0;
     };
 
 }
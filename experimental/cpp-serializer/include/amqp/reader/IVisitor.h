@@ -0,0 +1,61 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::reader::IVisitor
+ *
+ ******************************************************************************/
+
+/**
+ * Handed to [IReader::visit], the events a reader raises as it walks a
+ * blob, in the order it meets them. Nothing is built along the way; a
+ * consumer that only counts, sums or forwards values sees each one once
+ * and keeps nothing it doesn't choose to.
+ *
+ * A composite's properties are each announced by [onField] ahead of their
+ * value, a map's entries arrive as a key followed by its value, and
+ * every begin is matched by an end. Views are only valid for the
+ * duration of the call they're passed to.
+ */
+namespace amqp::reader {
+
+    class IVisitor {
+        public :
+            virtual ~IVisitor() = default;
+
+            virtual void onCompositeBegin (
+                std::string_view type_,
+                std::string_view descriptor_) = 0;
+            virtual void onCompositeEnd() = 0;
+
+            virtual void onField (std::string_view name_) = 0;
+
+            virtual void onListBegin (size_t elements_) = 0;
+            virtual void onListEnd() = 0;
+
+            virtual void onMapBegin (size_t entries_) = 0;
+            virtual void onMapEnd() = 0;
+
+            virtual void onInt (int32_t) = 0;
+            virtual void onLong (int64_t) = 0;
+            virtual void onBool (bool) = 0;
+            virtual void onDouble (double) = 0;
+            virtual void onString (std::string_view) = 0;
+
+            /**
+             * A binary's bytes. They may be a Corda blob of their own, as
+             * each of a transaction's components is, for the visitor to
+             * walk in turn if it wants what's inside.
+             */
+            virtual void onBinary (std::string_view) = 0;
+    };
+
+}
+
+/******************************************************************************/
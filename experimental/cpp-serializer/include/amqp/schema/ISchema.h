@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include "types.h"
 
 #include "amqp/AMQPDescribed.h"
@@ -9,8 +11,8 @@ namespace amqp::schema {
     template <class Iterator>
     class ISchema {
         public :
-            virtual Iterator fromType (const std::string &) const = 0;
-            virtual Iterator fromDescriptor (const std::string &) const = 0;
+            virtual Iterator fromType (std::string_view) const = 0;
+            virtual Iterator fromDescriptor (std::string_view) const = 0;
     };
 
 }
\ No newline at end of file
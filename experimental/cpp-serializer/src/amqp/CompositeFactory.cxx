@@ -1,6 +1,7 @@
 #include "CompositeFactory.h"
 
 #include <set>
+#include <atomic>
 #include <vector>
 #include <iostream>
 #include <algorithm>
@@ -14,22 +15,33 @@
 #include "amqp/reader/PropertyReader.h"
 
 #include "reader/Reader.h"
+#include "reader/Graph.h"
+#include "reader/AnyReader.h"
 #include "reader/CompositeReader.h"
+#include "reader/Natives.h"
 #include "reader/RestrictedReader.h"
 #include "reader/restricted-readers/MapReader.h"
 #include "reader/restricted-readers/ListReader.h"
 #include "reader/restricted-readers/ArrayReader.h"
 #include "reader/restricted-readers/EnumReader.h"
+#include "reader/property-readers/NativePropertyReader.h"
 
 #include "schema/restricted-types/Map.h"
 #include "schema/restricted-types/List.h"
 #include "schema/restricted-types/Enum.h"
 #include "schema/restricted-types/Array.h"
+#include "schema/restricted-types/Described.h"
 
 /******************************************************************************/
 
 namespace {
 
+    /**
+     * Behind [CompositeFactory::stats]
+     */
+    std::atomic<uint64_t> typesSeen { 0 };
+    std::atomic<uint64_t> typesBuilt { 0 };
+
 /**
  *
  */
@@ -86,16 +98,81 @@ amqp::internal::
 CompositeFactory::process (const SchemaType & schema_) {
     DBG ("process schema" << std::endl);
 
-    for (const auto & i : dynamic_cast<const schema::Schema &>(schema_)) {
+    index (schema_);
+    typesSeen.fetch_add (m_byName.size(), std::memory_order_relaxed);
+
+    for (const auto & i : *m_schema) {
         for (const auto & j : i) {
             process (*j);
-            m_readersByDescriptor[j->descriptor()] = m_readersByType[j->name()];
         }
     }
 }
 
 /******************************************************************************/
 
+/**
+ * Envelopes often carry far more of a schema than their object reaches,
+ * every class a CorDapp registered say, so only build what it does
+ */
+void
+amqp::internal::
+CompositeFactory::process (
+    const SchemaType & schema_,
+    const std::string & descriptor_
+) {
+    DBG ("process schema from " << descriptor_ << std::endl);
+
+    index (schema_);
+    typesSeen.fetch_add (m_byName.size(), std::memory_order_relaxed);
+    m_pruned = true;
+
+    find (descriptor_);
+}
+
+/******************************************************************************/
+
+amqp::internal::CompositeFactory::Stats
+amqp::internal::
+CompositeFactory::stats() {
+    return {
+        typesSeen.load (std::memory_order_relaxed),
+        typesBuilt.load (std::memory_order_relaxed)
+    };
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CompositeFactory::index (const SchemaType & schema_) {
+    m_schema = &dynamic_cast<const schema::Schema &>(schema_);
+
+    for (const auto & i : *m_schema) {
+        for (const auto & j : i) {
+            m_byName.emplace (j->name(), j.get());
+            m_byDescriptor.emplace (j->descriptor(), j.get());
+        }
+    }
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::
+CompositeFactory::find (std::string_view descriptor_) {
+    auto built = m_readersByDescriptor.find (std::string (descriptor_));
+
+    if (built != m_readersByDescriptor.end()) {
+        return built->second.get();
+    }
+
+    auto it = m_byDescriptor.find (descriptor_);
+
+    return it == m_byDescriptor.end() ? nullptr : process (*it->second).get();
+}
+
+/******************************************************************************/
+
 std::shared_ptr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::process (
@@ -103,19 +180,54 @@ CompositeFactory::process (
 {
     DBG ("process::" << schema_.name() << std::endl);
 
-    return computeIfAbsent<reader::Reader> (
+    auto & rtn = computeIfAbsent<reader::Reader> (
         m_readersByType,
         schema_.name(),
         [& schema_, this] () -> std::shared_ptr<reader::Reader> {
-            switch (schema_.type()) {
-                case schema::AMQPTypeNotation::composite_t : {
-                    return processComposite (schema_);
-                }
-                case schema::AMQPTypeNotation::restricted_t : {
-                    return processRestricted (schema_);
-                }
-            }
+            typesBuilt.fetch_add (1, std::memory_order_relaxed);
+
+            m_building.insert (schema_.name());
+
+            auto building = build (schema_);
+
+            m_building.erase (schema_.name());
+
+            return building;
         });
+
+    m_readersByDescriptor[schema_.descriptor()] = rtn;
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::shared_ptr<amqp::internal::reader::Reader>
+amqp::internal::
+CompositeFactory::build (
+    const amqp::internal::schema::AMQPTypeNotation & schema_)
+{
+    /*
+     * Types Corda has custom serializers for are decoded as the
+     * values they are, not as whatever they were written as
+     */
+    if (auto format = reader::Natives::find (
+            schema_.name(), schema_.descriptor()))
+    {
+        return std::make_shared<reader::NativePropertyReader> (
+                schema_.name(), format);
+    }
+
+    switch (schema_.type()) {
+        case schema::AMQPTypeNotation::composite_t : {
+            return processComposite (schema_);
+        }
+        case schema::AMQPTypeNotation::restricted_t : {
+            return processRestricted (schema_);
+        }
+    }
+
+    return nullptr;
 }
 
 /******************************************************************************/
@@ -126,7 +238,7 @@ CompositeFactory::processComposite (
         const amqp::internal::schema::AMQPTypeNotation & type_
 ) {
     DBG ("processComposite - " << type_.name() << std::endl);
-    std::vector<std::weak_ptr<reader::Reader>> readers;
+    std::vector<reader::CompositeReader::Field> readers;
 
     const auto & fields = dynamic_cast<const schema::Composite &> (
             type_).fields();
@@ -149,18 +261,20 @@ CompositeFactory::processComposite (
                     });
         }
         else {
-            // Insertion sorting ensures any type we depend on will have
-            // already been created and thus exist in the map
-            reader = m_readersByType[field->resolvedType()];
+            // built now if it hasn't been already, save for types the
+            // schema leaves out as values carry their own
+            reader = fetchReaderForAny (field->resolvedType());
         }
 
 
         assert (reader);
-        readers.emplace_back (reader);
-        assert (readers.back().lock());
+        readers.push_back ({ field->name(), reader.get() });
     }
 
-    return std::make_shared<reader::CompositeReader> (type_.name(), readers);
+    return std::make_shared<reader::CompositeReader> (
+            type_.name(),
+            type_.descriptor(),
+            std::move (readers));
 }
 
 /******************************************************************************/
@@ -195,7 +309,7 @@ CompositeFactory::fetchReaderForRestricted (const std::string & type_) {
                     return reader::PropertyReader::make (type_);
                 });
     } else {
-        rtn = m_readersByType[type_];
+        rtn = fetchReaderForAny (type_);
     }
 
     if (!rtn) {
@@ -207,6 +321,38 @@ CompositeFactory::fetchReaderForRestricted (const std::string & type_) {
 
 /******************************************************************************/
 
+/**
+ * The reader for a type the schema defines, building it if it hasn't been
+ * yet, or for an interface or any other type it leaves out, one that finds
+ * the reader for each value's class from the descriptor it's written with.
+ * So is a type that refers back to itself while it's still being built.
+ */
+std::shared_ptr<amqp::internal::reader::Reader>
+amqp::internal::
+CompositeFactory::fetchReaderForAny (const std::string & type_) {
+    auto it = m_readersByType.find (type_);
+
+    if (it != m_readersByType.end() && it->second) {
+        return it->second;
+    }
+
+    auto notation = m_byName.find (type_);
+
+    if (notation != m_byName.end() && !m_building.count (type_)) {
+        return process (*notation->second);
+    }
+
+    DBG ("fetchReaderForAny - " << type_ << " resolved per value" << std::endl);
+
+    m_anyReaders.push_back (std::make_shared<reader::AnyReader> (
+            type_,
+            [this](std::string_view descriptor_) { return find (descriptor_); }));
+
+    return m_anyReaders.back();
+}
+
+/******************************************************************************/
+
 std::shared_ptr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::processMap (
@@ -220,8 +366,8 @@ CompositeFactory::processMap (
 
     return std::make_shared<reader::MapReader> (
             map_.name(),
-            fetchReaderForRestricted (types.first),
-            fetchReaderForRestricted (types.second));
+            fetchReaderForRestricted (types.first).get(),
+            fetchReaderForRestricted (types.second).get());
 }
 
 /******************************************************************************/
@@ -235,7 +381,7 @@ CompositeFactory::processList (
 
     return std::make_shared<reader::ListReader> (
             list_.name(),
-            fetchReaderForRestricted (list_.listOf()));
+            fetchReaderForRestricted (list_.listOf()).get());
 }
 
 /******************************************************************************/
@@ -249,7 +395,33 @@ CompositeFactory::processArray (
 
     return std::make_shared<reader::ArrayReader> (
             array_.name(),
-            fetchReaderForRestricted (array_.arrayOf()));
+            fetchReaderForRestricted (array_.arrayOf()).get());
+}
+
+/******************************************************************************/
+
+/**
+ * A described primitive with no decoder of its own, the natives having
+ * been checked for its type already, is read as the primitive it is
+ */
+std::shared_ptr<amqp::internal::reader::Reader>
+amqp::internal::
+CompositeFactory::processDescribed (
+        const amqp::internal::schema::Described & described_
+) {
+    DBG ("Processing Described - " << described_.name() << " "
+        << described_.primitive() << std::endl); // NOLINT
+
+    auto format = reader::Natives::find (described_.primitive());
+
+    if (!format) {
+        throw std::runtime_error (
+            "No reader for " + described_.name() + " written as "
+                + described_.primitive());
+    }
+
+    return std::make_shared<reader::NativePropertyReader> (
+            described_.name(), format);
 }
 
 /******************************************************************************/
@@ -281,6 +453,10 @@ CompositeFactory::processRestricted (
             return processArray (
                 dynamic_cast<const schema::Array &> (restricted));
         }
+        case schema::Restricted::RestrictedTypes::described_t : {
+            return processDescribed (
+                dynamic_cast<const schema::Described &> (restricted));
+        }
     }
 
     DBG ("  ProcessRestricted: Returning nullptr"); // NOLINT
@@ -302,9 +478,44 @@ CompositeFactory::byType (const std::string & type_) {
 const std::shared_ptr<amqp::internal::reader::IReader>
 amqp::internal::
 CompositeFactory::byDescriptor (const std::string & descriptor_) {
-    auto it = m_readersByDescriptor.find (descriptor_);
+    // building it now if a pruned build left it out
+    if (!find (descriptor_)) {
+        return nullptr;
+    }
+
+    return m_readersByDescriptor[descriptor_];
+}
+
+/******************************************************************************/
+
+sPtr<amqp::internal::reader::Graph>
+amqp::internal::
+CompositeFactory::freeze() const {
+    if (!m_pruned) {
+        return reader::Graph::freeze (m_readersByType, m_readersByDescriptor);
+    }
+
+    /*
+     * Each type left out is built on its own when first asked for, along
+     * with whatever it reaches, frozen into a graph of its own
+     */
+    auto schema = m_schema;
 
-    return (it == m_readersByDescriptor.end()) ? nullptr : it->second;
+    return reader::Graph::freeze (
+        m_readersByType,
+        m_readersByDescriptor,
+        [schema](std::string_view descriptor_) -> sPtr<reader::Graph> {
+            CompositeFactory cf;
+
+            cf.index (*schema);
+            cf.m_pruned = true;
+
+            if (!cf.find (descriptor_)) {
+                return nullptr;
+            }
+
+            return cf.freeze();
+        });
 }
 
 /******************************************************************************/
@@ -5,6 +5,9 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <string_view>
 
 #include "types.h"
 
@@ -12,11 +15,13 @@
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/schema/described-types/Composite.h"
+#include "amqp/reader/Graph.h"
 #include "amqp/reader/CompositeReader.h"
 #include "amqp/schema/restricted-types/Map.h"
 #include "amqp/schema/restricted-types/Array.h"
 #include "amqp/schema/restricted-types/List.h"
 #include "amqp/schema/restricted-types/Enum.h"
+#include "amqp/schema/restricted-types/Described.h"
 
 /******************************************************************************/
 
@@ -25,28 +30,99 @@ namespace amqp::internal {
     class CompositeFactory
         : public ICompositeFactory<schema::SchemaMap::const_iterator>
     {
+        public :
+            /**
+             * Across every factory in the process, how many types the
+             * schemas processed held and how many of them readers were
+             * built for
+             */
+            struct Stats {
+                uint64_t types;
+                uint64_t built;
+            };
+
         private :
             using CompositePtr = uPtr<schema::Composite>;
             using EnvelopePtr  = uPtr<schema::Envelope>;
+            using Notations    = std::map<
+                    std::string, const schema::AMQPTypeNotation *, std::less<>>;
 
             spStrMap_t<reader::Reader> m_readersByType;
             spStrMap_t<reader::Reader> m_readersByDescriptor;
 
+            /**
+             * The schema's types, whether or not they've been built, so
+             * any can be built as it's first needed
+             */
+            const schema::Schema * m_schema { nullptr };
+            Notations              m_byName;
+            Notations              m_byDescriptor;
+
+            /**
+             * Whether only the types reached from a root were built, the
+             * rest waiting to be asked for
+             */
+            bool m_pruned { false };
+
+            /**
+             * Types whose readers are being built, so one that refers back
+             * to itself isn't built forever
+             */
+            std::set<std::string> m_building;
+
+            /**
+             * Readers for properties whose type the schema doesn't define,
+             * one each as they cache the classes their property is met as
+             */
+            std::vector<sPtr<reader::Reader>> m_anyReaders;
+
         public :
             CompositeFactory() = default;
 
+            /**
+             * Build readers for every type in the schema
+             */
             void process (const SchemaType &) override;
 
+            /**
+             * Build readers only for the type [descriptor_] names and
+             * those it reaches, the rest being built if they're later
+             * asked for. The schema has to outlive the factory and any
+             * graph frozen from it.
+             */
+            void process (const SchemaType &, const std::string & descriptor_);
+
+            static Stats stats();
+
             const std::shared_ptr<ReaderType> byType (
                     const std::string &) override;
 
             const std::shared_ptr<ReaderType> byDescriptor (
                     const std::string &) override;
 
+            /**
+             * Copy the readers built so far into a single allocation for
+             * reading blobs with. The factory needn't outlive the copy.
+             * Frozen from a pruned build, the graph builds any of the
+             * schema's other types it's asked for.
+             */
+            sPtr<reader::Graph> freeze() const;
+
         private :
+            void index (const SchemaType &);
+
+            /**
+             * The reader for [descriptor_], built if the schema has it and
+             * it hasn't been yet
+             */
+            const reader::Reader * find (std::string_view descriptor_);
+
             std::shared_ptr<reader::Reader> process (
                     const schema::AMQPTypeNotation &);
 
+            std::shared_ptr<reader::Reader> build (
+                    const schema::AMQPTypeNotation &);
+
             std::shared_ptr<reader::Reader> processComposite (
                     const schema::AMQPTypeNotation &);
 
@@ -65,8 +141,14 @@ namespace amqp::internal {
             std::shared_ptr<reader::Reader> processArray (
                     const schema::Array &);
 
+            std::shared_ptr<reader::Reader> processDescribed (
+                    const schema::Described &);
+
             decltype(m_readersByType)::mapped_type
             fetchReaderForRestricted (const std::string &);
+
+            decltype(m_readersByType)::mapped_type
+            fetchReaderForAny (const std::string &);
     };
 
 }
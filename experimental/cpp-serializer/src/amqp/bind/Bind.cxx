@@ -0,0 +1,330 @@
+#include "Bind.h"
+
+#include <tuple>
+#include <sstream>
+#include <algorithm>
+
+#include "proton/proton_wrapper.h"
+
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/described-types/Composite.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    template<typename Predicate>
+    const schema::Composite *
+    find (const schema::Schema & schema_, Predicate predicate_) {
+        for (const auto & level : schema_) {
+            for (const auto & type : level) {
+                if (type->type() == schema::AMQPTypeNotation::composite_t
+                    && predicate_ (*type))
+                {
+                    return static_cast<const schema::Composite *> (type.get());
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::string
+    describe (const bind::Expected & expected_) {
+        if (!expected_.type.empty()) {
+            return expected_.type;
+        }
+
+        return expected_.list ? "a list of a bound type" : "a bound type";
+    }
+
+    /**
+     * Walks a binding and the classes it's bound to together, noting every
+     * difference rather than stopping at the first
+     */
+    class Check {
+        private :
+            const schema::Schema & m_schema;
+
+        public :
+            std::vector<std::string> differences;
+
+            std::vector<std::tuple<
+                const bind::Verifier *,
+                std::string,
+                std::vector<size_t>>> learnt;
+
+            explicit Check (const schema::Schema & schema_)
+                : m_schema (schema_)
+            { }
+
+            void composite (const bind::Verifier &, const schema::Composite &);
+
+            void property (
+                const bind::Expected &,
+                const schema::Field &,
+                const schema::Composite &);
+    };
+
+    void
+    Check::composite (
+        const bind::Verifier & verifier_,
+        const schema::Composite & composite_
+    ) {
+        const auto & expected = verifier_.expected();
+
+        std::vector<bool> bound (expected.size(), false);
+        std::vector<size_t> order;
+
+        for (const auto & field : composite_) {
+            auto it = std::find_if (
+                    expected.begin(),
+                    expected.end(),
+                    [&field](const bind::Expected & e_) {
+                        return e_.name == field->name();
+                    });
+
+            if (it == expected.end()) {
+                differences.emplace_back (
+                    "+ " + composite_.name() + "." + field->name() + " : "
+                    + field->resolvedType() + " is not bound");
+                continue;
+            }
+
+            auto index = static_cast<size_t> (it - expected.begin());
+
+            bound[index] = true;
+            order.push_back (index);
+
+            property (*it, *field, composite_);
+        }
+
+        for (size_t i { 0 } ; i < expected.size() ; ++i) {
+            if (!bound[i]) {
+                differences.emplace_back (
+                    "- " + composite_.name() + "." + expected[i].name + " : "
+                    + describe (expected[i]) + " is bound but not in the schema");
+            }
+        }
+
+        learnt.emplace_back (&verifier_, composite_.descriptor(), std::move (order));
+    }
+
+    void
+    Check::property (
+        const bind::Expected & expected_,
+        const schema::Field & field_,
+        const schema::Composite & owner_
+    ) {
+        const auto & type = field_.resolvedType();
+
+        auto mismatch = [&]() {
+            differences.emplace_back (
+                "~ " + owner_.name() + "." + field_.name() + " : " + type
+                + " in the schema but bound as " + describe (expected_));
+        };
+
+        if (!expected_.composite) {
+            if (type != expected_.type) {
+                mismatch();
+            }
+
+            return;
+        }
+
+        auto name = type;
+
+        if (expected_.list) {
+            const std::string list ("java.util.List<");
+
+            if (type.compare (0, list.size(), list) != 0 || type.back() != '>') {
+                mismatch();
+                return;
+            }
+
+            name = type.substr (list.size(), type.size() - list.size() - 1);
+        }
+
+        auto composite = find (m_schema,
+            [&name](const schema::AMQPTypeNotation & type_) {
+                return type_.name() == name;
+            });
+
+        if (!composite) {
+            mismatch();
+            return;
+        }
+
+        this->composite (*expected_.composite, *composite);
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::bind::verify (
+    const Verifier & verifier_,
+    const schema::Schema & schema_,
+    const std::string & descriptor_
+) {
+    auto composite = find (schema_,
+        [&descriptor_](const schema::AMQPTypeNotation & type_) {
+            return type_.descriptor() == descriptor_;
+        });
+
+    if (!composite) {
+        throw std::runtime_error (
+            "No class in the blob's schema has the descriptor " + descriptor_);
+    }
+
+    Check check (schema_);
+
+    check.composite (verifier_, *composite);
+
+    if (!check.differences.empty()) {
+        std::stringstream ss;
+
+        ss << "Binding does not match " << composite->name()
+           << " in the blob's schema";
+
+        for (const auto & difference : check.differences) {
+            ss << std::endl << "  " << difference;
+        }
+
+        throw std::runtime_error (ss.str());
+    }
+
+    for (auto & learnt : check.learnt) {
+        std::get<0> (learnt)->learn (
+            std::get<1> (learnt), std::move (std::get<2> (learnt)));
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::bind::descriptor (pn_data_t * data_) {
+    proton::is_symbol (data_);
+
+    auto symbol = pn_data_get_symbol (data_);
+
+    return { symbol.start, symbol.size };
+}
+
+void
+amqp::internal::bind::next (pn_data_t * data_) {
+    if (!pn_data_next (data_)) {
+        throw std::runtime_error (
+            "Blob holds fewer values than its binding reads");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::bind::expect (
+    pn_data_t * data_,
+    pn_type_t type_,
+    const char * name_
+) {
+    auto type = pn_data_type (data_);
+
+    if (type != type_) {
+        throw std::runtime_error (
+            std::string ("Expected ") + name_ + " but the blob holds "
+            + (type == PN_INVALID ? "nothing" : pn_type_name (type)));
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::bind::Blob
+ *
+ ******************************************************************************/
+
+amqp::internal::bind::
+Blob::Blob (const char * bytes_, size_t size_)
+    : m_data (proton::DataPool::instance().acquire())
+{
+    if (pn_data_decode (m_data.get(), bytes_, size_) < 0) {
+        throw std::runtime_error ("Failed to decode AMQP stream");
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::bind::
+Blob::~Blob() = default;
+
+/******************************************************************************/
+
+/*
+ * The envelope is a described list of the object, the schema and the
+ * transforms
+ */
+pn_data_t *
+amqp::internal::bind::
+Blob::object() {
+    auto data = m_data.get();
+
+    pn_data_rewind (data);
+    pn_data_next (data);
+
+    if (!pn_data_is_described (data)) {
+        throw std::runtime_error ("Blob does not contain an envelope");
+    }
+
+    pn_data_enter (data);
+    pn_data_next (data);
+    pn_data_next (data);
+
+    proton::is_list (data);
+
+    pn_data_enter (data);
+    pn_data_next (data);
+
+    proton::is_described (data);
+
+    return data;
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Schema &
+amqp::internal::bind::
+Blob::schema() {
+    if (!m_envelope) {
+        auto data = m_data.get();
+        auto point = pn_data_point (data);
+
+        pn_data_rewind (data);
+        pn_data_next (data);
+
+        {
+            proton::auto_enter p (data);
+
+            auto it = AMQPDescriptorRegistory.find (pn_data_get_ulong (data));
+
+            if (it != AMQPDescriptorRegistory.end()) {
+                m_envelope.reset (
+                    dynamic_cast<schema::Envelope *> (
+                        it->second->build (data).release()));
+            }
+        }
+
+        pn_data_restore (data, point);
+
+        if (!m_envelope) {
+            throw std::runtime_error ("Blob does not contain an envelope");
+        }
+    }
+
+    return dynamic_cast<const schema::Schema &> (m_envelope->schema());
+}
+
+/******************************************************************************/
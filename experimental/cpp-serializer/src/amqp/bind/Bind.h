@@ -0,0 +1,464 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <array>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <shared_mutex>
+#include <string_view>
+#include <type_traits>
+
+#include <proton/codec.h>
+
+#include "types.h"
+#include "proton/DataPool.h"
+
+/******************************************************************************
+ *
+ * Forward class declarations
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class Schema;
+    class Envelope;
+
+}
+
+/******************************************************************************/
+
+/**
+ * Decoding a blob straight into a C++ type the caller already knows,
+ * rather than into a tree of [IValue]s keyed by field name. A binding
+ * names each member of the struct and the property of the Corda class it
+ * is read from,
+ *
+ *     struct Cash { long quantity; std::string currency; };
+ *
+ *     static const auto cash = amqp::bind<Cash> (
+ *         AMQP_FIELD (Cash, quantity),
+ *         AMQP_FIELD (Cash, currency));
+ *
+ *     Cash c = cash.decode (bytes, size);
+ *
+ * The first blob seen for each descriptor has its schema checked against
+ * the binding, failing with every difference between them if they don't
+ * match. After that a blob carrying the same descriptor is read member
+ * by member without looking at its schema at all.
+ *
+ * A member whose type is itself bound is read through that binding,
+ * passed as the last argument to [field] or [AMQP_BOUND_FIELD], as are
+ * the elements of a vector of such a type.
+ */
+#define AMQP_FIELD(type_, member_) \
+    amqp::field (#member_, &type_::member_)
+
+#define AMQP_BOUND_FIELD(type_, member_, binding_) \
+    amqp::field (#member_, &type_::member_, binding_)
+
+/******************************************************************************/
+
+namespace amqp::internal::bind {
+
+    class Verifier;
+
+    /**
+     * What a binding expects of one of the properties of the class it's
+     * bound to. [type] is the schema's name for it, left empty where it
+     * is, or is a list of, a type with its own binding, [composite]
+     */
+    struct Expected {
+        std::string      name;
+        std::string      type;
+        bool             list;
+        const Verifier * composite;
+    };
+
+    /**
+     * The part of a binding that can be checked against a schema without
+     * knowing the C++ type it reads into
+     */
+    class Verifier {
+        public :
+            virtual ~Verifier() = default;
+
+            virtual const std::vector<Expected> & expected() const = 0;
+
+            /**
+             * Having been verified against the class with [descriptor_],
+             * the index of the member each of its properties is read into
+             */
+            virtual void learn (
+                const std::string & descriptor_,
+                std::vector<size_t> order_) const = 0;
+    };
+
+    /**
+     * Check [verifier_] against the class in [schema_] with [descriptor_],
+     * and so any nested bindings against the classes of its properties.
+     * Either every binding taking part learns the order its class's
+     * properties arrive in or, if anything doesn't match, nothing does and
+     * the differences are thrown.
+     */
+    void verify (
+        const Verifier & verifier_,
+        const schema::Schema & schema_,
+        const std::string & descriptor_);
+
+    /**
+     * A blob decoded into a tree from the pool
+     */
+    class Blob {
+        private :
+            proton::DataPool::Lease        m_data;
+            uPtr<schema::Envelope>         m_envelope;
+
+        public :
+            Blob (const char *, size_t);
+            ~Blob();
+
+            /**
+             * Leaves the tree's cursor on the blob's object
+             */
+            pn_data_t * object();
+
+            /**
+             * The envelope's schema, only parsed if asked for
+             */
+            const schema::Schema & schema();
+    };
+
+    std::string_view descriptor (pn_data_t *);
+
+    /**
+     * Moves the cursor on to the next value, failing if [data_] holds
+     * fewer than the binding expects
+     */
+    void next (pn_data_t * data_);
+
+    /**
+     * Fails unless the value under the cursor is a [type_], naming what
+     * was expected as [name_]
+     */
+    void expect (pn_data_t * data_, pn_type_t type_, const char * name_);
+
+    /******************************************************************************/
+
+    /**
+     * Reading a value of type [T] from the tree and naming it as the
+     * schema would. Anything without a specialisation is a composite with
+     * a binding of its own, [Nested]
+     */
+    template<typename T, typename Nested>
+    struct Codec {
+        static_assert (!std::is_void_v<Nested>,
+            "A member of a bound type must be given the binding to read it");
+
+        static void read (pn_data_t * data_, T & value_, const Nested * nested_) {
+            nested_->read (data_, value_);
+        }
+
+        static Expected expected (std::string name_, const Nested * nested_) {
+            return { std::move (name_), "", false, nested_ };
+        }
+    };
+
+    /**
+     * The primitives, each naming itself as [Codec::name] and read only
+     * from a value of [type_]
+     */
+    template<class Codec, typename T, pn_type_t type_, typename Read, Read read_>
+    struct Primitive {
+        static void read (pn_data_t * data_, T & value_, const void *) {
+            expect (data_, type_, Codec::name);
+            value_ = read_ (data_);
+        }
+
+        static Expected expected (std::string name_, const void *) {
+            return { std::move (name_), Codec::name, false, nullptr };
+        }
+    };
+
+    template<>
+    struct Codec<int, void>
+        : Primitive<Codec<int, void>, int, PN_INT,
+                decltype (&pn_data_get_int), &pn_data_get_int>
+    {
+        static constexpr const char * name = "int";
+    };
+
+    template<>
+    struct Codec<long, void>
+        : Primitive<Codec<long, void>, long, PN_LONG,
+                decltype (&pn_data_get_long), &pn_data_get_long>
+    {
+        static constexpr const char * name = "long";
+    };
+
+    template<>
+    struct Codec<bool, void>
+        : Primitive<Codec<bool, void>, bool, PN_BOOL,
+                decltype (&pn_data_get_bool), &pn_data_get_bool>
+    {
+        static constexpr const char * name = "boolean";
+    };
+
+    template<>
+    struct Codec<double, void>
+        : Primitive<Codec<double, void>, double, PN_DOUBLE,
+                decltype (&pn_data_get_double), &pn_data_get_double>
+    {
+        static constexpr const char * name = "double";
+    };
+
+    template<>
+    struct Codec<std::string, void> {
+        static void read (pn_data_t * data_, std::string & value_, const void *) {
+            // a null string reads as empty
+            if (pn_data_type (data_) == PN_NULL) {
+                value_.clear();
+                return;
+            }
+
+            expect (data_, PN_STRING, "string");
+
+            auto bytes = pn_data_get_string (data_);
+            value_.assign (bytes.start, bytes.size);
+        }
+
+        static Expected expected (std::string name_, const void *) {
+            return { std::move (name_), "string", false, nullptr };
+        }
+    };
+
+    template<typename T, typename Nested>
+    struct Codec<std::vector<T>, Nested> {
+        static void read (
+            pn_data_t * data_,
+            std::vector<T> & value_,
+            const Nested * nested_
+        ) {
+            if (pn_data_type (data_) == PN_NULL) {
+                return;
+            }
+
+            // a described list, its descriptor then its elements
+            expect (data_, PN_DESCRIBED, "list");
+
+            pn_data_enter (data_);
+            next (data_);
+            next (data_);
+
+            expect (data_, PN_LIST, "list");
+
+            value_.resize (pn_data_get_list (data_));
+
+            pn_data_enter (data_);
+            for (auto & element : value_) {
+                next (data_);
+                Codec<T, Nested>::read (data_, element, nested_);
+            }
+            pn_data_exit (data_);
+
+            pn_data_exit (data_);
+        }
+
+        static Expected expected (std::string name_, const Nested * nested_) {
+            auto element = Codec<T, Nested>::expected (name_, nested_);
+
+            if (!element.type.empty()) {
+                element.type = "java.util.List<" + element.type + ">";
+            }
+            element.list = true;
+
+            return element;
+        }
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp {
+
+    template<class T, typename M, class Nested = void>
+    struct Field {
+        using Codec = internal::bind::Codec<M, Nested>;
+
+        const char *   name;
+        M T::*         member;
+        const Nested * nested;
+    };
+
+    template<class T, typename M>
+    Field<T, M>
+    field (const char * name_, M T::* member_) {
+        return { name_, member_, nullptr };
+    }
+
+    template<class T, typename M, class Nested>
+    Field<T, M, Nested>
+    field (const char * name_, M T::* member_, const Nested & nested_) {
+        return { name_, member_, &nested_ };
+    }
+
+    /******************************************************************************/
+
+    template<class T, class... Fields>
+    class Binding : public internal::bind::Verifier {
+        private :
+            using Reader = void (*) (const Binding &, pn_data_t *, T &);
+
+            std::tuple<Fields...>                        m_fields;
+            std::vector<internal::bind::Expected>        m_expected;
+            std::array<Reader, sizeof... (Fields)>       m_readers;
+
+            mutable std::shared_mutex                    m_mutex;
+            mutable std::map<
+                std::string,
+                std::vector<size_t>,
+                std::less<>>                             m_orders;
+
+            template<size_t I>
+            static void
+            readField (const Binding & binding_, pn_data_t * data_, T & value_) {
+                const auto & field = std::get<I> (binding_.m_fields);
+
+                std::decay_t<decltype (field)>::Codec::read (
+                        data_, value_.*field.member, field.nested);
+            }
+
+            template<size_t... I>
+            Binding (std::tuple<Fields...> fields_, std::index_sequence<I...>)
+                : m_fields (std::move (fields_))
+                , m_expected {
+                    std::tuple_element_t<I, std::tuple<Fields...>>::Codec::expected (
+                        std::get<I> (m_fields).name,
+                        std::get<I> (m_fields).nested)... }
+                , m_readers { &Binding::readField<I>... }
+            { }
+
+            /**
+             * The order [descriptor_]'s properties arrive in, if it's been
+             * verified
+             */
+            const std::vector<size_t> *
+            order (std::string_view descriptor_) const {
+                std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+                auto it = m_orders.find (descriptor_);
+
+                // entries are never removed, so it outlives the lock
+                return it == m_orders.end() ? nullptr : &it->second;
+            }
+
+        public :
+            explicit Binding (Fields... fields_)
+                : Binding (
+                    std::make_tuple (std::move (fields_)...),
+                    std::index_sequence_for<Fields...> { })
+            { }
+
+            Binding (const Binding &) = delete;
+            Binding & operator = (const Binding &) = delete;
+
+            const std::vector<internal::bind::Expected> &
+            expected() const override {
+                return m_expected;
+            }
+
+            void
+            learn (
+                const std::string & descriptor_,
+                std::vector<size_t> order_
+            ) const override {
+                std::unique_lock<std::shared_mutex> lock (m_mutex);
+
+                m_orders.emplace (descriptor_, std::move (order_));
+            }
+
+            /**
+             * Read the described composite under the cursor into [value_]
+             */
+            void
+            read (pn_data_t * data_, T & value_) const {
+                if (pn_data_type (data_) == PN_NULL) {
+                    return;
+                }
+
+                internal::bind::expect (data_, PN_DESCRIBED, "composite");
+
+                pn_data_enter (data_);
+                internal::bind::next (data_);
+
+                auto descriptor = internal::bind::descriptor (data_);
+                auto order = this->order (descriptor);
+
+                if (!order) {
+                    throw std::runtime_error (
+                        "No binding verified for " + std::string (descriptor));
+                }
+
+                internal::bind::next (data_);
+                internal::bind::expect (data_, PN_LIST, "composite");
+
+                pn_data_enter (data_);
+
+                for (auto index : *order) {
+                    internal::bind::next (data_);
+                    m_readers[index] (*this, data_, value_);
+                }
+
+                pn_data_exit (data_);
+                pn_data_exit (data_);
+            }
+
+            /**
+             * Decode a blob, less its Corda header, into a [T]
+             */
+            T
+            decode (const char * bytes_, size_t size_) const {
+                internal::bind::Blob blob (bytes_, size_);
+
+                auto object = blob.object();
+
+                {
+                    pn_data_enter (object);
+                    pn_data_next (object);
+
+                    auto descriptor = internal::bind::descriptor (object);
+
+                    if (!order (descriptor)) {
+                        internal::bind::verify (
+                            *this, blob.schema(), std::string (descriptor));
+                    }
+
+                    pn_data_exit (object);
+                }
+
+                T value { };
+                read (object, value);
+
+                return value;
+            }
+    };
+
+    /**
+     * A binding of [T]'s members to the properties of the class it was
+     * serialised from
+     */
+    template<class T, class... Fields>
+    Binding<T, Fields...>
+    bind (Fields... fields_) {
+        return Binding<T, Fields...> (std::move (fields_)...);
+    }
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,304 @@
+#include "AnyReader.h"
+
+#include <map>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Graph.h"
+#include "Variant.h"
+#include "PropertyReader.h"
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    /**
+     * Up to the last eight bytes of [descriptor_]
+     */
+    uint64_t
+    tail (std::string_view descriptor_) {
+        uint64_t rtn { 0 };
+        auto n = std::min (sizeof (rtn), descriptor_.size());
+
+        std::memcpy (&rtn, descriptor_.data() + descriptor_.size() - n, n);
+
+        return rtn;
+    }
+
+    /**
+     * The reader for a value written as a bare primitive
+     */
+    const Reader *
+    primitive (pn_type_t type_, const std::string & declared_) {
+        static const std::map<pn_type_t, sPtr<PropertyReader>> readers { // NOLINT
+            { PN_INT, PropertyReader::make ("int") },
+            { PN_LONG, PropertyReader::make ("long") },
+            { PN_BOOL, PropertyReader::make ("boolean") },
+            { PN_DOUBLE, PropertyReader::make ("double") },
+            { PN_STRING, PropertyReader::make ("string") },
+            { PN_BINARY, PropertyReader::make ("binary") },
+            { PN_TIMESTAMP, PropertyReader::make ("timestamp") },
+            { PN_UUID, PropertyReader::make ("uuid") }
+        };
+
+        auto it = readers.find (type_);
+
+        if (it == readers.end()) {
+            throw std::runtime_error (
+                std::string ("Can't read a ") + pn_type_name (type_)
+                    + " as a " + declared_);
+        }
+
+        return it->second.get();
+    }
+
+}
+
+/******************************************************************************
+ *
+ * AnyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+AnyReader::m_name { // NOLINT
+    "Any Reader"
+};
+
+/******************************************************************************
+ *
+ * class AnyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+AnyReader::AnyReader (
+    std::string type_,
+    Lookup lookup_
+) : m_type (std::move (type_))
+  , m_lookup (std::move (lookup_))
+  , m_cache { }
+  , m_victim { 0 }
+  , m_misses { 0 }
+{ }
+
+/******************************************************************************/
+
+/**
+ * The copy starts with an empty cache, the readers the original cached
+ * not being the graph's
+ */
+amqp::internal::reader::
+AnyReader::AnyReader (
+    const AnyReader & reader_,
+    Graph & graph_
+) : m_type (reader_.m_type)
+  , m_lookup ([&graph_](std::string_view descriptor_) {
+        return graph_.find (descriptor_);
+    })
+  , m_cache { }
+  , m_victim { 0 }
+  , m_misses { 0 }
+{ }
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+AnyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+AnyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::reader::
+AnyReader::misses() const {
+    return m_misses.load (std::memory_order_relaxed);
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+AnyReader::resolve (pn_data_t * data_) const {
+    if (!pn_data_is_described (data_)) {
+        return primitive (pn_data_type (data_), m_type);
+    }
+
+    proton::auto_enter ae (data_);
+
+    return resolve (proton::get_symbol<std::string_view> (data_));
+}
+
+/******************************************************************************/
+
+/**
+ * The cache fills from the front and entries are only ever replaced, never
+ * cleared, so the first empty way ends the search
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+AnyReader::resolve (std::string_view descriptor_) const {
+    auto end = tail (descriptor_);
+
+    for (const auto & way : m_cache) {
+        auto entry = way.load (std::memory_order_acquire);
+
+        if (!entry) {
+            break;
+        }
+
+        if (entry->tail == end && entry->descriptor == descriptor_) {
+            return entry->reader;
+        }
+    }
+
+    return miss (descriptor_);
+}
+
+/******************************************************************************/
+
+/**
+ * Find the reader for a class the cache doesn't hold and put it in a way
+ * of its own, or once they're all taken in place of one of the others
+ */
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+AnyReader::miss (std::string_view descriptor_) const {
+    m_misses.fetch_add (1, std::memory_order_relaxed);
+
+    const Entry * entry { nullptr };
+
+    {
+        std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+        auto it = m_entries.find (descriptor_);
+
+        if (it != m_entries.end()) {
+            entry = it->second.get();
+        }
+    }
+
+    if (!entry) {
+        auto reader = m_lookup (descriptor_);
+
+        if (!reader) {
+            throw std::runtime_error (
+                "No reader for descriptor " + std::string (descriptor_)
+                    + " reading a " + m_type);
+        }
+
+        std::unique_lock<std::shared_mutex> lock (m_mutex);
+
+        auto & owned = m_entries[std::string (descriptor_)];
+
+        if (!owned) {
+            owned = std::make_unique<Entry> (
+                Entry { std::string (descriptor_), reader, tail (descriptor_) });
+        }
+
+        entry = owned.get();
+    }
+
+    for (auto & way : m_cache) {
+        const Entry * empty { nullptr };
+
+        if (way.compare_exchange_strong (empty, entry, std::memory_order_acq_rel)
+            || empty == entry)
+        {
+            return entry->reader;
+        }
+    }
+
+    auto victim = m_victim.fetch_add (1, std::memory_order_relaxed) % ways;
+    m_cache[victim].store (entry, std::memory_order_release);
+
+    return entry->reader;
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+AnyReader::read (pn_data_t * data_) const {
+    return resolve (data_)->read (data_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+AnyReader::readString (pn_data_t * data_) const {
+    return resolve (data_)->readString (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+AnyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_
+) const {
+    return resolve (data_)->dump (name_, data_, schema_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+AnyReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_
+) const {
+    return resolve (data_)->dump (data_, schema_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+AnyReader::visit (
+    pn_data_t * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    resolve (data_)->visit (data_, schema_, visitor_);
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+AnyReader::freeze (Graph & graph_) const {
+    return graph_.make<AnyReader> (*this, graph_);
+}
+
+/******************************************************************************/
+
+/**
+ * Which class a value is can't be known until it's read, so the program
+ * hands such values back to this reader
+ */
+size_t
+amqp::internal::reader::
+AnyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Any { m_type, this });
+}
+
+/******************************************************************************/
@@ -0,0 +1,135 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "Reader.h"
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <shared_mutex>
+
+#include <proton/codec.h>
+
+#include "types.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Reads a property whose type the schema doesn't define, one declared
+     * as an interface, an abstract class or Object and written as whichever
+     * class implements it. Each value carries the descriptor of its class,
+     * which the schema does define, and the reader for that is found as
+     * the value is read.
+     *
+     * Each property gets a reader of its own holding an inline cache of
+     * the last few descriptors it met and their readers, so a property
+     * only ever written as one class, the common case, costs a comparison
+     * of its descriptor against the one cached. Past [ways] classes it
+     * falls back to looking them up.
+     *
+     * Values that aren't described are read as the primitive they're
+     * encoded as.
+     */
+    class AnyReader : public Reader {
+        public :
+            static constexpr size_t ways { 4 };
+
+            /**
+             * Where the reader for a descriptor is found, building it if
+             * need be, null if there isn't one
+             */
+            using Lookup = std::function<const Reader * (std::string_view)>;
+
+        private :
+            /**
+             * [tail] holds the last bytes of the descriptor. Corda's all
+             * start "net.corda:" and differ in the hash ending them, so
+             * comparing it first turns a way holding another class away
+             * without looking at the rest.
+             */
+            struct Entry {
+                std::string    descriptor;
+                const Reader * reader;
+                uint64_t       tail;
+            };
+
+            static const std::string m_name;
+
+            std::string m_type;
+
+            /**
+             * The factory's before the graph is frozen and the graph's
+             * after
+             */
+            Lookup m_lookup;
+
+            mutable std::array<std::atomic<const Entry *>, ways> m_cache;
+            mutable std::atomic<size_t>                          m_victim;
+            mutable std::atomic<uint64_t>                        m_misses;
+
+            /**
+             * Every class met, owning the entries the cache points to
+             */
+            mutable std::shared_mutex m_mutex;
+            mutable std::map<std::string, uPtr<Entry>, std::less<>> m_entries;
+
+            const Reader * miss (std::string_view) const;
+
+        public :
+            AnyReader (std::string type_, Lookup lookup_);
+
+            AnyReader (const AnyReader &, Graph &);
+
+            ~AnyReader() override = default;
+
+            /**
+             * The reader for the value under the cursor, leaving the
+             * cursor where it is
+             */
+            const Reader * resolve (pn_data_t *) const;
+
+            /**
+             * The reader for values of the class [descriptor_] describes
+             */
+            const Reader * resolve (std::string_view descriptor_) const;
+
+            /**
+             * How many reads missed the inline cache
+             */
+            uint64_t misses() const;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+
+            std::any read (pn_data_t *) const override;
+            std::string readString (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -7,6 +7,8 @@
 #include <proton/codec.h>
 #include <sstream>
 #include "debug.h"
+#include "Graph.h"
+#include "Variant.h"
 #include "Reader.h"
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
@@ -27,21 +29,38 @@ CompositeReader::m_name { // NOLINT
 amqp::internal::reader::
 CompositeReader::CompositeReader (
         std::string type_,
-        sVec<std::weak_ptr<Reader>> & readers_
-) : m_readers (readers_)
+        std::string descriptor_,
+        sVec<Field> fields_
+) : m_fields (fields_.begin(), fields_.end())
   , m_type (std::move (type_))
+  , m_descriptor (std::move (descriptor_))
 {
-    DBG ("MAKE CompositeReader: " << m_type << ": " << m_readers.size() << std::endl); // NOLINT
-    for (auto const reader : m_readers) {
-        assert (reader.lock());
-        if (auto r = reader.lock()) {
-            DBG ("  prop: " << r->name() << " " << r->type() << std::endl); // NOLINT
+    DBG ("MAKE CompositeReader: " << m_type << ": " << m_fields.size() << std::endl); // NOLINT
+    for (auto const & field : m_fields) {
+        assert (field.reader);
+        if (field.reader) {
+            DBG ("  prop: " << field.reader->name() << " " << field.reader->type() << std::endl); // NOLINT
         }
     }
 }
 
 /******************************************************************************/
 
+amqp::internal::reader::
+CompositeReader::CompositeReader (
+        const CompositeReader & reader_,
+        Graph & graph_
+) : m_fields (reader_.m_fields, graph_.resource())
+  , m_type (reader_.m_type)
+  , m_descriptor (reader_.m_descriptor)
+{
+    for (auto & field : m_fields) {
+        field.reader = graph_.link (field.reader);
+    }
+}
+
+/******************************************************************************/
+
 const std::string &
 amqp::internal::reader::
 CompositeReader::name() const {
@@ -77,6 +96,40 @@ CompositeReader::readString (pn_data_t * data_) const {
 
 /******************************************************************************/
 
+std::string_view
+amqp::internal::reader::
+CompositeReader::descriptor (pn_data_t * data_) {
+    return proton::get_symbol<std::string_view> (data_);
+}
+
+/******************************************************************************/
+
+/**
+ * A blob carrying a descriptor other than the one this reader was built
+ * for names its properties as its own schema does
+ */
+const std::vector<std::unique_ptr<amqp::internal::schema::Field>> *
+amqp::internal::reader::
+CompositeReader::schemaFields (
+    std::string_view descriptor_,
+    const SchemaType & schema_
+) const {
+    if (descriptor_ == m_descriptor) {
+        return nullptr;
+    }
+
+    const auto & it = schema_.fromDescriptor (descriptor_);
+
+    auto fields = &dynamic_cast<schema::Composite &> (
+            *(it->second.get())).fields();
+
+    assert (fields->size() == m_fields.size());
+
+    return fields;
+}
+
+/******************************************************************************/
+
 
 sVec<uPtr<amqp::reader::IValue>>
 amqp::internal::reader::
@@ -93,34 +146,23 @@ CompositeReader::_dump (
     proton::is_described (data_);
     proton::auto_enter ae (data_);
 
-    const auto & it = schema_.fromDescriptor (
-            proton::get_symbol<std::string>(data_));
-
-    auto & fields = dynamic_cast<schema::Composite &> (
-            *(it->second.get())).fields();
-
-    assert (fields.size() == m_readers.size());
+    auto fields = schemaFields (descriptor (data_), schema_);
 
     pn_data_next (data_);
 
     sVec<uPtr<amqp::reader::IValue>> read;
-    read.reserve (fields.size());
+    read.reserve (m_fields.size());
 
     proton::is_list (data_);
     {
         proton::auto_enter ae (data_);
 
-        for (int i (0) ; i < m_readers.size() ; ++i) {
-            if (auto l =  m_readers[i].lock()) {
-                DBG (fields[i]->name() << " "
-                    << (l ? "true" : "false") << std::endl); // NOLINT
-
-                read.emplace_back (l->dump (fields[i]->name(), data_, schema_));
-            } else {
-                std::stringstream s;
-                s << "null field reader: " << fields[i]->name();
-                throw std::runtime_error (s.str());
-            }
+        for (size_t i (0) ; i < m_fields.size() ; ++i) {
+            const auto & name = fields ? (*fields)[i]->name() : m_fields[i].name;
+
+            DBG (name << std::endl); // NOLINT
+
+            read.emplace_back (m_fields[i].reader->dump (name, data_, schema_));
         }
     }
 
@@ -162,3 +204,62 @@ CompositeReader::dump (
 
 /******************************************************************************/
 
+void
+amqp::internal::reader::
+CompositeReader::visit (
+    pn_data_t * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    proton::auto_next an (data_);
+
+    proton::is_described (data_);
+    proton::auto_enter ae (data_);
+
+    auto descriptor = this->descriptor (data_);
+    auto fields = schemaFields (descriptor, schema_);
+
+    pn_data_next (data_);
+
+    visitor_.onCompositeBegin (m_type, descriptor);
+
+    proton::is_list (data_);
+    {
+        proton::auto_enter ae (data_);
+
+        for (size_t i (0) ; i < m_fields.size() ; ++i) {
+            visitor_.onField (
+                fields ? (*fields)[i]->name() : m_fields[i].name);
+
+            m_fields[i].reader->visit (data_, schema_, visitor_);
+        }
+    }
+
+    visitor_.onCompositeEnd();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+CompositeReader::freeze (Graph & graph_) const {
+    return graph_.make<CompositeReader> (*this, graph_);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+CompositeReader::compile (variant::Program & program_) const {
+    variant::Composite node { m_type, m_descriptor, { } };
+
+    node.fields.reserve (m_fields.size());
+
+    for (const auto & field : m_fields) {
+        node.fields.push_back ({ field.name, program_.link (field.reader) });
+    }
+
+    return program_.add (std::move (node));
+}
+
+/******************************************************************************/
@@ -7,6 +7,7 @@
 #include <any>
 #include <vector>
 #include <iostream>
+#include <memory_resource>
 #include <amqp/schema/described-types/Schema.h>
 
 /******************************************************************************/
@@ -14,17 +15,36 @@
 namespace amqp::internal::reader {
 
     class CompositeReader : public Reader {
+        public :
+            /**
+             * What's needed to read one of the composite's properties,
+             * held together so reading them is a walk along an array
+             */
+            struct Field {
+                std::string    name;
+                const Reader * reader;
+            };
+
         private :
-            std::vector<std::weak_ptr<Reader>> m_readers;
+            std::pmr::vector<Field> m_fields;
 
             static const std::string m_name;
 
             std::string m_type;
 
+            /**
+             * The descriptor blobs of this type carry, when a blob carries
+             * another the property names are taken from the schema instead
+             */
+            std::string m_descriptor;
+
         public :
             CompositeReader (
                 std::string,
-                std::vector<std::weak_ptr<Reader>> &);
+                std::string,
+                std::vector<Field>);
+
+            CompositeReader (const CompositeReader &, Graph &);
 
             ~CompositeReader() override = default;
 
@@ -44,10 +64,24 @@ namespace amqp::internal::reader {
             const std::string & name() const override;
             const std::string & type() const override;
 
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
+
         private :
             std::vector<std::unique_ptr<amqp::reader::IValue>> _dump (
                 pn_data_t *,
                 const SchemaType &) const;
+
+            static std::string_view descriptor (pn_data_t *);
+
+            const std::vector<std::unique_ptr<schema::Field>> * schemaFields (
+                std::string_view,
+                const SchemaType &) const;
     };
 
 }
@@ -0,0 +1,502 @@
+#include "Document.h"
+
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "JsonVisitor.h"
+#include "concurrency/Interner.h"
+
+/******************************************************************************/
+
+namespace {
+
+    uint32_t
+    narrow (size_t value_) {
+        if (value_ > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error ("Blob too large for a document");
+        }
+
+        return static_cast<uint32_t>(value_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Document
+ *
+ ******************************************************************************/
+
+const amqp::internal::reader::Document::Slot &
+amqp::internal::reader::
+Document::root() const {
+    if (m_slots.empty()) {
+        throw std::runtime_error ("Empty document");
+    }
+
+    return m_slots.back();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+Document::size (const Slot & slot_) const {
+    switch (slot_.kind) {
+        case composite_e :
+        case list_e :
+            return slot_.range.count;
+        case map_e :
+            return slot_.range.count / 2;
+        default :
+            return 0;
+    }
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Document::Slot &
+amqp::internal::reader::
+Document::child (const Slot & container_, size_t n_) const {
+    return m_slots[container_.range.first + n_];
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+Document::field (const Slot & composite_, size_t n_) const {
+    return m_names[m_types[composite_.aux].fields[n_]];
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+Document::type (const Slot & composite_) const {
+    return m_names[m_types[composite_.aux].name];
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+Document::descriptor (const Slot & composite_) const {
+    return m_names[m_types[composite_.aux].descriptor];
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+Document::bytes (const Slot & slot_) const {
+    if (m_interned && slot_.kind == string_e) {
+        return { slot_.data, slot_.aux };
+    }
+
+    return std::string_view (m_bytes).substr (slot_.offset, slot_.aux);
+}
+
+/******************************************************************************/
+
+const std::vector<amqp::internal::reader::Document::Slot> &
+amqp::internal::reader::
+Document::slots() const {
+    return m_slots;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::walk (const Slot & slot_, amqp::reader::IVisitor & visitor_) const {
+    switch (slot_.kind) {
+        case int_e :
+            visitor_.onInt (static_cast<int32_t>(slot_.integer));
+            break;
+        case long_e :
+            visitor_.onLong (slot_.integer);
+            break;
+        case bool_e :
+            visitor_.onBool (slot_.boolean);
+            break;
+        case double_e :
+            visitor_.onDouble (slot_.real);
+            break;
+        case string_e :
+            visitor_.onString (bytes (slot_));
+            break;
+        case binary_e :
+            visitor_.onBinary (bytes (slot_));
+            break;
+        case composite_e : {
+            visitor_.onCompositeBegin (type (slot_), descriptor (slot_));
+
+            const auto & fields = m_types[slot_.aux].fields;
+
+            for (uint32_t i { 0 } ; i < slot_.range.count ; ++i) {
+                visitor_.onField (m_names[fields[i]]);
+                walk (m_slots[slot_.range.first + i], visitor_);
+            }
+
+            visitor_.onCompositeEnd();
+            break;
+        }
+        case list_e :
+            visitor_.onListBegin (slot_.range.count);
+
+            for (uint32_t i { 0 } ; i < slot_.range.count ; ++i) {
+                walk (m_slots[slot_.range.first + i], visitor_);
+            }
+
+            visitor_.onListEnd();
+            break;
+        case map_e :
+            visitor_.onMapBegin (slot_.range.count / 2);
+
+            for (uint32_t i { 0 } ; i < slot_.range.count ; ++i) {
+                walk (m_slots[slot_.range.first + i], visitor_);
+            }
+
+            visitor_.onMapEnd();
+            break;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::visit (amqp::reader::IVisitor & visitor_) const {
+    walk (root(), visitor_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+Document::json() const {
+    JsonVisitor json;
+    visit (json);
+
+    return json.str();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Document::Builder
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Document::Builder::Builder (concurrency::Interner * interner_)
+    : m_interner (interner_)
+{
+    m_document.m_interned = m_interner != nullptr;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::reader::
+Document::Builder::intern (std::string_view name_) {
+    auto it = m_interned.find (name_);
+
+    if (it != m_interned.end()) {
+        return it->second;
+    }
+
+    auto index = narrow (m_document.m_names.size());
+
+    std::string_view name = m_interner
+        ? m_interner->intern (name_)
+        : m_document.m_owned.emplace_back (name_);
+
+    m_document.m_names.push_back (name);
+    m_interned.emplace (name, index);
+
+    return index;
+}
+
+/******************************************************************************/
+
+/**
+ * The index of the type of the composite [open_] has just finished, the
+ * fields it named being the last on [m_fields]
+ */
+uint32_t
+amqp::internal::reader::
+Document::Builder::type (const Open & open_) {
+    auto begin = m_fields.begin() + open_.fields;
+
+    if (open_.hint != npos) {
+        const auto & fields = m_document.m_types[open_.hint].fields;
+
+        if (std::equal (begin, m_fields.end(), fields.begin(), fields.end())) {
+            return open_.hint;
+        }
+    }
+    auto & candidates = m_types[{ open_.name, open_.descriptor }];
+
+    for (auto candidate : candidates) {
+        const auto & fields = m_document.m_types[candidate].fields;
+
+        if (std::equal (begin, m_fields.end(), fields.begin(), fields.end())) {
+            return candidate;
+        }
+    }
+
+    auto index = narrow (m_document.m_types.size());
+
+    m_document.m_types.push_back ({
+        open_.name, open_.descriptor, { begin, m_fields.end() } });
+
+    candidates.push_back (index);
+
+    return index;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::open (
+    Kind kind_,
+    uint32_t name_,
+    uint32_t descriptor_,
+    uint32_t hint_
+) {
+    Slot slot { };
+    slot.kind = kind_;
+
+    m_open.push_back ({
+        m_stack.size(), m_fields.size(), name_, descriptor_, hint_ });
+
+    m_stack.push_back (slot);
+}
+
+/******************************************************************************/
+
+/**
+ * Move the children of the innermost open container to the document,
+ * leaving the container itself on the stack as its parent's child
+ */
+amqp::internal::reader::Document::Slot &
+amqp::internal::reader::
+Document::Builder::close() {
+    auto & slots = m_document.m_slots;
+    auto first = m_open.back().slot + 1;
+
+    auto & container = m_stack[first - 1];
+    container.range.first = narrow (slots.size());
+    container.range.count = narrow (m_stack.size() - first);
+
+    slots.insert (slots.end(), m_stack.begin() + first, m_stack.end());
+    m_stack.resize (first);
+
+    return m_stack.back();
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Document
+amqp::internal::reader::
+Document::Builder::document() {
+    if (!m_open.empty() || m_stack.size() != 1) {
+        throw std::runtime_error ("Document is incomplete");
+    }
+
+    m_document.m_slots.push_back (m_stack.back());
+    narrow (m_document.m_slots.size());
+
+    auto rtn = std::move (m_document);
+
+    m_document = Document();
+    m_document.m_interned = m_interner != nullptr;
+    m_stack.clear();
+    m_last.clear();
+    m_interned.clear();
+    m_types.clear();
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onCompositeBegin (
+    std::string_view type_,
+    std::string_view descriptor_
+) {
+    auto depth = m_open.size();
+
+    if (depth < m_last.size() && m_last[depth] != npos) {
+        const auto & last = m_document.m_types[m_last[depth]];
+
+        if (m_document.m_names[last.name] == type_
+            && m_document.m_names[last.descriptor] == descriptor_)
+        {
+            open (composite_e, last.name, last.descriptor, m_last[depth]);
+            return;
+        }
+    }
+
+    open (composite_e, intern (type_), intern (descriptor_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onCompositeEnd() {
+    auto index = type (m_open.back());
+
+    m_fields.resize (m_open.back().fields);
+    close().aux = index;
+    m_open.pop_back();
+
+    if (m_last.size() <= m_open.size()) {
+        m_last.resize (m_open.size() + 1, npos);
+    }
+
+    m_last[m_open.size()] = index;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onField (std::string_view name_) {
+    const auto & open = m_open.back();
+
+    if (open.hint != npos) {
+        const auto & fields = m_document.m_types[open.hint].fields;
+        auto n = m_fields.size() - open.fields;
+
+        if (n < fields.size() && m_document.m_names[fields[n]] == name_) {
+            m_fields.push_back (fields[n]);
+            return;
+        }
+    }
+
+    m_fields.push_back (intern (name_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onListBegin (size_t) {
+    open (list_e, 0, 0);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onListEnd() {
+    close();
+    m_open.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onMapBegin (size_t) {
+    open (map_e, 0, 0);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onMapEnd() {
+    close();
+    m_open.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onInt (int32_t value_) {
+    Slot slot { };
+    slot.kind = int_e;
+    slot.integer = value_;
+
+    m_stack.push_back (slot);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onLong (int64_t value_) {
+    Slot slot { };
+    slot.kind = long_e;
+    slot.integer = value_;
+
+    m_stack.push_back (slot);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onBool (bool value_) {
+    Slot slot { };
+    slot.kind = bool_e;
+    slot.boolean = value_;
+
+    m_stack.push_back (slot);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onDouble (double value_) {
+    Slot slot { };
+    slot.kind = double_e;
+    slot.real = value_;
+
+    m_stack.push_back (slot);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onString (std::string_view value_) {
+    Slot slot { };
+    slot.kind = string_e;
+    slot.aux = narrow (value_.size());
+
+    if (m_interner) {
+        slot.data = m_interner->intern (value_).data();
+    } else {
+        slot.offset = m_document.m_bytes.size();
+        m_document.m_bytes.append (value_);
+    }
+
+    m_stack.push_back (slot);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Document::Builder::onBinary (std::string_view value_) {
+    Slot slot { };
+    slot.kind = binary_e;
+    slot.aux = narrow (value_.size());
+    slot.offset = m_document.m_bytes.size();
+
+    m_document.m_bytes.append (value_);
+    m_stack.push_back (slot);
+}
+
+/******************************************************************************/
@@ -0,0 +1,246 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+#include <unordered_map>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace concurrency {
+
+    class Interner;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The values a blob holds, kept as a handful of flat arrays rather
+     * than a tree of [IValue]s. Every value is a sixteen byte [Slot] and
+     * a container's children sit side by side in the slot array, so a
+     * container is an index range into it. Strings and binaries are
+     * ranges of one pool of bytes and a composite's property names come
+     * from a table of the types met, each listing its fields once however
+     * many values of it there are. Building one is a few appends per
+     * value and freeing it is freeing the arrays.
+     *
+     * A document is built by handing its [Builder] to a reader's visit,
+     * and can be walked with the same events, which is how it's written
+     * as the JSON the value tree would dump to.
+     *
+     * Built with a [concurrency::Interner] its strings, enum constants,
+     * names and descriptors are the interner's copies instead, shared
+     * with every other document built with it, and the interner has to
+     * outlive them all.
+     */
+    class Document {
+        public :
+            class Builder;
+
+            enum Kind : uint8_t {
+                int_e, long_e, bool_e, double_e, string_e, binary_e,
+                composite_e, list_e, map_e
+            };
+
+            struct Slot {
+                Kind kind;
+
+                /**
+                 * The index of a composite's type, or a string's or
+                 * binary's length in bytes
+                 */
+                uint32_t aux;
+
+                union {
+                    int64_t integer;
+                    double  real;
+                    bool    boolean;
+
+                    /**
+                     * Where a string's or binary's bytes start in the pool
+                     */
+                    uint64_t offset;
+
+                    /**
+                     * An interned string's bytes
+                     */
+                    const char * data;
+
+                    /**
+                     * A container's children, a map's being its keys and
+                     * values alternating
+                     */
+                    struct {
+                        uint32_t first;
+                        uint32_t count;
+                    } range;
+                };
+            };
+
+            static_assert (sizeof (Slot) == 16, "Slots are to be 16 bytes");
+
+        private :
+            struct Type {
+                uint32_t              name;
+                uint32_t              descriptor;
+                std::vector<uint32_t> fields;
+            };
+
+            std::vector<Slot>             m_slots;
+            std::string                   m_bytes;
+            std::vector<std::string_view> m_names;
+            std::vector<Type>             m_types;
+
+            /**
+             * The names' text when they aren't interned
+             */
+            std::deque<std::string> m_owned;
+
+            bool m_interned { false };
+
+            void walk (const Slot &, amqp::reader::IVisitor &) const;
+
+        public :
+            /**
+             * The blob's object, a document always having one
+             */
+            const Slot & root() const;
+
+            /**
+             * The elements of a list, the fields of a composite or the
+             * entries of a map
+             */
+            size_t size (const Slot &) const;
+
+            /**
+             * The [n_]th child of a container, for a map its keys being
+             * the even children and their values the odd
+             */
+            const Slot & child (const Slot & container_, size_t n_) const;
+
+            /**
+             * The name of a composite's [n_]th property
+             */
+            std::string_view field (const Slot & composite_, size_t n_) const;
+
+            std::string_view type (const Slot & composite_) const;
+            std::string_view descriptor (const Slot & composite_) const;
+
+            /**
+             * A string's text or a binary's bytes
+             */
+            std::string_view bytes (const Slot &) const;
+
+            /**
+             * Every slot, the root last
+             */
+            const std::vector<Slot> & slots() const;
+
+            /**
+             * Raise the events the document was built from on [visitor_]
+             */
+            void visit (amqp::reader::IVisitor & visitor_) const;
+
+            std::string json() const;
+    };
+
+    /**
+     * Builds a [Document] from a reader's events. A value is held on a
+     * stack of slots until its container ends, when the container's
+     * children move together to the end of the document's slots.
+     *
+     * Names are numbered as they arrive, though a composite named as the
+     * last one at its depth was is checked against that one's type first,
+     * so the elements of a list of composites cost a comparison of each
+     * name rather than a lookup.
+     */
+    class Document::Builder : public amqp::reader::IVisitor {
+        private :
+            static constexpr uint32_t npos = UINT32_MAX;
+
+            struct Open {
+                size_t   slot;
+                size_t   fields;
+                uint32_t name;
+                uint32_t descriptor;
+
+                /**
+                 * The type of the last composite closed at this depth,
+                 * which the siblings in a list of them share, if this one
+                 * is named as it was
+                 */
+                uint32_t hint;
+            };
+
+            Document m_document;
+
+            concurrency::Interner * m_interner;
+
+            std::vector<Slot>     m_stack;
+            std::vector<Open>     m_open;
+            std::vector<uint32_t> m_fields;
+            std::vector<uint32_t> m_last;
+
+            std::unordered_map<std::string_view, uint32_t> m_interned;
+
+            /**
+             * The types with each name and descriptor, told apart by their
+             * fields only if a blob somehow has two that differ
+             */
+            std::map<std::pair<uint32_t, uint32_t>, std::vector<uint32_t>> m_types;
+
+            uint32_t intern (std::string_view);
+            uint32_t type (const Open &);
+
+            void open (Kind, uint32_t, uint32_t, uint32_t = npos);
+            Slot & close();
+
+        public :
+            /**
+             * Strings and names go through [interner_] if there is one
+             */
+            explicit Builder (concurrency::Interner * interner_ = nullptr);
+
+            /**
+             * The document built, leaving the builder empty
+             */
+            Document document();
+
+            void onCompositeBegin (std::string_view, std::string_view) override;
+            void onCompositeEnd() override;
+
+            void onField (std::string_view) override;
+
+            void onListBegin (size_t) override;
+            void onListEnd() override;
+
+            void onMapBegin (size_t) override;
+            void onMapEnd() override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onBool (bool) override;
+            void onDouble (double) override;
+            void onString (std::string_view) override;
+
+            /**
+             * Kept as bytes, a Corda blob among them being decoded only
+             * when the document is walked
+             */
+            void onBinary (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
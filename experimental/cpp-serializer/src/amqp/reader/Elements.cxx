@@ -0,0 +1,228 @@
+#include "Elements.h"
+
+#include <vector>
+#include <stdexcept>
+#include <string_view>
+#include <proton/codec.h>
+
+#include "concurrency/ThreadPool.h"
+#include "proton/DataPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Set while a thread reads elements from its copy of a collection, so
+     * a collection nested in one of them is read in place rather than
+     * being shared out again
+     */
+    thread_local bool inCopy { false };
+
+    struct CopyScope {
+        bool outer { inCopy };
+
+        CopyScope() { inCopy = true; }
+        ~CopyScope() { inCopy = outer; }
+    };
+
+    /**
+     * Put the value at [from_]'s cursor, and everything under it, after
+     * [to_]'s
+     */
+    void
+    copy (pn_data_t * to_, pn_data_t * from_) {
+        switch (pn_data_type (from_)) {
+            case PN_DESCRIBED :
+                pn_data_put_described (to_);
+                break;
+            case PN_LIST :
+                pn_data_put_list (to_);
+                break;
+            case PN_MAP :
+                pn_data_put_map (to_);
+                break;
+            case PN_ARRAY :
+                pn_data_put_array (
+                    to_,
+                    pn_data_is_array_described (from_),
+                    pn_data_get_array_type (from_));
+                break;
+            default :
+                pn_data_put_atom (to_, pn_data_get_atom (from_));
+                return;
+        }
+
+        pn_data_enter (from_);
+        pn_data_enter (to_);
+
+        while (pn_data_next (from_)) {
+            copy (to_, from_);
+        }
+
+        pn_data_exit (from_);
+        pn_data_exit (to_);
+    }
+
+    /**
+     * Encode [elements_] values starting from the current node, and no
+     * more of the tree, noting where each starts in the tree the encoding
+     * decodes to. The cursor's left on the last of them, as reading them
+     * in place would have done.
+     */
+    std::vector<char>
+    encode (
+        pn_data_t * data_,
+        size_t elements_,
+        std::vector<pn_handle_t> & starts_
+    ) {
+        auto elements = proton::DataPool::instance().acquire();
+
+        for (size_t i { 0 } ; i < elements_ ; ++i) {
+            copy (elements.get(), data_);
+
+            starts_[i] = pn_data_point (elements.get());
+
+            if (i + 1 < elements_) {
+                pn_data_next (data_);
+            }
+        }
+
+        std::vector<char> bytes (pn_data_encoded_size (elements.get()));
+
+        if (pn_data_encode (elements.get(), bytes.data(), bytes.size()) < 0) {
+            throw std::runtime_error ("Failed to re-encode AMQP elements");
+        }
+
+        return bytes;
+    }
+
+    void
+    decode (pn_data_t * data_, std::string_view bytes_) {
+        for (size_t i { 0 } ; i < bytes_.size() ; ) {
+            auto read = pn_data_decode (
+                    data_, bytes_.data() + i, bytes_.size() - i);
+
+            if (read <= 0) {
+                throw std::runtime_error ("Failed to decode AMQP tree copy");
+            }
+
+            i += read;
+        }
+    }
+
+    proton::DataPool::Lease
+    decode (const std::vector<char> & bytes_) {
+        auto data = proton::DataPool::instance().acquire();
+
+        decode (data.get(), { bytes_.data(), bytes_.size() });
+
+        return data;
+    }
+
+    /**
+     * Every thread taking part works from its own copy of the collection
+     */
+    void
+    fromCopies (
+        pn_data_t * data_,
+        size_t elements_,
+        const amqp::internal::reader::Reader & reader_,
+        const amqp::internal::reader::Reader::SchemaType & schema_,
+        size_t grain_,
+        std::vector<proton::DataPool::Lease> & copies_,
+        std::vector<uPtr<amqp::reader::IValue>> & values_
+    ) {
+        auto & pool = concurrency::ThreadPool::instance();
+
+        std::vector<pn_handle_t> starts (elements_);
+
+        auto bytes = encode (data_, elements_, starts);
+
+        pool.parallelFor (elements_, grain_,
+            [&](size_t participant_, size_t begin_, size_t end_) {
+                auto & copy = copies_[participant_];
+
+                if (!copy) {
+                    copy = decode (bytes);
+                }
+
+                CopyScope scope;
+
+                for (auto i = begin_ ; i < end_ ; ++i) {
+                    pn_data_restore (copy.get(), starts[i]);
+                    values_[i] = reader_.dump (copy.get(), schema_);
+                }
+            });
+    }
+
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+Elements::m_threshold { 512 }; // NOLINT
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+Elements::threshold() {
+    return m_threshold;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Elements::threshold (size_t threshold_) {
+    m_threshold = threshold_;
+}
+
+/******************************************************************************/
+
+sList<uPtr<amqp::reader::IValue>>
+amqp::internal::reader::
+Elements::dump (
+    pn_data_t * data_,
+    size_t elements_,
+    const Reader & reader_,
+    const Elements::SchemaType & schema_
+) {
+    sList<uPtr<amqp::reader::IValue>> read;
+
+    // nothing to share out, however low the threshold's been set
+    if (!elements_) {
+        return read;
+    }
+
+    auto & pool = concurrency::ThreadPool::instance();
+
+    if (elements_ < m_threshold || !pool.threads() || inCopy) {
+        for (size_t i { 0 } ; i < elements_ ; ++i) {
+            read.emplace_back (reader_.dump (data_, schema_));
+        }
+
+        return read;
+    }
+
+    /*
+     * Enough chunks that a participant arriving late or running slowly
+     * still leaves the others something to take
+     */
+    auto grain = std::max<size_t> (1, elements_ / (4 * pool.participants()));
+
+    std::vector<proton::DataPool::Lease> copies (pool.participants());
+    std::vector<uPtr<amqp::reader::IValue>> values (elements_);
+
+    fromCopies (data_, elements_, reader_, schema_, grain, copies, values);
+
+    for (auto & value : values) {
+        read.emplace_back (std::move (value));
+    }
+
+    return read;
+}
+
+/******************************************************************************/
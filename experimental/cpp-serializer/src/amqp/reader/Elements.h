@@ -0,0 +1,57 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+struct pn_data_t;
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Decoding of the elements of a list or array, every one of which is
+     * read by the same [Reader].
+     *
+     * Small collections are read in place. Past [threshold] elements they
+     * are shared out across the decoder's [concurrency::ThreadPool]. The
+     * tree can't be navigated from several threads at once, so the
+     * elements alone are copied out of it and encoded once, and each
+     * thread taking part decodes its own copy of them. Node handles are
+     * positions in a tree's pre-order, which a round trip through the
+     * encoder preserves, so where each element starts is noted once as
+     * it's copied and is valid in every copy. Collections nested in those
+     * elements are read in place by the thread reading the element.
+     */
+    class Elements {
+        public :
+            using SchemaType = Reader::SchemaType;
+
+        private :
+            static size_t m_threshold;
+
+        public :
+            static size_t threshold();
+
+            /**
+             * Set the smallest collection that will be decoded in parallel
+             */
+            static void threshold (size_t);
+
+            /**
+             * Read [elements_] values starting from the current node,
+             * returning them in order
+             */
+            static sList<uPtr<amqp::reader::IValue>> dump (
+                pn_data_t *,
+                size_t elements_,
+                const Reader &,
+                const SchemaType &);
+    };
+
+}
+
+/******************************************************************************/
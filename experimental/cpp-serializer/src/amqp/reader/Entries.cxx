@@ -0,0 +1,184 @@
+#include "Entries.h"
+
+#include <algorithm>
+#include <proton/codec.h>
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::reader::Entries;
+
+    void
+    join (std::string & out_, const Entries & entries_) {
+        out_ += "{ ";
+
+        for (size_t i { 0 } ; i < entries_.size() ; ++i) {
+            if (i) {
+                out_ += ", ";
+            }
+
+            entries_[i].dump (out_);
+        }
+
+        out_ += " }";
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Entries
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Entries::Entries()
+    : m_sorted (true)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::reader::Entries::Key
+amqp::internal::reader::
+Entries::key (pn_data_t * data_) {
+    switch (pn_data_type (data_)) {
+        case PN_BOOL :
+            return pn_data_get_bool (data_);
+        case PN_INT :
+            return pn_data_get_int (data_);
+        case PN_LONG :
+            return pn_data_get_long (data_);
+        case PN_DOUBLE :
+            return pn_data_get_double (data_);
+        case PN_STRING : {
+            auto bytes = pn_data_get_string (data_);
+            return std::string (bytes.start, bytes.size);
+        }
+        default :
+            return std::monostate { };
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Entries::reserve (size_t size_) {
+    m_entries.reserve (size_);
+    m_keys.reserve (size_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Entries::add (
+    Key key_,
+    uPtr<amqp::reader::IValue> dumpedKey_,
+    uPtr<amqp::reader::IValue> value_
+) {
+    m_sorted = m_sorted
+        && key_.index()
+        && (m_keys.empty() || m_keys.back() < key_);
+
+    if (m_index) {
+        m_index->emplace (key_, m_entries.size());
+    }
+
+    m_keys.emplace_back (std::move (key_));
+    m_entries.emplace_back (
+        std::make_unique<ValuePair> (std::move (dumpedKey_), std::move (value_)));
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+Entries::size() const {
+    return m_entries.size();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::ValuePair &
+amqp::internal::reader::
+Entries::operator[] (size_t i_) const {
+    return *m_entries[i_];
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Entries::sorted() const {
+    return m_sorted;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Entries::index() const {
+    if (m_index) {
+        return;
+    }
+
+    m_index = std::make_unique<std::unordered_map<Key, size_t>>();
+    m_index->reserve (m_keys.size());
+
+    // where a key repeats the first entry for it wins, as a scan would
+    for (size_t i { 0 } ; i < m_keys.size() ; ++i) {
+        if (m_keys[i].index()) {
+            m_index->emplace (m_keys[i], i);
+        }
+    }
+}
+
+/******************************************************************************/
+
+const amqp::reader::IValue *
+amqp::internal::reader::
+Entries::lookup (const Key & key_, Lookup lookup_) const {
+    if (lookup_ == sorted_e && m_sorted) {
+        auto it = std::lower_bound (m_keys.begin(), m_keys.end(), key_);
+
+        return it != m_keys.end() && *it == key_
+            ? &m_entries[it - m_keys.begin()]->value()
+            : nullptr;
+    }
+
+    index();
+
+    auto it = m_index->find (key_);
+
+    return it != m_index->end()
+        ? &m_entries[it->second]->value()
+        : nullptr;
+}
+
+/******************************************************************************
+ *
+ * Dumping, as the maps of values they replace did
+ *
+ ******************************************************************************/
+
+template<>
+void
+amqp::internal::reader::
+TypedSingle<amqp::internal::reader::Entries>::dump (std::string & out_) const {
+    join (out_, m_value);
+}
+
+/******************************************************************************/
+
+template<>
+void
+amqp::internal::reader::
+TypedPair<amqp::internal::reader::Entries>::dump (std::string & out_) const {
+    encoding::json::quote (out_, m_property);
+    out_ += " : ";
+    join (out_, m_value);
+}
+
+/******************************************************************************/
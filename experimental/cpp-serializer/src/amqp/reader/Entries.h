@@ -0,0 +1,152 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <variant>
+#include <limits>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+struct pn_data_t;
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The entries of a decoded map, in the order the blob holds them, each
+     * alongside its key as a typed value that can be looked up without
+     * dumping anything.
+     *
+     * Lookups go through a hash of the keys, built the first time one is
+     * asked for so a map that's only ever dumped never pays for it, or
+     * with [sorted_e] by a binary search of the keys as they are. Corda
+     * writes sorted maps in key order so for those the search needs no
+     * index at all. Where the keys turn out not to be in order a sorted
+     * lookup quietly uses the hash instead.
+     *
+     * Only primitive keys are typed, a key of any other type is held as
+     * [std::monostate] and can't be looked up. As with the rest of a
+     * decoded tree the first lookup isn't safe to race with another,
+     * call [index] first if it's to be shared between threads.
+     */
+    class Entries {
+        public :
+            using Key = std::variant<
+                std::monostate, bool, int32_t, int64_t, double, std::string>;
+
+            enum Lookup { hash_e, sorted_e };
+
+        private :
+            sVec<uPtr<ValuePair>> m_entries;
+            sVec<Key>             m_keys;
+            bool                  m_sorted;
+
+            mutable uPtr<std::unordered_map<Key, size_t>> m_index;
+
+            const amqp::reader::IValue * lookup (const Key &, Lookup) const;
+
+            /**
+             * Whether the integer [key_] can be held by a [T] without
+             * wrapping, an unsigned key above [T]'s range can't match any
+             * key a map holds
+             */
+            template<typename T, typename K>
+            static bool fits (K key_) {
+                if constexpr (std::is_signed_v<K>) {
+                    return key_ >= std::numeric_limits<T>::min()
+                        && key_ <= std::numeric_limits<T>::max();
+                } else {
+                    return key_ <= static_cast<std::make_unsigned_t<T>> (
+                        std::numeric_limits<T>::max());
+                }
+            }
+
+        public :
+            Entries();
+
+            /**
+             * The key under the cursor, which is left where it is for the
+             * key's reader to consume
+             */
+            static Key key (pn_data_t *);
+
+            void reserve (size_t);
+            void add (Key, uPtr<amqp::reader::IValue>, uPtr<amqp::reader::IValue>);
+
+            size_t size() const;
+            const ValuePair & operator[] (size_t) const;
+
+            decltype (m_entries.cbegin()) begin() const {
+                return m_entries.cbegin();
+            }
+
+            decltype (m_entries.cend()) end() const {
+                return m_entries.cend();
+            }
+
+            /**
+             * Whether every key is typed and each is greater than the last
+             */
+            bool sorted() const;
+
+            /**
+             * Build the hash of the keys now rather than on first lookup
+             */
+            void index() const;
+
+            /**
+             * The value held against [key_], null if there isn't one.
+             * Strings, string literals included, are looked up as strings
+             * and integers by value whatever their width.
+             */
+            template<typename K>
+            const amqp::reader::IValue * find (
+                const K & key_,
+                Lookup lookup_ = hash_e
+            ) const {
+                if constexpr (std::is_convertible_v<const K &, std::string_view>) {
+                    return lookup (Key { std::string (std::string_view (key_)) }, lookup_);
+                } else if constexpr (std::is_same_v<K, bool>) {
+                    return lookup (Key { key_ }, lookup_);
+                } else if constexpr (std::is_integral_v<K>) {
+                    const amqp::reader::IValue * rtn { nullptr };
+
+                    if (fits<int32_t> (key_)) {
+                        rtn = lookup (Key { static_cast<int32_t> (key_) }, lookup_);
+                    }
+
+                    if (!rtn && fits<int64_t> (key_)) {
+                        rtn = lookup (Key { static_cast<int64_t> (key_) }, lookup_);
+                    }
+
+                    return rtn;
+                } else {
+                    return lookup (Key { static_cast<double> (key_) }, lookup_);
+                }
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+template<>
+void
+amqp::internal::reader::
+TypedSingle<amqp::internal::reader::Entries>::dump (std::string &) const;
+
+template<>
+void
+amqp::internal::reader::
+TypedPair<amqp::internal::reader::Entries>::dump (std::string &) const;
+
+/******************************************************************************/
@@ -0,0 +1,228 @@
+#include "Graph.h"
+
+#include <mutex>
+
+/******************************************************************************/
+
+/**
+ * Stands in for the arena while working out how large it needs to be,
+ * counting each allocation at its worst case padding
+ */
+class amqp::internal::reader::
+Graph::Measure : public std::pmr::memory_resource {
+    private :
+        std::pmr::monotonic_buffer_resource m_upstream;
+        size_t                              m_bytes { 0 };
+
+        void *
+        do_allocate (size_t bytes_, size_t alignment_) override {
+            m_bytes += bytes_ + alignment_ - 1;
+            return m_upstream.allocate (bytes_, alignment_);
+        }
+
+        void
+        do_deallocate (void *, size_t, size_t) override { }
+
+        bool
+        do_is_equal (const std::pmr::memory_resource & other_)
+            const noexcept override
+        {
+            return this == &other_;
+        }
+
+    public :
+        size_t bytes() const { return m_bytes; }
+};
+
+/******************************************************************************/
+
+/**
+ * A graph the size of [capacity_], or if that's zero one that measures
+ * what it needs instead of using an arena at all
+ */
+amqp::internal::reader::
+Graph::Graph (
+    const spStrMap_t<Reader> & byType_,
+    const spStrMap_t<Reader> & byDescriptor_,
+    size_t capacity_
+) : m_capacity { capacity_ } {
+    if (capacity_) {
+        m_arena = std::make_unique<std::byte[]> (capacity_);
+        m_resource = std::make_unique<std::pmr::monotonic_buffer_resource> (
+                m_arena.get(), capacity_, std::pmr::null_memory_resource());
+    } else {
+        m_resource = std::make_unique<Measure>();
+    }
+
+    build (byType_, byDescriptor_);
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+Graph::~Graph() {
+    for (auto it = m_nodes.rbegin() ; it != m_nodes.rend() ; ++it) {
+        (*it)->~Reader();
+    }
+}
+
+/******************************************************************************/
+
+sPtr<amqp::internal::reader::Graph>
+amqp::internal::reader::
+Graph::freeze (
+    const spStrMap_t<Reader> & byType_,
+    const spStrMap_t<Reader> & byDescriptor_,
+    Extend extend_
+) {
+    size_t capacity;
+
+    {
+        Graph measure (byType_, byDescriptor_, 0);
+        capacity = dynamic_cast<Measure &> (*measure.m_resource).bytes();
+    }
+
+    auto rtn = sPtr<Graph> (new Graph (byType_, byDescriptor_, capacity));
+    rtn->m_extend = std::move (extend_);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Graph::build (
+    const spStrMap_t<Reader> & byType_,
+    const spStrMap_t<Reader> & byDescriptor_
+) {
+    for (const auto & reader : byType_) {
+        m_byType[reader.first] = link (reader.second.get());
+    }
+
+    for (const auto & reader : byDescriptor_) {
+        m_byDescriptor[reader.first] = link (reader.second.get());
+    }
+
+    // only needed while copying
+    m_frozen.clear();
+}
+
+/******************************************************************************/
+
+std::pmr::memory_resource *
+amqp::internal::reader::
+Graph::resource() const {
+    return m_resource.get();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+Graph::link (const Reader * reader_) {
+    if (!reader_) {
+        return nullptr;
+    }
+
+    auto it = m_frozen.find (reader_);
+
+    if (it != m_frozen.end()) {
+        return it->second;
+    }
+
+    auto frozen = reader_->freeze (*this);
+    m_frozen[reader_] = frozen;
+
+    return frozen;
+}
+
+/******************************************************************************/
+
+sPtr<amqp::internal::reader::IReader>
+amqp::internal::reader::
+Graph::byType (std::string_view type_) const {
+    auto it = m_byType.find (type_);
+
+    if (it == m_byType.end()) {
+        return nullptr;
+    }
+
+    return sPtr<IReader> (
+        shared_from_this(), const_cast<Reader *> (it->second));
+}
+
+/******************************************************************************/
+
+sPtr<amqp::internal::reader::IReader>
+amqp::internal::reader::
+Graph::byDescriptor (std::string_view descriptor_) const {
+    auto reader = find (descriptor_);
+
+    if (!reader) {
+        return nullptr;
+    }
+
+    return sPtr<IReader> (
+        shared_from_this(), const_cast<Reader *> (reader));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+Graph::find (std::string_view descriptor_) const {
+    auto it = m_byDescriptor.find (descriptor_);
+
+    if (it != m_byDescriptor.end()) {
+        return it->second;
+    }
+
+    if (!m_extend) {
+        return nullptr;
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+        auto extension = m_extensions.find (descriptor_);
+
+        if (extension != m_extensions.end()) {
+            return extension->second ? extension->second->find (descriptor_) : nullptr;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock (m_mutex);
+
+    // a type the schema doesn't have is remembered as such
+    auto [extension, added] = m_extensions.try_emplace (std::string (descriptor_));
+
+    if (added) {
+        extension->second = m_extend (descriptor_);
+    }
+
+    return extension->second ? extension->second->find (descriptor_) : nullptr;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Graph::contains (const IReader * reader_) const {
+    auto begin = reinterpret_cast<const std::byte *> (m_arena.get());
+    auto at = reinterpret_cast<const std::byte *> (
+            dynamic_cast<const void *> (reader_));
+
+    return std::less_equal<> () (begin, at)
+        && std::less<> () (at, begin + m_capacity);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+Graph::bytes() const {
+    return m_capacity;
+}
+
+/******************************************************************************/
@@ -0,0 +1,125 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <string_view>
+#include <shared_mutex>
+#include <memory_resource>
+
+#include "types.h"
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The readers a [CompositeFactory] built for a schema, frozen into a
+     * single allocation. Each reader is copied into it with its children
+     * replaced by raw pointers to their own copies, and anything the copy
+     * holds that can take its allocator from [resource], a composite's
+     * per-field table for instance, is laid out alongside it. Nothing is
+     * added or removed once the graph is built.
+     *
+     * The readers handed out share ownership of the graph, so it lives for
+     * as long as any of them are in use.
+     *
+     * A graph frozen from only the readers a blob's root class reaches
+     * can be given an [Extend] for the types it left out. The first time
+     * one of them is asked for, a polymorphic property meeting it say,
+     * its readers are built and frozen into a graph of their own that
+     * this one holds on to.
+     */
+    class Graph : public std::enable_shared_from_this<Graph> {
+        public :
+            using Extend = std::function<sPtr<Graph> (std::string_view)>;
+
+        private :
+            class Measure;
+
+            std::unique_ptr<std::byte[]>                      m_arena;
+            size_t                                            m_capacity;
+            uPtr<std::pmr::memory_resource>                   m_resource;
+
+            std::vector<Reader *>                             m_nodes;
+            std::map<const Reader *, const Reader *>          m_frozen;
+            std::map<std::string, const Reader *, std::less<>> m_byType;
+            std::map<std::string, const Reader *, std::less<>> m_byDescriptor;
+
+            Extend                                                     m_extend;
+            mutable std::shared_mutex                                  m_mutex;
+            mutable std::map<std::string, sPtr<Graph>, std::less<>>    m_extensions;
+
+            Graph (const spStrMap_t<Reader> &, const spStrMap_t<Reader> &, size_t);
+
+            void build (const spStrMap_t<Reader> &, const spStrMap_t<Reader> &);
+
+        public :
+            static sPtr<Graph> freeze (
+                const spStrMap_t<Reader> & byType_,
+                const spStrMap_t<Reader> & byDescriptor_,
+                Extend extend_ = nullptr);
+
+            ~Graph();
+
+            Graph (const Graph &) = delete;
+            Graph & operator = (const Graph &) = delete;
+
+            /**
+             * Where the copies put anything they allocate
+             */
+            std::pmr::memory_resource * resource() const;
+
+            /**
+             * Construct a reader in the graph
+             */
+            template<typename T, typename ... Args>
+            T * make (Args && ... args_);
+
+            /**
+             * The copy of [reader_] in this graph, copying it on first use
+             */
+            const Reader * link (const Reader * reader_);
+
+            sPtr<IReader> byType (std::string_view) const;
+            sPtr<IReader> byDescriptor (std::string_view) const;
+
+            /**
+             * The reader for [descriptor_] without taking a share of the
+             * graph, for readers within it, extending the graph with it
+             * if need be
+             */
+            const Reader * find (std::string_view descriptor_) const;
+
+            /**
+             * Whether [reader_] lives in the graph's allocation
+             */
+            bool contains (const IReader * reader_) const;
+
+            /**
+             * The graph's arena, not counting any it's been extended with
+             */
+            size_t bytes() const;
+    };
+
+}
+
+/******************************************************************************/
+
+template<typename T, typename ... Args>
+T *
+amqp::internal::reader::
+Graph::make (Args && ... args_) {
+    auto node = new (m_resource->allocate (sizeof (T), alignof (T)))
+        T (std::forward<Args> (args_)...);
+
+    m_nodes.push_back (node);
+
+    return node;
+}
+
+/******************************************************************************/
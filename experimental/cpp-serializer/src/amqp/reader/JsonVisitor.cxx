@@ -0,0 +1,221 @@
+#include "JsonVisitor.h"
+
+#include "Nested.h"
+#include "encoding/Json.h"
+#include "property-readers/BinaryPropertyReader.h"
+
+/******************************************************************************/
+
+amqp::internal::reader::
+JsonVisitor::JsonVisitor()
+    : m_out (1)
+{ }
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+JsonVisitor::str() const {
+    return m_out.front();
+}
+
+/******************************************************************************/
+
+/**
+ * Before any value, separating it from the one before and, if it's a
+ * map's key, diverting it until it's complete
+ */
+void
+amqp::internal::reader::
+JsonVisitor::begin() {
+    if (m_frames.empty()) {
+        return;
+    }
+
+    auto & frame = m_frames.back();
+
+    switch (frame.scope) {
+        case list_e :
+            if (frame.written++) {
+                out() += ", ";
+            }
+            break;
+        case map_e :
+            if (frame.written++ % 2 == 0) {
+                if (frame.written > 1) {
+                    out() += ", ";
+                }
+
+                m_out.emplace_back();
+            }
+            break;
+        case composite_e :
+            // [onField] has already separated it
+            break;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::end() {
+    if (m_frames.empty()) {
+        return;
+    }
+
+    auto & frame = m_frames.back();
+
+    if (frame.scope == map_e && frame.written % 2 == 1) {
+        auto key = std::move (m_out.back());
+        m_out.pop_back();
+
+        if (key.empty() || key.front() != '"') {
+            encoding::json::quote (out(), key);
+        } else {
+            out() += key;
+        }
+
+        out() += " : ";
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onCompositeBegin (std::string_view, std::string_view) {
+    begin();
+    out() += "{ ";
+    m_frames.push_back ({ composite_e, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onCompositeEnd() {
+    m_frames.pop_back();
+    out() += " }";
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onField (std::string_view name_) {
+    if (m_frames.back().written++) {
+        out() += ", ";
+    }
+
+    encoding::json::quote (out(), name_);
+    out() += " : ";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onListBegin (size_t) {
+    begin();
+    out() += "[ ";
+    m_frames.push_back ({ list_e, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onListEnd() {
+    m_frames.pop_back();
+    out() += " ]";
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onMapBegin (size_t) {
+    begin();
+    out() += "{ ";
+    m_frames.push_back ({ map_e, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onMapEnd() {
+    m_frames.pop_back();
+    out() += " }";
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onInt (int32_t value_) {
+    begin();
+    encoding::json::number (out(), value_);
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onLong (int64_t value_) {
+    begin();
+    encoding::json::number (out(), value_);
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onBool (bool value_) {
+    begin();
+    out() += std::to_string (value_);
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onDouble (double value_) {
+    begin();
+    encoding::json::number (out(), value_);
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onString (std::string_view value_) {
+    begin();
+    encoding::json::quote (out(), value_);
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonVisitor::onBinary (std::string_view value_) {
+    if (Nested::is (value_)) {
+        Nested::visit (value_, *this);
+        return;
+    }
+
+    begin();
+    out() += BinaryPropertyReader::json (value_);
+    end();
+}
+
+/******************************************************************************/
@@ -0,0 +1,74 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The JSON a reader's [IValue]s would dump to, written straight from
+     * its events instead. The output is character for character what the
+     * value tree produces, including its rendering of map keys that
+     * aren't strings as the string of their JSON.
+     */
+    class JsonVisitor : public amqp::reader::IVisitor {
+        private :
+            enum Scope { composite_e, list_e, map_e };
+
+            struct Frame {
+                Scope  scope;
+                size_t written;
+            };
+
+            std::vector<Frame>       m_frames;
+
+            /**
+             * What's being written to is the last of these, a map's key
+             * being written to one of its own until it's known whether
+             * it needs quoting
+             */
+            std::vector<std::string> m_out;
+
+            std::string & out() { return m_out.back(); }
+
+            void begin();
+            void end();
+
+        public :
+            JsonVisitor();
+
+            const std::string & str() const;
+
+            void onCompositeBegin (std::string_view, std::string_view) override;
+            void onCompositeEnd() override;
+
+            void onField (std::string_view) override;
+
+            void onListBegin (size_t) override;
+            void onListEnd() override;
+
+            void onMapBegin (size_t) override;
+            void onMapEnd() override;
+
+            void onInt (int32_t) override;
+            void onLong (int64_t) override;
+            void onBool (bool) override;
+            void onDouble (double) override;
+            void onString (std::string_view) override;
+
+            /**
+             * Bytes that are a Corda blob are written as the object they
+             * hold, walked with this visitor as they arrive
+             */
+            void onBinary (std::string_view) override;
+    };
+
+}
+
+/******************************************************************************/
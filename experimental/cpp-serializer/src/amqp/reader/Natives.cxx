@@ -0,0 +1,234 @@
+#include "Natives.h"
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <stdexcept>
+#include <shared_mutex>
+
+#include "encoding/Hex.h"
+#include "encoding/Iso8601.h"
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using Format = amqp::internal::reader::Natives::Format;
+
+    [[noreturn]] void
+    malformed (const pn_atom_t * atoms_, size_t count_) {
+        throw std::runtime_error (
+            "Unexpected " + std::to_string (count_) + " value native starting "
+                + (count_ ? pn_type_name (atoms_[0].type) : "empty"));
+    }
+
+    void
+    expect (const pn_atom_t * atoms_, size_t count_, size_t expected_) {
+        if (count_ != expected_) {
+            malformed (atoms_, count_);
+        }
+    }
+
+    /**
+     * Java's byte, short, int and long, and their boxes, whichever of
+     * them a proxy's property was written as
+     */
+    int64_t
+    integer (const pn_atom_t & atom_) {
+        switch (atom_.type) {
+            case PN_BYTE :  return atom_.u.as_byte;
+            case PN_UBYTE : return atom_.u.as_ubyte;
+            case PN_SHORT : return atom_.u.as_short;
+            case PN_USHORT : return atom_.u.as_ushort;
+            case PN_INT :   return atom_.u.as_int;
+            case PN_UINT :  return atom_.u.as_uint;
+            case PN_LONG :  return atom_.u.as_long;
+            default :
+                malformed (&atom_, 1);
+        }
+    }
+
+    std::string_view
+    bytes (const pn_atom_t & atom_) {
+        switch (atom_.type) {
+            case PN_STRING :
+            case PN_SYMBOL :
+            case PN_BINARY :
+                return { atom_.u.as_bytes.start, atom_.u.as_bytes.size };
+            default :
+                malformed (&atom_, 1);
+        }
+    }
+
+    /**************************************************************************/
+
+    void
+    timestamp (std::string & out_, const pn_atom_t * atoms_, size_t count_) {
+        expect (atoms_, count_, 1);
+
+        if (atoms_[0].type != PN_TIMESTAMP) {
+            malformed (atoms_, count_);
+        }
+
+        encoding::iso8601::millis (out_, atoms_[0].u.as_timestamp);
+    }
+
+    void
+    uuid (std::string & out_, const pn_atom_t * atoms_, size_t count_) {
+        expect (atoms_, count_, 1);
+
+        if (atoms_[0].type != PN_UUID) {
+            malformed (atoms_, count_);
+        }
+
+        encoding::hex::uuid (out_, atoms_[0].u.as_uuid.bytes);
+    }
+
+    /**
+     * Instant's proxy, its epochSeconds and nanos
+     */
+    void
+    instant (std::string & out_, const pn_atom_t * atoms_, size_t count_) {
+        expect (atoms_, count_, 2);
+
+        encoding::iso8601::instant (out_,
+            integer (atoms_[0]),
+            static_cast<int32_t>(integer (atoms_[1])));
+    }
+
+    /**
+     * LocalDate's proxy, its year, month and day
+     */
+    void
+    date (std::string & out_, const pn_atom_t * atoms_, size_t count_) {
+        expect (atoms_, count_, 3);
+
+        encoding::iso8601::date (out_,
+            integer (atoms_[0]),
+            static_cast<int>(integer (atoms_[1])),
+            static_cast<int>(integer (atoms_[2])));
+    }
+
+    /**
+     * LocalTime's proxy, its hour, minute, second and nano
+     */
+    void
+    time (std::string & out_, const pn_atom_t * atoms_, size_t count_) {
+        expect (atoms_, count_, 4);
+
+        encoding::iso8601::time (out_,
+            static_cast<int>(integer (atoms_[0])),
+            static_cast<int>(integer (atoms_[1])),
+            static_cast<int>(integer (atoms_[2])),
+            static_cast<int32_t>(integer (atoms_[3])));
+    }
+
+    /**
+     * Anything written as its string form
+     */
+    void
+    text (std::string & out_, const pn_atom_t * atoms_, size_t count_) {
+        expect (atoms_, count_, 1);
+
+        out_ += bytes (atoms_[0]);
+    }
+
+    /**
+     * Anything written as bytes, in the upper case hex Corda prints them
+     * in
+     */
+    void
+    hex (std::string & out_, const pn_atom_t * atoms_, size_t count_) {
+        expect (atoms_, count_, 1);
+
+        auto bytes = ::bytes (atoms_[0]);
+        encoding::hex::encode (out_, bytes.data(), bytes.size());
+    }
+
+    /**************************************************************************/
+
+    std::shared_mutex mutex;
+
+    std::map<std::string, Format> & natives() {
+        static std::map<std::string, Format> rtn { // NOLINT
+            { "timestamp", timestamp },
+            { "uuid", uuid },
+            { "string", text },
+            { "binary", hex },
+            { "java.time.Instant", instant },
+            { "java.time.LocalDate", date },
+            { "java.time.LocalTime", time },
+            { "java.math.BigDecimal", text },
+            { "java.math.BigInteger", text },
+            { "java.util.Currency", text },
+            { "java.security.PublicKey", hex }
+        };
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Natives::add (const std::string & key_, Format format_) {
+    std::unique_lock<std::shared_mutex> lock (mutex);
+
+    natives()[key_] = format_;
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Natives::Format
+amqp::internal::reader::
+Natives::find (const std::string & name_, const std::string & descriptor_) {
+    std::shared_lock<std::shared_mutex> lock (mutex);
+
+    const auto & map = natives();
+
+    auto it = map.find (name_);
+
+    if (it == map.end() && !descriptor_.empty()) {
+        it = map.find (descriptor_);
+    }
+
+    return it == map.end() ? nullptr : it->second;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Natives::format (std::string & out_, Format format_, pn_data_t * data_) {
+    std::array<pn_atom_t, arity> atoms;
+    size_t count { 0 };
+
+    if (pn_data_type (data_) != PN_DESCRIBED) {
+        atoms[count++] = proton::readAndNext<pn_atom_t> (data_);
+    } else {
+        proton::auto_next an (data_);
+        proton::auto_enter ae (data_, true);
+
+        if (pn_data_type (data_) == PN_LIST) {
+            proton::auto_list_enter ale (data_, true);
+
+            if (ale.elements() > atoms.size()) {
+                throw std::runtime_error (
+                    "Native of " + std::to_string (ale.elements()) + " values");
+            }
+
+            for ( ; count < ale.elements() ; ++count) {
+                atoms[count] = proton::readAndNext<pn_atom_t> (data_);
+            }
+        } else {
+            atoms[count++] = proton::readAndNext<pn_atom_t> (data_);
+        }
+    }
+
+    format_ (out_, atoms.data(), count);
+}
+
+/******************************************************************************/
@@ -0,0 +1,68 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+
+#include <proton/codec.h>
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Decoders for the values Corda writes through custom serializers
+     * rather than as plain composites of their properties, keyed by type
+     * name or descriptor and consulted by the [CompositeFactory] before it
+     * builds a generic reader for a type. Each prints its value as the
+     * JVM's [toString] would and the readers present that as a string.
+     *
+     * Registered from the start are the AMQP timestamp and uuid, what
+     * java.util.Date and java.util.UUID are written as, the java.time
+     * Instant, LocalDate and LocalTime proxies, BigDecimal, BigInteger and
+     * Currency, written as strings, and PublicKey, written as its encoded
+     * bytes. Any other type written as a described string or binary is
+     * read with the decoder for that primitive.
+     */
+    class Natives {
+        public :
+            /**
+             * Append the text of a value to [out_] given the primitives it
+             * was written as, either the one primitive, described or not,
+             * or the elements of a described list in order. Throws if they
+             * aren't what the type is written as.
+             */
+            using Format = void (*)(
+                std::string & out_, const pn_atom_t * atoms_, size_t count_);
+
+            /**
+             * At most this many elements of a described list are handed to
+             * a [Format]
+             */
+            static constexpr size_t arity { 8 };
+
+            /**
+             * Decode values of the type named, or described, by [key_] with
+             * [format_], replacing any decoder it had
+             */
+            static void add (const std::string & key_, Format format_);
+
+            /**
+             * The decoder for the type named [name_] or, failing that,
+             * described by [descriptor_], null if there's neither
+             */
+            static Format find (
+                const std::string & name_,
+                const std::string & descriptor_ = "");
+
+            /**
+             * Read the value at the tree's cursor with [format_], appending
+             * its text to [out_] and moving past it
+             */
+            static void format (std::string & out_, Format format_, pn_data_t *);
+    };
+
+}
+
+/******************************************************************************/
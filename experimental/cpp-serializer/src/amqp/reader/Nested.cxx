@@ -0,0 +1,141 @@
+#include "Nested.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include <proton/codec.h>
+
+#include "Graph.h"
+#include "concurrency/Cache.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/tape/Sections.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "proton/DataPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    /**
+     * A schema and the readers built from it
+     */
+    struct Readers {
+        uPtr<schema::Schema>  schema;
+        sPtr<reader::Graph>   graph;
+    };
+
+    /**
+     * The readers for the schema in [section_], building them only if no
+     * recent nested blob has carried the same bytes. Only those
+     * [descriptor_]'s class reaches are built up front, the graph building
+     * any others a later blob of the same schema asks for.
+     */
+    sPtr<const Readers>
+    readers (std::string_view section_, std::string_view descriptor_) {
+        static concurrency::Cache<Readers> built (256);
+
+        return built.get (section_, [section_, descriptor_]() -> sPtr<const Readers> {
+            auto rtn = std::make_shared<Readers>();
+
+            rtn->schema = tape::schema (section_);
+
+            CompositeFactory cf;
+            cf.process (*rtn->schema, std::string (descriptor_));
+
+            rtn->graph = cf.freeze();
+
+            return rtn;
+        });
+    }
+
+    /**
+     * Decode the blob's object alone and hand [read_] its reader with the
+     * tree's cursor on it
+     */
+    template<typename Read>
+    auto
+    read (std::string_view bytes_, Read && read_) {
+        if (!reader::Nested::is (bytes_)) {
+            throw std::runtime_error ("Not a Corda blob");
+        }
+
+        auto header = amqp::AMQP_HEADER.size() + 1;
+
+        auto sections = tape::sections (
+            bytes_.data() + header, bytes_.size() - header);
+
+        auto cached = readers (sections.schema, sections.descriptor);
+        auto reader = cached->graph->byDescriptor (sections.descriptor);
+
+        if (!reader) {
+            throw std::runtime_error (
+                "No reader for descriptor " + std::string (sections.descriptor));
+        }
+
+        auto data = proton::DataPool::instance().acquire();
+
+        auto decoded = pn_data_decode (
+            data.get(), sections.object.data(), sections.object.size());
+
+        if (decoded != static_cast<ssize_t>(sections.object.size())) {
+            throw std::runtime_error ("Failed to decode nested blob");
+        }
+
+        pn_data_rewind (data.get());
+        pn_data_next (data.get());
+
+        return read_ (*reader, data.get(), *cached->schema);
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Nested::is (std::string_view bytes_) {
+    const auto & magic = amqp::AMQP_HEADER;
+
+    return bytes_.size() > magic.size()
+        && bytes_.compare (0, magic.size(), magic.data(), magic.size()) == 0
+        && bytes_[magic.size()] == amqp::DATA_AND_STOP;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+Nested::dump (const std::string & name_, std::string_view bytes_) {
+    return read (bytes_,
+        [&name_](const auto & reader_, pn_data_t * data_, const auto & schema_) {
+            return reader_.dump (name_, data_, schema_);
+        });
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+Nested::dump (std::string_view bytes_) {
+    return read (bytes_,
+        [](const auto & reader_, pn_data_t * data_, const auto & schema_) {
+            return reader_.dump (data_, schema_);
+        });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Nested::visit (std::string_view bytes_, amqp::reader::IVisitor & visitor_) {
+    read (bytes_,
+        [&visitor_](const auto & reader_, pn_data_t * data_, const auto & schema_) {
+            reader_.visit (data_, schema_, visitor_);
+        });
+}
+
+/******************************************************************************/
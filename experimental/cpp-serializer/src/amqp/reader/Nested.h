@@ -0,0 +1,55 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <string_view>
+
+#include "types.h"
+#include "amqp/reader/IReader.h"
+
+/******************************************************************************/
+
+namespace amqp::reader {
+    class IVisitor;
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A Corda blob carried in a binary property of another, as each of a
+     * transaction's components is and as a signed transaction's wire
+     * transaction is. Its bytes are read as a blob in their own right,
+     * Corda header and all, against the schema they carry.
+     *
+     * Readers are built once for each distinct schema section seen and
+     * shared by every nested blob carrying the same bytes, so a million
+     * components written from a handful of classes parse a handful of
+     * schemas. Only the last few hundred sections' readers are kept.
+     */
+    class Nested {
+        public :
+            /**
+             * Whether [bytes_] start with the Corda header and an encoding
+             * we can read
+             */
+            static bool is (std::string_view bytes_);
+
+            static uPtr<amqp::reader::IValue> dump (
+                const std::string & name_,
+                std::string_view bytes_);
+
+            static uPtr<amqp::reader::IValue> dump (std::string_view bytes_);
+
+            /**
+             * Walk the blob's object, raising events on [visitor_] as if
+             * the object stood where its bytes do
+             */
+            static void visit (std::string_view bytes_, amqp::reader::IVisitor &);
+    };
+
+}
+
+/******************************************************************************/
@@ -5,10 +5,13 @@
 #include "amqp/reader/property-readers/LongPropertyReader.h"
 #include "amqp/reader/property-readers/StringPropertyReader.h"
 #include "amqp/reader/property-readers/DoublePropertyReader.h"
+#include "amqp/reader/property-readers/BinaryPropertyReader.h"
+#include "amqp/reader/property-readers/NativePropertyReader.h"
 
 #include <map>
 #include <string>
 #include <iostream>
+#include <stdexcept>
 #include <functional>
 
 #include <proton/codec.h>
@@ -49,9 +52,33 @@ namespace {
             "double", []() -> std::shared_ptr<PropertyReader> {
                 return std::make_shared<DoublePropertyReader> ();
             }
+        },
+        {
+            "binary", []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<BinaryPropertyReader> ();
+            }
         }
     };
 
+    /**
+     * The primitives we read directly and, failing them, those with a
+     * decoder in [Natives]
+     */
+    std::shared_ptr<amqp::internal::reader::PropertyReader>
+    forType (const std::string & type_) {
+        auto it = propertyMap.find (type_);
+
+        if (it != propertyMap.end()) {
+            return it->second();
+        }
+
+        if (auto format = Natives::find (type_)) {
+            return std::make_shared<NativePropertyReader> (type_, format);
+        }
+
+        throw std::runtime_error ("No reader for primitive " + type_);
+    }
+
 }
 
 /******************************************************************************
@@ -63,7 +90,7 @@ namespace {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const FieldPtr & field_) {
-    return propertyMap[field_->type()]();
+    return forType (field_->type());
 }
 
 /******************************************************************************/
@@ -71,7 +98,7 @@ PropertyReader::make (const FieldPtr & field_) {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const std::string & type_) {
-    return propertyMap[type_]();
+    return forType (type_);
 }
 
 /******************************************************************************/
@@ -79,7 +106,7 @@ PropertyReader::make (const std::string & type_) {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const internal::schema::Field & field_) {
-    return propertyMap[field_.type()]();
+    return forType (field_.type());
 }
 
 /******************************************************************************/
@@ -1,88 +1,47 @@
 #include "Reader.h"
 
 #include <memory>
-#include <sstream>
 
 /******************************************************************************/
 
 namespace {
 
-    struct AutoMap {
-        std::stringstream & m_stream;
-
-        AutoMap (
-                const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : { ";
-        }
-
-        explicit AutoMap (std::stringstream & stream_)
-            : m_stream (stream_)
-        {
-            m_stream << "{ ";
-        }
-
-        ~AutoMap() {
-            m_stream << " }";
-        }
-    };
-
-    struct AutoList {
-        std::stringstream & m_stream;
-
-        AutoList (
-                const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : [ ";
-        }
-
-        explicit AutoList (std::stringstream & stream_)
-            : m_stream (stream_)
-        {
-            m_stream << "[ ";
-        }
-
-        ~AutoList() {
-            m_stream << " ]";
-        }
-    };
-
-    template<class Auto, class T>
-    std::string
-    dumpPair (const std::string & name_, const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (name_, rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
+    /**
+     * Append the dumps of [begin_, end_) to [out_] as a JSON object or
+     * array, [open_] being "{" or "[", each child writing straight into
+     * the buffer
+     */
+    template<class T>
+    void
+    dumpSingle (std::string & out_, char open_, const T & begin_, const T & end_) {
+        out_ += open_;
+        out_ += ' ';
+
+        for (auto it (begin_) ; it != end_ ; ++it) {
+            if (it != begin_) {
+                out_ += ", ";
             }
+
+            (*it)->dump (out_);
         }
 
-        return rtn.str();
+        out_ += ' ';
+        out_ += open_ == '{' ? '}' : ']';
     }
 
-    template<class Auto, class T>
-    std::string
-    dumpSingle (const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
-            }
-        }
-
-        return rtn.str();
+    template<class T>
+    void
+    dumpPair (
+        std::string & out_,
+        const std::string & name_,
+        char open_,
+        const T & begin_,
+        const T & end_
+    ) {
+        encoding::json::quote (out_, name_);
+        out_ += " : ";
+
+        dumpSingle (out_, open_, begin_, end_);
     }
 
 }
@@ -93,14 +52,26 @@ namespace {
  *
  ******************************************************************************/
 
-std::string
+/**
+ * JSON only allows strings as object keys, anything else, a number for
+ * example, is emitted as the string of its JSON representation. A dumped
+ * value that starts with a quote is already a string.
+ */
+void
 amqp::internal::reader::
-ValuePair::dump() const {
-    std::stringstream ss;
+ValuePair::dump (std::string & out_) const {
+    auto key = out_.size();
 
-    ss << m_key->dump() << " : " << m_value->dump();
+    m_key->dump (out_);
+
+    if (key == out_.size() || out_[key] != '"') {
+        auto unquoted = out_.substr (key);
+        out_.resize (key);
+        encoding::json::quote (out_, unquoted);
+    }
 
-    return ss.str();
+    out_ += " : ";
+    m_value->dump (out_);
 }
 
 /******************************************************************************
@@ -110,31 +81,31 @@ ValuePair::dump() const {
  ******************************************************************************/
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump (std::string & out_) const {
+    ::dumpPair (out_, m_property, '{', m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump (std::string & out_) const {
+    ::dumpPair (out_, m_property, '{', m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump (std::string & out_) const {
+    ::dumpPair (out_, m_property, '{', m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpPair<AutoList> (m_property, m_value.begin(), m_value.end());
+TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump (std::string & out_) const {
+    ::dumpPair (out_, m_property, '[', m_value.begin(), m_value.end());
 }
 
 /******************************************************************************
@@ -144,31 +115,31 @@ TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const {
  ******************************************************************************/
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpSingle<AutoList> (m_value.begin(), m_value.end());
+TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump (std::string & out_) const {
+    ::dumpSingle (out_, '[', m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpSingle<AutoMap> (m_value.begin(), m_value.end());
+TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump (std::string & out_) const {
+    ::dumpSingle (out_, '{', m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const {
-    return ::dumpSingle<AutoList> (m_value.begin(), m_value.end());
+TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump (std::string & out_) const {
+    ::dumpSingle (out_, '[', m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const {
-    return ::dumpSingle<AutoMap> (m_value.begin(), m_value.end());
+TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump (std::string & out_) const {
+    ::dumpSingle (out_, '{', m_value.begin(), m_value.end());
 }
 
 /******************************************************************************/
@@ -8,6 +8,7 @@
 #include <vector>
 #include <memory>
 
+#include "encoding/Json.h"
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/reader/IReader.h"
 
@@ -17,7 +18,13 @@ namespace amqp::internal::reader {
 
     class Value : public amqp::reader::IValue {
         public :
-            std::string dump() const override = 0;
+            std::string dump() const override {
+                std::string rtn;
+                dump (rtn);
+                return rtn;
+            }
+
+            void dump (std::string &) const override = 0;
 
             ~Value() override = default;
     };
@@ -37,7 +44,7 @@ namespace amqp::internal::reader {
      */
     class Single : public Value {
         public :
-            std::string dump() const override = 0;
+            using Value::dump;
 
             ~Single() override = default;
     };
@@ -67,13 +74,15 @@ namespace amqp::internal::reader {
                 return m_value;
             }
 
-            std::string dump() const override;
+            using Single::dump;
+            void dump (std::string &) const override;
     };
 
     /*
      * A Pair represents an association between a property and
      * the value of the property, i.e. a : b where property
-     * a has value b
+     * a has value b. The property is emitted as a JSON string,
+     * the value is expected to already be valid JSON
      */
     class Pair : public Value {
         protected :
@@ -91,7 +100,7 @@ namespace amqp::internal::reader {
                 : m_property (std::move (pair_.m_property))
             { }
 
-            std::string dump() const override = 0;
+            using Value::dump;
     };
 
 
@@ -120,7 +129,8 @@ namespace amqp::internal::reader {
                 return m_value;
             }
 
-            std::string dump() const override;
+            using Pair::dump;
+            void dump (std::string &) const override;
     };
 
     /**
@@ -143,7 +153,16 @@ namespace amqp::internal::reader {
               , m_value (std::move (value_))
         { }
 
-        std::string dump() const override;
+        const amqp::reader::IValue & key() const {
+            return *m_key;
+        }
+
+        const amqp::reader::IValue & value() const {
+            return *m_value;
+        }
+
+        using Value::dump;
+        void dump (std::string &) const override;
     };
 
 }
@@ -155,38 +174,38 @@ namespace amqp::internal::reader {
  ******************************************************************************/
 
 template<typename T>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedSingle<T>::dump() const {
-    return std::to_string (m_value);
+TypedSingle<T>::dump (std::string & out_) const {
+    encoding::json::number (out_, m_value);
 }
 
 template<>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedSingle<std::string>::dump() const {
-    return m_value;
+TypedSingle<std::string>::dump (std::string & out_) const {
+    out_ += m_value;
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const;
+TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const;
+TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump (std::string &) const;
 
 /******************************************************************************
  *
@@ -195,38 +214,42 @@ TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const;
  ******************************************************************************/
 
 template<typename T>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedPair<T>::dump() const {
-    return m_property + " : " + std::to_string (m_value);
+TypedPair<T>::dump (std::string & out_) const {
+    encoding::json::quote (out_, m_property);
+    out_ += " : ";
+    encoding::json::number (out_, m_value);
 }
 
 template<>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedPair<std::string>::dump() const {
-    return m_property + " : " + m_value;
+TypedPair<std::string>::dump (std::string & out_) const {
+    encoding::json::quote (out_, m_property);
+    out_ += " : ";
+    out_ += m_value;
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump() const;
+TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const;
+TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump (std::string &) const;
 
 /******************************************************************************
  *
@@ -238,6 +261,12 @@ namespace amqp::internal::reader  {
 
     using IReader = amqp::reader::IReader<schema::SchemaMap::const_iterator>;
 
+    class Graph;
+
+    namespace variant {
+        class Program;
+    }
+
     /**
      * Interface that represents an object that has the ability to consume
      * the payload of a Corda serialized blob in a way defined by some
@@ -267,6 +296,23 @@ namespace amqp::internal::reader  {
             uPtr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override = 0;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
+
+            /**
+             * Copy this reader into [graph_], its children being replaced
+             * by their own copies there
+             */
+            virtual const Reader * freeze (Graph & graph_) const = 0;
+
+            /**
+             * Add this reader, and those it reads its children with, to
+             * [program_] as a closed set of nodes, returning its index
+             */
+            virtual size_t compile (variant::Program & program_) const = 0;
     };
 
 }
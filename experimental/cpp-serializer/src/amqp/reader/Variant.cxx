@@ -0,0 +1,85 @@
+#include "Variant.h"
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    template<typename ... Ts>
+    struct overloaded : Ts ... { using Ts::operator() ...; };
+
+    template<typename ... Ts>
+    overloaded (Ts ...) -> overloaded<Ts ...>;
+
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::variant::
+type (const Node & node_) {
+    static const std::string int_t { "int" };
+    static const std::string long_t { "long" };
+    static const std::string bool_t { "boolean" };
+    static const std::string double_t { "double" };
+    static const std::string string_t { "string" };
+    static const std::string binary_t { "binary" };
+
+    return std::visit (overloaded {
+        [](const Int &) -> const std::string & { return int_t; },
+        [](const Long &) -> const std::string & { return long_t; },
+        [](const Bool &) -> const std::string & { return bool_t; },
+        [](const Double &) -> const std::string & { return double_t; },
+        [](const String &) -> const std::string & { return string_t; },
+        [](const Binary &) -> const std::string & { return binary_t; },
+        [](const auto & compound_) -> const std::string & {
+            return compound_.type;
+        }
+    }, node_);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::variant::
+Program::link (const Reader * reader_) {
+    auto it = m_compiled.find (reader_);
+
+    if (it != m_compiled.end()) {
+        return it->second;
+    }
+
+    auto index = reader_->compile (*this);
+    m_compiled[reader_] = index;
+
+    return index;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::variant::
+Program::add (Node node_) {
+    m_nodes.push_back (std::move (node_));
+
+    return m_nodes.size() - 1;
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::variant::Node &
+amqp::internal::reader::variant::
+Program::operator [] (size_t node_) const {
+    return m_nodes[node_];
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::variant::
+Program::size() const {
+    return m_nodes.size();
+}
+
+/******************************************************************************/
@@ -0,0 +1,127 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <variant>
+
+#include "Natives.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    class Reader;
+    class AnyReader;
+
+}
+
+/******************************************************************************/
+
+/**
+ * The readers a [CompositeFactory] builds, recast as a closed set of plain
+ * structures. A reader for a schema becomes a flat [Program] of nodes
+ * that refer to one another by index, and reading a blob with it is a
+ * switch on each node's alternative rather than a virtual call, leaving
+ * the compiler free to inline the primitive reads into the loop over a
+ * composite's properties.
+ */
+namespace amqp::internal::reader::variant {
+
+    struct Int { };
+    struct Long { };
+    struct Bool { };
+    struct Double { };
+    struct String { };
+    struct Binary { };
+
+    struct Composite {
+        struct Field {
+            std::string name;
+            size_t      reader;
+        };
+
+        std::string        type;
+        std::string        descriptor;
+        std::vector<Field> fields;
+    };
+
+    struct List {
+        std::string type;
+        size_t      element;
+    };
+
+    struct Array {
+        std::string type;
+        size_t      element;
+    };
+
+    struct Map {
+        std::string type;
+        size_t      key;
+        size_t      value;
+    };
+
+    struct Enum {
+        std::string type;
+    };
+
+    /**
+     * A value one of the [Natives] decodes, read a primitive at a time
+     * and handed to it as they are for all that it's a leaf
+     */
+    struct Native {
+        std::string     type;
+        Natives::Format format;
+    };
+
+    /**
+     * A property of a type the schema doesn't define, whose class is only
+     * known once its value is read. The node hands the value back to the
+     * [AnyReader] it was compiled from, which has to outlive the program.
+     */
+    struct Any {
+        std::string       type;
+        const AnyReader * reader;
+    };
+
+    using Node = std::variant<
+        Int, Long, Bool, Double, String, Binary,
+        Composite, List, Map, Array, Enum, Native, Any>;
+
+    /**
+     * The type name of the reader a node was compiled from
+     */
+    const std::string & type (const Node &);
+
+    /**
+     * A typed primitive read out of a blob, monostate for anything that
+     * isn't a primitive. A binary's bytes are held as a string, as is
+     * the text of a native.
+     */
+    using Value = std::variant<
+        std::monostate, int, long, bool, double, std::string>;
+
+    class Program {
+        private :
+            std::vector<Node>                m_nodes;
+            std::map<const Reader *, size_t> m_compiled;
+
+        public :
+            /**
+             * The index of [reader_]'s node, compiling it on first use
+             */
+            size_t link (const Reader * reader_);
+
+            size_t add (Node);
+
+            const Node & operator [] (size_t) const;
+
+            size_t size() const;
+    };
+
+}
+
+/******************************************************************************/
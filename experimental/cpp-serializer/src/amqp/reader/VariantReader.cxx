@@ -0,0 +1,612 @@
+#include "VariantReader.h"
+
+#include <proton/codec.h>
+
+#include "Graph.h"
+#include "Entries.h"
+#include "Nested.h"
+#include "AnyReader.h"
+#include "Elements.h"
+#include "encoding/Json.h"
+#include "proton/proton_wrapper.h"
+#include "restricted-readers/EnumReader.h"
+#include "property-readers/BinaryPropertyReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    using IValue = amqp::reader::IValue;
+
+    template<typename T>
+    uPtr<IValue>
+    make (const std::string * name_, T && value_) {
+        if (name_) {
+            return std::make_unique<TypedPair<T>> (*name_, std::move (value_));
+        }
+
+        return std::make_unique<TypedSingle<T>> (std::move (value_));
+    }
+
+    /**
+     * Walks a program over a blob, one of these per [VariantReader::dump]
+     */
+    class Dumper {
+        private :
+            const sPtr<const variant::Program> & m_program;
+            pn_data_t *                          m_data;
+            const Reader::SchemaType &           m_schema;
+
+        public :
+            Dumper (
+                const sPtr<const variant::Program> & program_,
+                pn_data_t * data_,
+                const Reader::SchemaType & schema_
+            ) : m_program (program_)
+              , m_data (data_)
+              , m_schema (schema_)
+            { }
+
+            /**
+             * Read the value at [node_], as a property named [name_] or,
+             * when that's null, as a single value
+             */
+            uPtr<IValue> dump (size_t node_, const std::string * name_);
+
+            uPtr<IValue> operator() (const variant::Int &, const std::string *);
+            uPtr<IValue> operator() (const variant::Long &, const std::string *);
+            uPtr<IValue> operator() (const variant::Bool &, const std::string *);
+            uPtr<IValue> operator() (const variant::Double &, const std::string *);
+            uPtr<IValue> operator() (const variant::String &, const std::string *);
+            uPtr<IValue> operator() (const variant::Binary &, const std::string *);
+            uPtr<IValue> operator() (const variant::Composite &, const std::string *);
+            uPtr<IValue> operator() (const variant::List &, const std::string *);
+            uPtr<IValue> operator() (const variant::Array &, const std::string *);
+            uPtr<IValue> operator() (const variant::Map &, const std::string *);
+            uPtr<IValue> operator() (const variant::Enum &, const std::string *);
+            uPtr<IValue> operator() (const variant::Native &, const std::string *);
+            uPtr<IValue> operator() (const variant::Any &, const std::string *);
+
+        private :
+            sList<uPtr<IValue>> elements (size_t);
+    };
+
+    /**************************************************************************/
+
+    inline uPtr<IValue>
+    Dumper::dump (size_t node_, const std::string * name_) {
+        return std::visit ([&](const auto & node_) {
+            return (*this) (node_, name_);
+        }, (*m_program)[node_]);
+    }
+
+    /**************************************************************************/
+
+    inline uPtr<IValue>
+    Dumper::operator() (const variant::Int &, const std::string * name_) {
+        return make (name_, proton::readAndNext<int> (m_data));
+    }
+
+    inline uPtr<IValue>
+    Dumper::operator() (const variant::Long &, const std::string * name_) {
+        return make (name_, proton::readAndNext<long> (m_data));
+    }
+
+    inline uPtr<IValue>
+    Dumper::operator() (const variant::Bool &, const std::string * name_) {
+        return make (name_, std::to_string (proton::readAndNext<bool> (m_data)));
+    }
+
+    inline uPtr<IValue>
+    Dumper::operator() (const variant::Double &, const std::string * name_) {
+        return make (name_, proton::readAndNext<double> (m_data));
+    }
+
+    inline uPtr<IValue>
+    Dumper::operator() (const variant::String &, const std::string * name_) {
+        return make (name_, encoding::json::quote (
+                proton::readAndNext<std::string_view> (m_data)));
+    }
+
+    uPtr<IValue>
+    Dumper::operator() (const variant::Binary &, const std::string * name_) {
+        auto bytes = proton::readAndNext<pn_bytes_t> (m_data);
+        std::string_view view { bytes.start, bytes.size };
+
+        if (Nested::is (view)) {
+            return name_ ? Nested::dump (*name_, view) : Nested::dump (view);
+        }
+
+        return make (name_, BinaryPropertyReader::json (view));
+    }
+
+    /**************************************************************************/
+
+    uPtr<IValue>
+    Dumper::operator() (
+        const variant::Composite & composite_,
+        const std::string * name_
+    ) {
+        proton::auto_next an (m_data);
+
+        proton::is_described (m_data);
+        proton::auto_enter ae (m_data);
+
+        auto descriptor = proton::get_symbol<std::string_view> (m_data);
+
+        const std::vector<std::unique_ptr<
+            amqp::internal::schema::Field>> * fields { nullptr };
+
+        if (descriptor != composite_.descriptor) {
+            const auto & it = m_schema.fromDescriptor (descriptor);
+
+            fields = &dynamic_cast<amqp::internal::schema::Composite &> (
+                    *(it->second.get())).fields();
+        }
+
+        pn_data_next (m_data);
+
+        sVec<uPtr<IValue>> read;
+        read.reserve (composite_.fields.size());
+
+        proton::is_list (m_data);
+        {
+            proton::auto_enter ae (m_data);
+
+            for (size_t i { 0 } ; i < composite_.fields.size() ; ++i) {
+                const auto & field = composite_.fields[i];
+
+                read.emplace_back (dump (
+                    field.reader,
+                    fields ? &(*fields)[i]->name() : &field.name));
+            }
+        }
+
+        return make (name_, std::move (read));
+    }
+
+    /**************************************************************************/
+
+    /**
+     * The elements of a list or array, handed to [Elements] when there are
+     * enough of them to be worth sharing out
+     */
+    sList<uPtr<IValue>>
+    Dumper::elements (size_t element_) {
+        proton::is_described (m_data);
+
+        sList<uPtr<IValue>> read;
+
+        proton::auto_enter ae (m_data);
+        m_schema.fromDescriptor (proton::readAndNext<std::string_view> (m_data));
+
+        proton::auto_list_enter ale (m_data, true);
+
+        if (ale.elements() < Elements::threshold()) {
+            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                read.emplace_back (dump (element_, nullptr));
+            }
+        } else {
+            read = Elements::dump (
+                m_data,
+                ale.elements(),
+                VariantReader (m_program, element_),
+                m_schema);
+        }
+
+        return read;
+    }
+
+    /**************************************************************************/
+
+    uPtr<IValue>
+    Dumper::operator() (const variant::List & list_, const std::string * name_) {
+        proton::auto_next an (m_data);
+
+        return make (name_, elements (list_.element));
+    }
+
+    /**************************************************************************/
+
+    uPtr<IValue>
+    Dumper::operator() (const variant::Array & array_, const std::string * name_) {
+        proton::auto_next an (m_data);
+
+        return make (name_, elements (array_.element));
+    }
+
+    /**************************************************************************/
+
+    uPtr<IValue>
+    Dumper::operator() (const variant::Map & map_, const std::string * name_) {
+        proton::auto_next an (m_data);
+
+        proton::is_described (m_data);
+        proton::auto_enter ae (m_data);
+
+        m_schema.fromDescriptor (proton::readAndNext<std::string_view> (m_data));
+
+        proton::auto_map_enter am (m_data, true);
+
+        Entries read;
+        read.reserve (am.elements() / 2);
+
+        for (size_t i { 0 } ; i < am.elements() ; i += 2) {
+            auto typed = Entries::key (m_data);
+            auto key = dump (map_.key, nullptr);
+
+            read.add (std::move (typed), std::move (key), dump (map_.value, nullptr));
+        }
+
+        return make (name_, std::move (read));
+    }
+
+    /**************************************************************************/
+
+    uPtr<IValue>
+    Dumper::operator() (const variant::Enum &, const std::string * name_) {
+        proton::auto_next an (m_data);
+        proton::is_described (m_data);
+
+        return make (name_, EnumReader::value (m_data));
+    }
+
+    /**************************************************************************/
+
+    uPtr<IValue>
+    Dumper::operator() (const variant::Native & native_, const std::string * name_) {
+        std::string text;
+        Natives::format (text, native_.format, m_data);
+
+        return make (name_, encoding::json::quote (text));
+    }
+
+    /**************************************************************************/
+
+    uPtr<IValue>
+    Dumper::operator() (const variant::Any & any_, const std::string * name_) {
+        auto reader = any_.reader->resolve (m_data);
+
+        return name_
+            ? reader->dump (*name_, m_data, m_schema)
+            : reader->dump (m_data, m_schema);
+    }
+
+    /**************************************************************************/
+
+    /**
+     * As [Dumper] but raising events on a visitor rather than building
+     * values
+     */
+    class Walker {
+        private :
+            const variant::Program &     m_program;
+            pn_data_t *                  m_data;
+            const Reader::SchemaType &   m_schema;
+            amqp::reader::IVisitor &     m_visitor;
+
+        public :
+            Walker (
+                const variant::Program & program_,
+                pn_data_t * data_,
+                const Reader::SchemaType & schema_,
+                amqp::reader::IVisitor & visitor_
+            ) : m_program (program_)
+              , m_data (data_)
+              , m_schema (schema_)
+              , m_visitor (visitor_)
+            { }
+
+            void visit (size_t node_) {
+                std::visit ([this](const auto & node_) {
+                    (*this) (node_);
+                }, m_program[node_]);
+            }
+
+            void operator() (const variant::Int &) {
+                m_visitor.onInt (proton::readAndNext<int> (m_data));
+            }
+
+            void operator() (const variant::Long &) {
+                m_visitor.onLong (proton::readAndNext<long> (m_data));
+            }
+
+            void operator() (const variant::Bool &) {
+                m_visitor.onBool (proton::readAndNext<bool> (m_data));
+            }
+
+            void operator() (const variant::Double &) {
+                m_visitor.onDouble (proton::readAndNext<double> (m_data));
+            }
+
+            void operator() (const variant::String &) {
+                m_visitor.onString (
+                    proton::readAndNext<std::string_view> (m_data));
+            }
+
+            void operator() (const variant::Binary &) {
+                auto bytes = proton::readAndNext<pn_bytes_t> (m_data);
+
+                m_visitor.onBinary ({ bytes.start, bytes.size });
+            }
+
+            void operator() (const variant::Composite &);
+            void operator() (const variant::List & list_) { elements (list_.element); }
+            void operator() (const variant::Array & array_) { elements (array_.element); }
+            void operator() (const variant::Map &);
+            void operator() (const variant::Enum &);
+
+            void operator() (const variant::Native & native_) {
+                std::string text;
+                Natives::format (text, native_.format, m_data);
+
+                m_visitor.onString (text);
+            }
+
+            void operator() (const variant::Any & any_) {
+                any_.reader->resolve (m_data)->visit (m_data, m_schema, m_visitor);
+            }
+
+        private :
+            void elements (size_t);
+    };
+
+    /**************************************************************************/
+
+    void
+    Walker::operator() (const variant::Composite & composite_) {
+        proton::auto_next an (m_data);
+
+        proton::is_described (m_data);
+        proton::auto_enter ae (m_data);
+
+        auto descriptor = proton::get_symbol<std::string_view> (m_data);
+
+        const std::vector<std::unique_ptr<
+            amqp::internal::schema::Field>> * fields { nullptr };
+
+        if (descriptor != composite_.descriptor) {
+            const auto & it = m_schema.fromDescriptor (descriptor);
+
+            fields = &dynamic_cast<amqp::internal::schema::Composite &> (
+                    *(it->second.get())).fields();
+        }
+
+        pn_data_next (m_data);
+
+        m_visitor.onCompositeBegin (composite_.type, descriptor);
+
+        proton::is_list (m_data);
+        {
+            proton::auto_enter ae (m_data);
+
+            for (size_t i { 0 } ; i < composite_.fields.size() ; ++i) {
+                const auto & field = composite_.fields[i];
+
+                m_visitor.onField (fields ? (*fields)[i]->name() : field.name);
+
+                visit (field.reader);
+            }
+        }
+
+        m_visitor.onCompositeEnd();
+    }
+
+    /**************************************************************************/
+
+    void
+    Walker::elements (size_t element_) {
+        proton::auto_next an (m_data);
+
+        proton::is_described (m_data);
+        proton::auto_enter ae (m_data, true);
+
+        proton::auto_list_enter ale (m_data, true);
+
+        m_visitor.onListBegin (ale.elements());
+
+        for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+            visit (element_);
+        }
+
+        m_visitor.onListEnd();
+    }
+
+    /**************************************************************************/
+
+    void
+    Walker::operator() (const variant::Map & map_) {
+        proton::auto_next an (m_data);
+
+        proton::is_described (m_data);
+        proton::auto_enter ae (m_data, true);
+
+        proton::auto_map_enter am (m_data, true);
+
+        m_visitor.onMapBegin (am.elements() / 2);
+
+        for (size_t i { 0 } ; i < am.elements() ; i += 2) {
+            visit (map_.key);
+            visit (map_.value);
+        }
+
+        m_visitor.onMapEnd();
+    }
+
+    /**************************************************************************/
+
+    void
+    Walker::operator() (const variant::Enum &) {
+        proton::auto_next an (m_data);
+
+        m_visitor.onString (EnumReader::constant (m_data));
+    }
+
+}
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+VariantReader::m_name { // NOLINT
+    "Variant Reader"
+};
+
+/******************************************************************************/
+
+amqp::internal::reader::
+VariantReader::VariantReader (
+    sPtr<const variant::Program> program_,
+    size_t node_
+) : m_program (std::move (program_))
+  , m_node (node_)
+{ }
+
+/******************************************************************************/
+
+sPtr<amqp::internal::reader::VariantReader>
+amqp::internal::reader::
+VariantReader::compile (const Reader & reader_) {
+    auto program = std::make_shared<variant::Program>();
+
+    auto node = program->link (&reader_);
+
+    return std::make_shared<VariantReader> (std::move (program), node);
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+VariantReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+VariantReader::type() const {
+    return variant::type ((*m_program)[m_node]);
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::variant::Value
+amqp::internal::reader::
+VariantReader::value (pn_data_t * data_) const {
+    // alternatives in the order variant::Node lists them
+    switch ((*m_program)[m_node].index()) {
+        case 0 : return proton::readAndNext<int> (data_);
+        case 1 : return proton::readAndNext<long> (data_);
+        case 2 : return proton::readAndNext<bool> (data_);
+        case 3 : return proton::readAndNext<double> (data_);
+        case 4 : return proton::readAndNext<std::string> (data_);
+        case 5 : {
+            auto bytes = proton::readAndNext<pn_bytes_t> (data_);
+            return std::string (bytes.start, bytes.size);
+        }
+        case 11 : {
+            std::string text;
+            Natives::format (text,
+                std::get<variant::Native> ((*m_program)[m_node]).format, data_);
+
+            return text;
+        }
+        default : return std::monostate { };
+    }
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+VariantReader::read (pn_data_t * data_) const {
+    return std::visit ([](auto && value_) -> std::any {
+        if constexpr (std::is_same_v<
+            std::decay_t<decltype (value_)>, std::monostate>)
+        {
+            return std::any (1);
+        } else {
+            return std::any (value_);
+        }
+    }, value (data_));
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+VariantReader::readString (pn_data_t * data_) const {
+    return std::visit ([](auto && value_) -> std::string {
+        using T = std::decay_t<decltype (value_)>;
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            return value_;
+        } else if constexpr (std::is_same_v<T, std::monostate>) {
+            return "";
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return std::to_string (value_);
+        } else {
+            return encoding::json::number (value_);
+        }
+    }, value (data_));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+VariantReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType & schema_
+) const {
+    return Dumper (m_program, data_, schema_).dump (m_node, &name_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+VariantReader::dump (
+    pn_data_t * data_,
+    const SchemaType & schema_
+) const {
+    return Dumper (m_program, data_, schema_).dump (m_node, nullptr);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+VariantReader::visit (
+    pn_data_t * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    Walker (*m_program, data_, schema_, visitor_).visit (m_node);
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+VariantReader::freeze (Graph & graph_) const {
+    return graph_.make<VariantReader> (*this);
+}
+
+/******************************************************************************/
+
+/**
+ * Already compiled, the program holding it is shared rather than copied
+ */
+size_t
+amqp::internal::reader::
+VariantReader::compile (variant::Program &) const {
+    throw std::logic_error ("Variant readers are already compiled");
+}
+
+/******************************************************************************/
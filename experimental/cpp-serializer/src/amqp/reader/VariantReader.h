@@ -0,0 +1,70 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "Reader.h"
+#include "Variant.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Reads blobs with a [variant::Program] compiled from an ordinary
+     * reader graph, presenting it through the same [IReader] interface.
+     * Dumping produces exactly what the virtual readers would, but only
+     * the entry point is a virtual call, everything beneath it is a
+     * switch over the program's nodes.
+     */
+    class VariantReader : public Reader {
+        private :
+            static const std::string m_name;
+
+            sPtr<const variant::Program> m_program;
+            size_t                       m_node;
+
+        public :
+            VariantReader (sPtr<const variant::Program>, size_t);
+
+            /**
+             * Compile [reader_] and everything it reads with
+             */
+            static sPtr<VariantReader> compile (const Reader & reader_);
+
+            ~VariantReader() override = default;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+
+            /**
+             * Boxes the result of [value] for the [IReader] interface
+             */
+            std::any read (pn_data_t *) const override;
+            std::string readString (pn_data_t *) const override;
+
+            /**
+             * Read a primitive without boxing it
+             */
+            variant::Value value (pn_data_t *) const;
+
+            uPtr<amqp::reader::IValue> dump(
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            uPtr<amqp::reader::IValue> dump(
+                pn_data_t *,
+                const SchemaType &) const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,156 @@
+#include "BinaryPropertyReader.h"
+
+#include <proton/codec.h>
+
+#include "Graph.h"
+#include "Nested.h"
+#include "Variant.h"
+#include "encoding/Hex.h"
+#include "proton/proton_wrapper.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string_view
+    view (pn_bytes_t bytes_) {
+        return { bytes_.start, bytes_.size };
+    }
+
+}
+
+/******************************************************************************
+ *
+ * BinaryPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader::m_type { // NOLINT
+        "binary"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader::m_name { // NOLINT
+        "Binary Reader"
+};
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+BinaryPropertyReader::json (std::string_view bytes_) {
+    std::string rtn { "\"" };
+
+    encoding::hex::encode (rtn, bytes_.data(), bytes_.size());
+    rtn += '"';
+
+    return rtn;
+}
+
+/******************************************************************************
+ *
+ * class BinaryPropertyReader
+ *
+ ******************************************************************************/
+
+std::any
+amqp::internal::reader::
+BinaryPropertyReader::read (pn_data_t * data_) const {
+    return std::any { std::string (view (proton::readAndNext<pn_bytes_t> (data_))) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+BinaryPropertyReader::readString (pn_data_t * data_) const {
+    auto bytes = proton::readAndNext<pn_bytes_t> (data_);
+
+    return encoding::hex::encode (bytes.start, bytes.size);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BinaryPropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType &) const
+{
+    auto bytes = view (proton::readAndNext<pn_bytes_t> (data_));
+
+    if (Nested::is (bytes)) {
+        return Nested::dump (name_, bytes);
+    }
+
+    return std::make_unique<TypedPair<std::string>> (name_, json (bytes));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+BinaryPropertyReader::dump (
+        pn_data_t * data_,
+        const SchemaType &) const
+{
+    auto bytes = view (proton::readAndNext<pn_bytes_t> (data_));
+
+    if (Nested::is (bytes)) {
+        return Nested::dump (bytes);
+    }
+
+    return std::make_unique<TypedSingle<std::string>> (json (bytes));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+BinaryPropertyReader::visit (
+    pn_data_t * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_
+) const {
+    visitor_.onBinary (view (proton::readAndNext<pn_bytes_t> (data_)));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+BinaryPropertyReader::freeze (Graph & graph_) const {
+    return graph_.make<BinaryPropertyReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+BinaryPropertyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Binary { });
+}
+
+/******************************************************************************/
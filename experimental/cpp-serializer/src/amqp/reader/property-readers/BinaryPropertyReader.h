@@ -0,0 +1,58 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string_view>
+
+#include "PropertyReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A byte array, Corda's OpaqueBytes and everything built on it. Bytes
+     * that are a Corda blob of their own are dumped as the object they
+     * hold, see [Nested], anything else as a string of upper case hex.
+     * A visitor is handed the bytes as they are.
+     */
+    class BinaryPropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+        public :
+            /**
+             * The JSON bytes that aren't a nested blob are dumped as
+             */
+            static std::string json (std::string_view);
+
+            std::string readString (pn_data_t *) const override;
+
+            std::any read (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &
+            ) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                pn_data_t *,
+                const SchemaType &
+            ) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
+    };
+}
+
+/******************************************************************************/
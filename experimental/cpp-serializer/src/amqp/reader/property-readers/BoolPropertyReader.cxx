@@ -1,5 +1,7 @@
 #include "BoolPropertyReader.h"
 
+#include "Graph.h"
+#include "Variant.h"
 #include "proton/proton_wrapper.h"
 
 /******************************************************************************
@@ -19,7 +21,7 @@ BoolPropertyReader::m_name { // NOLINT
 const std::string
 amqp::internal::reader::
 BoolPropertyReader::m_type { // NOLINT
-        "bool"
+        "boolean"
 };
 
 /******************************************************************************
@@ -85,3 +87,31 @@ BoolPropertyReader::type() const {
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+BoolPropertyReader::visit (
+    pn_data_t * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_
+) const {
+    visitor_.onBool (proton::readAndNext<bool> (data_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+BoolPropertyReader::freeze (Graph & graph_) const {
+    return graph_.make<BoolPropertyReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+BoolPropertyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Bool { });
+}
+
+/******************************************************************************/
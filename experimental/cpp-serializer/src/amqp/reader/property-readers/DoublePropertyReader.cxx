@@ -1,5 +1,8 @@
 #include "DoublePropertyReader.h"
 
+#include "Graph.h"
+#include "Variant.h"
+#include "encoding/Json.h"
 #include "proton/proton_wrapper.h"
 
 /******************************************************************************
@@ -37,7 +40,7 @@ DoublePropertyReader::read (pn_data_t * data_) const {
 std::string
 amqp::internal::reader::
 DoublePropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<double> (data_));
+    return encoding::json::number (proton::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
@@ -49,9 +52,9 @@ DoublePropertyReader::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
+    return std::make_unique<TypedPair<double>> (
             name_,
-            std::to_string (proton::readAndNext<double> (data_)));
+            proton::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
@@ -62,8 +65,8 @@ DoublePropertyReader::dump (
         pn_data_t * data_,
         const SchemaType & schema_) const
 {
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<double> (data_)));
+    return std::make_unique<TypedSingle<double>> (
+            proton::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
@@ -83,3 +86,31 @@ DoublePropertyReader::type() const {
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+DoublePropertyReader::visit (
+    pn_data_t * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_
+) const {
+    visitor_.onDouble (proton::readAndNext<double> (data_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+DoublePropertyReader::freeze (Graph & graph_) const {
+    return graph_.make<DoublePropertyReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+DoublePropertyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Double { });
+}
+
+/******************************************************************************/
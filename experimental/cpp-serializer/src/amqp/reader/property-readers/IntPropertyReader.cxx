@@ -5,6 +5,9 @@
 #include <string>
 #include <proton/codec.h>
 
+#include "Graph.h"
+#include "Variant.h"
+#include "encoding/Json.h"
 #include "proton/proton_wrapper.h"
 #include "amqp/reader/IReader.h"
 
@@ -45,7 +48,7 @@ IntPropertyReader::read (pn_data_t * data_) const {
 std::string
 amqp::internal::reader::
 IntPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<int> (data_));
+    return encoding::json::number (proton::readAndNext<int> (data_));
 }
 
 /******************************************************************************/
@@ -57,9 +60,9 @@ IntPropertyReader::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
+    return std::make_unique<TypedPair<int>> (
             name_,
-            std::to_string (proton::readAndNext<int> (data_)));
+            proton::readAndNext<int> (data_));
 }
 
 /******************************************************************************/
@@ -70,8 +73,8 @@ IntPropertyReader::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<int> (data_)));
+    return std::make_unique<TypedSingle<int>> (
+            proton::readAndNext<int> (data_));
 }
 
 /******************************************************************************/
@@ -91,3 +94,31 @@ IntPropertyReader::type() const {
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+IntPropertyReader::visit (
+    pn_data_t * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_
+) const {
+    visitor_.onInt (proton::readAndNext<int> (data_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+IntPropertyReader::freeze (Graph & graph_) const {
+    return graph_.make<IntPropertyReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+IntPropertyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Int { });
+}
+
+/******************************************************************************/
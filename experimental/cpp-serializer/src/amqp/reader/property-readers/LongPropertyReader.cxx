@@ -1,5 +1,8 @@
 #include "LongPropertyReader.h"
 
+#include "Graph.h"
+#include "Variant.h"
+#include "encoding/Json.h"
 #include "proton/proton_wrapper.h"
 
 /******************************************************************************
@@ -39,7 +42,7 @@ LongPropertyReader::read (pn_data_t * data_) const {
 std::string
 amqp::internal::reader::
 LongPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<long> (data_));
+    return encoding::json::number (proton::readAndNext<long> (data_));
 }
 
 /******************************************************************************/
@@ -51,9 +54,9 @@ LongPropertyReader::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
+    return std::make_unique<TypedPair<long>> (
             name_,
-            std::to_string (proton::readAndNext<long> (data_)));
+            proton::readAndNext<long> (data_));
 }
 
 /******************************************************************************/
@@ -64,8 +67,8 @@ LongPropertyReader::dump (
     pn_data_t * data_,
     const SchemaType & schema_) const
 {
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<long> (data_)));
+    return std::make_unique<TypedSingle<long>> (
+            proton::readAndNext<long> (data_));
 }
 
 /******************************************************************************/
@@ -85,3 +88,31 @@ LongPropertyReader::type() const {
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+LongPropertyReader::visit (
+    pn_data_t * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_
+) const {
+    visitor_.onLong (proton::readAndNext<long> (data_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+LongPropertyReader::freeze (Graph & graph_) const {
+    return graph_.make<LongPropertyReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+LongPropertyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Long { });
+}
+
+/******************************************************************************/
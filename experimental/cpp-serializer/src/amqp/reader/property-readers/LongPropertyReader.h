@@ -31,6 +31,14 @@ namespace amqp::internal::reader {
 
             const std::string & name() const override;
             const std::string & type() const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
     };
 
 }
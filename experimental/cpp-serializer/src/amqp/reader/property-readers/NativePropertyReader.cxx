@@ -0,0 +1,131 @@
+#include "NativePropertyReader.h"
+
+#include "Graph.h"
+#include "Variant.h"
+#include "encoding/Json.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************
+ *
+ * NativePropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+NativePropertyReader::m_name { // NOLINT
+        "Native Reader"
+};
+
+/******************************************************************************
+ *
+ * class NativePropertyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+NativePropertyReader::NativePropertyReader (
+    std::string type_,
+    Natives::Format format_
+) : m_type (std::move (type_))
+  , m_format (format_)
+{ }
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+NativePropertyReader::text (pn_data_t * data_) const {
+    std::string rtn;
+    Natives::format (rtn, m_format, data_);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+NativePropertyReader::read (pn_data_t * data_) const {
+    return std::any { text (data_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+NativePropertyReader::readString (pn_data_t * data_) const {
+    return text (data_);
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+NativePropertyReader::dump (
+    const std::string & name_,
+    pn_data_t * data_,
+    const SchemaType &) const
+{
+    return std::make_unique<TypedPair<std::string>> (
+        name_,
+        encoding::json::quote (text (data_)));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+NativePropertyReader::dump (
+    pn_data_t * data_,
+    const SchemaType &) const
+{
+    return std::make_unique<TypedSingle<std::string>> (
+        encoding::json::quote (text (data_)));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+NativePropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+NativePropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+NativePropertyReader::visit (
+    pn_data_t * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_
+) const {
+    visitor_.onString (text (data_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+NativePropertyReader::freeze (Graph & graph_) const {
+    return graph_.make<NativePropertyReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+NativePropertyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Native { m_type, m_format });
+}
+
+/******************************************************************************/
@@ -0,0 +1,56 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+#include "Natives.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A value of a type with a decoder in [Natives], dumped as the JSON
+     * string that decoder prints and handed to a visitor as that string.
+     */
+    class NativePropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+
+            std::string      m_type;
+            Natives::Format  m_format;
+
+            std::string text (pn_data_t *) const;
+
+        public :
+            NativePropertyReader (std::string type_, Natives::Format format_);
+
+            std::string readString (pn_data_t *) const override;
+
+            std::any read (pn_data_t *) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                const std::string &,
+                pn_data_t *,
+                const SchemaType &
+            ) const override;
+
+            uPtr<amqp::reader::IValue> dump (
+                pn_data_t *,
+                const SchemaType &
+            ) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
+    };
+}
+
+/******************************************************************************/
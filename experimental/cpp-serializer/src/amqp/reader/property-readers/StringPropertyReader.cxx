@@ -2,6 +2,9 @@
 
 #include <proton/codec.h>
 
+#include "Graph.h"
+#include "Variant.h"
+#include "encoding/Json.h"
 #include "proton/proton_wrapper.h"
 
 /******************************************************************************
@@ -55,7 +58,7 @@ StringPropertyReader::dump (
 {
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            encoding::json::quote (proton::readAndNext<std::string_view> (data_)));
 }
 
 /******************************************************************************/
@@ -67,7 +70,7 @@ StringPropertyReader::dump (
         const SchemaType & schema_) const
 {
     return std::make_unique<TypedSingle<std::string>> (
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+            encoding::json::quote (proton::readAndNext<std::string_view> (data_)));
 }
 
 /******************************************************************************/
@@ -87,3 +90,31 @@ StringPropertyReader::type() const {
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+StringPropertyReader::visit (
+    pn_data_t * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_
+) const {
+    visitor_.onString (proton::readAndNext<std::string_view> (data_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+StringPropertyReader::freeze (Graph & graph_) const {
+    return graph_.make<StringPropertyReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+StringPropertyReader::compile (variant::Program & program_) const {
+    return program_.add (variant::String { });
+}
+
+/******************************************************************************/
@@ -11,7 +11,7 @@ namespace amqp::internal::reader {
     class ArrayReader : public RestrictedReader {
         private :
             // How to read the underlying types
-            std::weak_ptr<Reader> m_reader;
+            const Reader * m_reader;
 
             std::list<uPtr<amqp::reader::IValue>> dump_(
                 pn_data_t *,
@@ -23,7 +23,7 @@ namespace amqp::internal::reader {
             std::string m_primType;
 
         public :
-            ArrayReader (std::string, std::weak_ptr<Reader>);
+            ArrayReader (std::string, const Reader *);
 
             ~ArrayReader() final = default;
 
@@ -37,6 +37,14 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
     };
 
 }
@@ -1,5 +1,8 @@
 #include "EnumReader.h"
 
+#include "Graph.h"
+#include "Variant.h"
+#include "encoding/Json.h"
 #include "amqp/reader/IReader.h"
 #include "amqp/schema/Descriptors.h"
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
@@ -19,49 +22,56 @@ EnumReader::EnumReader (
 
 /******************************************************************************/
 
-namespace {
-
-    std::string
-    getValue (pn_data_t * data_) {
-        proton::is_described (data_);
-
-        {
-            proton::auto_enter ae (data_);
-
-            /*
-             * Referenced objects are added to a stream when the serialiser
-             * notices it's writing a value it's already written, so to save
-             * space it will just link back to that. Currently we have
-             * no mechanism for decoding that so just throw an error
-             */
-            if (pn_data_type (data_) == PN_ULONG) {
-                if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
-                amqp::schema::descriptors::REFERENCED_OBJECT
-            ) {
-                    throw std::runtime_error (
-                            "Currently don't support referenced objects");
-                }
+std::string_view
+amqp::internal::reader::
+EnumReader::constant (pn_data_t * data_) {
+    proton::is_described (data_);
+
+    {
+        proton::auto_enter ae (data_);
+
+        /*
+         * Referenced objects are added to a stream when the serialiser
+         * notices it's writing a value it's already written, so to save
+         * space it will just link back to that. Currently we have
+         * no mechanism for decoding that so just throw an error
+         */
+        if (pn_data_type (data_) == PN_ULONG) {
+            if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
+            amqp::schema::descriptors::REFERENCED_OBJECT
+        ) {
+                throw std::runtime_error (
+                        "Currently don't support referenced objects");
             }
+        }
 
-            auto fingerprint = proton::readAndNext<std::string>(data_);
+        // the fingerprint
+        proton::readAndNext<std::string_view>(data_);
 
-            proton::auto_list_enter ale (data_, true);
+        proton::auto_list_enter ale (data_, true);
 
-            return proton::readAndNext<std::string>(data_);
+        return proton::readAndNext<std::string_view>(data_);
 
-            /*
-             * After a string representation of the enumerated value
-             * the ordinal value is also encoded. We don't need that for
-             * just dumping things to a string but if I don't leave this
-             * here I'll forget its even a thing
-             */
-            // auto idx = proton::readAndNext<int>(data_);
-        }
+        /*
+         * After a string representation of the enumerated value
+         * the ordinal value is also encoded. We don't need that for
+         * just dumping things to a string but if I don't leave this
+         * here I'll forget its even a thing
+         */
+        // auto idx = proton::readAndNext<int>(data_);
     }
 }
 
 /******************************************************************************/
 
+std::string
+amqp::internal::reader::
+EnumReader::value (pn_data_t * data_) {
+    return encoding::json::quote (constant (data_));
+}
+
+/******************************************************************************/
+
 std::unique_ptr<amqp::reader::IValue>
 amqp::internal::reader::
 EnumReader::dump (
@@ -74,7 +84,7 @@ EnumReader::dump (
 
     return std::make_unique<TypedPair<std::string>> (
             name_,
-            getValue(data_));
+            value (data_));
 }
 
 /******************************************************************************/
@@ -88,7 +98,37 @@ EnumReader::dump(
     proton::auto_next an (data_);
     proton::is_described (data_);
 
-    return std::make_unique<TypedSingle<std::string>> (getValue(data_));
+    return std::make_unique<TypedSingle<std::string>> (value (data_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+EnumReader::visit (
+    pn_data_t * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    proton::auto_next an (data_);
+
+    visitor_.onString (constant (data_));
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+EnumReader::freeze (Graph & graph_) const {
+    return graph_.make<EnumReader> (*this);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+EnumReader::compile (variant::Program & program_) const {
+    return program_.add (variant::Enum { type() });
 }
 
 /******************************************************************************/
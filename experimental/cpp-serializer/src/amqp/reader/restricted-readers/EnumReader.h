@@ -12,6 +12,17 @@ namespace amqp::internal::reader {
         public :
             EnumReader (std::string, std::vector<std::string>);
 
+            /**
+             * The name of the enumerated value at the current node, as a
+             * view into the tree
+             */
+            static std::string_view constant (pn_data_t *);
+
+            /**
+             * Read the enumerated value at the current node as a JSON string
+             */
+            static std::string value (pn_data_t *);
+
             std::unique_ptr<amqp::reader::IValue> dump(
                 const std::string &,
                 pn_data_t *,
@@ -20,6 +31,14 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
     };
 
 }
@@ -1,5 +1,8 @@
 #include "ListReader.h"
 
+#include "Graph.h"
+#include "Variant.h"
+#include "Elements.h"
 #include "proton/proton_wrapper.h"
 
 /******************************************************************************
@@ -58,14 +61,13 @@ ListReader::dump_(
 
     {
         proton::auto_enter ae (data_);
-        schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+        schema_.fromDescriptor (proton::readAndNext<std::string_view>(data_));
 
         {
             proton::auto_list_enter ale (data_, true);
 
-            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
-                read.emplace_back (m_reader.lock()->dump (data_, schema_));
-            }
+            read = Elements::dump (
+                    data_, ale.elements(), *m_reader, schema_);
         }
     }
 
@@ -73,3 +75,46 @@ ListReader::dump_(
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+ListReader::visit (
+    pn_data_t * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    proton::auto_next an (data_);
+
+    proton::is_described (data_);
+    proton::auto_enter ae (data_, true);
+
+    proton::auto_list_enter ale (data_, true);
+
+    visitor_.onListBegin (ale.elements());
+
+    for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+        m_reader->visit (data_, schema_, visitor_);
+    }
+
+    visitor_.onListEnd();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+ListReader::freeze (Graph & graph_) const {
+    return graph_.make<ListReader> (type(), graph_.link (m_reader));
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+ListReader::compile (variant::Program & program_) const {
+    auto element = program_.link (m_reader);
+
+    return program_.add (variant::List { type(), element });
+}
+
+/******************************************************************************/
@@ -11,7 +11,7 @@ namespace amqp::internal::reader {
     class ListReader : public RestrictedReader {
         private :
             // How to read the underlying types
-            std::weak_ptr<Reader> m_reader;
+            const Reader * m_reader;
 
             std::list<uPtr<amqp::reader::IValue>> dump_(
                 pn_data_t *,
@@ -20,9 +20,9 @@ namespace amqp::internal::reader {
         public :
             ListReader (
                 const std::string & type_,
-                std::weak_ptr<Reader> reader_
+                const Reader * reader_
             ) : RestrictedReader (type_)
-              , m_reader (std::move (reader_))
+              , m_reader (reader_)
             { }
 
             ~ListReader() final = default;
@@ -37,6 +37,14 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
     };
 
 }
@@ -1,5 +1,8 @@
 #include "MapReader.h"
 
+#include "Graph.h"
+#include "Variant.h"
+#include "Entries.h"
 #include "Reader.h"
 #include "amqp/reader/IReader.h"
 #include "proton/proton_wrapper.h"
@@ -14,7 +17,7 @@ MapReader::restrictedType() const {
 
 /******************************************************************************/
 
-sVec<uPtr<amqp::reader::IValue>>
+amqp::internal::reader::Entries
 amqp::internal::reader::
 MapReader::dump_(
     pn_data_t * data_,
@@ -28,21 +31,24 @@ MapReader::dump_(
     // and don't need context from the schema as there isn't
     // any. Maps have a Key and a Value, they aren't named
     // parameters, unlike composite types.
-    schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+    schema_.fromDescriptor (proton::readAndNext<std::string_view>(data_));
 
     {
         proton::auto_map_enter am (data_, true);
 
-        decltype (dump_(data_, schema_)) rtn;
+        Entries rtn;
         rtn.reserve (am.elements() / 2);
 
         for (int i {0} ; i < am.elements() ; i += 2) {
-            rtn.emplace_back (
-                std::make_unique<ValuePair> (
-                    m_keyReader.lock()->dump (data_, schema_),
-                    m_valueReader.lock()->dump (data_, schema_)
-                )
-            );
+            // the key has to be consumed before the value, don't rely on
+            // the compiler's choice of argument evaluation order
+            auto typed = Entries::key (data_);
+            auto key = m_keyReader->dump (data_, schema_);
+
+            rtn.add (
+                std::move (typed),
+                std::move (key),
+                m_valueReader->dump (data_, schema_));
         }
 
         return rtn;
@@ -60,7 +66,7 @@ MapReader::dump(
 ) const {
     proton::auto_next an (data_);
 
-    return std::make_unique<TypedPair<sVec<uPtr<amqp::reader::IValue>>>>(
+    return std::make_unique<TypedPair<Entries>>(
             name_,
             dump_ (data_, schema_));
 }
@@ -75,8 +81,56 @@ MapReader::dump(
 ) const  {
     proton::auto_next an (data_);
 
-    return std::make_unique<TypedSingle<sVec<uPtr<amqp::reader::IValue>>>>(
+    return std::make_unique<TypedSingle<Entries>>(
             dump_ (data_, schema_));
 }
 
 /******************************************************************************/
+
+void
+amqp::internal::reader::
+MapReader::visit (
+    pn_data_t * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    proton::auto_next an (data_);
+
+    proton::is_described (data_);
+    proton::auto_enter ae (data_, true);
+
+    proton::auto_map_enter am (data_, true);
+
+    visitor_.onMapBegin (am.elements() / 2);
+
+    for (size_t i { 0 } ; i < am.elements() ; i += 2) {
+        m_keyReader->visit (data_, schema_, visitor_);
+        m_valueReader->visit (data_, schema_, visitor_);
+    }
+
+    visitor_.onMapEnd();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+MapReader::freeze (Graph & graph_) const {
+    return graph_.make<MapReader> (
+            type(),
+            graph_.link (m_keyReader),
+            graph_.link (m_valueReader));
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+MapReader::compile (variant::Program & program_) const {
+    auto key = program_.link (m_keyReader);
+    auto value = program_.link (m_valueReader);
+
+    return program_.add (variant::Map { type(), key, value });
+}
+
+/******************************************************************************/
@@ -2,6 +2,7 @@
 
 /******************************************************************************/
 
+#include "Entries.h"
 #include "RestrictedReader.h"
 
 /******************************************************************************/
@@ -11,21 +12,21 @@ namespace amqp::internal::reader {
     class MapReader : public RestrictedReader {
         private :
             // How to read the underlying types
-            std::weak_ptr<Reader> m_keyReader;
-            std::weak_ptr<Reader> m_valueReader;
+            const Reader * m_keyReader;
+            const Reader * m_valueReader;
 
-            sVec<uPtr<amqp::reader::IValue>> dump_(
+            Entries dump_(
                     pn_data_t *,
                     const SchemaType &) const;
 
         public :
             MapReader (
                 const std::string & type_,
-                std::weak_ptr<Reader> keyReader_,
-                std::weak_ptr<Reader> valueReader_
+                const Reader * keyReader_,
+                const Reader * valueReader_
             ) : RestrictedReader (type_)
-              , m_keyReader (std::move (keyReader_))
-              , m_valueReader (std::move (valueReader_))
+              , m_keyReader (keyReader_)
+              , m_valueReader (valueReader_)
             { }
 
             ~MapReader() final = default;
@@ -40,6 +41,14 @@ namespace amqp::internal::reader {
             std::unique_ptr<amqp::reader::IValue> dump(
                 pn_data_t *,
                 const SchemaType &) const override;
+
+            void visit (
+                pn_data_t *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const Reader * freeze (Graph &) const override;
+            size_t compile (variant::Program &) const override;
     };
 
 }
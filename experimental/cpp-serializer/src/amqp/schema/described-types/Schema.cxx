@@ -63,7 +63,7 @@ Schema::types() const {
 
 amqp::internal::schema::SchemaMap::const_iterator
 amqp::internal::schema::
-Schema::fromType (const std::string & type_) const {
+Schema::fromType (std::string_view type_) const {
     return m_typeToDescriptor.find(type_);
 }
 
@@ -71,7 +71,7 @@ Schema::fromType (const std::string & type_) const {
 
 amqp::internal::schema::SchemaMap::const_iterator
 amqp::internal::schema::
-Schema::fromDescriptor (const std::string & descriptor_) const {
+Schema::fromDescriptor (std::string_view descriptor_) const {
     return m_descriptorToType.find (descriptor_);
 }
 
@@ -18,9 +18,14 @@
 
 namespace amqp::internal::schema {
 
+    /**
+     * Ordered by [std::less<>] so a view of a name or descriptor, one read
+     * straight out of a blob say, can be looked up without copying it
+     */
     using SchemaMap = std::map<
             std::string,
-            const std::reference_wrapper<const uPtr <AMQPTypeNotation>>>;
+            const std::reference_wrapper<const uPtr <AMQPTypeNotation>>,
+            std::less<>>;
 
     using ISchemaType = amqp::schema::ISchema<SchemaMap::const_iterator>;
 
@@ -48,8 +53,8 @@ namespace amqp::internal::schema {
 
             const OrderedTypeNotations<AMQPTypeNotation> & types() const;
 
-            SchemaMap::const_iterator fromType (const std::string &) const override;
-            SchemaMap::const_iterator fromDescriptor (const std::string &) const override ;
+            SchemaMap::const_iterator fromType (std::string_view) const override;
+            SchemaMap::const_iterator fromDescriptor (std::string_view) const override ;
 
             decltype (m_types.begin()) begin() const { return m_types.begin(); }
             decltype (m_types.end()) end() const { return m_types.end(); }
@@ -22,7 +22,7 @@ namespace {
             },
             {
                 "java.lang.Boolean",
-                std::pair { std::regex { "java.lang.Boolean"}, "bool"}
+                std::pair { std::regex { "java.lang.Boolean"}, "boolean"}
             },
             {
                 "java.lang.Byte",
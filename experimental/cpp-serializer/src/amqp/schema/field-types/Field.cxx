@@ -122,7 +122,10 @@ Field::typeIsPrimitive (const std::string & type_) {
             type_ == "long" ||
             type_ == "boolean" ||
             type_ == "int" ||
-            type_ == "double");
+            type_ == "double" ||
+            type_ == "binary" ||
+            type_ == "timestamp" ||
+            type_ == "uuid");
 }
 
 /******************************************************************************/
@@ -3,6 +3,7 @@
 #include "Map.h"
 #include "List.h"
 #include "Enum.h"
+#include "Described.h"
 #include "amqp/schema/described-types/Composite.h"
 
 /******************************************************************************
@@ -150,6 +151,19 @@ Array::dependsOnEnum (const amqp::internal::schema::Enum & enum_) const {
 
 /******************************************************************************/
 
+int
+amqp::internal::schema::
+Array::dependsOnDescribed (const amqp::internal::schema::Described & described_) const {
+    // do we depend on the lhs, it can't depend on us
+    if (arrayOf() == described_.name()) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
 int
 amqp::internal::schema::
 Array::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
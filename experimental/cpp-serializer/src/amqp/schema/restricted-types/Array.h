@@ -19,6 +19,7 @@ namespace amqp::internal::schema {
             int dependsOnList (const List &) const override;
             int dependsOnEnum (const Enum &) const override;
             int dependsOnArray (const Array &) const override;
+            int dependsOnDescribed (const Described &) const override;
 
         public :
             Array (
@@ -0,0 +1,123 @@
+#include "Described.h"
+
+#include "Map.h"
+#include "List.h"
+#include "Array.h"
+#include "amqp/schema/described-types/Composite.h"
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Described::Described (
+    uPtr<Descriptor> descriptor_,
+    std::string name_,
+    std::string label_,
+    std::vector<std::string> provides_,
+    std::string source_
+) : Restricted (
+        std::move (descriptor_),
+        std::move (name_),
+        std::move (label_),
+        std::move (provides_),
+        amqp::internal::schema::Restricted::RestrictedTypes::described_t)
+  , m_primitive { std::move (source_) }
+{
+}
+
+/******************************************************************************/
+
+std::vector<std::string>::const_iterator
+amqp::internal::schema::
+Described::begin() const {
+    return m_primitive.begin();
+}
+
+/******************************************************************************/
+
+std::vector<std::string>::const_iterator
+amqp::internal::schema::
+Described::end() const {
+    return m_primitive.end();
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Described::primitive() const {
+    return m_primitive.front();
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Described::dependsOnMap (const amqp::internal::schema::Map & map_) const {
+    // does lhs_ depend on us
+    auto lhsMapOf { map_.mapOf() };
+
+    if (lhsMapOf.first.get() == name() || lhsMapOf.second.get() == name()) {
+        return 2;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Described::dependsOnList (const amqp::internal::schema::List & list_) const {
+    // does the left hand side depend on us
+    if (list_.listOf() == name()) {
+        return 2;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Described::dependsOnArray (const amqp::internal::schema::Array & array_) const {
+    // does the left hand side depend on us
+    if (array_.arrayOf() == name()) {
+        return 2;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Described::dependsOnEnum (const amqp::internal::schema::Enum &) const {
+    return 0;
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::schema::
+Described::dependsOnDescribed (const amqp::internal::schema::Described &) const {
+    // both hold nothing but a primitive
+    return 0;
+}
+
+/*********************************************************o*********************/
+
+int
+amqp::internal::schema::
+Described::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
+    for (const auto & field : lhs_.fields()) {
+        if (field->resolvedType() == name()) {
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+/*********************************************************o*********************/
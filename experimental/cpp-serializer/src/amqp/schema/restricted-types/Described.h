@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Restricted.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A type Corda writes as a single primitive under a descriptor of its
+     * own, as its custom serializers write BigDecimal and Currency, as
+     * strings, and PublicKey, as its encoded bytes. It never depends on
+     * another type.
+     */
+    class Described : public Restricted {
+        private :
+            std::vector<std::string> m_primitive;
+
+            int dependsOnMap (const Map &) const override;
+            int dependsOnList (const List &) const override;
+            int dependsOnEnum (const Enum &) const override;
+            int dependsOnArray (const Array &) const override;
+            int dependsOnDescribed (const Described &) const override;
+
+        public :
+            Described (
+                uPtr<Descriptor> descriptor_,
+                std::string,
+                std::string,
+                std::vector<std::string>,
+                std::string);
+
+            std::vector<std::string>::const_iterator begin() const override;
+            std::vector<std::string>::const_iterator end() const override;
+
+            /**
+             * The primitive the value is written as, the restricted type's
+             * source
+             */
+            const std::string & primitive() const;
+
+            int dependsOnRHS (const Composite &) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -6,6 +6,7 @@
 
 #include "Map.h"
 #include "List.h"
+#include "Described.h"
 #include "amqp/schema/described-types/Composite.h"
 
 /******************************************************************************/
@@ -94,6 +95,15 @@ Enum::dependsOnEnum (const amqp::internal::schema::Enum &) const {
 
 /*********************************************************o*********************/
 
+int
+amqp::internal::schema::
+Enum::dependsOnDescribed (const amqp::internal::schema::Described &) const {
+    // neither can depend on the other
+    return 0;
+}
+
+/******************************************************************************/
+
 int
 amqp::internal::schema::
 Enum::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
@@ -2,6 +2,7 @@
 #include "List.h"
 #include "Map.h"
 #include "Enum.h"
+#include "Described.h"
 
 #include "debug.h"
 #include "colours.h"
@@ -135,6 +136,19 @@ List::dependsOnEnum (const amqp::internal::schema::Enum & enum_) const {
 
 /******************************************************************************/
 
+int
+amqp::internal::schema::
+List::dependsOnDescribed (const amqp::internal::schema::Described & described_) const {
+    // do we depend on the lhs, it can't depend on us
+    if (listOf() == described_.name()) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
 int
 amqp::internal::schema::
 List::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
@@ -1,6 +1,7 @@
 #include "Map.h"
 #include "List.h"
 #include "Enum.h"
+#include "Described.h"
 #include "amqp/schema/described-types/Composite.h"
 
 /******************************************************************************
@@ -150,6 +151,21 @@ Map::dependsOnEnum (const amqp::internal::schema::Enum & lhs_) const {
 
 /******************************************************************************/
 
+int
+amqp::internal::schema::
+Map::dependsOnDescribed (const amqp::internal::schema::Described & described_) const {
+    // do we depend on the lhs, it can't depend on us
+    auto of { mapOf() };
+
+    if (of.first.get() == described_.name() || of.second.get() == described_.name()) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
 int
 amqp::internal::schema::
 Map::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const  {
@@ -4,6 +4,7 @@
 #include "List.h"
 #include "Enum.h"
 #include "Array.h"
+#include "Described.h"
 
 #include <string>
 #include <vector>
@@ -65,6 +66,10 @@ namespace amqp::internal::schema {
                 stream_ << "array";
                 break;
             }
+            case Restricted::RestrictedTypes::described_t : {
+                stream_ << "described";
+                break;
+            }
         }
 
         return stream_;
@@ -82,7 +87,7 @@ namespace {
 
     std::map<std::string, std::string> boxedToUnboxed = {
             { "java.lang.Integer", "int" },
-            { "java.lang.Boolean", "bool" },
+            { "java.lang.Boolean", "boolean" },
             { "java.lang.Byte", "char" },
             { "java.lang.Short", "short" },
             { "java.lang.Character", "char" },
@@ -184,6 +189,18 @@ Restricted::make(
                 std::move (label_),
                 std::move (provides_),
                 std::move (source_));
+    } else if (Field::typeIsPrimitive (source_)) {
+        /*
+         * Corda's custom serializers that write a type as a string, such
+         * as BigDecimal, or as bytes, such as PublicKey, name that
+         * primitive as the source
+         */
+        return std::make_unique<Described> (
+                std::move (descriptor_),
+                std::move (name_),
+                std::move (label_),
+                std::move (provides_),
+                std::move (source_));
     } else {
         throw std::runtime_error ("Unknown restricted type");
     }
@@ -255,6 +272,9 @@ Restricted::dependsOnRHS (const Restricted & lhs_) const  {
         case Restricted::RestrictedTypes::array_t :
             return dependsOnArray (
                     static_cast<const amqp::internal::schema::Array &>(lhs_)); // NOLINT
+        case Restricted::RestrictedTypes::described_t :
+            return dependsOnDescribed (
+                    static_cast<const amqp::internal::schema::Described &>(lhs_)); // NOLINT
     }
 }
 
@@ -29,6 +29,7 @@ namespace amqp::internal::schema {
     class Enum;
     class List;
     class Array;
+    class Described;
 
 }
 
@@ -44,7 +45,7 @@ namespace amqp::internal::schema {
         public :
             friend std::ostream & operator << (std::ostream &, const Restricted&);
 
-            enum RestrictedTypes { list_t, map_t, enum_t, array_t };
+            enum RestrictedTypes { list_t, map_t, enum_t, array_t, described_t };
 
             static std::string unbox (const std::string &);
 
@@ -61,7 +62,7 @@ namespace amqp::internal::schema {
             std::vector<std::string> m_provides;
 
             /**
-             * Is it a map or list
+             * Is it a map, list or a described primitive
              */
             RestrictedTypes m_source;
 
@@ -80,6 +81,7 @@ namespace amqp::internal::schema {
             virtual int dependsOnList (const List &) const = 0;
             virtual int dependsOnArray (const Array &) const = 0;
             virtual int dependsOnEnum (const Enum &) const = 0;
+            virtual int dependsOnDescribed (const Described &) const = 0;
 
         public :
             static std::unique_ptr<Restricted> make(
@@ -0,0 +1,576 @@
+#include "Blob.h"
+
+#include <string>
+#include <stdexcept>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/field-types/Field.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/restricted-types/Map.h"
+#include "amqp/schema/restricted-types/List.h"
+#include "amqp/schema/restricted-types/Array.h"
+#include "amqp/schema/restricted-types/Restricted.h"
+#include "amqp/schema/restricted-types/Described.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+namespace {
+
+    [[noreturn]] void
+    noEnvelope() {
+        throw std::runtime_error ("Blob does not contain an envelope");
+    }
+
+    [[noreturn]] void
+    unexpected (pn_type_t type_, const std::string & reading_) {
+        throw std::runtime_error (
+            std::string ("Unexpected ") + pn_type_name (type_)
+                + " reading " + reading_);
+    }
+
+    std::string_view
+    view (const pn_atom_t & atom_) {
+        return { atom_.u.as_bytes.start, atom_.u.as_bytes.size };
+    }
+
+    /**
+     * The encoding of a property of the schema's type [type_], where it's
+     * one of the primitives we read
+     */
+    pn_type_t
+    primitive (const std::string & type_) {
+        if (type_ == "int") return PN_INT;
+        if (type_ == "long") return PN_LONG;
+        if (type_ == "string") return PN_STRING;
+        if (type_ == "boolean") return PN_BOOL;
+        if (type_ == "double") return PN_DOUBLE;
+        if (type_ == "binary") return PN_BINARY;
+        if (type_ == "timestamp") return PN_TIMESTAMP;
+        if (type_ == "uuid") return PN_UUID;
+
+        return PN_INVALID;
+    }
+
+    [[noreturn]] void
+    mismatch (pn_type_t found_, pn_type_t expected_) {
+        throw std::runtime_error (
+            std::string ("Expected ") + pn_type_name (expected_)
+                + ", found " + pn_type_name (found_));
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stream::Blob
+ *
+ ******************************************************************************/
+
+amqp::internal::stream::
+Blob::Blob (
+    const schema::Schema & schema_,
+    amqp::reader::IVisitor & visitor_
+) : m_visitor { visitor_ }
+  , m_decoder { *this }
+  , m_header { 0 }
+  , m_expected { PN_INVALID }
+  , m_raising { false }
+  , m_timestamp { reader::Natives::find ("timestamp") }
+  , m_uuid { reader::Natives::find ("uuid") }
+{
+    m_atoms.reserve (reader::Natives::arity);
+    m_held.reserve (reader::Natives::arity);
+
+    for (auto i { schema_.begin() } ; i != schema_.end() ; ++i) {
+        for (auto & j : *i) {
+            auto [it, added] = m_types.try_emplace (j->descriptor());
+
+            if (!added) {
+                continue;
+            }
+
+            auto & known = it->second;
+            known.type = j.get();
+            known.format = reader::Natives::find (j->name(), j->descriptor());
+
+            if (!known.format
+                && j->type() == schema::AMQPTypeNotation::restricted_t
+                && static_cast<const schema::Restricted *> (
+                        j.get())->restrictedType() == schema::Restricted::described_t)
+            {
+                known.format = reader::Natives::find (
+                    static_cast<const schema::Described *> (j.get())->primitive());
+            }
+
+            if (j->type() == schema::AMQPTypeNotation::composite_t) {
+                for (const auto & field : static_cast<const schema::Composite *> (
+                        j.get())->fields())
+                {
+                    known.fields.push_back (primitive (field->type()));
+                }
+            }
+        }
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::stream::Decoder::Status
+amqp::internal::stream::
+Blob::feed (const char * bytes_, size_t size_) {
+    const auto & magic = amqp::AMQP_HEADER;
+
+    for ( ; m_header <= magic.size() && size_ ; ++m_header, ++bytes_, --size_) {
+        if (m_header < magic.size() && *bytes_ != magic[m_header]) {
+            throw std::runtime_error ("Not a Corda stream");
+        }
+
+        if (m_header == magic.size() && *bytes_ != amqp::DATA_AND_STOP) {
+            throw std::runtime_error (
+                "Unsupported Corda encoding " + std::to_string (*bytes_));
+        }
+    }
+
+    return m_decoder.feed (bytes_, size_);
+}
+
+/******************************************************************************/
+
+const amqp::internal::stream::Decoder &
+amqp::internal::stream::
+Blob::decoder() const {
+    return m_decoder;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::stream::
+Blob::path() const {
+    std::string rtn;
+
+    for (size_t i { 0 } ; i < m_frames.size() ; ++i) {
+        const auto & frame = m_frames[i];
+        auto index = frame.index;
+
+        if (m_raising || i + 1 < m_frames.size()) {
+            if (!index) {
+                continue;
+            }
+
+            --index;
+        }
+
+        switch (frame.kind) {
+            case fields_e : {
+                const auto & fields = static_cast<const schema::Composite *> (
+                    frame.type)->fields();
+
+                if (!rtn.empty()) {
+                    rtn += '.';
+                }
+
+                rtn += index < fields.size()
+                    ? fields[index]->name()
+                    : "#" + std::to_string (index);
+
+                break;
+            }
+            case list_e :
+                rtn += "[" + std::to_string (index) + "]";
+                break;
+            case map_e :
+                rtn += "[" + std::to_string (index / 2)
+                    + (index % 2 ? "].value" : "].key");
+                break;
+            default :
+                break;
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * Enter a list or map of [type_], noting what its elements are if they're
+ * primitives
+ */
+void
+amqp::internal::stream::
+Blob::push (Kind kind_, const schema::AMQPTypeNotation * type_) {
+    Frame frame { kind_, 0, type_ };
+
+    const auto * restricted = static_cast<const schema::Restricted *> (type_);
+
+    switch (restricted->restrictedType()) {
+        case schema::Restricted::list_t :
+            frame.elements[0] = frame.elements[1] = primitive (
+                static_cast<const schema::List *> (restricted)->listOf());
+            break;
+        case schema::Restricted::array_t :
+            frame.elements[0] = frame.elements[1] = primitive (
+                static_cast<const schema::Array *> (restricted)->arrayOf());
+            break;
+        case schema::Restricted::map_t : {
+            auto [key, value] = static_cast<const schema::Map *> (
+                restricted)->mapOf();
+
+            frame.elements[0] = primitive (key);
+            frame.elements[1] = primitive (value);
+            break;
+        }
+        default :
+            break;
+    }
+
+    m_frames.push_back (frame);
+}
+
+/******************************************************************************/
+
+/**
+ * What the value about to be raised is to the blob, announcing it as the
+ * property it is if it's one
+ */
+amqp::internal::stream::Blob::Role
+amqp::internal::stream::
+Blob::child() {
+    m_expected = PN_INVALID;
+
+    if (m_frames.empty()) {
+        return root_e;
+    }
+
+    auto & frame = m_frames.back();
+    auto index = frame.index++;
+
+    switch (frame.kind) {
+        case envelope_e :
+            return index == 0 ? envelopeDescriptor_e : sectionList_e;
+        case sections_e :
+            return index == 0 ? object_e : ignored_e;
+        case described_e :
+            return index == 0 ? descriptor_e : body_e;
+        case fields_e : {
+            const auto & fields = static_cast<const schema::Composite *> (
+                frame.type)->fields();
+
+            if (index >= fields.size()) {
+                throw std::runtime_error (
+                    "More properties than " + frame.type->name() + " has");
+            }
+
+            m_visitor.onField (fields[index]->name());
+            m_expected = frame.fields[index];
+
+            return object_e;
+        }
+        case list_e :
+        case map_e :
+            m_expected = frame.elements[index % 2];
+            return object_e;
+        case enum_e :
+            return index == 0 ? constant_e : ignored_e;
+        case native_e :
+            return atom_e;
+        default :
+            return ignored_e;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stream::
+Blob::onBegin (pn_type_t type_, size_t count_) {
+    m_raising = true;
+
+    switch (child()) {
+        case root_e :
+            if (type_ != PN_DESCRIBED) {
+                noEnvelope();
+            }
+
+            m_frames.push_back ({ envelope_e, 0, nullptr });
+            break;
+        case sectionList_e :
+            if (type_ != PN_LIST) {
+                noEnvelope();
+            }
+
+            m_frames.push_back ({ sections_e, 0, nullptr });
+            break;
+        case object_e :
+            if (m_expected != PN_INVALID) {
+                mismatch (type_, m_expected);
+            }
+
+            if (type_ != PN_DESCRIBED) {
+                throw std::runtime_error ("Expected a described type");
+            }
+
+            m_frames.push_back ({ described_e, 0, nullptr });
+            break;
+        case body_e : {
+            auto type = m_frames.back().type;
+
+            if (m_frames.back().format) {
+                if (type_ != PN_LIST) {
+                    unexpected (type_, type->name());
+                }
+
+                Frame frame { native_e, 0, type };
+                frame.format = m_frames.back().format;
+
+                m_frames.push_back (frame);
+                m_atoms.clear();
+                m_held.clear();
+                break;
+            }
+
+            if (type->type() == schema::AMQPTypeNotation::composite_t) {
+                if (type_ != PN_LIST) {
+                    unexpected (type_, type->name());
+                }
+
+                Frame frame { fields_e, 0, type };
+                frame.fields = m_frames.back().fields;
+
+                m_frames.push_back (frame);
+                break;
+            }
+
+            switch (static_cast<const schema::Restricted *> (type)->restrictedType()) {
+                case schema::Restricted::list_t :
+                case schema::Restricted::array_t :
+                    if (type_ != PN_LIST && type_ != PN_ARRAY) {
+                        unexpected (type_, type->name());
+                    }
+
+                    m_visitor.onListBegin (count_);
+                    push (list_e, type);
+                    break;
+                case schema::Restricted::map_t :
+                    if (type_ != PN_MAP) {
+                        unexpected (type_, type->name());
+                    }
+
+                    m_visitor.onMapBegin (count_ / 2);
+                    push (map_e, type);
+                    break;
+                case schema::Restricted::enum_t :
+                    if (type_ != PN_LIST) {
+                        unexpected (type_, type->name());
+                    }
+
+                    m_frames.push_back ({ enum_e, 0, type });
+                    break;
+                case schema::Restricted::described_t :
+                    unexpected (type_, type->name());
+            }
+
+            break;
+        }
+        case ignored_e :
+            m_frames.push_back ({ skipped_e, 0, nullptr });
+            break;
+        case envelopeDescriptor_e :
+            noEnvelope();
+        case descriptor_e :
+            throw std::runtime_error ("Expected a symbol");
+        case constant_e :
+            throw std::runtime_error ("Expected a String");
+        case atom_e :
+            unexpected (type_, m_frames.back().type->name());
+    }
+
+    m_raising = false;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stream::
+Blob::onEnd (pn_type_t) {
+    auto frame = m_frames.back();
+
+    if (frame.kind == fields_e) {
+        const auto & fields = static_cast<const schema::Composite *> (
+            frame.type)->fields();
+
+        // thrown with the frame still in place, so the path ends at the
+        // first property missing
+        if (frame.index < fields.size()) {
+            throw std::runtime_error (
+                "Missing property " + fields[frame.index]->name()
+                    + " of " + frame.type->name());
+        }
+    }
+
+    m_frames.pop_back();
+
+    switch (frame.kind) {
+        case described_e :
+            if (!frame.format
+                && frame.type->type() == schema::AMQPTypeNotation::composite_t)
+            {
+                m_visitor.onCompositeEnd();
+            }
+            break;
+        case native_e :
+            native (frame.format, m_atoms.data(), m_atoms.size());
+            break;
+        case list_e :
+            m_visitor.onListEnd();
+            break;
+        case map_e :
+            m_visitor.onMapEnd();
+            break;
+        default :
+            break;
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::stream::
+Blob::onValue (const pn_atom_t & atom_) {
+    m_raising = true;
+
+    switch (child()) {
+        case envelopeDescriptor_e :
+            if (atom_.type != PN_ULONG
+                || amqp::stripCorda (atom_.u.as_ulong)
+                        != static_cast<uint32_t>(
+                            amqp::schema::descriptors::ENVELOPE))
+            {
+                noEnvelope();
+            }
+            break;
+        case descriptor_e : {
+            if (atom_.type == PN_ULONG
+                && amqp::stripCorda (atom_.u.as_ulong)
+                        == static_cast<uint32_t>(
+                            amqp::schema::descriptors::REFERENCED_OBJECT))
+            {
+                throw std::runtime_error (
+                    "Currently don't support referenced objects");
+            }
+
+            if (atom_.type != PN_SYMBOL) {
+                throw std::runtime_error ("Expected a symbol");
+            }
+
+            auto it = m_types.find (view (atom_));
+
+            if (it == m_types.end()) {
+                throw std::runtime_error (
+                    "No type for descriptor " + std::string (view (atom_)));
+            }
+
+            m_frames.back().type = it->second.type;
+            m_frames.back().fields = it->second.fields.data();
+            m_frames.back().format = it->second.format;
+
+            if (!it->second.format
+                && it->second.type->type() == schema::AMQPTypeNotation::composite_t)
+            {
+                m_visitor.onCompositeBegin (it->second.type->name(), view (atom_));
+            }
+
+            break;
+        }
+        case constant_e :
+            if (atom_.type != PN_STRING && atom_.type != PN_SYMBOL) {
+                throw std::runtime_error ("Expected a String");
+            }
+
+            m_visitor.onString (view (atom_));
+            break;
+        case object_e :
+            if (m_expected != PN_INVALID && atom_.type != m_expected) {
+                mismatch (atom_.type, m_expected);
+            }
+
+            switch (atom_.type) {
+                case PN_BOOL :      m_visitor.onBool (atom_.u.as_bool); break;
+                case PN_UBYTE :     m_visitor.onInt (atom_.u.as_ubyte); break;
+                case PN_BYTE :      m_visitor.onInt (atom_.u.as_byte); break;
+                case PN_USHORT :    m_visitor.onInt (atom_.u.as_ushort); break;
+                case PN_SHORT :     m_visitor.onInt (atom_.u.as_short); break;
+                case PN_INT :       m_visitor.onInt (atom_.u.as_int); break;
+                case PN_CHAR :      m_visitor.onInt (atom_.u.as_char); break;
+                case PN_UINT :      m_visitor.onLong (atom_.u.as_uint); break;
+                case PN_LONG :      m_visitor.onLong (atom_.u.as_long); break;
+                case PN_ULONG :     m_visitor.onLong (atom_.u.as_ulong); break;
+                case PN_TIMESTAMP : native (m_timestamp, &atom_, 1); break;
+                case PN_UUID :      native (m_uuid, &atom_, 1); break;
+                case PN_FLOAT :     m_visitor.onDouble (atom_.u.as_float); break;
+                case PN_DOUBLE :    m_visitor.onDouble (atom_.u.as_double); break;
+                case PN_STRING :
+                case PN_SYMBOL :    m_visitor.onString (view (atom_)); break;
+                case PN_BINARY :    m_visitor.onBinary (view (atom_)); break;
+                default :
+                    throw std::runtime_error (
+                        std::string ("Can't visit a ") + pn_type_name (atom_.type));
+            }
+            break;
+        case atom_e : {
+            if (m_atoms.size() == reader::Natives::arity) {
+                throw std::runtime_error (
+                    "Too many values for " + m_frames.back().type->name());
+            }
+
+            m_atoms.push_back (atom_);
+
+            if (atom_.type == PN_STRING || atom_.type == PN_SYMBOL || atom_.type == PN_BINARY) {
+                const auto & held = m_held.emplace_back (view (atom_));
+
+                m_atoms.back().u.as_bytes = { held.size(), held.data() };
+            }
+            break;
+        }
+        case ignored_e :
+            break;
+        case root_e :
+        case sectionList_e :
+            noEnvelope();
+        case body_e :
+            if (!m_frames.back().format) {
+                unexpected (atom_.type, m_frames.back().type->name());
+            }
+
+            native (m_frames.back().format, &atom_, 1);
+            break;
+    }
+
+    m_raising = false;
+}
+
+/******************************************************************************/
+
+/**
+ * Raise the text [format_] makes of a native's primitives
+ */
+void
+amqp::internal::stream::
+Blob::native (
+    reader::Natives::Format format_,
+    const pn_atom_t * atoms_,
+    size_t count_
+) {
+    std::string text;
+    format_ (text, atoms_, count_);
+
+    m_visitor.onString (text);
+}
+
+/******************************************************************************/
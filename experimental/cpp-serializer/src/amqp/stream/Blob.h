@@ -0,0 +1,188 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "types.h"
+#include "Decoder.h"
+#include "amqp/reader/Natives.h"
+
+/******************************************************************************/
+
+namespace amqp::reader {
+    class IVisitor;
+}
+
+namespace amqp::internal::schema {
+    class Field;
+    class Schema;
+    class AMQPTypeNotation;
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::stream {
+
+    /**
+     * The object of a Corda blob, read from the blob's bytes, Corda header
+     * and all, as they arrive and raised on an [amqp::reader::IVisitor] as
+     * the readers' [visit] would raise it, each value as soon as it's
+     * complete.
+     *
+     * A blob's envelope carries its schema after its object, so the schema
+     * has to be known before the blob is, as it is for the blobs of a
+     * class that's been seen before. The blob's own schema and transforms
+     * are stepped over as they go by.
+     *
+     * A property, list element or map key or value the schema gives a
+     * primitive type must hold that type.
+     *
+     * Values of the types [reader::Natives] decode are raised as the
+     * strings they decode to once their primitives have all arrived.
+     */
+    class Blob : private IEvents {
+        private :
+            /**
+             * What each compound the decoder is inside is to the blob
+             */
+            enum Kind {
+                envelope_e,
+                sections_e,
+                described_e,
+                fields_e,
+                list_e,
+                map_e,
+                enum_e,
+                native_e,
+                skipped_e
+            };
+
+            /**
+             * What a compound's next child is to the blob
+             */
+            enum Role {
+                root_e,
+                envelopeDescriptor_e,
+                sectionList_e,
+                object_e,
+                descriptor_e,
+                body_e,
+                constant_e,
+                atom_e,
+                ignored_e
+            };
+
+            struct Frame {
+                Kind kind;
+
+                size_t index;
+
+                /**
+                 * The type a described value's descriptor named
+                 */
+                const schema::AMQPTypeNotation * type;
+
+                /**
+                 * The primitive types of a list's elements, or of a map's
+                 * keys and values, where the schema says they're one
+                 */
+                pn_type_t elements[2] { PN_INVALID, PN_INVALID };
+
+                /**
+                 * Those of a composite's properties, from [Known::fields]
+                 */
+                const pn_type_t * fields { nullptr };
+
+                /**
+                 * The decoder of a described value the [reader::Natives]
+                 * decode, from [Known::format]
+                 */
+                reader::Natives::Format format { nullptr };
+            };
+
+            /**
+             * A type the schema describes and, for a composite, the
+             * primitive type of each of its properties
+             */
+            struct Known {
+                const schema::AMQPTypeNotation * type;
+                std::vector<pn_type_t>           fields;
+                reader::Natives::Format          format;
+            };
+
+            std::map<std::string_view, Known, std::less<>> m_types;
+
+            amqp::reader::IVisitor & m_visitor;
+
+            Decoder m_decoder;
+
+            std::vector<Frame> m_frames;
+
+            /**
+             * Bytes of the Corda header seen so far
+             */
+            size_t m_header;
+
+            /**
+             * The primitive type the schema says the value about to be
+             * raised is, PN_INVALID where it doesn't say or it isn't one
+             */
+            pn_type_t m_expected;
+
+            /**
+             * Whether an event's being handled, so a problem lies with the
+             * innermost compound's latest child rather than its next
+             */
+            bool m_raising;
+
+            /**
+             * The primitives of the native being read, with the bytes of
+             * any that have them held as they won't outlive their event
+             */
+            std::vector<pn_atom_t>   m_atoms;
+            std::vector<std::string> m_held;
+
+            /**
+             * The decoders of the primitives that are natives themselves
+             */
+            reader::Natives::Format m_timestamp;
+            reader::Natives::Format m_uuid;
+
+            void native (reader::Natives::Format, const pn_atom_t *, size_t);
+
+            Role child();
+            void push (Kind, const schema::AMQPTypeNotation *);
+
+            void onBegin (pn_type_t, size_t) override;
+            void onEnd (pn_type_t) override;
+            void onValue (const pn_atom_t &) override;
+
+        public :
+            /**
+             * The schema has to outlive the blob
+             */
+            Blob (const schema::Schema &, amqp::reader::IVisitor &);
+
+            /**
+             * As for [Decoder::feed], the first chunk starting with the
+             * Corda header
+             */
+            Decoder::Status feed (const char * bytes_, size_t size_);
+
+            const Decoder & decoder() const;
+
+            /**
+             * Where in the object the decoder is, each property by name
+             * and each list element or map entry by index, such as
+             * "legs[2].amount". Empty outside the object.
+             */
+            std::string path() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,551 @@
+#include "Decoder.h"
+
+#include <limits>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+
+#include "amqp/tape/Tape.h"
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+
+    uint64_t
+    be (const char * bytes_, size_t width_) {
+        uint64_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < width_ ; ++i) {
+            rtn = (rtn << 8) | static_cast<uint8_t>(bytes_[i]);
+        }
+
+        return rtn;
+    }
+
+    template<typename T>
+    T
+    bits (const char * bytes_) {
+        auto raw = be (bytes_, sizeof (T));
+
+        T rtn;
+        if constexpr (sizeof (T) == 4) {
+            auto narrow = static_cast<uint32_t>(raw);
+            memcpy (&rtn, &narrow, sizeof (T));
+        } else {
+            memcpy (&rtn, &raw, sizeof (T));
+        }
+
+        return rtn;
+    }
+
+    [[noreturn]] void
+    unknown (uint8_t code_, size_t offset_) {
+        std::stringstream ss;
+        ss << "Unknown AMQP format code 0x"
+           << std::hex << std::setw (2) << std::setfill ('0')
+           << static_cast<int>(code_)
+           << std::dec << " at offset " << offset_;
+
+        throw std::runtime_error (ss.str());
+    }
+
+    /**
+     * The value of a fixed width encoding from its content
+     */
+    pn_atom_t
+    atom (uint8_t code_, const char * bytes_) {
+        pn_atom_t rtn { };
+
+        switch (code_) {
+            case 0x40 :
+                rtn.type = PN_NULL;
+                break;
+            case 0x41 : case 0x42 :
+                rtn.type = PN_BOOL;
+                rtn.u.as_bool = code_ == 0x41;
+                break;
+            case 0x56 :
+                rtn.type = PN_BOOL;
+                rtn.u.as_bool = bytes_[0] != 0;
+                break;
+            case 0x50 :
+                rtn.type = PN_UBYTE;
+                rtn.u.as_ubyte = static_cast<uint8_t>(bytes_[0]);
+                break;
+            case 0x51 :
+                rtn.type = PN_BYTE;
+                rtn.u.as_byte = static_cast<int8_t>(bytes_[0]);
+                break;
+            case 0x60 :
+                rtn.type = PN_USHORT;
+                rtn.u.as_ushort = be (bytes_, 2);
+                break;
+            case 0x61 :
+                rtn.type = PN_SHORT;
+                rtn.u.as_short = static_cast<int16_t>(be (bytes_, 2));
+                break;
+            case 0x43 : case 0x52 : case 0x70 :
+                rtn.type = PN_UINT;
+                rtn.u.as_uint = be (bytes_, amqp::internal::tape::fixed (code_));
+                break;
+            case 0x54 :
+                rtn.type = PN_INT;
+                rtn.u.as_int = static_cast<int8_t>(bytes_[0]);
+                break;
+            case 0x71 :
+                rtn.type = PN_INT;
+                rtn.u.as_int = static_cast<int32_t>(be (bytes_, 4));
+                break;
+            case 0x44 : case 0x53 : case 0x80 :
+                rtn.type = PN_ULONG;
+                rtn.u.as_ulong = be (bytes_, amqp::internal::tape::fixed (code_));
+                break;
+            case 0x55 :
+                rtn.type = PN_LONG;
+                rtn.u.as_long = static_cast<int8_t>(bytes_[0]);
+                break;
+            case 0x81 :
+                rtn.type = PN_LONG;
+                rtn.u.as_long = static_cast<int64_t>(be (bytes_, 8));
+                break;
+            case 0x72 :
+                rtn.type = PN_FLOAT;
+                rtn.u.as_float = bits<float> (bytes_);
+                break;
+            case 0x82 :
+                rtn.type = PN_DOUBLE;
+                rtn.u.as_double = bits<double> (bytes_);
+                break;
+            case 0x73 :
+                rtn.type = PN_CHAR;
+                rtn.u.as_char = be (bytes_, 4);
+                break;
+            case 0x83 :
+                rtn.type = PN_TIMESTAMP;
+                rtn.u.as_timestamp = static_cast<int64_t>(be (bytes_, 8));
+                break;
+            case 0x74 :
+                rtn.type = PN_DECIMAL32;
+                rtn.u.as_decimal32 = be (bytes_, 4);
+                break;
+            case 0x84 :
+                rtn.type = PN_DECIMAL64;
+                rtn.u.as_decimal64 = be (bytes_, 8);
+                break;
+            case 0x94 :
+                rtn.type = PN_DECIMAL128;
+                memcpy (rtn.u.as_decimal128.bytes, bytes_, 16);
+                break;
+            case 0x98 :
+                rtn.type = PN_UUID;
+                memcpy (rtn.u.as_uuid.bytes, bytes_, 16);
+                break;
+            default :
+                break;
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::stream::Decoder
+ *
+ ******************************************************************************/
+
+amqp::internal::stream::
+Decoder::Decoder (IEvents & events_)
+    : m_events { events_ }
+    , m_step { code_e }
+    , m_code { 0 }
+    , m_size { 0 }
+    , m_offset { 0 }
+    , m_start { 0 }
+    , m_at { nullptr }
+    , m_end { nullptr }
+    , m_done { false }
+{ }
+
+/******************************************************************************/
+
+amqp::internal::stream::Decoder::Status
+amqp::internal::stream::
+Decoder::feed (const char * bytes_, size_t size_) {
+    m_at = bytes_;
+    m_end = bytes_ + size_;
+
+    /*
+     * Bytes held over for a step are done with once it's been taken
+     */
+    while (m_at != m_end || !m_done) {
+        if (m_done) {
+            throw std::runtime_error (
+                "Input continues past the end of the AMQP value at offset "
+                    + std::to_string (m_offset));
+        }
+
+        if (!step()) {
+            break;
+        }
+
+        m_held.clear();
+    }
+
+    m_at = m_end = nullptr;
+
+    return m_done ? done_e : more_e;
+}
+
+/******************************************************************************/
+
+/**
+ * Point [bytes_] at the next [size_] bytes, straight into the chunk being
+ * fed where they're all in it, otherwise gathering them into [m_held] over
+ * as many chunks as it takes. False while they're still incomplete.
+ */
+bool
+amqp::internal::stream::
+Decoder::take (size_t size_, const char *& bytes_) {
+    auto available = static_cast<size_t>(m_end - m_at);
+
+    if (m_held.empty() && available >= size_) {
+        bytes_ = m_at;
+        m_at += size_;
+        m_offset += size_;
+
+        return true;
+    }
+
+    auto n = std::min (size_ - m_held.size(), available);
+
+    m_held.append (m_at, n);
+    m_at += n;
+    m_offset += n;
+
+    if (m_held.size() < size_) {
+        return false;
+    }
+
+    bytes_ = m_held.data();
+
+    return true;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::stream::
+Decoder::prefix() const {
+    return (m_code & 0x10) ? 4 : 1;
+}
+
+/******************************************************************************/
+
+/**
+ * Described values carry no size of their own, so are bounded by whatever
+ * they're inside
+ */
+size_t
+amqp::internal::stream::
+Decoder::bound() const {
+    for (auto it = m_stack.rbegin() ; it != m_stack.rend() ; ++it) {
+        if (it->end != unbounded) {
+            return it->end;
+        }
+    }
+
+    return unbounded;
+}
+
+/******************************************************************************/
+
+/**
+ * Take the current step, false if the input ran out first
+ */
+bool
+amqp::internal::stream::
+Decoder::step() {
+    const char * bytes;
+
+    switch (m_step) {
+        case code_e : {
+            if (!take (1, bytes)) {
+                return false;
+            }
+
+            m_start = m_offset - 1;
+            m_code = bytes[0];
+
+            dispatch();
+            break;
+        }
+        case value_e : {
+            dispatch();
+            break;
+        }
+        case fixed_e : {
+            if (!take (tape::fixed (m_code), bytes)) {
+                return false;
+            }
+
+            if (m_code == 0x45) {
+                m_events.onBegin (PN_LIST, 0);
+                m_events.onEnd (PN_LIST);
+            } else {
+                m_events.onValue (atom (m_code, bytes));
+            }
+
+            completed();
+            break;
+        }
+        case size_e : {
+            if (!take (prefix(), bytes)) {
+                return false;
+            }
+
+            m_size = be (bytes, prefix());
+
+            /*
+             * Checked before anything is buffered on the size's say so, a
+             * string claiming gigabytes inside a list of a few bytes is
+             * rejected rather than waited for
+             */
+            if (m_size > bound() - m_offset) {
+                throw std::runtime_error (
+                    "Value at offset " + std::to_string (m_start)
+                        + " claims " + std::to_string (m_size)
+                        + " bytes, running past the end of its enclosing value at offset "
+                        + std::to_string (bound()));
+            }
+
+            if (m_code < 0xc0) {
+                m_step = payload_e;
+            } else if (m_code < 0xe0 && m_size < prefix()) {
+                throw std::runtime_error (
+                    "Compound value at offset " + std::to_string (m_start)
+                        + " is too short");
+            } else if (m_code >= 0xe0 && m_size < prefix() + 1) {
+                throw std::runtime_error (
+                    "Array at offset " + std::to_string (m_start)
+                        + " is too short");
+            } else {
+                m_step = count_e;
+            }
+
+            break;
+        }
+        case payload_e : {
+            if (!take (m_size, bytes)) {
+                return false;
+            }
+
+            pn_atom_t value { };
+
+            switch (m_code) {
+                case 0xa0 : case 0xb0 : value.type = PN_BINARY; break;
+                case 0xa1 : case 0xb1 : value.type = PN_STRING; break;
+                default :               value.type = PN_SYMBOL; break;
+            }
+
+            value.u.as_bytes = pn_bytes (m_size, bytes);
+
+            m_events.onValue (value);
+
+            completed();
+            break;
+        }
+        case count_e : {
+            if (!take (prefix(), bytes)) {
+                return false;
+            }
+
+            auto count = static_cast<uint32_t>(be (bytes, prefix()));
+            auto end = m_offset - prefix() + m_size;
+
+            if (m_code >= 0xe0) {
+                m_stack.push_back ({ PN_ARRAY, count, end, 0, false });
+                m_step = element_e;
+                break;
+            }
+
+            auto type = (m_code & 0x01) ? PN_MAP : PN_LIST;
+
+            m_events.onBegin (type, count);
+
+            if (count) {
+                m_stack.push_back ({ type, count, end, 0, false });
+                next();
+            } else {
+                m_events.onEnd (type);
+                completed();
+            }
+
+            break;
+        }
+        case element_e : {
+            if (!take (1, bytes)) {
+                return false;
+            }
+
+            auto & frame = m_stack.back();
+            auto code = static_cast<uint8_t>(bytes[0]);
+
+            /*
+             * A described array's descriptor sits between its count and
+             * the constructor its elements share
+             */
+            if (code == 0x00) {
+                if (frame.described) {
+                    unknown (code, m_offset - 1);
+                }
+
+                frame.described = true;
+                m_events.onBegin (PN_ARRAY, frame.remaining + 1);
+                m_step = code_e;
+                break;
+            }
+
+            frame.element = code;
+
+            if (!frame.described) {
+                m_events.onBegin (PN_ARRAY, frame.remaining);
+            }
+
+            if (frame.remaining) {
+                next();
+            } else {
+                m_stack.pop_back();
+                m_events.onEnd (PN_ARRAY);
+                completed();
+            }
+
+            break;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Work out what to read of the value whose constructor is [m_code]
+ */
+void
+amqp::internal::stream::
+Decoder::dispatch() {
+    if (m_code == 0x00) {
+        m_events.onBegin (PN_DESCRIBED, 2);
+        m_stack.push_back ({ PN_DESCRIBED, 2, unbounded, 0, false });
+        m_step = code_e;
+        return;
+    }
+
+    if (tape::fixed (m_code) >= 0) {
+        m_step = fixed_e;
+        return;
+    }
+
+    switch (m_code) {
+        case 0xa0 : case 0xa1 : case 0xa3 :
+        case 0xb0 : case 0xb1 : case 0xb3 :
+        case 0xc0 : case 0xc1 : case 0xd0 : case 0xd1 :
+        case 0xe0 : case 0xf0 :
+            m_step = size_e;
+            break;
+        default :
+            unknown (m_code, m_start);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Set up to read the next child of the innermost compound, which for an
+ * array is an element without a constructor of its own
+ */
+void
+amqp::internal::stream::
+Decoder::next() {
+    auto & frame = m_stack.back();
+
+    if (frame.type != PN_ARRAY) {
+        m_step = code_e;
+    } else if (frame.element) {
+        m_start = m_offset;
+        m_code = frame.element;
+        m_step = value_e;
+    } else {
+        m_step = element_e;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * A value has been read whole, close every compound it was the last
+ * child of
+ */
+void
+amqp::internal::stream::
+Decoder::completed() {
+    while (!m_stack.empty()) {
+        auto & frame = m_stack.back();
+
+        if (m_offset > frame.end) {
+            throw std::runtime_error (
+                "Compound value ending at offset " + std::to_string (frame.end)
+                    + " overrun at offset " + std::to_string (m_offset));
+        }
+
+        // a described array's descriptor, its elements are still to come
+        if (frame.type == PN_ARRAY && !frame.element) {
+            m_step = element_e;
+            return;
+        }
+
+        if (--frame.remaining) {
+            next();
+            return;
+        }
+
+        auto type = frame.type;
+
+        m_stack.pop_back();
+        m_events.onEnd (type);
+    }
+
+    m_done = true;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::stream::
+Decoder::offset() const {
+    return m_offset;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::stream::
+Decoder::start() const {
+    return m_start;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::stream::
+Decoder::depth() const {
+    return m_stack.size();
+}
+
+/******************************************************************************/
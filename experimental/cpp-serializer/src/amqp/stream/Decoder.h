@@ -0,0 +1,165 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <proton/types.h>
+#include <proton/codec.h>
+
+/******************************************************************************/
+
+namespace amqp::internal::stream {
+
+    /**
+     * What a [Decoder] raises as it works through its input, each value
+     * as soon as the last of its bytes arrives.
+     *
+     * Compound values are bracketed by [onBegin] and [onEnd] around their
+     * children. A described value has two, its descriptor then the value,
+     * a described array has its descriptor ahead of its elements and a
+     * map's count is of its keys and values together, all as proton and
+     * the tape count them.
+     *
+     * Binaries, strings and symbols are views of the bytes being fed or of
+     * the decoder's own buffer, valid only for the call they're passed to.
+     */
+    class IEvents {
+        public :
+            virtual ~IEvents() = default;
+
+            virtual void onBegin (pn_type_t, size_t count_) = 0;
+            virtual void onEnd (pn_type_t) = 0;
+
+            virtual void onValue (const pn_atom_t &) = 0;
+    };
+
+    /**
+     * Decodes a single AMQP value from input handed to it in chunks of any
+     * size, split anywhere, rather than needing the whole of its encoding
+     * before starting as [pn_data_decode] does.
+     *
+     * Where it is in the value is kept on an explicit stack of the
+     * compounds it's inside, so it can stop at any byte and pick up from
+     * there on the next [feed] however deeply the value nests. Nothing is
+     * kept of what's already been raised; beyond the stack the only bytes
+     * held between chunks are those of the value a chunk ended part way
+     * through, so a blob of any size is decoded in the memory its largest
+     * string or binary needs.
+     */
+    class Decoder {
+        public :
+            enum Status { more_e, done_e };
+
+        private :
+            enum Step {
+                code_e,     // a constructor
+                value_e,    // dispatch on a constructor already known
+                fixed_e,    // a fixed width value's content
+                size_e,     // a size prefix
+                count_e,    // a compound's count
+                payload_e,  // a binary, string or symbol's content
+                element_e   // the constructor an array's elements share
+            };
+
+            struct Frame {
+                pn_type_t type;
+
+                /**
+                 * Children still to come, for an array not counting its
+                 * descriptor
+                 */
+                uint32_t remaining;
+
+                /**
+                 * The offset past the compound's encoding
+                 */
+                size_t end;
+
+                /**
+                 * The constructor an array's elements share, zero until
+                 * it's been read
+                 */
+                uint8_t element;
+
+                /**
+                 * Whether an array has a descriptor
+                 */
+                bool described;
+            };
+
+            IEvents & m_events;
+
+            std::vector<Frame> m_stack;
+
+            Step     m_step;
+            uint8_t  m_code;
+            uint32_t m_size;
+
+            /**
+             * Bytes consumed since the start of the value, and where the
+             * value under decode started, for reporting where a problem
+             * lies
+             */
+            size_t m_offset;
+            size_t m_start;
+
+            /**
+             * Whatever's been read of something a chunk ended part way
+             * through
+             */
+            std::string m_held;
+
+            const char * m_at;
+            const char * m_end;
+
+            bool m_done;
+
+            bool take (size_t, const char *&);
+
+            bool step();
+
+            void dispatch();
+            void next();
+            void completed();
+
+            size_t prefix() const;
+
+            /**
+             * The offset past the innermost sized compound being read,
+             * nothing in it being allowed to claim it runs further
+             */
+            size_t bound() const;
+
+        public :
+            explicit Decoder (IEvents &);
+
+            /**
+             * Decode as much of the value as [bytes_] allows, raising an
+             * event for each part of it completed along the way. Returns
+             * [done_e] once the value is complete, input running past its
+             * end being an error, and [more_e] otherwise.
+             */
+            Status feed (const char * bytes_, size_t size_);
+
+            /**
+             * Bytes consumed so far
+             */
+            size_t offset() const;
+
+            /**
+             * Where the value being read, or last read, began
+             */
+            size_t start() const;
+
+            /**
+             * How many compounds the next byte is inside
+             */
+            size_t depth() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,167 @@
+#include "Sections.h"
+
+#include <stdexcept>
+#include <proton/codec.h>
+
+#include "Tape.h"
+#include "proton/DataPool.h"
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    uint64_t
+    be (const char * bytes_, size_t width_) {
+        uint64_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < width_ ; ++i) {
+            rtn = (rtn << 8) | static_cast<uint8_t>(bytes_[i]);
+        }
+
+        return rtn;
+    }
+
+    /**
+     * The Corda id of the ulong descriptor at [at_], or -1 if it's something
+     * else
+     */
+    int64_t
+    descriptor (const char * bytes_, size_t size_, size_t at_) {
+        switch (static_cast<uint8_t>(bytes_[at_])) {
+            case 0x44 :
+                return 0;
+            case 0x53 :
+                return at_ + 1 < size_ ? be (bytes_ + at_ + 1, 1) : -1;
+            case 0x80 :
+                return at_ + 8 < size_
+                    ? static_cast<int64_t>(amqp::stripCorda (
+                            be (bytes_ + at_ + 1, 8)))
+                    : -1;
+            default :
+                return -1;
+        }
+    }
+
+    [[noreturn]] void
+    noEnvelope() {
+        throw std::runtime_error ("Blob does not contain an envelope");
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::tape::Sections
+amqp::internal::tape::sections (const char * bytes_, size_t size_) {
+    using amqp::schema::descriptors::ENVELOPE;
+
+    if (size_ < 2 || bytes_[0] != 0x00) {
+        noEnvelope();
+    }
+
+    if (descriptor (bytes_, size_, 1) != ENVELOPE) {
+        noEnvelope();
+    }
+
+    auto list = extent (bytes_, size_, 1);
+
+    if (list >= size_) {
+        noEnvelope();
+    }
+
+    auto code = static_cast<uint8_t>(bytes_[list]);
+
+    if (code != 0xc0 && code != 0xd0) {
+        noEnvelope();
+    }
+
+    size_t prefix = (code & 0x10) ? 4 : 1;
+
+    if (list + 1 + 2 * prefix > size_) {
+        noEnvelope();
+    }
+
+    auto count = be (bytes_ + list + 1 + prefix, prefix);
+
+    if (count < 2) {
+        noEnvelope();
+    }
+
+    Sections rtn;
+
+    auto view = [bytes_, size_](size_t & at_) -> std::string_view {
+        auto begin = at_;
+        at_ = extent (bytes_, size_, at_);
+
+        return { bytes_ + begin, at_ - begin };
+    };
+
+    auto at = list + 1 + 2 * prefix;
+
+    rtn.object = view (at);
+    rtn.schema = view (at);
+
+    if (count > 2) {
+        rtn.transforms = view (at);
+    }
+
+    /*
+     * A described object's descriptor is the first thing in it
+     */
+    const auto & object = rtn.object;
+
+    if (object.size() > 2 && object[0] == 0x00) {
+        auto symbol = static_cast<uint8_t>(object[1]);
+
+        if (symbol == 0xa3 || symbol == 0xb3) {
+            size_t width = symbol == 0xb3 ? 4 : 1;
+
+            if (object.size() >= 2 + width) {
+                auto length = be (object.data() + 2, width);
+
+                if (2 + width + length <= object.size()) {
+                    rtn.descriptor = object.substr (2 + width, length);
+                }
+            }
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::tape::hash (std::string_view section_) {
+    uint64_t rtn { 0xcbf29ce484222325ULL };
+
+    for (auto c : section_) {
+        rtn ^= static_cast<uint8_t>(c);
+        rtn *= 0x100000001b3ULL;
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::schema::Schema>
+amqp::internal::tape::schema (std::string_view section_) {
+    Tape (section_.data(), section_.size());
+
+    auto data = proton::DataPool::instance().acquire();
+
+    if (pn_data_decode (data.get(), section_.data(), section_.size()) < 0) {
+        throw std::runtime_error ("Failed to decode schema section");
+    }
+
+    pn_data_rewind (data.get());
+    pn_data_next (data.get());
+
+    return schema::descriptors::dispatchDescribed<schema::Schema> (data.get());
+}
+
+/******************************************************************************/
@@ -0,0 +1,70 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstdint>
+#include <string_view>
+
+#include "types.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    class Schema;
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::tape {
+
+    /**
+     * Where each part of a blob's envelope lies, found without decoding
+     * any of them. Each view is of the bytes the sections were found in.
+     */
+    struct Sections {
+        /**
+         * The serialised object, by far the largest part of most blobs
+         */
+        std::string_view object;
+
+        std::string_view schema;
+
+        /**
+         * Empty if the envelope carries no transforms
+         */
+        std::string_view transforms;
+
+        /**
+         * The descriptor of the object's class, the fingerprint Corda
+         * gives it, or empty if the object isn't described by a symbol
+         */
+        std::string_view descriptor;
+    };
+
+    /**
+     * Split [size_] bytes of a blob, less its Corda header, into the
+     * sections of its envelope. Only the envelope's own constructor and
+     * those of its sections are read, each section is stepped over by its
+     * encoded size.
+     */
+    Sections sections (const char * bytes_, size_t size_);
+
+    /**
+     * A 64 bit FNV-1a hash of a section's bytes. Blobs written against
+     * the same classes carry byte for byte the same schema section, so
+     * this tells schemas apart without parsing them.
+     */
+    uint64_t hash (std::string_view section_);
+
+    /**
+     * Parse the schema section alone. It's indexed by a [Tape] first,
+     * which refuses values nested deeper than proton's recursive decoder
+     * could safely follow.
+     */
+    uPtr<schema::Schema> schema (std::string_view section_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,437 @@
+#include "Tape.h"
+
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    uint32_t
+    be (const char * bytes_, size_t width_) {
+        uint32_t rtn { 0 };
+
+        for (size_t i { 0 } ; i < width_ ; ++i) {
+            rtn = (rtn << 8) | static_cast<uint8_t>(bytes_[i]);
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Far deeper than any schema nests its types, and far shallower than
+     * the stack a scan that deep would need
+     */
+    constexpr size_t maxDepth { 1000 };
+
+    [[noreturn]] void
+    unknown (uint8_t code_, size_t offset_) {
+        std::stringstream ss;
+        ss << "Unknown AMQP format code 0x"
+           << std::hex << std::setw (2) << std::setfill ('0')
+           << static_cast<int>(code_)
+           << std::dec << " at offset " << offset_;
+
+        throw std::runtime_error (ss.str());
+    }
+
+}
+
+/******************************************************************************/
+
+int
+amqp::internal::tape::fixed (uint8_t code_) {
+    switch (code_) {
+        case 0x40 : case 0x41 : case 0x42 :
+        case 0x43 : case 0x44 : case 0x45 :
+            return 0;
+        case 0x50 : case 0x51 : case 0x52 :
+        case 0x53 : case 0x54 : case 0x55 : case 0x56 :
+            return 1;
+        case 0x60 : case 0x61 :
+            return 2;
+        case 0x70 : case 0x71 : case 0x72 : case 0x73 : case 0x74 :
+            return 4;
+        case 0x80 : case 0x81 : case 0x82 : case 0x83 : case 0x84 :
+            return 8;
+        case 0x94 : case 0x98 :
+            return 16;
+        default :
+            return -1;
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::tape::
+Tape::Tape (const char * bytes_, size_t size_)
+    : m_bytes { bytes_ }
+    , m_size { size_ }
+{
+    if (size_ >= Node::npos) {
+        throw std::runtime_error ("AMQP stream too large to index");
+    }
+
+    for (size_t at { 0 } ; at < m_size ; ) {
+        at = scan (at, Node::npos, false, 0, 0);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Check there are [bytes_] to read at [at_], returning [at_]
+ */
+size_t
+amqp::internal::tape::
+Tape::need (size_t at_, size_t bytes_) const {
+    if (bytes_ > m_size || at_ > m_size - bytes_) {
+        throw std::runtime_error (
+            "Truncated AMQP stream at offset " + std::to_string (at_));
+    }
+
+    return at_;
+}
+
+/******************************************************************************/
+
+/**
+ * Make room for a node's [count_] children in the table of them, returning
+ * where they start
+ */
+uint32_t
+amqp::internal::tape::
+Tape::children (size_t count_) {
+    auto rtn = m_children.size();
+
+    // each is scanned in turn so a false count is found out, but not
+    // before a count no stream this size could hold has been made room for
+    if (count_ > m_size) {
+        throw std::runtime_error (
+            "Compound value claims more children than the stream holds");
+    }
+
+    m_children.resize (rtn + count_);
+
+    return static_cast<uint32_t>(rtn);
+}
+
+/******************************************************************************/
+
+/**
+ * Record the value at [at_] and everything under it, returning the offset
+ * past its encoding. Array elements are [bare_], their shared constructor
+ * [code_] having already been read. [depth_] is how many values it's
+ * nested in, bounded so a stream of nothing but nested constructors
+ * can't exhaust the stack.
+ */
+size_t
+amqp::internal::tape::
+Tape::scan (
+    size_t at_,
+    uint32_t parent_,
+    bool bare_,
+    uint8_t code_,
+    size_t depth_
+) {
+    if (depth_ > maxDepth) {
+        throw std::runtime_error (
+            "AMQP values nested too deeply at offset " + std::to_string (at_));
+    }
+
+    auto index = m_nodes.size();
+    m_nodes.emplace_back();
+
+    Node node { };
+    node.offset = at_;
+    node.parent = parent_;
+    node.bare = bare_;
+
+    if (!bare_) {
+        code_ = m_bytes[need (at_++, 1)];
+    }
+
+    node.code = code_;
+
+    auto width = fixed (code_);
+
+    if (code_ == 0x00 && !bare_) {
+        node.count = 2;
+        node.payload = at_;
+        node.children = children (2);
+
+        for (uint32_t n { 0 } ; n < 2 ; ++n) {
+            m_children[node.children + n] = m_nodes.size();
+            at_ = scan (at_, index, false, 0, depth_ + 1);
+        }
+    } else if (width >= 0) {
+        node.payload = at_;
+        at_ = need (at_, width) + width;
+    } else {
+        /*
+         * Everything else carries a size, one byte wide for the codes in
+         * the lower half of each row and four in the upper
+         */
+        size_t prefix = (code_ & 0x10) ? 4 : 1;
+        auto size = be (m_bytes + need (at_, prefix), prefix);
+        auto end = need (at_ + prefix, size) + size;
+
+        switch (code_) {
+            case 0xa0 : case 0xa1 : case 0xa3 :
+            case 0xb0 : case 0xb1 : case 0xb3 :
+                node.payload = at_ + prefix;
+                break;
+            case 0xc0 : case 0xc1 :
+            case 0xd0 : case 0xd1 : {
+                if (size < prefix) {
+                    throw std::runtime_error (
+                        "Compound value at offset "
+                            + std::to_string (node.offset) + " is too short");
+                }
+
+                node.count = be (m_bytes + at_ + prefix, prefix);
+                node.payload = at_ + 2 * prefix;
+                node.children = children (node.count);
+
+                size_t i { node.payload };
+                for (uint32_t n { 0 } ; n < node.count ; ++n) {
+                    m_children[node.children + n] = m_nodes.size();
+                    i = scan (i, index, false, 0, depth_ + 1);
+                }
+
+                if (i > end) {
+                    throw std::runtime_error (
+                        "Compound value at offset "
+                            + std::to_string (node.offset)
+                            + " overruns its size");
+                }
+
+                break;
+            }
+            case 0xe0 : case 0xf0 : {
+                if (size < prefix + 1) {
+                    throw std::runtime_error (
+                        "Array at offset " + std::to_string (node.offset)
+                            + " is too short");
+                }
+
+                auto elements = be (m_bytes + at_ + prefix, prefix);
+
+                node.count = elements;
+                node.payload = at_ + 2 * prefix;
+
+                size_t i { node.payload };
+                auto ctor = static_cast<uint8_t>(m_bytes[i++]);
+
+                /*
+                 * A described array's descriptor is its first child
+                 */
+                if (ctor == 0x00) {
+                    node.count = elements + 1;
+                    node.children = children (node.count);
+                    m_children[node.children] = m_nodes.size();
+
+                    i = scan (i, index, false, 0, depth_ + 1);
+                    ctor = m_bytes[need (i++, 1)];
+
+                    if (ctor == 0x00) {
+                        unknown (ctor, i - 1);
+                    }
+                } else {
+                    node.children = children (node.count);
+                }
+
+                auto first = node.children + node.count - elements;
+
+                for (uint32_t n { 0 } ; n < elements ; ++n) {
+                    m_children[first + n] = m_nodes.size();
+                    i = scan (i, index, true, ctor, depth_ + 1);
+                }
+
+                if (i > end) {
+                    throw std::runtime_error (
+                        "Array at offset " + std::to_string (node.offset)
+                            + " overruns its size");
+                }
+
+                break;
+            }
+            default :
+                unknown (code_, node.offset);
+        }
+
+        at_ = end;
+    }
+
+    node.size = at_ - node.offset;
+    node.next = m_nodes.size();
+    m_nodes[index] = node;
+
+    return at_;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::tape::
+Tape::size() const {
+    return m_nodes.size();
+}
+
+/******************************************************************************/
+
+const amqp::internal::tape::Node &
+amqp::internal::tape::
+Tape::operator [] (size_t node_) const {
+    return m_nodes[node_];
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::tape::
+Tape::skip (size_t node_) const {
+    return m_nodes[node_].next;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::tape::
+Tape::child (size_t node_, size_t n_) const {
+    if (n_ >= m_nodes[node_].count) {
+        throw std::out_of_range (
+            "Node " + std::to_string (node_) + " has no child "
+                + std::to_string (n_));
+    }
+
+    return m_children[m_nodes[node_].children + n_];
+}
+
+/******************************************************************************/
+
+pn_type_t
+amqp::internal::tape::
+Tape::type (size_t node_) const {
+    switch (m_nodes[node_].code) {
+        case 0x00 : return PN_DESCRIBED;
+        case 0x40 : return PN_NULL;
+        case 0x41 : case 0x42 : case 0x56 : return PN_BOOL;
+        case 0x43 : case 0x52 : case 0x70 : return PN_UINT;
+        case 0x44 : case 0x53 : case 0x80 : return PN_ULONG;
+        case 0x50 : return PN_UBYTE;
+        case 0x51 : return PN_BYTE;
+        case 0x54 : case 0x71 : return PN_INT;
+        case 0x55 : case 0x81 : return PN_LONG;
+        case 0x60 : return PN_USHORT;
+        case 0x61 : return PN_SHORT;
+        case 0x72 : return PN_FLOAT;
+        case 0x73 : return PN_CHAR;
+        case 0x74 : return PN_DECIMAL32;
+        case 0x82 : return PN_DOUBLE;
+        case 0x83 : return PN_TIMESTAMP;
+        case 0x84 : return PN_DECIMAL64;
+        case 0x94 : return PN_DECIMAL128;
+        case 0x98 : return PN_UUID;
+        case 0xa0 : case 0xb0 : return PN_BINARY;
+        case 0xa1 : case 0xb1 : return PN_STRING;
+        case 0xa3 : case 0xb3 : return PN_SYMBOL;
+        case 0x45 : case 0xc0 : case 0xd0 : return PN_LIST;
+        case 0xc1 : case 0xd1 : return PN_MAP;
+        case 0xe0 : case 0xf0 : return PN_ARRAY;
+        default : return PN_INVALID;
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::tape::
+Tape::bytes (size_t node_) const {
+    return { m_bytes + m_nodes[node_].offset, m_nodes[node_].size };
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::tape::
+Tape::value (size_t node_) const {
+    auto & node = m_nodes[node_];
+
+    switch (node.code) {
+        case 0xa0 : case 0xa1 : case 0xa3 :
+        case 0xb0 : case 0xb1 : case 0xb3 :
+            return {
+                m_bytes + node.payload,
+                node.size - (node.payload - node.offset) };
+        default :
+            throw std::runtime_error (
+                "Node " + std::to_string (node_)
+                    + " is not a binary, string or symbol");
+    }
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::tape::
+Tape::payload (size_t node_) const {
+    return m_bytes + m_nodes[node_].payload;
+}
+
+size_t
+amqp::internal::tape::extent (
+    const char * bytes_,
+    size_t size_,
+    size_t at_
+) {
+    auto need = [size_](size_t at_, size_t bytes_) {
+        if (bytes_ > size_ || at_ > size_ - bytes_) {
+            throw std::runtime_error (
+                "Truncated AMQP stream at offset " + std::to_string (at_));
+        }
+
+        return at_;
+    };
+
+    /*
+     * A described value is its descriptor followed by the value, either of
+     * which can itself be described, so rather than recursing into them
+     * count the values still to step over
+     */
+    for (size_t values { 1 } ; values ; --values) {
+        auto code = static_cast<uint8_t>(bytes_[need (at_, 1)]);
+        auto width = fixed (code);
+
+        if (code == 0x00) {
+            ++at_;
+            values += 2;
+            continue;
+        }
+
+        if (width >= 0) {
+            at_ = need (at_ + 1, width) + width;
+            continue;
+        }
+
+        switch (code) {
+            case 0xa0 : case 0xa1 : case 0xa3 :
+            case 0xb0 : case 0xb1 : case 0xb3 :
+            case 0xc0 : case 0xc1 : case 0xd0 : case 0xd1 :
+            case 0xe0 : case 0xf0 : {
+                size_t prefix = (code & 0x10) ? 4 : 1;
+                auto size = be (bytes_ + need (at_ + 1, prefix), prefix);
+
+                at_ = need (at_ + 1 + prefix, size) + size;
+                break;
+            }
+            default :
+                unknown (code, at_);
+        }
+    }
+
+    return at_;
+}
+
+/******************************************************************************/
@@ -0,0 +1,151 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include <proton/types.h>
+#include <proton/codec.h>
+
+/******************************************************************************/
+
+namespace amqp::internal::tape {
+
+    /**
+     * One value on the tape. Values are recorded in pre-order, the same
+     * order proton numbers the nodes of a tree it decodes, so the node a
+     * [pn_handle_t] names is at index handle - 1 of a tape scanned over
+     * the same bytes. A described value is a node with two children, its
+     * descriptor and the value, and a described array has its descriptor
+     * as its first child, again as proton has them.
+     */
+    struct Node {
+        static constexpr uint32_t npos = UINT32_MAX;
+
+        /**
+         * Where the value's encoding starts. For an element of an array
+         * that is after the constructor the array shares out to them all.
+         */
+        uint32_t offset;
+
+        /**
+         * Length of the value's encoding from [offset]
+         */
+        uint32_t size;
+
+        /**
+         * Where the value's content starts, past its constructor and any
+         * size and count prefix
+         */
+        uint32_t payload;
+
+        /**
+         * Number of children, zero for anything not compound
+         */
+        uint32_t count;
+
+        /**
+         * Index of the node following this one's subtree, which is its
+         * next sibling if it has one
+         */
+        uint32_t next;
+
+        uint32_t parent;
+
+        /**
+         * Where the indices of the node's children start in the tape's
+         * table of them
+         */
+        uint32_t children;
+
+        uint8_t code;
+
+        /**
+         * True for an array element, whose encoding can't be decoded
+         * without its array's constructor
+         */
+        bool bare;
+    };
+
+    /**
+     * A structural index of an AMQP byte stream, built by a single scan
+     * over it. Every value's position, format code, size and child count
+     * land in a flat array so finding things in the stream afterwards,
+     * skipping whole subtrees or the nth element of a list, is a matter of
+     * following indices rather than re-parsing constructors. It's used to
+     * find a blob's sections and check a stream's structure before it's
+     * handed to proton; the readers still walk proton's decoded tree.
+     *
+     * The tape doesn't copy the bytes it indexes, they have to outlive it.
+     */
+    class Tape {
+        private :
+            const char *      m_bytes;
+            size_t            m_size;
+            std::vector<Node> m_nodes;
+
+            /**
+             * The index of every node but the roots, each compound's
+             * children listed together
+             */
+            std::vector<uint32_t> m_children;
+
+            size_t scan (size_t, uint32_t, bool, uint8_t, size_t);
+            uint32_t children (size_t);
+
+            size_t need (size_t, size_t) const;
+
+        public :
+            Tape (const char *, size_t);
+
+            size_t size() const;
+
+            const Node & operator [] (size_t) const;
+
+            /**
+             * The tape index of the node after [node_]'s subtree
+             */
+            size_t skip (size_t node_) const;
+
+            /**
+             * The tape index of the [n_]th child of [node_], looked up
+             * directly rather than hopping along its siblings
+             */
+            size_t child (size_t node_, size_t n_) const;
+
+            pn_type_t type (size_t) const;
+
+            /**
+             * The bytes encoding [node_]. Unless the node is [Node::bare]
+             * they can be decoded on their own.
+             */
+            std::string_view bytes (size_t node_) const;
+
+            /**
+             * The content of a binary, string or symbol node
+             */
+            std::string_view value (size_t) const;
+
+            const char * payload (size_t) const;
+    };
+
+    /**
+     * Bytes of content behind a fixed width format code, or -1 if the
+     * code isn't one of them
+     */
+    int fixed (uint8_t code_);
+
+    /**
+     * The offset past the value whose encoding starts at [at_] within the
+     * [size_] bytes at [bytes_]. Anything carrying a size is stepped over
+     * whole rather than looked inside, so finding the end of a value
+     * costs the same however much it holds, and however many descriptors
+     * are chained in front of it.
+     */
+    size_t extent (const char * bytes_, size_t size_, size_t at_);
+
+}
+
+/******************************************************************************/
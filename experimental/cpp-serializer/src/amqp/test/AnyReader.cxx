@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <stdexcept>
+#include <proton/codec.h>
+
+#include "amqp/reader/AnyReader.h"
+#include "amqp/reader/PropertyReader.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    spStrMap_t<Reader>
+    classes (std::initializer_list<std::string> descriptors_) {
+        spStrMap_t<Reader> rtn;
+
+        for (const auto & descriptor : descriptors_) {
+            rtn[descriptor] = PropertyReader::make ("int");
+        }
+
+        return rtn;
+    }
+
+    AnyReader::Lookup
+    lookup (const spStrMap_t<Reader> & classes_) {
+        return [&classes_](std::string_view descriptor_) -> const Reader * {
+            auto it = classes_.find (std::string (descriptor_));
+            return it == classes_.end() ? nullptr : it->second.get();
+        };
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (AnyReader, monomorphic) { // NOLINT
+    auto byDescriptor = classes ({ "net.corda:a" });
+
+    AnyReader reader ("net.corda.State", lookup (byDescriptor));
+
+    for (int i { 0 } ; i < 100 ; ++i) {
+        EXPECT_EQ (byDescriptor["net.corda:a"].get(), reader.resolve ("net.corda:a"));
+    }
+
+    EXPECT_EQ (1, reader.misses());
+}
+
+/******************************************************************************/
+
+TEST (AnyReader, polymorphic) { // NOLINT
+    auto byDescriptor = classes ({
+        "net.corda:a", "net.corda:b", "net.corda:c", "net.corda:d", "net.corda:e" });
+
+    AnyReader reader ("net.corda.State", lookup (byDescriptor));
+
+    // as many classes as the cache has ways only miss the once each
+    for (int i { 0 } ; i < 10 ; ++i) {
+        for (const auto * descriptor : { "net.corda:a", "net.corda:b", "net.corda:c", "net.corda:d" }) {
+            EXPECT_EQ (byDescriptor[descriptor].get(), reader.resolve (descriptor));
+        }
+    }
+
+    EXPECT_EQ (AnyReader::ways, reader.misses());
+
+    // past them they're still found, if not as cheaply
+    for (int i { 0 } ; i < 10 ; ++i) {
+        for (const auto & [descriptor, expected] : byDescriptor) {
+            EXPECT_EQ (expected.get(), reader.resolve (descriptor));
+        }
+    }
+
+    EXPECT_THROW (reader.resolve ("net.corda:f"), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (AnyReader, value) { // NOLINT
+    auto byDescriptor = classes ({ "net.corda:a" });
+
+    AnyReader reader ("net.corda.State", lookup (byDescriptor));
+
+    auto data = pn_data (0);
+
+    pn_data_put_described (data);
+    pn_data_enter (data);
+    pn_data_put_symbol (data, pn_bytes (11, "net.corda:a"));
+    pn_data_put_int (data, 1);
+    pn_data_exit (data);
+    pn_data_put_int (data, 2);
+    pn_data_put_bool (data, true);
+    pn_data_put_float (data, 1.0);
+
+    pn_data_rewind (data);
+    pn_data_next (data);
+
+    EXPECT_EQ (byDescriptor["net.corda:a"].get(), reader.resolve (data));
+
+    // the cursor's left on the value
+    EXPECT_EQ (PN_DESCRIBED, pn_data_type (data));
+
+    pn_data_next (data);
+    EXPECT_EQ ("int", reader.resolve (data)->type());
+
+    pn_data_next (data);
+    EXPECT_EQ ("boolean", reader.resolve (data)->type());
+
+    pn_data_next (data);
+    EXPECT_THROW (reader.resolve (data), std::runtime_error); // NOLINT
+
+    pn_data_free (data);
+}
+
+/******************************************************************************/
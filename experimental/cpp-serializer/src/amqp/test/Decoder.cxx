@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <proton/codec.h>
+
+#include "amqp/tape/Tape.h"
+#include "amqp/stream/Decoder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::stream;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A described list holding an int, a list of strings, a map, a
+     * described array of ulongs, an empty list, a double and an array of
+     * lists
+     */
+    std::vector<char>
+    encoded() {
+        auto data = pn_data (0);
+
+        pn_data_put_described (data);
+        pn_data_enter (data);
+        pn_data_put_ulong (data, 0x1234);
+        pn_data_put_list (data);
+        pn_data_enter (data);
+            pn_data_put_int (data, -69);
+            pn_data_put_list (data);
+            pn_data_enter (data);
+                pn_data_put_string (data, pn_bytes (3, "one"));
+                pn_data_put_string (data, pn_bytes (3, "two"));
+                pn_data_put_string (data, pn_bytes (5, "three"));
+            pn_data_exit (data);
+            pn_data_put_map (data);
+            pn_data_enter (data);
+                pn_data_put_symbol (data, pn_bytes (1, "a"));
+                pn_data_put_long (data, 1L << 40);
+                pn_data_put_symbol (data, pn_bytes (1, "b"));
+                pn_data_put_bool (data, true);
+            pn_data_exit (data);
+            pn_data_put_array (data, true, PN_ULONG);
+            pn_data_enter (data);
+                pn_data_put_symbol (data, pn_bytes (5, "array"));
+                pn_data_put_ulong (data, 1);
+                pn_data_put_ulong (data, 2);
+            pn_data_exit (data);
+            pn_data_put_list (data);
+            pn_data_put_double (data, 2.5);
+            pn_data_put_array (data, false, PN_LIST);
+            pn_data_enter (data);
+                pn_data_put_list (data);
+                pn_data_enter (data);
+                    pn_data_put_uint (data, 7);
+                pn_data_exit (data);
+                pn_data_put_list (data);
+            pn_data_exit (data);
+        pn_data_exit (data);
+        pn_data_exit (data);
+
+        std::vector<char> bytes (pn_data_encoded_size (data));
+        pn_data_encode (data, bytes.data(), bytes.size());
+        pn_data_free (data);
+
+        return bytes;
+    }
+
+    /**
+     * Writes each event down as it arrives
+     */
+    class Trace : public IEvents {
+        public :
+            std::string trace;
+
+            void onBegin (pn_type_t type_, size_t count_) override {
+                switch (type_) {
+                    case PN_DESCRIBED : trace += "described"; break;
+                    case PN_LIST :      trace += "list"; break;
+                    case PN_MAP :       trace += "map"; break;
+                    default :           trace += "array"; break;
+                }
+
+                trace += "(" + std::to_string (count_) + " ";
+            }
+
+            void onEnd (pn_type_t) override {
+                trace += ") ";
+            }
+
+            void onValue (const pn_atom_t & atom_) override {
+                switch (atom_.type) {
+                    case PN_INT :
+                        trace += std::to_string (atom_.u.as_int);
+                        break;
+                    case PN_UINT :
+                        trace += std::to_string (atom_.u.as_uint) + "u";
+                        break;
+                    case PN_LONG :
+                        trace += std::to_string (atom_.u.as_long) + "l";
+                        break;
+                    case PN_ULONG :
+                        trace += std::to_string (atom_.u.as_ulong) + "ul";
+                        break;
+                    case PN_BOOL :
+                        trace += atom_.u.as_bool ? "true" : "false";
+                        break;
+                    case PN_DOUBLE :
+                        trace += std::to_string (atom_.u.as_double);
+                        break;
+                    case PN_STRING :
+                    case PN_SYMBOL :
+                        trace += "'" + std::string (
+                            atom_.u.as_bytes.start, atom_.u.as_bytes.size) + "'";
+                        break;
+                    default :
+                        trace += "?";
+                        break;
+                }
+
+                trace += " ";
+            }
+    };
+
+    /**
+     * Feed [bytes_] in chunks of [chunk_], checking the value only
+     * completes with its last byte
+     */
+    std::string
+    chunked (const std::vector<char> & bytes_, size_t chunk_) {
+        Trace trace;
+        Decoder decoder (trace);
+
+        for (size_t at { 0 } ; at < bytes_.size() ; at += chunk_) {
+            auto n = std::min (chunk_, bytes_.size() - at);
+            auto status = decoder.feed (bytes_.data() + at, n);
+
+            EXPECT_EQ (at + n == bytes_.size(), status == Decoder::done_e) << at;
+        }
+
+        EXPECT_EQ (bytes_.size(), decoder.offset());
+        EXPECT_EQ (0, decoder.depth());
+
+        return trace.trace;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Decoder, whole) { // NOLINT
+    auto bytes = encoded();
+
+    EXPECT_EQ (
+        "described(2 4660ul list(7 -69 list(3 'one' 'two' 'three' ) "
+        "map(4 'a' 1099511627776l 'b' true ) "
+        "array(3 'array' 1ul 2ul ) list(0 ) 2.500000 "
+        "array(2 list(1 7u ) list(0 ) ) ) ) ",
+        chunked (bytes, bytes.size()));
+}
+
+/******************************************************************************/
+
+/**
+ * However the input's split it decodes to the same events
+ */
+TEST (Decoder, chunked) { // NOLINT
+    auto bytes = encoded();
+    auto whole = chunked (bytes, bytes.size());
+
+    for (size_t chunk { 1 } ; chunk < bytes.size() ; ++chunk) {
+        EXPECT_EQ (whole, chunked (bytes, chunk)) << chunk;
+    }
+
+    // and split at every byte in turn
+    for (size_t split { 1 } ; split < bytes.size() ; ++split) {
+        Trace trace;
+        Decoder decoder (trace);
+
+        EXPECT_EQ (Decoder::more_e, decoder.feed (bytes.data(), split));
+        EXPECT_EQ (Decoder::done_e, decoder.feed (
+            bytes.data() + split, bytes.size() - split));
+
+        EXPECT_EQ (whole, trace.trace) << split;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Raises a value for each node of a tape over the same bytes
+ */
+TEST (Decoder, matchesTape) { // NOLINT
+    auto bytes = encoded();
+    amqp::internal::tape::Tape tape (bytes.data(), bytes.size());
+
+    struct Count : public IEvents {
+        size_t nodes { 0 };
+
+        void onBegin (pn_type_t, size_t) override { ++nodes; }
+        void onEnd (pn_type_t) override { }
+        void onValue (const pn_atom_t &) override { ++nodes; }
+    } count;
+
+    Decoder decoder (count);
+    decoder.feed (bytes.data(), bytes.size());
+
+    EXPECT_EQ (tape.size(), count.nodes);
+}
+
+/******************************************************************************/
+
+TEST (Decoder, errors) { // NOLINT
+    auto bytes = encoded();
+
+    {
+        Trace trace;
+        Decoder decoder (trace);
+
+        bytes.push_back (0x40);
+
+        EXPECT_THROW ( // NOLINT
+            decoder.feed (bytes.data(), bytes.size()), std::runtime_error);
+    }
+
+    {
+        Trace trace;
+        Decoder decoder (trace);
+        const char unknown[] = { 0x00, 0x53, 0x01, 0x3f };
+
+        EXPECT_THROW ( // NOLINT
+            decoder.feed (unknown, sizeof (unknown)), std::runtime_error);
+    }
+
+    {
+        // a list claiming a size that can't hold its one int
+        Trace trace;
+        Decoder decoder (trace);
+        const char overrun[] = { static_cast<char>(0xc0), 0x02, 0x01, 0x71, 0, 0, 0, 1 };
+
+        EXPECT_THROW ( // NOLINT
+            decoder.feed (overrun, sizeof (overrun)), std::runtime_error);
+    }
+
+    {
+        /*
+         * A string inside a list of a few bytes claiming 4GB is rejected
+         * on reading its size, not buffered while waiting for the rest
+         */
+        Trace trace;
+        Decoder decoder (trace);
+        const char huge[] = {
+            static_cast<char>(0xc0), 0x07, 0x01,
+            static_cast<char>(0xb1),
+            static_cast<char>(0xff), static_cast<char>(0xff),
+            static_cast<char>(0xff), static_cast<char>(0xf0) };
+
+        EXPECT_THROW ( // NOLINT
+            decoder.feed (huge, sizeof (huge)), std::runtime_error);
+    }
+
+    {
+        // and the same of a compound inside a described value's list
+        Trace trace;
+        Decoder decoder (trace);
+        const char huge[] = {
+            static_cast<char>(0xc0), 0x0a, 0x01,
+            0x00, 0x53, 0x01,
+            static_cast<char>(0xd0),
+            0x00, 0x00, 0x01, 0x00 };
+
+        EXPECT_THROW ( // NOLINT
+            decoder.feed (huge, sizeof (huge)), std::runtime_error);
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "Reader.h"
+#include "Entries.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    uPtr<amqp::reader::IValue>
+    single (const std::string & value_) {
+        return std::make_unique<TypedSingle<std::string>> (value_);
+    }
+
+    Entries
+    entries (const std::vector<Entries::Key> & keys_) {
+        Entries rtn;
+
+        for (size_t i { 0 } ; i < keys_.size() ; ++i) {
+            rtn.add (keys_[i], single ("k" + std::to_string (i)), single (std::to_string (i)));
+        }
+
+        return rtn;
+    }
+
+    std::string
+    found (const amqp::reader::IValue * value_) {
+        return value_ ? value_->dump() : "<none>";
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Entries, dump) { // NOLINT
+    auto e = entries ({ 1, 2 });
+
+    EXPECT_EQ (R"({ "k0" : 0, "k1" : 1 })", TypedSingle<Entries> (std::move (e)).dump());
+    EXPECT_EQ (R"("m" : {  })", TypedPair<Entries> ("m", Entries()).dump());
+}
+
+/******************************************************************************/
+
+TEST (Entries, hash) { // NOLINT
+    auto e = entries ({ 5, 1, 3, std::monostate { } });
+
+    EXPECT_FALSE (e.sorted());
+
+    EXPECT_EQ ("0", found (e.find (5)));
+    EXPECT_EQ ("2", found (e.find (3)));
+    EXPECT_EQ ("<none>", found (e.find (4)));
+
+    // integers are found whatever the width asked with
+    EXPECT_EQ ("1", found (e.find (1L)));
+    EXPECT_EQ ("1", found (e.find (static_cast<int16_t> (1))));
+
+    // not in order, a sorted lookup falls back to the hash
+    EXPECT_EQ ("2", found (e.find (3, Entries::sorted_e)));
+}
+
+/******************************************************************************/
+
+/**
+ * An unsigned key too big for a signed key of some width isn't wrapped
+ * round onto a negative one of it
+ */
+TEST (Entries, unsignedKeys) { // NOLINT
+    auto e = entries ({ -1, int64_t { -1 }, INT32_MIN, int64_t { INT64_MIN }, 7 });
+
+    EXPECT_EQ ("<none>", found (e.find (UINT32_MAX)));
+    EXPECT_EQ ("<none>", found (e.find (UINT64_MAX)));
+    EXPECT_EQ ("<none>", found (e.find (static_cast<uint32_t> (INT32_MAX) + 1)));
+    EXPECT_EQ ("<none>", found (e.find (static_cast<uint64_t> (INT64_MAX) + 1)));
+
+    EXPECT_EQ ("4", found (e.find (7U)));
+    EXPECT_EQ ("4", found (e.find (uint64_t { 7 })));
+
+    // a signed key still finds its negative match at either width
+    EXPECT_EQ ("0", found (e.find (-1)));
+    EXPECT_EQ ("0", found (e.find (int64_t { -1 })));
+    EXPECT_EQ ("2", found (e.find (int64_t { INT32_MIN })));
+    EXPECT_EQ ("3", found (e.find (int64_t { INT64_MIN })));
+}
+
+/******************************************************************************/
+
+TEST (Entries, sorted) { // NOLINT
+    auto e = entries ({ std::string ("alice"), std::string ("bob"), std::string ("carol") });
+
+    EXPECT_TRUE (e.sorted());
+
+    EXPECT_EQ ("1", found (e.find ("bob", Entries::sorted_e)));
+    EXPECT_EQ ("2", found (e.find (std::string ("carol"), Entries::sorted_e)));
+    EXPECT_EQ ("<none>", found (e.find ("dave", Entries::sorted_e)));
+    EXPECT_EQ ("0", found (e.find ("alice")));
+
+    auto l = entries ({ int64_t { -4 }, int64_t { 7 }, int64_t { 1 } << 40 });
+
+    EXPECT_EQ ("1", found (l.find (7, Entries::sorted_e)));
+    EXPECT_EQ ("2", found (l.find (int64_t { 1 } << 40, Entries::sorted_e)));
+}
+
+/******************************************************************************/
+
+TEST (Entries, indexedLater) { // NOLINT
+    Entries e;
+    e.add (1, single ("1"), single ("a"));
+
+    EXPECT_EQ ("a", found (e.find (1)));
+
+    // entries added once the index exists are found too
+    e.add (2, single ("2"), single ("b"));
+    EXPECT_EQ ("b", found (e.find (2)));
+
+    // and the first of a repeated key wins
+    e.add (1, single ("1"), single ("c"));
+    EXPECT_EQ ("a", found (e.find (1)));
+}
+
+/******************************************************************************/
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <stdexcept>
+#include <proton/codec.h>
+
+#include "amqp/reader/Natives.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    pn_atom_t
+    atom (int64_t value_) {
+        pn_atom_t rtn;
+        rtn.type = PN_LONG;
+        rtn.u.as_long = value_;
+
+        return rtn;
+    }
+
+    /**
+     * Format the described list holding [values_]
+     */
+    std::string
+    format (Natives::Format format_, std::initializer_list<int64_t> values_) {
+        auto data = pn_data (0);
+
+        pn_data_put_described (data);
+        pn_data_enter (data);
+        pn_data_put_symbol (data, pn_bytes (4, "test"));
+        pn_data_put_list (data);
+        pn_data_enter (data);
+
+        for (auto value : values_) {
+            pn_data_put_long (data, value);
+        }
+
+        pn_data_exit (data);
+        pn_data_exit (data);
+
+        pn_data_rewind (data);
+        pn_data_next (data);
+
+        std::string rtn;
+
+        try {
+            Natives::format (rtn, format_, data);
+        } catch (...) {
+            pn_data_free (data);
+            throw;
+        }
+
+        pn_data_free (data);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Natives, builtIn) { // NOLINT
+    auto instant = Natives::find ("java.time.Instant");
+
+    ASSERT_NE (nullptr, instant);
+    EXPECT_EQ (nullptr, Natives::find ("java.time.Nonsense"));
+
+    EXPECT_EQ ("1970-01-01T00:00:00Z", format (instant, { 0, 0 }));
+    EXPECT_EQ ("2001-09-09T01:46:40.500Z", format (instant, { 1000000000, 500000000 }));
+
+    EXPECT_THROW (format (instant, { 0 }), std::runtime_error); // NOLINT
+
+    std::string out;
+    auto ts = atom (0);
+    ts.type = PN_TIMESTAMP;
+    Natives::find ("timestamp")(out, &ts, 1);
+
+    EXPECT_EQ ("1970-01-01T00:00:00Z", out);
+}
+
+/******************************************************************************/
+
+TEST (Natives, byDescriptor) { // NOLINT
+    Natives::add ("net.corda:natives/test", [](
+        std::string & out_, const pn_atom_t * atoms_, size_t count_
+    ) {
+        for (size_t i { 0 } ; i < count_ ; ++i) {
+            if (i) out_ += '/';
+            out_ += std::to_string (atoms_[i].u.as_long);
+        }
+    });
+
+    EXPECT_EQ (nullptr, Natives::find ("net.corda.Test"));
+
+    auto found = Natives::find ("net.corda.Test", "net.corda:natives/test");
+
+    ASSERT_NE (nullptr, found);
+    EXPECT_EQ ("1/-2/3", format (found, { 1, -2, 3 }));
+
+    auto one = atom (69);
+    std::string out;
+    found (out, &one, 1);
+
+    EXPECT_EQ ("69", out);
+}
+
+/******************************************************************************/
@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <proton/codec.h>
+
+#include "amqp/tape/Tape.h"
+#include "amqp/tape/Sections.h"
+#include "amqp/schema/described-types/Schema.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::tape;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A described list holding an int, a list of strings, a map, a
+     * described array of ulongs and an empty list
+     */
+    std::vector<char>
+    encoded() {
+        auto data = pn_data (0);
+
+        pn_data_put_described (data);
+        pn_data_enter (data);
+        pn_data_put_ulong (data, 0x1234);
+        pn_data_put_list (data);
+        pn_data_enter (data);
+            pn_data_put_int (data, -69);
+            pn_data_put_list (data);
+            pn_data_enter (data);
+                pn_data_put_string (data, pn_bytes (3, "one"));
+                pn_data_put_string (data, pn_bytes (3, "two"));
+                pn_data_put_string (data, pn_bytes (5, "three"));
+            pn_data_exit (data);
+            pn_data_put_map (data);
+            pn_data_enter (data);
+                pn_data_put_symbol (data, pn_bytes (1, "a"));
+                pn_data_put_long (data, 1L << 40);
+                pn_data_put_symbol (data, pn_bytes (1, "b"));
+                pn_data_put_bool (data, true);
+            pn_data_exit (data);
+            pn_data_put_array (data, true, PN_ULONG);
+            pn_data_enter (data);
+                pn_data_put_symbol (data, pn_bytes (5, "array"));
+                pn_data_put_ulong (data, 1);
+                pn_data_put_ulong (data, 2);
+            pn_data_exit (data);
+            pn_data_put_list (data);
+        pn_data_exit (data);
+        pn_data_exit (data);
+
+        std::vector<char> bytes (pn_data_encoded_size (data));
+        pn_data_encode (data, bytes.data(), bytes.size());
+        pn_data_free (data);
+
+        return bytes;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Tape indices line up with the handles of the nodes proton decodes from
+ * the same bytes
+ */
+TEST (Tape, matchesProton) { // NOLINT
+    auto bytes = encoded();
+    Tape tape (bytes.data(), bytes.size());
+
+    auto data = pn_data (0);
+    pn_data_decode (data, bytes.data(), bytes.size());
+
+    ASSERT_EQ (18, tape.size());
+
+    for (size_t i { 0 } ; i < tape.size() ; ++i) {
+        // a node's handle is one past its index, zero being no node
+        pn_data_restore (data, reinterpret_cast<pn_handle_t>(i + 1));
+
+        EXPECT_EQ (pn_data_type (data), tape.type (i)) << i;
+        EXPECT_EQ (i, reinterpret_cast<uintptr_t>(pn_data_point (data)) - 1);
+    }
+
+    pn_data_free (data);
+}
+
+/******************************************************************************/
+
+/**
+ * Children are found directly, however much lies between them
+ */
+TEST (Tape, children) { // NOLINT
+    auto bytes = encoded();
+    Tape tape (bytes.data(), bytes.size());
+
+    ASSERT_EQ (PN_DESCRIBED, tape.type (0));
+    EXPECT_EQ (PN_ULONG, tape.type (tape.child (0, 0)));
+
+    auto list = tape.child (0, 1);
+    ASSERT_EQ (PN_LIST, tape.type (list));
+    ASSERT_EQ (5, tape[list].count);
+    EXPECT_EQ (PN_INT, tape.type (tape.child (list, 0)));
+
+    // straight to the map without looking at the strings
+    auto map = tape.child (list, 2);
+    ASSERT_EQ (PN_MAP, tape.type (map));
+    EXPECT_EQ ("a", tape.value (tape.child (map, 0)));
+    EXPECT_EQ (PN_LONG, tape.type (tape.child (map, 1)));
+    EXPECT_EQ ("b", tape.value (tape.child (map, 2)));
+    EXPECT_EQ (PN_BOOL, tape.type (tape.child (map, 3)));
+    EXPECT_EQ (1, *tape.payload (tape.child (map, 3)));
+
+    // the strings, after the event
+    auto strings = tape.child (list, 1);
+
+    std::vector<std::string> read;
+    for (size_t i { 0 } ; i < tape[strings].count ; ++i) {
+        read.emplace_back (tape.value (tape.child (strings, i)));
+    }
+
+    EXPECT_EQ ((std::vector<std::string> { "one", "two", "three" }), read);
+
+    // a described array's descriptor is its first child
+    auto array = tape.child (list, 3);
+    ASSERT_EQ (PN_ARRAY, tape.type (array));
+    ASSERT_EQ (3, tape[array].count);
+    EXPECT_EQ ("array", tape.value (tape.child (array, 0)));
+    EXPECT_FALSE (tape[tape.child (array, 0)].bare);
+    EXPECT_EQ (PN_ULONG, tape.type (tape.child (array, 2)));
+    EXPECT_TRUE (tape[tape.child (array, 2)].bare);
+
+    EXPECT_EQ (PN_LIST, tape.type (tape.child (list, 4)));
+    EXPECT_EQ (0, tape[tape.child (list, 4)].count);
+    EXPECT_THROW (tape.child (list, 5), std::out_of_range); // NOLINT
+
+    // every child is where hopping along its siblings would have found it
+    for (size_t node { 0 } ; node < tape.size() ; ++node) {
+        for (size_t i { 1 } ; i < tape[node].count ; ++i) {
+            EXPECT_EQ (tape.skip (tape.child (node, i - 1)), tape.child (node, i))
+                << node << " " << i;
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The compact encodings proton's encoder doesn't itself produce
+ */
+TEST (Tape, compact) { // NOLINT
+    const char bytes[] = {
+        '\xc0', 0x0b, 0x05,         // list8, 5 elements
+            0x45,                   // list0
+            0x53, 0x07,             // smallulong
+            0x54, '\xff',           // smallint
+            0x42,                   // false
+            '\xa1', 0x02, 'h', 'i'  // str8
+    };
+
+    Tape tape (bytes, sizeof (bytes));
+
+    ASSERT_EQ (6, tape.size());
+    EXPECT_EQ (6, tape.skip (0));
+    EXPECT_EQ (5, tape.child (0, 4));
+    EXPECT_EQ ("hi", tape.value (5));
+    EXPECT_EQ (std::string_view ("\x53\x07", 2), tape.bytes (2));
+
+    EXPECT_EQ (PN_LIST, tape.type (1));
+    EXPECT_EQ (0, tape[1].count);
+    EXPECT_EQ (PN_ULONG, tape.type (2));
+    EXPECT_EQ (7, *tape.payload (2));
+    EXPECT_EQ (PN_INT, tape.type (3));
+    EXPECT_EQ ('\xff', *tape.payload (3));
+    EXPECT_EQ (PN_BOOL, tape.type (4));
+    EXPECT_EQ (0x42, tape[4].code);
+}
+
+/******************************************************************************/
+
+TEST (Tape, malformed) { // NOLINT
+    const char truncated[] = { '\xc0', 0x05, 0x02, 0x53 };
+    const char unknown[] = { 0x01 };
+    const char crowded[] = { '\xd0', 0, 0, 0, 0x04, '\xff', '\xff', '\xff', '\xff' };
+
+    EXPECT_THROW (Tape (truncated, sizeof (truncated)), std::runtime_error); // NOLINT
+    EXPECT_THROW (Tape (unknown, sizeof (unknown)), std::runtime_error); // NOLINT
+    EXPECT_THROW (Tape (crowded, sizeof (crowded)), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * Stepping over a value by its size lands where scanning it does
+ */
+TEST (Tape, extent) { // NOLINT
+    auto bytes = encoded();
+    Tape tape (bytes.data(), bytes.size());
+
+    for (size_t i { 0 } ; i < tape.size() ; ++i) {
+        if (!tape[i].bare) {
+            EXPECT_EQ (
+                tape[i].offset + tape[i].size,
+                extent (bytes.data(), bytes.size(), tape[i].offset)) << i;
+        }
+    }
+
+    EXPECT_THROW ( // NOLINT
+        extent (bytes.data(), bytes.size() - 1, 0), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/**
+ * Chained descriptors and nested lists run out of bytes or depth rather
+ * than stack
+ */
+TEST (Tape, deep) { // NOLINT
+    std::string zeros (2000000, '\0');
+
+    EXPECT_THROW ( // NOLINT
+        extent (zeros.data(), zeros.size(), 0), std::runtime_error);
+    EXPECT_THROW (Tape (zeros.data(), zeros.size()), std::runtime_error); // NOLINT
+
+    // an envelope whose object is nothing but descriptors
+    std::string envelope {
+        '\0', '\x80', 0, 0, '\xc5', 0x62, 0, 0, 0, 0x01,
+        '\xd0', 0, '\x1e', '\x84', '\x84', 0, 0, 0, 0x03 };
+
+    envelope += zeros;
+
+    EXPECT_THROW ( // NOLINT
+        sections (envelope.data(), envelope.size()), std::runtime_error);
+
+    // a hundred thousand lists, each holding the next
+    const size_t depth { 100000 };
+
+    std::string lists;
+    for (size_t i { 0 } ; i < depth ; ++i) {
+        auto size = static_cast<uint32_t>(9 * (depth - i) + 1 - 5);
+
+        lists += '\xd0';
+        for (int shift { 24 } ; shift >= 0 ; shift -= 8) {
+            lists += static_cast<char>(size >> shift);
+        }
+        lists += std::string ("\0\0\0\x01", 4);
+    }
+    lists += '\x45';
+
+    EXPECT_EQ (lists.size(), extent (lists.data(), lists.size(), 0));
+
+    EXPECT_THROW (Tape (lists.data(), lists.size()), std::runtime_error); // NOLINT
+    EXPECT_THROW (schema (lists), std::runtime_error); // NOLINT
+
+    // but a chain of a few descriptors is fine
+    const char chained[] = { 0x00, 0x00, 0x53, 0x01, 0x53, 0x02, 0x54, 0x03 };
+
+    EXPECT_EQ (sizeof (chained), extent (chained, sizeof (chained), 0));
+    EXPECT_EQ (5, Tape (chained, sizeof (chained)).size());
+}
+
+/******************************************************************************/
@@ -0,0 +1,113 @@
+#include "Validate.h"
+
+#include <stdexcept>
+
+#include "types.h"
+#include "concurrency/Cache.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/tape/Sections.h"
+#include "amqp/stream/Blob.h"
+#include "amqp/schema/described-types/Schema.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::schema::Schema;
+
+    /**
+     * Every value is checked as it's raised, there's nothing to do with it
+     * after that
+     */
+    class Discard : public amqp::reader::IVisitor {
+        public :
+            void onCompositeBegin (std::string_view, std::string_view) override { }
+            void onCompositeEnd() override { }
+            void onField (std::string_view) override { }
+            void onListBegin (size_t) override { }
+            void onListEnd() override { }
+            void onMapBegin (size_t) override { }
+            void onMapEnd() override { }
+            void onInt (int32_t) override { }
+            void onLong (int64_t) override { }
+            void onBool (bool) override { }
+            void onDouble (double) override { }
+            void onString (std::string_view) override { }
+            void onBinary (std::string_view) override { }
+    };
+
+    /**
+     * The parsed schema section, parsing it only if no recent blob's
+     * carried the same bytes
+     */
+    sPtr<const Schema>
+    parsed (std::string_view section_) {
+        static concurrency::Cache<Schema> schemas (256);
+
+        return schemas.get (section_, [section_]() -> sPtr<const Schema> {
+            return amqp::internal::tape::schema (section_);
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::Validation
+amqp::
+validate (const char * bytes_, size_t size_) {
+    const auto & magic = amqp::AMQP_HEADER;
+
+    for (size_t i { 0 } ; i < magic.size() ; ++i) {
+        if (i >= size_ || bytes_[i] != magic[i]) {
+            return { "Not a Corda blob", i, "" };
+        }
+    }
+
+    auto header = magic.size() + 1;
+
+    if (size_ < header) {
+        return { "Missing encoding", magic.size(), "" };
+    }
+
+    if (bytes_[magic.size()] != amqp::DATA_AND_STOP) {
+        return {
+            "Unsupported encoding " + std::to_string (bytes_[magic.size()]),
+            magic.size(), "" };
+    }
+
+    amqp::internal::tape::Sections sections;
+
+    try {
+        sections = amqp::internal::tape::sections (bytes_ + header, size_ - header);
+    } catch (const std::exception & e) {
+        return { e.what(), header, "" };
+    }
+
+    sPtr<const Schema> schema;
+
+    try {
+        schema = parsed (sections.schema);
+    } catch (const std::exception & e) {
+        return {
+            e.what(),
+            static_cast<size_t>(sections.schema.data() - bytes_), "" };
+    }
+
+    Discard discard;
+    amqp::internal::stream::Blob blob (*schema, discard);
+
+    try {
+        if (blob.feed (bytes_, size_) != amqp::internal::stream::Decoder::done_e) {
+            return { "Blob ends part way through a value", size_, blob.path() };
+        }
+    } catch (const std::exception & e) {
+        return { e.what(), header + blob.decoder().start(), blob.path() };
+    }
+
+    return { };
+}
+
+/******************************************************************************/
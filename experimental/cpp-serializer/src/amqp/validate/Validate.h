@@ -0,0 +1,51 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+
+/******************************************************************************/
+
+namespace amqp {
+
+    /**
+     * What, if anything, is wrong with a blob
+     */
+    struct Validation {
+        /**
+         * Empty if the blob is valid
+         */
+        std::string error;
+
+        /**
+         * Where in the blob, Corda header and all, the problem was found
+         */
+        size_t offset { 0 };
+
+        /**
+         * The property it was found in, such as "legs[2].amount", empty
+         * if it wasn't in the blob's object
+         */
+        std::string path;
+
+        bool valid() const { return error.empty(); }
+    };
+
+    /**
+     * Check a blob could be read without reading it. It must have a Corda
+     * header and an encoding we understand, be well formed AMQP holding
+     * an envelope, carry a schema that parses and an object that
+     * conforms to that schema, using only the types the readers support.
+     *
+     * The object is decoded straight from its bytes against the schema,
+     * raising every value on a visitor that does nothing, so no values or
+     * strings are built. Schemas are parsed once each and the last few
+     * hundred kept for the next blob carrying the same bytes. Safe to call
+     * from many threads.
+     */
+    Validation validate (const char * bytes_, size_t size_);
+
+}
+
+/******************************************************************************/
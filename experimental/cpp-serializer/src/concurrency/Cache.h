@@ -0,0 +1,158 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+/******************************************************************************/
+
+namespace concurrency {
+
+    /**
+     * A map from byte strings, the schema section of a blob say, to values
+     * made from them, shared between threads and holding at most
+     * [capacity] of them. Keys are found by their hash but a hit is only
+     * taken once the bytes compare equal, so bytes crafted to collide with
+     * another's hash are never given its value.
+     *
+     * When full the least recently used value is dropped. Values are
+     * handed out shared, so anyone still using a dropped one keeps it.
+     */
+    template<typename T, typename Hash = std::hash<std::string_view>>
+    class Cache {
+        private :
+            struct Entry {
+                std::string              key;
+                std::shared_ptr<const T> value;
+                std::atomic<uint64_t>    used;
+            };
+
+            const size_t m_capacity;
+
+            mutable std::shared_mutex                                  m_mutex;
+            std::unordered_multimap<size_t, std::unique_ptr<Entry>>   m_entries;
+            mutable std::atomic<uint64_t>                              m_clock;
+
+            /**
+             * Called with the lock held, shared or otherwise
+             */
+            const Entry * lookup (size_t hash_, std::string_view key_) const;
+
+        public :
+            explicit Cache (size_t capacity_);
+
+            Cache (const Cache &) = delete;
+            Cache & operator = (const Cache &) = delete;
+
+            /**
+             * The value for [key_], made by [make_] if there isn't one.
+             * Two threads missing on the same key at once may both make
+             * it, only one being kept.
+             */
+            template<typename Make>
+            std::shared_ptr<const T> get (std::string_view key_, Make && make_);
+
+            size_t size() const;
+    };
+
+}
+
+/******************************************************************************/
+
+template<typename T, typename Hash>
+concurrency::
+Cache<T, Hash>::Cache (size_t capacity_)
+    : m_capacity { std::max<size_t> (1, capacity_) }
+    , m_clock { 0 }
+{ }
+
+/******************************************************************************/
+
+template<typename T, typename Hash>
+const typename concurrency::Cache<T, Hash>::Entry *
+concurrency::
+Cache<T, Hash>::lookup (size_t hash_, std::string_view key_) const {
+    auto range = m_entries.equal_range (hash_);
+
+    for (auto it = range.first ; it != range.second ; ++it) {
+        if (it->second->key == key_) {
+            it->second->used.store (
+                m_clock.fetch_add (1, std::memory_order_relaxed),
+                std::memory_order_relaxed);
+
+            return it->second.get();
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
+
+template<typename T, typename Hash>
+template<typename Make>
+std::shared_ptr<const T>
+concurrency::
+Cache<T, Hash>::get (std::string_view key_, Make && make_) {
+    auto hash = Hash{}(key_);
+
+    {
+        std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+        if (auto entry = lookup (hash, key_)) {
+            return entry->value;
+        }
+    }
+
+    std::shared_ptr<const T> value = make_();
+
+    std::unique_lock<std::shared_mutex> lock (m_mutex);
+
+    // someone else may have made it while the lock was let go
+    if (auto entry = lookup (hash, key_)) {
+        return entry->value;
+    }
+
+    if (m_entries.size() >= m_capacity) {
+        auto oldest = m_entries.begin();
+
+        for (auto it = m_entries.begin() ; it != m_entries.end() ; ++it) {
+            if (it->second->used.load (std::memory_order_relaxed)
+                < oldest->second->used.load (std::memory_order_relaxed))
+            {
+                oldest = it;
+            }
+        }
+
+        m_entries.erase (oldest);
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->key = std::string (key_);
+    entry->value = std::move (value);
+    entry->used = m_clock.fetch_add (1, std::memory_order_relaxed);
+
+    return m_entries.emplace (hash, std::move (entry))->second->value;
+}
+
+/******************************************************************************/
+
+template<typename T, typename Hash>
+size_t
+concurrency::
+Cache<T, Hash>::size() const {
+    std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+    return m_entries.size();
+}
+
+/******************************************************************************/
@@ -0,0 +1,150 @@
+#include "Interner.h"
+
+#include <mutex>
+#include <cstring>
+#include <functional>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Strings are packed into blocks of this many bytes, anything over a
+     * quarter of one getting a block to itself
+     */
+    constexpr size_t block { 64 * 1024 };
+
+}
+
+/******************************************************************************/
+
+double
+concurrency::
+Interner::Stats::hitRate() const {
+    return lookups ? static_cast<double>(hits) / lookups : 0.0;
+}
+
+/******************************************************************************/
+
+concurrency::
+Interner::Shard::Shard()
+    : m_used { 0 }
+    , m_bytes { 0 }
+    , m_lookups { 0 }
+    , m_hits { 0 }
+{ }
+
+/******************************************************************************/
+
+/**
+ * Called with the shard's lock held exclusively
+ */
+const char *
+concurrency::
+Interner::Shard::copy (std::string_view value_) {
+    char * rtn;
+
+    if (value_.size() > block / 4) {
+        m_large.push_back (std::make_unique<char[]> (value_.size()));
+        rtn = m_large.back().get();
+    } else {
+        if (m_blocks.empty() || m_used + value_.size() > block) {
+            m_blocks.push_back (std::make_unique<char[]> (block));
+            m_used = 0;
+        }
+
+        rtn = m_blocks.back().get() + m_used;
+        m_used += value_.size();
+    }
+
+    std::memcpy (rtn, value_.data(), value_.size());
+    m_bytes += value_.size();
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+concurrency::
+Interner::Interner (size_t shards_) {
+    size_t shards { 1 };
+
+    while (shards < shards_) {
+        shards *= 2;
+    }
+
+    m_shards.reserve (shards);
+
+    for (size_t i { 0 } ; i < shards ; ++i) {
+        m_shards.push_back (std::make_unique<Shard>());
+    }
+}
+
+/******************************************************************************/
+
+concurrency::Interner &
+concurrency::
+Interner::instance() {
+    static Interner interner;
+
+    return interner;
+}
+
+/******************************************************************************/
+
+std::string_view
+concurrency::
+Interner::intern (std::string_view value_) {
+    auto hash = std::hash<std::string_view>{}(value_);
+    auto & shard = *m_shards[hash & (m_shards.size() - 1)];
+
+    shard.m_lookups.fetch_add (1, std::memory_order_relaxed);
+
+    {
+        std::shared_lock<std::shared_mutex> lock (shard.m_mutex);
+
+        auto it = shard.m_strings.find (value_);
+
+        if (it != shard.m_strings.end()) {
+            shard.m_hits.fetch_add (1, std::memory_order_relaxed);
+            return *it;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock (shard.m_mutex);
+
+    // someone else may have got there while the lock was let go
+    auto it = shard.m_strings.find (value_);
+
+    if (it != shard.m_strings.end()) {
+        shard.m_hits.fetch_add (1, std::memory_order_relaxed);
+        return *it;
+    }
+
+    std::string_view copy { shard.copy (value_), value_.size() };
+    shard.m_strings.insert (copy);
+
+    return copy;
+}
+
+/******************************************************************************/
+
+concurrency::Interner::Stats
+concurrency::
+Interner::stats() const {
+    Stats rtn { 0, 0, 0, 0 };
+
+    for (const auto & shard : m_shards) {
+        rtn.lookups += shard->m_lookups.load (std::memory_order_relaxed);
+        rtn.hits += shard->m_hits.load (std::memory_order_relaxed);
+
+        std::shared_lock<std::shared_mutex> lock (shard->m_mutex);
+
+        rtn.strings += shard->m_strings.size();
+        rtn.bytes += shard->m_bytes;
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,91 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <shared_mutex>
+#include <unordered_set>
+
+/******************************************************************************/
+
+namespace concurrency {
+
+    /**
+     * A table of strings shared between threads, handing back one
+     * immutable copy of each distinct string however many times it's
+     * interned. Copies are packed into blocks that are only freed with
+     * the table, so the views it returns stay valid for as long as it
+     * lives and cost nothing to keep beyond the first.
+     *
+     * The table is split into shards by hash, each behind a reader
+     * writer lock, so threads interning strings that are already there,
+     * by far the common case over a corpus, only ever share locks.
+     *
+     * One can be made for a batch and dropped with it, or the process
+     * wide [instance] used for values that stay resident throughout.
+     */
+    class Interner {
+        public :
+            struct Stats {
+                uint64_t lookups;
+                uint64_t hits;
+
+                /**
+                 * Distinct strings held and the bytes they take
+                 */
+                uint64_t strings;
+                uint64_t bytes;
+
+                double hitRate() const;
+            };
+
+        private :
+            struct Shard {
+                mutable std::shared_mutex m_mutex;
+
+                std::unordered_set<std::string_view> m_strings;
+
+                std::vector<std::unique_ptr<char[]>> m_blocks;
+                std::vector<std::unique_ptr<char[]>> m_large;
+                size_t                               m_used;
+                uint64_t                             m_bytes;
+
+                std::atomic<uint64_t> m_lookups;
+                std::atomic<uint64_t> m_hits;
+
+                Shard();
+
+                const char * copy (std::string_view);
+            };
+
+            std::vector<std::unique_ptr<Shard>> m_shards;
+
+        public :
+            /**
+             * [shards_] is rounded up to a power of two
+             */
+            explicit Interner (size_t shards_ = 64);
+
+            Interner (const Interner &) = delete;
+            Interner & operator = (const Interner &) = delete;
+
+            /**
+             * The process wide table
+             */
+            static Interner & instance();
+
+            /**
+             * The table's copy of [value_], made if it hasn't one yet
+             */
+            std::string_view intern (std::string_view value_);
+
+            Stats stats() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,281 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * The pool, and our index within it, of the worker running on this
+     * thread if it is one
+     */
+    thread_local const void * t_pool { nullptr };
+    thread_local size_t t_worker { 0 };
+
+    uPtr<concurrency::ThreadPool> & shared() {
+        static uPtr<concurrency::ThreadPool> pool;
+        return pool;
+    }
+
+}
+
+/******************************************************************************/
+
+namespace concurrency {
+
+    /**
+     * A single [ThreadPool::parallelFor]. Owned jointly by the caller and
+     * every ticket queued for it, so a ticket picked up after the job has
+     * finished finds nothing left to do rather than a dangling pointer.
+     */
+    class Job {
+        private :
+            const ThreadPool::Body & m_body;
+            const size_t             m_n;
+            const size_t             m_grain;
+            const size_t             m_chunks;
+
+            std::atomic<size_t> m_next;
+            std::atomic<size_t> m_joined;
+            std::atomic<bool>   m_failed;
+
+            std::mutex              m_mutex;
+            std::condition_variable m_finished;
+            size_t                  m_done;
+            std::exception_ptr      m_error;
+
+        public :
+            Job (const ThreadPool::Body & body_, size_t n_, size_t grain_)
+                : m_body (body_)
+                , m_n (n_)
+                , m_grain (grain_)
+                , m_chunks ((n_ + grain_ - 1) / grain_)
+                , m_next (0)
+                , m_joined (0)
+                , m_failed (false)
+                , m_done (0)
+            { }
+
+            size_t chunks() const { return m_chunks; }
+
+            void participate();
+            void wait();
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Once something has failed the remaining chunks are still claimed, and
+ * counted off, just not run
+ */
+void
+concurrency::
+Job::participate() {
+    auto participant = m_joined++;
+
+    for (size_t chunk { m_next++ } ; chunk < m_chunks ; chunk = m_next++) {
+        if (!m_failed) {
+            try {
+                auto begin = chunk * m_grain;
+                m_body (participant, begin, std::min (m_n, begin + m_grain));
+            } catch (...) {
+                std::lock_guard<std::mutex> l (m_mutex);
+
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+
+                m_failed = true;
+            }
+        }
+
+        std::lock_guard<std::mutex> l (m_mutex);
+
+        if (++m_done == m_chunks) {
+            m_finished.notify_all();
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+concurrency::
+Job::wait() {
+    std::unique_lock<std::mutex> l (m_mutex);
+
+    m_finished.wait (l, [this] { return m_done == m_chunks; });
+
+    if (m_error) {
+        std::rethrow_exception (m_error);
+    }
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * class ThreadPool
+ *
+ ******************************************************************************/
+
+concurrency::
+ThreadPool::ThreadPool (size_t threads_)
+    : m_queued (0)
+    , m_stop (false)
+{
+    m_workers.reserve (threads_);
+    for (size_t i { 0 } ; i < threads_ ; ++i) {
+        m_workers.emplace_back (std::make_unique<Worker>());
+    }
+
+    m_threads.reserve (threads_);
+    for (size_t i { 0 } ; i < threads_ ; ++i) {
+        m_threads.emplace_back (&ThreadPool::run, this, i);
+    }
+}
+
+/******************************************************************************/
+
+concurrency::
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> l (m_mutex);
+        m_stop = true;
+    }
+
+    m_wake.notify_all();
+
+    for (auto & thread : m_threads) {
+        thread.join();
+    }
+}
+
+/******************************************************************************/
+
+concurrency::ThreadPool &
+concurrency::
+ThreadPool::instance() {
+    static std::once_flag made;
+
+    // unless resize has made it first
+    std::call_once (made, []() {
+        auto & pool = shared();
+
+        if (!pool) {
+            auto hw = std::thread::hardware_concurrency();
+            pool = std::make_unique<ThreadPool> (hw > 1 ? hw - 1 : 0);
+        }
+    });
+
+    return *shared();
+}
+
+/******************************************************************************/
+
+void
+concurrency::
+ThreadPool::resize (size_t threads_) {
+    shared() = std::make_unique<ThreadPool> (threads_);
+}
+
+/******************************************************************************/
+
+/**
+ * Our own deque first, newest ticket first, then the oldest ticket of
+ * each of the others in turn starting with our neighbour
+ */
+sPtr<concurrency::Job>
+concurrency::
+ThreadPool::take (size_t self_) {
+    {
+        auto & own = *m_workers[self_];
+        std::lock_guard<std::mutex> l (own.m_mutex);
+
+        if (!own.m_tickets.empty()) {
+            auto job = std::move (own.m_tickets.back());
+            own.m_tickets.pop_back();
+            return job;
+        }
+    }
+
+    for (size_t i { 1 } ; i < m_workers.size() ; ++i) {
+        auto & victim = *m_workers[(self_ + i) % m_workers.size()];
+        std::lock_guard<std::mutex> l (victim.m_mutex);
+
+        if (!victim.m_tickets.empty()) {
+            auto job = std::move (victim.m_tickets.front());
+            victim.m_tickets.pop_front();
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
+
+void
+concurrency::
+ThreadPool::run (size_t self_) {
+    t_pool = this;
+    t_worker = self_;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> l (m_mutex);
+            m_wake.wait (l, [this] { return m_stop || m_queued; });
+
+            if (m_stop) return;
+        }
+
+        if (auto job = take (self_)) {
+            {
+                std::lock_guard<std::mutex> l (m_mutex);
+                --m_queued;
+            }
+
+            job->participate();
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+concurrency::
+ThreadPool::parallelFor (size_t n_, size_t grain_, const Body & body_) {
+    auto job = std::make_shared<Job> (body_, n_, std::max<size_t> (1, grain_));
+
+    /*
+     * The caller takes part so only ask for as many others as there are
+     * chunks left for them
+     */
+    auto helpers = std::min (threads(), job->chunks() ? job->chunks() - 1 : 0);
+
+    if (helpers) {
+        auto first = (t_pool == this) ? t_worker : 0;
+
+        for (size_t i { 0 } ; i < helpers ; ++i) {
+            auto & worker = *m_workers[(first + i) % m_workers.size()];
+            std::lock_guard<std::mutex> l (worker.m_mutex);
+            worker.m_tickets.push_back (job);
+        }
+
+        {
+            std::lock_guard<std::mutex> l (m_mutex);
+            m_queued += helpers;
+        }
+
+        m_wake.notify_all();
+    }
+
+    job->participate();
+    job->wait();
+}
+
+/******************************************************************************/
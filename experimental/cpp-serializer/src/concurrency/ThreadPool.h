@@ -0,0 +1,108 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "types.h"
+
+/******************************************************************************/
+
+namespace concurrency {
+
+    class Job;
+
+    /**
+     * A fixed set of worker threads, each with its own deque of work.
+     * Workers take from the back of their own deque and, when that's
+     * empty, steal from the front of everyone else's.
+     *
+     * Work is submitted as a [parallelFor] over an index range. The range
+     * is cut into chunks and a ticket to join the job is queued for as many
+     * workers as could usefully help. Whoever joins, including the calling
+     * thread, then claims chunks until there are none left, so threads that
+     * turn up late or run slowly simply end up doing less.
+     *
+     * A [parallelFor] issued from inside another, by a worker decoding an
+     * element that itself holds a large collection for example, queues its
+     * tickets one to a worker, starting with that worker's own deque and
+     * carrying on round the pool, rather than from the first worker as a
+     * top level job does. While waiting for its job to finish the caller
+     * only ever works on that job, never picking up unrelated work part
+     * way through its own.
+     */
+    class ThreadPool {
+        public :
+            /**
+             * Called with the participant index, in [0, participants()), and
+             * the half open range of indices to process. A participant
+             * never runs two chunks of the same job concurrently so state
+             * indexed by it needs no locking.
+             */
+            using Body = std::function<void (size_t, size_t, size_t)>;
+
+        private :
+            struct Worker {
+                std::mutex           m_mutex;
+                std::deque<sPtr<Job>> m_tickets;
+            };
+
+            std::vector<uPtr<Worker>> m_workers;
+            std::vector<std::thread>  m_threads;
+
+            std::mutex              m_mutex;
+            std::condition_variable m_wake;
+            size_t                  m_queued;
+            bool                    m_stop;
+
+            void run (size_t);
+            sPtr<Job> take (size_t);
+
+        public :
+            explicit ThreadPool (size_t);
+            ~ThreadPool();
+
+            ThreadPool (const ThreadPool &) = delete;
+            ThreadPool & operator = (const ThreadPool &) = delete;
+
+            /**
+             * The pool shared by the decoder, by default one worker per
+             * hardware thread beyond the caller's own. Safe for many
+             * threads to be first to ask for it.
+             */
+            static ThreadPool & instance();
+
+            /**
+             * Replace the shared pool with one of the given number of
+             * workers. Only to be called while nothing is using it,
+             * typically at startup.
+             */
+            static void resize (size_t);
+
+            size_t threads() const { return m_threads.size(); }
+
+            /**
+             * The most participants a single job can have, every worker
+             * plus the caller
+             */
+            size_t participants() const { return threads() + 1; }
+
+            /**
+             * Run [body_] over [0, n_) in chunks of [grain_] indices,
+             * returning once every chunk has completed. If any chunk throws
+             * no further chunks are started and the first exception is
+             * rethrown here.
+             */
+            void parallelFor (size_t n_, size_t grain_, const Body & body_);
+    };
+
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "concurrency/Cache.h"
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+using concurrency::Cache;
+using concurrency::ThreadPool;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Puts every key in the same bucket, as bytes crafted to collide would
+     */
+    struct Collide {
+        size_t operator()(std::string_view) const { return 42; }
+    };
+
+}
+
+/******************************************************************************/
+
+TEST (Cache, collisions) { // NOLINT
+    Cache<std::string, Collide> cache (8);
+
+    int made { 0 };
+
+    auto make = [&made](std::string_view key_) {
+        return [&made, key_]() {
+            ++made;
+            return std::make_shared<const std::string> (key_);
+        };
+    };
+
+    EXPECT_EQ ("a", *cache.get ("a", make ("a")));
+    EXPECT_EQ ("b", *cache.get ("b", make ("b")));
+    EXPECT_EQ ("a", *cache.get ("a", make ("a")));
+    EXPECT_EQ ("b", *cache.get ("b", make ("b")));
+
+    EXPECT_EQ (2, made);
+    EXPECT_EQ (2, cache.size());
+}
+
+/******************************************************************************/
+
+TEST (Cache, bounded) { // NOLINT
+    Cache<int> cache (2);
+
+    int made { 0 };
+
+    auto make = [&made](int value_) {
+        return [&made, value_]() {
+            ++made;
+            return std::make_shared<const int> (value_);
+        };
+    };
+
+    auto one = cache.get ("one", make (1));
+    cache.get ("two", make (2));
+
+    // touching one leaves two the least recently used
+    cache.get ("one", make (1));
+    cache.get ("three", make (3));
+
+    EXPECT_EQ (2, cache.size());
+    EXPECT_EQ (3, made);
+
+    EXPECT_EQ (1, *cache.get ("one", make (1)));
+    EXPECT_EQ (3, made);
+
+    EXPECT_EQ (2, *cache.get ("two", make (2)));
+    EXPECT_EQ (4, made);
+
+    // a dropped value lives on with whoever still holds it
+    cache.get ("four", make (4));
+    cache.get ("five", make (5));
+    EXPECT_EQ (1, *one);
+    EXPECT_EQ (2, cache.size());
+}
+
+/******************************************************************************/
+
+TEST (Cache, concurrent) { // NOLINT
+    Cache<std::string> cache (16);
+    ThreadPool pool (4);
+
+    std::vector<std::string> seen (16 * 100);
+
+    pool.parallelFor (seen.size(), 16, [&](size_t, size_t b_, size_t e_) {
+        for (auto i = b_ ; i < e_ ; ++i) {
+            auto key = "schema-" + std::to_string (i % 16);
+
+            seen[i] = *cache.get (key, [&key]() {
+                return std::make_shared<const std::string> (key);
+            });
+        }
+    });
+
+    for (size_t i { 0 } ; i < seen.size() ; ++i) {
+        ASSERT_EQ ("schema-" + std::to_string (i % 16), seen[i]) << i;
+    }
+
+    EXPECT_EQ (16, cache.size());
+}
+
+/******************************************************************************/
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "concurrency/Interner.h"
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+using concurrency::Interner;
+using concurrency::ThreadPool;
+
+/******************************************************************************/
+
+TEST (Interner, shares) { // NOLINT
+    Interner interner (4);
+
+    std::string a { "GBP" }, b { "GBP" };
+
+    auto first = interner.intern (a);
+    auto second = interner.intern (b);
+
+    EXPECT_EQ ("GBP", first);
+    EXPECT_EQ (first.data(), second.data());
+    EXPECT_NE (a.data(), first.data());
+
+    EXPECT_NE (first.data(), interner.intern ("USD").data());
+    EXPECT_EQ ("", interner.intern (""));
+
+    std::string large (100000, 'x');
+    EXPECT_EQ (large, interner.intern (large));
+    EXPECT_EQ (interner.intern (large).data(), interner.intern (large).data());
+
+    auto stats = interner.stats();
+
+    EXPECT_EQ (7, stats.lookups);
+    EXPECT_EQ (3, stats.hits);
+    EXPECT_EQ (4, stats.strings);
+    EXPECT_EQ (3 + 3 + 100000, stats.bytes);
+    EXPECT_DOUBLE_EQ (3.0 / 7, stats.hitRate());
+}
+
+/******************************************************************************/
+
+TEST (Interner, concurrent) { // NOLINT
+    Interner interner;
+    ThreadPool pool (4);
+
+    const size_t distinct { 1000 };
+    std::vector<const char *> seen (distinct * 50);
+
+    pool.parallelFor (seen.size(), 16, [&](size_t, size_t b_, size_t e_) {
+        for (auto i = b_ ; i < e_ ; ++i) {
+            seen[i] = interner.intern ("party-" + std::to_string (i % distinct)).data();
+        }
+    });
+
+    for (size_t i { 0 } ; i < seen.size() ; ++i) {
+        ASSERT_EQ (seen[i % distinct], seen[i]) << i;
+        ASSERT_EQ (
+            "party-" + std::to_string (i % distinct),
+            std::string (seen[i], 6 + std::to_string (i % distinct).size()));
+    }
+
+    auto stats = interner.stats();
+
+    EXPECT_EQ (seen.size(), stats.lookups);
+    EXPECT_EQ (seen.size() - distinct, stats.hits);
+    EXPECT_EQ (distinct, stats.strings);
+}
+
+/******************************************************************************/
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+using concurrency::ThreadPool;
+
+/******************************************************************************/
+
+TEST (ThreadPool, covers) { // NOLINT
+    ThreadPool pool (3);
+    std::vector<int> hits (10007, 0);
+
+    pool.parallelFor (hits.size(), 64, [&](size_t p_, size_t b_, size_t e_) {
+        ASSERT_LT (p_, pool.participants());
+        for (auto i = b_ ; i < e_ ; ++i) ++hits[i];
+    });
+
+    EXPECT_EQ (hits.size(), std::accumulate (hits.begin(), hits.end(), 0u));
+    EXPECT_EQ (hits.end(), std::find_if (hits.begin(), hits.end(),
+            [](int h_) { return h_ != 1; }));
+}
+
+/******************************************************************************/
+
+TEST (ThreadPool, noWorkers) { // NOLINT
+    ThreadPool pool (0);
+    size_t sum { 0 };
+
+    pool.parallelFor (100, 7, [&](size_t p_, size_t b_, size_t e_) {
+        EXPECT_EQ (0, p_);
+        for (auto i = b_ ; i < e_ ; ++i) sum += i;
+    });
+
+    EXPECT_EQ (4950, sum);
+}
+
+/******************************************************************************/
+
+/**
+ * Every worker busy with an outer chunk starts an inner job of its own
+ */
+TEST (ThreadPool, nested) { // NOLINT
+    ThreadPool pool (3);
+    std::atomic<size_t> sum { 0 };
+
+    pool.parallelFor (16, 1, [&](size_t, size_t b_, size_t e_) {
+        for (auto i = b_ ; i < e_ ; ++i) {
+            pool.parallelFor (1000, 10, [&](size_t, size_t ib_, size_t ie_) {
+                sum += ie_ - ib_;
+            });
+        }
+    });
+
+    EXPECT_EQ (16000, sum);
+}
+
+/******************************************************************************/
+
+TEST (ThreadPool, throws) { // NOLINT
+    ThreadPool pool (3);
+
+    EXPECT_THROW (
+        pool.parallelFor (1000, 1, [](size_t, size_t b_, size_t) {
+            if (b_ == 500) throw std::runtime_error ("bad element");
+        }),
+        std::runtime_error);
+
+    // and the pool is still usable afterwards
+    std::atomic<size_t> count { 0 };
+    pool.parallelFor (1000, 1, [&](size_t, size_t, size_t) { ++count; });
+    EXPECT_EQ (1000, count);
+}
+
+/******************************************************************************/
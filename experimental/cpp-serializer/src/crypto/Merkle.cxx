@@ -0,0 +1,55 @@
+#include "Merkle.h"
+
+#include <stdexcept>
+
+/******************************************************************************/
+
+const crypto::Digest &
+crypto::merkle::
+zero() {
+    static const Digest zero { };
+    return zero;
+}
+
+/******************************************************************************/
+
+const crypto::Digest &
+crypto::merkle::
+ones() {
+    static const Digest ones = []() {
+        Digest rtn;
+        rtn.fill (0xff);
+        return rtn;
+    }();
+
+    return ones;
+}
+
+/******************************************************************************/
+
+crypto::Digest
+crypto::merkle::
+root (std::vector<Digest> leaves_) {
+    if (leaves_.empty()) {
+        throw std::runtime_error ("Cannot calculate the Merkle root of no leaves");
+    }
+
+    size_t width { 1 };
+
+    while (width < leaves_.size()) {
+        width *= 2;
+    }
+
+    leaves_.resize (width, zero());
+
+    // each level overwrites the front of the one below it
+    for ( ; width > 1 ; width /= 2) {
+        for (size_t i { 0 } ; i < width / 2 ; ++i) {
+            leaves_[i] = sha256 (leaves_[2 * i], leaves_[2 * i + 1]);
+        }
+    }
+
+    return leaves_.front();
+}
+
+/******************************************************************************/
@@ -0,0 +1,37 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+
+#include "Sha256.h"
+
+/******************************************************************************/
+
+/**
+ * Merkle trees as Corda builds them over a transaction's components. The
+ * leaves are padded with [zero] up to the next power of two and each node
+ * is the SHA-256 of its two children one after the other.
+ */
+namespace crypto::merkle {
+
+    /**
+     * The hash a tree is padded with
+     */
+    const Digest & zero();
+
+    /**
+     * What Corda puts in place of a component group a transaction doesn't
+     * have
+     */
+    const Digest & ones();
+
+    /**
+     * The root of the tree over [leaves_], which mustn't be empty. A
+     * single leaf is its own root.
+     */
+    Digest root (std::vector<Digest> leaves_);
+
+}
+
+/******************************************************************************/
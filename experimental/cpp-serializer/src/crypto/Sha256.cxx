@@ -0,0 +1,378 @@
+#include "Sha256.h"
+
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    alignas (16) constexpr uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+        0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+        0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+        0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+        0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    constexpr uint32_t H0[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    inline uint32_t
+    rotr (uint32_t x_, int n_) {
+        return (x_ >> n_) | (x_ << (32 - n_));
+    }
+
+    inline uint32_t
+    be32 (const uint8_t * p_) {
+        return (uint32_t (p_[0]) << 24) | (uint32_t (p_[1]) << 16)
+            | (uint32_t (p_[2]) << 8) | uint32_t (p_[3]);
+    }
+
+    void
+    scalar (uint32_t * state_, const uint8_t * data_, size_t blocks_) {
+        for ( ; blocks_ ; --blocks_, data_ += 64) {
+            uint32_t w[64];
+
+            for (int i { 0 } ; i < 16 ; ++i) {
+                w[i] = be32 (data_ + 4 * i);
+            }
+
+            for (int i { 16 } ; i < 64 ; ++i) {
+                auto s0 = rotr (w[i - 15], 7) ^ rotr (w[i - 15], 18) ^ (w[i - 15] >> 3);
+                auto s1 = rotr (w[i - 2], 17) ^ rotr (w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            auto a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+            auto e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+
+            for (int i { 0 } ; i < 64 ; ++i) {
+                auto t1 = h + (rotr (e, 6) ^ rotr (e, 11) ^ rotr (e, 25))
+                    + ((e & f) ^ (~e & g)) + K[i] + w[i];
+                auto t2 = (rotr (a, 2) ^ rotr (a, 13) ^ rotr (a, 22))
+                    + ((a & b) ^ (a & c) ^ (b & c));
+
+                h = g; g = f; f = e; e = d + t1;
+                d = c; c = b; b = a; a = t1 + t2;
+            }
+
+            state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+            state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+        }
+    }
+
+#if defined(__x86_64__)
+
+    /*
+     * The extensions keep the state as ABEF and CDGH and do two rounds per
+     * instruction, so each group of four rounds is a pair of them with the
+     * message schedule for four rounds on being computed alongside. The
+     * sixteen groups differ only in which of the four message registers
+     * they use and whether the schedule still needs extending, which is
+     * settled at compile time by instantiating a group for each.
+     */
+
+    struct Lanes {
+        __m128i state0;
+        __m128i state1;
+        __m128i msg[4];
+    };
+
+    template<int group>
+    __attribute__((target("sha,sse4.1")))
+    inline void
+    rounds (Lanes & lanes_, const uint8_t * data_) {
+        const auto mask = _mm_set_epi64x (
+            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        auto & w = lanes_.msg;
+
+        if constexpr (group < 4) {
+            w[group] = _mm_shuffle_epi8 (_mm_loadu_si128 (
+                reinterpret_cast<const __m128i *>(data_ + 16 * group)), mask);
+        }
+
+        auto msg = _mm_add_epi32 (w[group % 4],
+            _mm_load_si128 (reinterpret_cast<const __m128i *>(K + 4 * group)));
+
+        lanes_.state1 = _mm_sha256rnds2_epu32 (lanes_.state1, lanes_.state0, msg);
+
+        if constexpr (group >= 3 && group <= 14) {
+            auto & next = w[(group + 1) % 4];
+
+            next = _mm_add_epi32 (next,
+                _mm_alignr_epi8 (w[group % 4], w[(group + 3) % 4], 4));
+            next = _mm_sha256msg2_epu32 (next, w[group % 4]);
+        }
+
+        msg = _mm_shuffle_epi32 (msg, 0x0e);
+        lanes_.state0 = _mm_sha256rnds2_epu32 (lanes_.state0, lanes_.state1, msg);
+
+        if constexpr (group >= 1 && group <= 12) {
+            auto & previous = w[(group + 3) % 4];
+
+            previous = _mm_sha256msg1_epu32 (previous, w[group % 4]);
+        }
+    }
+
+    template<int ... groups>
+    __attribute__((target("sha,sse4.1")))
+    inline void
+    block (Lanes & lanes_, const uint8_t * data_, std::integer_sequence<int, groups ...>) {
+        (rounds<groups> (lanes_, data_), ...);
+    }
+
+    __attribute__((target("sha,sse4.1")))
+    void
+    shani (uint32_t * state_, const uint8_t * data_, size_t blocks_) {
+        Lanes lanes { };
+
+        auto tmp = _mm_shuffle_epi32 (_mm_loadu_si128 (
+            reinterpret_cast<const __m128i *>(state_)), 0xb1);           // CDAB
+        lanes.state1 = _mm_shuffle_epi32 (_mm_loadu_si128 (
+            reinterpret_cast<const __m128i *>(state_ + 4)), 0x1b);       // EFGH
+        lanes.state0 = _mm_alignr_epi8 (tmp, lanes.state1, 8);           // ABEF
+        lanes.state1 = _mm_blend_epi16 (lanes.state1, tmp, 0xf0);        // CDGH
+
+        for ( ; blocks_ ; --blocks_, data_ += 64) {
+            auto abef = lanes.state0;
+            auto cdgh = lanes.state1;
+
+            block (lanes, data_, std::make_integer_sequence<int, 16>());
+
+            lanes.state0 = _mm_add_epi32 (lanes.state0, abef);
+            lanes.state1 = _mm_add_epi32 (lanes.state1, cdgh);
+        }
+
+        tmp = _mm_shuffle_epi32 (lanes.state0, 0x1b);                    // FEBA
+        lanes.state1 = _mm_shuffle_epi32 (lanes.state1, 0xb1);           // DCHG
+
+        _mm_storeu_si128 (reinterpret_cast<__m128i *>(state_),
+            _mm_blend_epi16 (tmp, lanes.state1, 0xf0));                  // DCBA
+        _mm_storeu_si128 (reinterpret_cast<__m128i *>(state_ + 4),
+            _mm_alignr_epi8 (lanes.state1, tmp, 8));                     // HGFE
+    }
+
+#endif
+
+    crypto::Sha256::Level
+    detect() {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+
+        unsigned eax, ebx, ecx, edx;
+
+        // bit 29 of leaf 7, which not every compiler we build with lets
+        // __builtin_cpu_supports be asked about
+        if (__get_cpuid_count (7, 0, &eax, &ebx, &ecx, &edx)
+            && (ebx & (1u << 29))
+            && __builtin_cpu_supports ("sse4.1"))
+        {
+            return crypto::Sha256::shani_t;
+        }
+#endif
+        return crypto::Sha256::scalar_t;
+    }
+
+    std::atomic<int> &
+    cap() {
+        static std::atomic<int> cap { crypto::Sha256::shani_t };
+        return cap;
+    }
+
+    void
+    compress (uint32_t * state_, const uint8_t * data_, size_t blocks_) {
+#if defined(__x86_64__)
+        if (crypto::Sha256::level() == crypto::Sha256::shani_t) {
+            shani (state_, data_, blocks_);
+            return;
+        }
+#endif
+        scalar (state_, data_, blocks_);
+    }
+
+}
+
+/******************************************************************************
+ *
+ * crypto::Sha256 statics
+ *
+ ******************************************************************************/
+
+crypto::Sha256::Level
+crypto::
+Sha256::detected() {
+    static const Level level = detect();
+    return level;
+}
+
+/******************************************************************************/
+
+crypto::Sha256::Level
+crypto::
+Sha256::level() {
+    return static_cast<Level>(std::min<int> (detected(), cap().load()));
+}
+
+/******************************************************************************/
+
+void
+crypto::
+Sha256::limit (Level level_) {
+    cap().store (level_);
+}
+
+/******************************************************************************/
+
+const char *
+crypto::
+Sha256::name (Level level_) {
+    switch (level_) {
+        case scalar_t : return "scalar";
+        case shani_t  : return "sha-ni";
+    }
+
+    return "unknown";
+}
+
+/******************************************************************************
+ *
+ * crypto::Sha256
+ *
+ ******************************************************************************/
+
+crypto::
+Sha256::Sha256()
+    : m_block { }
+    , m_used { 0 }
+    , m_length { 0 }
+{
+    std::copy (std::begin (H0), std::end (H0), m_state);
+}
+
+/******************************************************************************/
+
+crypto::Sha256 &
+crypto::
+Sha256::update (const void * bytes_, size_t size_) {
+    auto in = static_cast<const uint8_t *>(bytes_);
+
+    m_length += size_;
+
+    if (m_used) {
+        auto n = std::min (size_, sizeof (m_block) - m_used);
+
+        memcpy (m_block + m_used, in, n);
+        m_used += n;
+        in += n;
+        size_ -= n;
+
+        if (m_used < sizeof (m_block)) {
+            return *this;
+        }
+
+        compress (m_state, m_block, 1);
+        m_used = 0;
+    }
+
+    // whole blocks straight from the input
+    if (size_ >= 64) {
+        compress (m_state, in, size_ / 64);
+
+        in += size_ & ~size_t { 63 };
+        size_ &= 63;
+    }
+
+    memcpy (m_block, in, size_);
+    m_used = size_;
+
+    return *this;
+}
+
+/******************************************************************************/
+
+crypto::Digest
+crypto::
+Sha256::digest() {
+    auto bits = m_length * 8;
+
+    m_block[m_used++] = 0x80;
+
+    if (m_used > 56) {
+        memset (m_block + m_used, 0, 64 - m_used);
+        compress (m_state, m_block, 1);
+        m_used = 0;
+    }
+
+    memset (m_block + m_used, 0, 56 - m_used);
+
+    for (int i { 0 } ; i < 8 ; ++i) {
+        m_block[56 + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    }
+
+    compress (m_state, m_block, 1);
+
+    Digest rtn;
+
+    for (int i { 0 } ; i < 8 ; ++i) {
+        rtn[4 * i]     = static_cast<uint8_t>(m_state[i] >> 24);
+        rtn[4 * i + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+        rtn[4 * i + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+        rtn[4 * i + 3] = static_cast<uint8_t>(m_state[i]);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+crypto::Digest
+crypto::
+sha256 (const void * bytes_, size_t size_) {
+    return Sha256().update (bytes_, size_).digest();
+}
+
+/******************************************************************************/
+
+crypto::Digest
+crypto::
+sha256 (const Digest & left_, const Digest & right_) {
+    return Sha256()
+        .update (left_.data(), left_.size())
+        .update (right_.data(), right_.size())
+        .digest();
+}
+
+/******************************************************************************/
+
+crypto::Digest
+crypto::
+sha256Twice (const void * bytes_, size_t size_) {
+    auto once = sha256 (bytes_, size_);
+
+    return sha256 (once.data(), once.size());
+}
+
+/******************************************************************************/
@@ -0,0 +1,75 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/******************************************************************************/
+
+namespace crypto {
+
+    using Digest = std::array<uint8_t, 32>;
+
+    /**
+     * SHA-256, incrementally over as many pieces as the message comes in.
+     * Blocks are compressed with the x86 SHA extensions where the host has
+     * them, otherwise in plain C++.
+     */
+    class Sha256 {
+        public :
+            enum Level { scalar_t, shani_t };
+
+            /**
+             * The best implementation this machine supports
+             */
+            static Level detected();
+
+            /**
+             * The implementation used, [detected] unless capped by [limit]
+             */
+            static Level level();
+
+            /**
+             * Cap the implementation used, for testing and benchmarking the
+             * fallback on hardware that has the extensions
+             */
+            static void limit (Level);
+
+            static const char * name (Level);
+
+        private :
+            uint32_t m_state[8];
+            uint8_t  m_block[64];
+            size_t   m_used;
+            uint64_t m_length;
+
+        public :
+            Sha256();
+
+            Sha256 & update (const void *, size_t);
+
+            /**
+             * Pad the message and return its digest, after which the
+             * hasher must not be updated again
+             */
+            Digest digest();
+    };
+
+    Digest sha256 (const void *, size_t);
+
+    /**
+     * The digest of the two digests one after the other, as a Merkle
+     * tree's nodes are
+     */
+    Digest sha256 (const Digest &, const Digest &);
+
+    /**
+     * The digest of the digest, Corda's sha256Twice
+     */
+    Digest sha256Twice (const void *, size_t);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "crypto/Sha256.h"
+#include "crypto/Merkle.h"
+
+/******************************************************************************/
+
+/**
+ * Hashing throughput of each implementation, on the few dozen bytes a
+ * Merkle node or component nonce is and on the kilobytes a component is,
+ * and the root of a tree of a transaction's worth of leaves.
+ */
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    random (size_t len_) {
+        std::mt19937 gen { 42 };
+        std::string raw (len_, '\0');
+
+        for (auto & c : raw) c = static_cast<char>(gen());
+
+        return raw;
+    }
+
+    bool
+    setLevel (benchmark::State & state_) {
+        auto level = static_cast<crypto::Sha256::Level>(state_.range (0));
+
+        if (level > crypto::Sha256::detected()) {
+            state_.SkipWithError ("not supported on this machine");
+            return false;
+        }
+
+        crypto::Sha256::limit (level);
+        state_.SetLabel (crypto::Sha256::name (level));
+
+        return true;
+    }
+
+}
+
+/******************************************************************************/
+
+static void
+BM_Sha256 (benchmark::State & state_) {
+    if (!setLevel (state_)) return;
+
+    auto message = random (state_.range (1));
+
+    for (auto _ : state_) {
+        benchmark::DoNotOptimize (crypto::sha256 (message.data(), message.size()));
+    }
+
+    state_.SetBytesProcessed (state_.iterations() * message.size());
+}
+
+/******************************************************************************/
+
+static void
+BM_MerkleRoot (benchmark::State & state_) {
+    if (!setLevel (state_)) return;
+
+    std::vector<crypto::Digest> leaves (state_.range (1));
+
+    for (size_t i { 0 } ; i < leaves.size() ; ++i) {
+        leaves[i] = crypto::sha256 (&i, sizeof (i));
+    }
+
+    for (auto _ : state_) {
+        benchmark::DoNotOptimize (crypto::merkle::root (leaves));
+    }
+
+    state_.SetItemsProcessed (state_.iterations() * leaves.size());
+}
+
+/******************************************************************************/
+
+BENCHMARK (BM_Sha256)->ArgsProduct ({
+    { crypto::Sha256::scalar_t, crypto::Sha256::shani_t },
+    { 64, 1024, 1 << 20 } });
+
+BENCHMARK (BM_MerkleRoot)->ArgsProduct ({
+    { crypto::Sha256::scalar_t, crypto::Sha256::shani_t },
+    { 16, 1024 } });
+
+BENCHMARK_MAIN();
+
+/******************************************************************************/
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "crypto/Merkle.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    hex (const crypto::Digest & digest_) {
+        static const char digits[] = "0123456789abcdef";
+        std::string rtn;
+
+        for (auto c : digest_) {
+            rtn += digits[c >> 4];
+            rtn += digits[c & 0xF];
+        }
+
+        return rtn;
+    }
+
+    crypto::Digest
+    leaf (const std::string & str_) {
+        return crypto::sha256 (str_.data(), str_.size());
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Merkle, root) { // NOLINT
+    auto a = leaf ("a");
+    auto b = leaf ("b");
+    auto c = leaf ("c");
+
+    EXPECT_EQ (hex (a), hex (crypto::merkle::root ({ a })));
+    EXPECT_EQ (hex (crypto::sha256 (a, b)), hex (crypto::merkle::root ({ a, b })));
+
+    // padded with zero hashes up to four and then to eight leaves
+    EXPECT_EQ (
+        "d0a664079d491a97357efa1ce1eab5aeb566adef78a2b910e8d13e901e192832",
+        hex (crypto::merkle::root ({ a, b, c })));
+    EXPECT_EQ (
+        "3e82cbbb494969fa50724638ca4baca3caa3c793a9f7d224b6f49c3f34244d2e",
+        hex (crypto::merkle::root ({ a, b, c, a, b })));
+
+    EXPECT_THROW (crypto::merkle::root ({ }), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Merkle, padding) { // NOLINT
+    EXPECT_EQ (std::string (64, '0'), hex (crypto::merkle::zero()));
+    EXPECT_EQ (std::string (64, 'f'), hex (crypto::merkle::ones()));
+}
+
+/******************************************************************************/
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "crypto/Sha256.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    hex (const crypto::Digest & digest_) {
+        static const char digits[] = "0123456789abcdef";
+        std::string rtn;
+
+        for (auto c : digest_) {
+            rtn += digits[c >> 4];
+            rtn += digits[c & 0xF];
+        }
+
+        return rtn;
+    }
+
+    std::string
+    hash (const std::string & in_) {
+        return hex (crypto::sha256 (in_.data(), in_.size()));
+    }
+
+    /**
+     * Every implementation this machine has
+     */
+    std::vector<crypto::Sha256::Level>
+    levels() {
+        std::vector<crypto::Sha256::Level> rtn { crypto::Sha256::scalar_t };
+
+        if (crypto::Sha256::detected() == crypto::Sha256::shani_t) {
+            rtn.push_back (crypto::Sha256::shani_t);
+        }
+
+        return rtn;
+    }
+
+    struct Restore {
+        ~Restore() { crypto::Sha256::limit (crypto::Sha256::shani_t); }
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * The FIPS 180-2 examples, which between them cover an empty message, one
+ * that pads into a second block and one of many blocks
+ */
+TEST (Sha256, vectors) { // NOLINT
+    Restore restore;
+
+    for (auto level : levels()) {
+        crypto::Sha256::limit (level);
+
+        SCOPED_TRACE (crypto::Sha256::name (level));
+
+        EXPECT_EQ (
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+            hash (""));
+        EXPECT_EQ (
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+            hash ("abc"));
+        EXPECT_EQ (
+            "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+            hash ("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+        EXPECT_EQ (
+            "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+            hash (std::string (1000000, 'a')));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * However a message is split across updates, and whichever implementation
+ * compresses it, the digest is the same
+ */
+TEST (Sha256, pieces) { // NOLINT
+    Restore restore;
+
+    std::mt19937 gen { 7 };
+    std::string message (1000, '\0');
+
+    for (auto & c : message) c = static_cast<char>(gen());
+
+    for (size_t size : { 0, 1, 55, 56, 63, 64, 65, 119, 128, 1000 }) {
+        crypto::Sha256::limit (crypto::Sha256::scalar_t);
+
+        auto expected = crypto::sha256 (message.data(), size);
+
+        for (auto level : levels()) {
+            crypto::Sha256::limit (level);
+
+            for (size_t step : { 1, 3, 64, 100 }) {
+                crypto::Sha256 hasher;
+
+                for (size_t i { 0 } ; i < size ; i += step) {
+                    hasher.update (message.data() + i, std::min (step, size - i));
+                }
+
+                EXPECT_EQ (hex (expected), hex (hasher.digest()))
+                    << crypto::Sha256::name (level) << " " << size << " " << step;
+            }
+        }
+    }
+}
+
+/******************************************************************************/
+
+TEST (Sha256, twice) { // NOLINT
+    auto once = crypto::sha256 ("abc", 3);
+
+    EXPECT_EQ (
+        hex (crypto::sha256 (once.data(), once.size())),
+        hex (crypto::sha256Twice ("abc", 3)));
+
+    EXPECT_EQ (
+        "4f8b42c22dd3729b519ba6f68d2da7cc5b2d606d05daed5ad5128cc03e6c6358",
+        hex (crypto::sha256Twice ("abc", 3)));
+}
+
+/******************************************************************************/
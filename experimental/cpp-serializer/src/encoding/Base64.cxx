@@ -0,0 +1,362 @@
+#include "Base64.h"
+#include "Cpu.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr unsigned char INVALID    = 0xFF;
+    constexpr unsigned char WHITESPACE = 0xFE;
+    constexpr unsigned char PAD        = 0xFD;
+
+    constexpr std::array<unsigned char, 256>
+    makeTable() {
+        std::array<unsigned char, 256> table { };
+
+        for (auto & i : table) i = INVALID;
+
+        for (int i { 0 } ; i < 26 ; ++i) {
+            table['A' + i] = i;
+            table['a' + i] = 26 + i;
+        }
+        for (int i { 0 } ; i < 10 ; ++i) table['0' + i] = 52 + i;
+
+        table['+'] = 62;
+        table['/'] = 63;
+        table['='] = PAD;
+
+        table[' ']  = WHITESPACE;
+        table['\t'] = WHITESPACE;
+        table['\r'] = WHITESPACE;
+        table['\n'] = WHITESPACE;
+
+        return table;
+    }
+
+    constexpr std::array<unsigned char, 256> table = makeTable(); // NOLINT
+
+    [[noreturn]] void
+    badChar (const char * in_, size_t idx_) {
+        std::stringstream ss;
+        ss << "Invalid base64 character '" << in_[idx_]
+           << "' at offset " << idx_;
+        throw std::runtime_error (ss.str());
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+encoding::base64::
+isBase64Char (char c_) {
+    return table[static_cast<unsigned char>(c_)] < 64;
+}
+
+/******************************************************************************/
+
+size_t
+encoding::base64::
+decodedSize (size_t len_) {
+    return ((len_ + 3) / 4) * 3;
+}
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * The scalar decoder, one character at a time. Kept as an object so the
+     * vector kernels can hand over to it whenever they hit something they
+     * don't deal with (whitespace, padding, errors) and pick up again once
+     * it reaches the start of the next quantum.
+     */
+    class Decoder {
+        private :
+            char * m_out;
+            uint32_t m_acc { 0 };
+            int m_bits { 0 };
+            size_t m_sextets { 0 };
+            size_t m_padding { 0 };
+
+        public :
+            explicit Decoder (char * out_) : m_out (out_) { }
+
+            char * out() const { return m_out; }
+
+            /**
+             * True when sitting on the boundary between two four character
+             * quanta, the only place bulk decoding can take over
+             */
+            bool aligned() const {
+                return m_sextets % 4 == 0 && !m_padding;
+            }
+
+            /**
+             * Account for whole quanta decoded by someone else
+             */
+            void skip (size_t sextets_) {
+                m_sextets += sextets_;
+                m_out += sextets_ / 4 * 3;
+            }
+
+            void step (const char *, size_t);
+            void finish() const;
+    };
+
+    inline void
+    Decoder::step (const char * in_, size_t idx_) {
+        auto v = table[static_cast<unsigned char>(in_[idx_])];
+
+        if (v < 64) {
+            if (m_padding) {
+                throw std::runtime_error ("Base64 data found after padding");
+            }
+
+            m_acc = (m_acc << 6) | v;
+            m_bits += 6;
+            ++m_sextets;
+
+            if (m_bits >= 8) {
+                m_bits -= 8;
+                *m_out++ = static_cast<char>((m_acc >> m_bits) & 0xFF);
+            }
+        } else if (v == PAD) {
+            ++m_padding;
+        } else if (v != WHITESPACE) {
+            badChar (in_, idx_);
+        }
+    }
+
+    void
+    Decoder::finish() const {
+        /*
+         * A lone trailing sextet can't encode a whole byte, and padding, when
+         * present, has to bring the input to a multiple of four characters
+         */
+        if (m_sextets % 4 == 1 || m_padding > 2
+            || (m_padding && (m_sextets + m_padding) % 4 != 0))
+        {
+            throw std::runtime_error ("Malformed base64 input");
+        }
+    }
+
+    /**
+     * Alternates between a bulk [kernel_], which decodes whole blocks of
+     * alphabet characters and returns how many it consumed, and the scalar
+     * [Decoder] for everything else.
+     */
+    template<typename Kernel>
+    size_t
+    decode (const char * in_, size_t len_, char * out_, Kernel kernel_) {
+        Decoder decoder (out_);
+        size_t i { 0 };
+
+        while (true) {
+            auto consumed = kernel_ (in_ + i, len_ - i, decoder.out());
+
+            decoder.skip (consumed);
+            i += consumed;
+
+            if (i == len_) break;
+
+            do {
+                decoder.step (in_, i++);
+            } while (i < len_ && !decoder.aligned());
+
+            if (i == len_) break;
+        }
+
+        decoder.finish();
+
+        return decoder.out() - out_;
+    }
+
+#if defined(__x86_64__)
+
+    /*
+     * Character classification and translation after Muła and Lemire,
+     * "Faster Base64 Encoding and Decoding using AVX2 Instructions". Each
+     * character is looked up by both its nibbles, a character is in the
+     * alphabet iff the two lookups share no bits. The high nibble, adjusted
+     * for '/' which shares its nibble with '+' and the digits, then selects
+     * the offset taking the character to its sextet value.
+     *
+     * The four sextets of each 32 bit word are then merged in two multiply
+     * adds, leaving three big endian bytes per word to be shuffled into
+     * place.
+     */
+
+    __attribute__((target("sse4.1")))
+    inline bool
+    sextets (__m128i in_, __m128i & out_) {
+        const auto lutLo = _mm_setr_epi8 (
+                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const auto lutHi = _mm_setr_epi8 (
+                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const auto lutRoll = _mm_setr_epi8 (
+                0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto mask = _mm_set1_epi8 (0x0F);
+
+        auto hi = _mm_and_si128 (_mm_srli_epi32 (in_, 4), mask);
+        auto lo = _mm_and_si128 (in_, mask);
+
+        if (!_mm_testz_si128 (
+                _mm_shuffle_epi8 (lutLo, lo), _mm_shuffle_epi8 (lutHi, hi)))
+        {
+            return false;
+        }
+
+        auto slash = _mm_cmpeq_epi8 (in_, _mm_set1_epi8 ('/'));
+        auto roll = _mm_shuffle_epi8 (lutRoll, _mm_add_epi8 (slash, hi));
+
+        out_ = _mm_add_epi8 (in_, roll);
+
+        return true;
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128i
+    pack (__m128i sextets_) {
+        auto merged = _mm_madd_epi16 (
+                _mm_maddubs_epi16 (sextets_, _mm_set1_epi32 (0x01400140)),
+                _mm_set1_epi32 (0x00011000));
+
+        return _mm_shuffle_epi8 (merged, _mm_setr_epi8 (
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    /**
+     * 16 characters into 12 bytes per iteration. Only the 12 bytes are
+     * written so the output never needs more than [decodedSize] bytes.
+     */
+    __attribute__((target("sse4.1")))
+    size_t
+    sse41 (const char * in_, size_t len_, char * out_) {
+        size_t i { 0 };
+
+        for ( ; i + 16 <= len_ ; i += 16) {
+            __m128i values;
+
+            if (!sextets (_mm_loadu_si128 ((const __m128i *)(in_ + i)), values)) {
+                break;
+            }
+
+            alignas (16) char bytes[16];
+            _mm_store_si128 ((__m128i *)bytes, pack (values));
+            std::memcpy (out_, bytes, 12);
+            out_ += 12;
+        }
+
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    inline bool
+    sextets (__m256i in_, __m256i & out_) {
+        const auto lutLo = _mm256_setr_epi8 (
+                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const auto lutHi = _mm256_setr_epi8 (
+                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const auto lutRoll = _mm256_setr_epi8 (
+                0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto mask = _mm256_set1_epi8 (0x0F);
+
+        auto hi = _mm256_and_si256 (_mm256_srli_epi32 (in_, 4), mask);
+        auto lo = _mm256_and_si256 (in_, mask);
+
+        if (!_mm256_testz_si256 (
+                _mm256_shuffle_epi8 (lutLo, lo), _mm256_shuffle_epi8 (lutHi, hi)))
+        {
+            return false;
+        }
+
+        auto slash = _mm256_cmpeq_epi8 (in_, _mm256_set1_epi8 ('/'));
+        auto roll = _mm256_shuffle_epi8 (lutRoll, _mm256_add_epi8 (slash, hi));
+
+        out_ = _mm256_add_epi8 (in_, roll);
+
+        return true;
+    }
+
+    /**
+     * As [sse41] but 32 characters at a time, the shuffle leaving 12 bytes
+     * at the bottom of each lane
+     */
+    __attribute__((target("avx2")))
+    size_t
+    avx2 (const char * in_, size_t len_, char * out_) {
+        const auto order = _mm256_setr_epi8 (
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        size_t i { 0 };
+
+        for ( ; i + 32 <= len_ ; i += 32) {
+            __m256i values;
+
+            if (!sextets (_mm256_loadu_si256 ((const __m256i *)(in_ + i)), values)) {
+                break;
+            }
+
+            auto merged = _mm256_madd_epi16 (
+                    _mm256_maddubs_epi16 (values, _mm256_set1_epi32 (0x01400140)),
+                    _mm256_set1_epi32 (0x00011000));
+
+            alignas (32) char bytes[32];
+            _mm256_store_si256 ((__m256i *)bytes, _mm256_shuffle_epi8 (merged, order));
+            std::memcpy (out_, bytes, 12);
+            std::memcpy (out_ + 12, bytes + 16, 12);
+            out_ += 24;
+        }
+
+        /*
+         * The rest of the decoder is legacy SSE encoded, leaving the upper
+         * halves dirty makes every transition to it very expensive
+         */
+        _mm256_zeroupper();
+
+        return i + sse41 (in_ + i, len_ - i, out_);
+    }
+
+#endif
+
+}
+
+/******************************************************************************/
+
+size_t
+encoding::base64::
+decode (const char * in_, size_t len_, char * out_) {
+#if defined(__x86_64__)
+    switch (cpu::level()) {
+        case cpu::avx2_t  : return ::decode (in_, len_, out_, avx2);
+        case cpu::sse41_t : return ::decode (in_, len_, out_, sse41);
+        case cpu::scalar_t : break;
+    }
+#endif
+
+    return ::decode (in_, len_, out_, [](const char *, size_t, char *) {
+        return size_t { 0 };
+    });
+}
+
+/******************************************************************************/
@@ -0,0 +1,36 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * Standard (RFC 4648) base64 decoding. Text exported from databases and
+ * JSON APIs is frequently line wrapped, so whitespace within the input is
+ * skipped. Padding is optional.
+ */
+namespace encoding::base64 {
+
+    /**
+     * The maximum number of bytes [decode] can write for an input of the
+     * given length.
+     */
+    size_t decodedSize (size_t);
+
+    /**
+     * Decode the input into the output buffer, which must be at least
+     * [decodedSize] bytes long. Throws on characters outside of the
+     * base64 alphabet or malformed padding. Vectorised where [cpu::level]
+     * allows, whitespace and padding being handled by the scalar decoder.
+     *
+     * @return the number of bytes written
+     */
+    size_t decode (const char *, size_t, char *);
+
+    bool isBase64Char (char);
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,73 @@
+#include "Cpu.h"
+
+#include <atomic>
+#include <algorithm>
+
+/******************************************************************************/
+
+namespace {
+
+    encoding::cpu::Level
+    detect() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports ("avx2")) {
+            return encoding::cpu::avx2_t;
+        }
+
+        if (__builtin_cpu_supports ("sse4.1")) {
+            return encoding::cpu::sse41_t;
+        }
+#endif
+        return encoding::cpu::scalar_t;
+    }
+
+    std::atomic<int> &
+    cap() {
+        static std::atomic<int> cap { encoding::cpu::avx2_t };
+        return cap;
+    }
+
+}
+
+/******************************************************************************/
+
+encoding::cpu::Level
+encoding::cpu::
+detected() {
+    static const Level level = detect();
+    return level;
+}
+
+/******************************************************************************/
+
+encoding::cpu::Level
+encoding::cpu::
+level() {
+    return static_cast<Level>(std::min<int> (detected(), cap().load()));
+}
+
+/******************************************************************************/
+
+void
+encoding::cpu::
+limit (Level level_) {
+    cap().store (level_);
+}
+
+/******************************************************************************/
+
+const char *
+encoding::cpu::
+name (Level level_) {
+    switch (level_) {
+        case scalar_t : return "scalar";
+        case sse41_t  : return "sse4.1";
+        case avx2_t   : return "avx2";
+    }
+
+    return "unknown";
+}
+
+/******************************************************************************/
@@ -0,0 +1,37 @@
+#pragma once
+
+/******************************************************************************/
+
+/**
+ * Runtime detection of the vector instruction sets our decoders have
+ * specialised implementations for. We build for the lowest common
+ * denominator and pick the best implementation the host supports the first
+ * time a decoder is used.
+ */
+namespace encoding::cpu {
+
+    enum Level { scalar_t, sse41_t, avx2_t };
+
+    /**
+     * The best level supported by this machine
+     */
+    Level detected();
+
+    /**
+     * The level decoders will dispatch to, normally [detected] unless
+     * capped with [limit]
+     */
+    Level level();
+
+    /**
+     * Cap the level used by the dispatching decoders, useful for testing and
+     * benchmarking the fallbacks on hardware that supports better. Can't
+     * raise the level beyond what the hardware supports.
+     */
+    void limit (Level);
+
+    const char * name (Level);
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,346 @@
+#include "Hex.h"
+#include "Cpu.h"
+
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr unsigned char INVALID = 0xFF;
+
+    constexpr std::array<unsigned char, 256>
+    makeTable() {
+        std::array<unsigned char, 256> table { };
+
+        for (auto & i : table) i = INVALID;
+
+        for (int i { 0 } ; i < 10 ; ++i) table['0' + i] = i;
+        for (int i { 0 } ; i < 6 ; ++i) {
+            table['a' + i] = 10 + i;
+            table['A' + i] = 10 + i;
+        }
+
+        return table;
+    }
+
+    constexpr std::array<unsigned char, 256> table = makeTable(); // NOLINT
+
+    [[noreturn]] void
+    badDigit (const char * in_, size_t idx_) {
+        std::stringstream ss;
+        ss << "Invalid hex digit '" << in_[idx_] << "' at offset " << idx_;
+        throw std::runtime_error (ss.str());
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+encoding::hex::
+isHexDigit (char c_) {
+    return table[static_cast<unsigned char>(c_)] != INVALID;
+}
+
+/******************************************************************************/
+
+size_t
+encoding::hex::
+prefix (const char * in_, size_t len_) {
+    if (len_ >= 2 && in_[0] == '\\' && in_[1] == 'x') {
+        return 2;
+    }
+
+    if (len_ >= 2 && in_[0] == '0' && (in_[1] == 'x' || in_[1] == 'X')) {
+        return 2;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
+size_t
+encoding::hex::
+decodedSize (size_t len_) {
+    return len_ / 2;
+}
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Decodes pairs of digits from [idx_] until the end of the input,
+     * throwing with the offset of the first invalid digit
+     */
+    size_t
+    scalar (const char * in_, size_t len_, char * out_, size_t idx_) {
+        for (size_t i { idx_ } ; i < len_ ; i += 2) {
+            auto hi = table[static_cast<unsigned char>(in_[i])];
+            auto lo = table[static_cast<unsigned char>(in_[i + 1])];
+
+            if (hi == INVALID || lo == INVALID) {
+                badDigit (in_, hi == INVALID ? i : i + 1);
+            }
+
+            out_[i / 2] = static_cast<char>((hi << 4) | lo);
+        }
+
+        return len_ / 2;
+    }
+
+#if defined(__x86_64__)
+
+    /*
+     * The vector kernels map each character to its nibble value and check
+     * that every one of them was a digit. They stop at the first block
+     * containing anything else and leave it to [scalar] to work out where
+     * the bad digit was.
+     *
+     * Digits are c - '0' in [0, 9], letters are (c | 0x20) - 'a' in [0, 5],
+     * unsigned comparisons being done as min (x, n) == x
+     */
+
+    __attribute__((target("sse4.1")))
+    inline bool
+    nibbles (__m128i in_, __m128i & out_) {
+        auto digit = _mm_sub_epi8 (in_, _mm_set1_epi8 ('0'));
+        auto alpha = _mm_sub_epi8 (
+                _mm_or_si128 (in_, _mm_set1_epi8 (0x20)),
+                _mm_set1_epi8 ('a'));
+
+        auto isDigit = _mm_cmpeq_epi8 (
+                _mm_min_epu8 (digit, _mm_set1_epi8 (9)), digit);
+        auto isAlpha = _mm_cmpeq_epi8 (
+                _mm_min_epu8 (alpha, _mm_set1_epi8 (5)), alpha);
+
+        out_ = _mm_blendv_epi8 (
+                _mm_add_epi8 (alpha, _mm_set1_epi8 (10)), digit, isDigit);
+
+        return _mm_movemask_epi8 (_mm_or_si128 (isDigit, isAlpha)) == 0xFFFF;
+    }
+
+    /**
+     * 32 characters into 16 bytes per iteration. Each pair of nibbles, high
+     * first, is combined as hi * 16 + lo by a multiply-add against 0x10, 0x01
+     */
+    __attribute__((target("sse4.1")))
+    size_t
+    sse41 (const char * in_, size_t len_, char * out_, size_t idx_) {
+        const auto weights = _mm_set1_epi16 (0x0110);
+        size_t i { idx_ };
+
+        for ( ; i + 32 <= len_ ; i += 32) {
+            __m128i a, b;
+
+            if (!nibbles (_mm_loadu_si128 ((const __m128i *)(in_ + i)), a)
+                || !nibbles (_mm_loadu_si128 ((const __m128i *)(in_ + i + 16)), b))
+            {
+                break;
+            }
+
+            _mm_storeu_si128 ((__m128i *)(out_ + i / 2), _mm_packus_epi16 (
+                    _mm_maddubs_epi16 (a, weights),
+                    _mm_maddubs_epi16 (b, weights)));
+        }
+
+        return scalar (in_, len_, out_, i);
+    }
+
+    __attribute__((target("avx2")))
+    inline bool
+    nibbles (__m256i in_, __m256i & out_) {
+        auto digit = _mm256_sub_epi8 (in_, _mm256_set1_epi8 ('0'));
+        auto alpha = _mm256_sub_epi8 (
+                _mm256_or_si256 (in_, _mm256_set1_epi8 (0x20)),
+                _mm256_set1_epi8 ('a'));
+
+        auto isDigit = _mm256_cmpeq_epi8 (
+                _mm256_min_epu8 (digit, _mm256_set1_epi8 (9)), digit);
+        auto isAlpha = _mm256_cmpeq_epi8 (
+                _mm256_min_epu8 (alpha, _mm256_set1_epi8 (5)), alpha);
+
+        out_ = _mm256_blendv_epi8 (
+                _mm256_add_epi8 (alpha, _mm256_set1_epi8 (10)), digit, isDigit);
+
+        return _mm256_movemask_epi8 (_mm256_or_si256 (isDigit, isAlpha)) == -1;
+    }
+
+    /**
+     * As [sse41] but 64 characters at a time. The pack works within each
+     * 128 bit lane so the quarters need putting back in order afterwards
+     */
+    __attribute__((target("avx2")))
+    size_t
+    avx2 (const char * in_, size_t len_, char * out_) {
+        const auto weights = _mm256_set1_epi16 (0x0110);
+        size_t i { 0 };
+
+        for ( ; i + 64 <= len_ ; i += 64) {
+            __m256i a, b;
+
+            if (!nibbles (_mm256_loadu_si256 ((const __m256i *)(in_ + i)), a)
+                || !nibbles (_mm256_loadu_si256 ((const __m256i *)(in_ + i + 32)), b))
+            {
+                break;
+            }
+
+            auto packed = _mm256_packus_epi16 (
+                    _mm256_maddubs_epi16 (a, weights),
+                    _mm256_maddubs_epi16 (b, weights));
+
+            _mm256_storeu_si256 ((__m256i *)(out_ + i / 2),
+                    _mm256_permute4x64_epi64 (packed, 0xD8));
+        }
+
+        /*
+         * The rest of the decoder is legacy SSE encoded, leaving the upper
+         * halves dirty makes every transition to it very expensive
+         */
+        _mm256_zeroupper();
+
+        return sse41 (in_, len_, out_, i);
+    }
+
+#endif
+
+}
+
+/******************************************************************************/
+
+size_t
+encoding::hex::
+decode (const char * in_, size_t len_, char * out_) {
+    if (len_ % 2 != 0) {
+        throw std::runtime_error ("Hex input has an odd number of digits");
+    }
+
+#if defined(__x86_64__)
+    switch (cpu::level()) {
+        case cpu::avx2_t  : return avx2 (in_, len_, out_);
+        case cpu::sse41_t : return sse41 (in_, len_, out_, 0);
+        case cpu::scalar_t : break;
+    }
+#endif
+
+    return scalar (in_, len_, out_, 0);
+}
+
+/******************************************************************************/
+
+void
+encoding::hex::
+encode (std::string & out_, const void * bytes_, size_t size_) {
+    static const char digits[] = "0123456789ABCDEF";
+
+    auto in = static_cast<const unsigned char *>(bytes_);
+    auto at = out_.size();
+
+    out_.resize (at + 2 * size_);
+
+    for (size_t i { 0 } ; i < size_ ; ++i) {
+        out_[at + 2 * i] = digits[in[i] >> 4];
+        out_[at + 2 * i + 1] = digits[in[i] & 0xF];
+    }
+}
+
+/******************************************************************************/
+
+std::string
+encoding::hex::
+encode (const void * bytes_, size_t size_) {
+    std::string rtn;
+    encode (rtn, bytes_, size_);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Where each of a UUID's 32 digits is printed, its dashes following
+     * the 8th, 12th, 16th and 20th
+     */
+    constexpr size_t
+    place (size_t digit_) {
+        return digit_ + (digit_ >= 8) + (digit_ >= 12) + (digit_ >= 16) + (digit_ >= 20);
+    }
+
+    void
+    uuidScalar (char * out_, const unsigned char * in_) {
+        static const char digits[] = "0123456789abcdef";
+
+        for (size_t i { 0 } ; i < 16 ; ++i) {
+            out_[place (2 * i)] = digits[in_[i] >> 4];
+            out_[place (2 * i + 1)] = digits[in_[i] & 0xF];
+        }
+    }
+
+#if defined(__x86_64__)
+
+    /**
+     * Every nibble looked up in one shuffle against the digits, the high
+     * and low nibbles of each byte interleaved back into 32 digits and
+     * those copied out around the dashes
+     */
+    __attribute__((target("sse4.1")))
+    void
+    uuidSse41 (char * out_, const unsigned char * in_) {
+        const auto digits = _mm_setr_epi8 (
+            '0', '1', '2', '3', '4', '5', '6', '7',
+            '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+        const auto mask = _mm_set1_epi8 (0x0F);
+
+        auto bytes = _mm_loadu_si128 ((const __m128i *)in_);
+
+        auto hi = _mm_shuffle_epi8 (
+                digits, _mm_and_si128 (_mm_srli_epi16 (bytes, 4), mask));
+        auto lo = _mm_shuffle_epi8 (digits, _mm_and_si128 (bytes, mask));
+
+        char hex[32];
+        _mm_storeu_si128 ((__m128i *)hex, _mm_unpacklo_epi8 (hi, lo));
+        _mm_storeu_si128 ((__m128i *)(hex + 16), _mm_unpackhi_epi8 (hi, lo));
+
+        std::memcpy (out_, hex, 8);
+        std::memcpy (out_ + 9, hex + 8, 4);
+        std::memcpy (out_ + 14, hex + 12, 4);
+        std::memcpy (out_ + 19, hex + 16, 4);
+        std::memcpy (out_ + 24, hex + 20, 12);
+    }
+
+#endif
+
+}
+
+/******************************************************************************/
+
+void
+encoding::hex::
+uuid (std::string & out_, const void * bytes_) {
+    auto in = static_cast<const unsigned char *>(bytes_);
+    auto at = out_.size();
+
+    out_.resize (at + 36, '-');
+
+#if defined(__x86_64__)
+    if (cpu::level() != cpu::scalar_t) {
+        uuidSse41 (&out_[at], in);
+        return;
+    }
+#endif
+
+    uuidScalar (&out_[at], in);
+}
+
+/******************************************************************************/
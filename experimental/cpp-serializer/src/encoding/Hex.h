@@ -0,0 +1,58 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+
+/******************************************************************************/
+
+/**
+ * Conversion of hexadecimal text, as found in database exports of binary
+ * columns, back into the raw bytes it represents, and of bytes into it.
+ */
+namespace encoding::hex {
+
+    /**
+     * Database tools like to prefix hex encoded binary, PostgreSQL's bytea
+     * output is "\x...." for example. Returns how many leading characters
+     * of the input are such a prefix and should be skipped.
+     */
+    size_t prefix (const char *, size_t);
+
+    /**
+     * The maximum number of bytes [decode] can write for an input of the
+     * given length.
+     */
+    size_t decodedSize (size_t);
+
+    /**
+     * Decode the input into the output buffer, which must be at least
+     * [decodedSize] bytes long. Both upper and lower case digits are
+     * accepted. Any other character, or an odd number of digits, will
+     * throw. Vectorised where [cpu::level] allows.
+     *
+     * @return the number of bytes written
+     */
+    size_t decode (const char *, size_t, char *);
+
+    bool isHexDigit (char);
+
+    /**
+     * Append the upper case hex of [size_] bytes to [out_], as Corda
+     * prints hashes and byte arrays
+     */
+    void encode (std::string & out_, const void *, size_t size_);
+
+    std::string encode (const void *, size_t);
+
+    /**
+     * Append the 16 bytes of a UUID to [out_] as Java prints one, lower
+     * case hex in groups of 8, 4, 4, 4 and 12 digits separated by dashes.
+     * Vectorised where [cpu::level] allows.
+     */
+    void uuid (std::string & out_, const void *);
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,141 @@
+#include "Iso8601.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Append [value_] in exactly [width_] digits
+     */
+    void
+    digits (std::string & out_, uint64_t value_, size_t width_) {
+        auto at = out_.size();
+        out_.resize (at + width_);
+
+        for (auto i = at + width_ ; i > at ; value_ /= 10) {
+            out_[--i] = static_cast<char>('0' + value_ % 10);
+        }
+    }
+
+    void
+    fraction (std::string & out_, int32_t nanos_) {
+        if (nanos_ <= 0) {
+            return;
+        }
+
+        out_ += '.';
+
+        if (nanos_ % 1000000 == 0) {
+            digits (out_, nanos_ / 1000000, 3);
+        } else if (nanos_ % 1000 == 0) {
+            digits (out_, nanos_ / 1000, 6);
+        } else {
+            digits (out_, nanos_, 9);
+        }
+    }
+
+    int64_t
+    floorDiv (int64_t x_, int64_t y_) {
+        return x_ / y_ - (x_ % y_ < 0);
+    }
+
+    /**
+     * The proleptic Gregorian date [days_] from 1970-01-01, after Howard
+     * Hinnant's civil_from_days. Working in 400 year eras, each 146097
+     * days, with years starting in March puts the leap day last and
+     * leaves the month a linear function of the day of the year.
+     */
+    void
+    civil (int64_t days_, int64_t & year_, int & month_, int & day_) {
+        days_ += 719468;
+
+        auto era = floorDiv (days_, 146097);
+        auto doe = days_ - era * 146097;
+        auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        auto mp = (5 * doy + 2) / 153;
+
+        day_ = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+        month_ = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        year_ = yoe + era * 400 + (month_ <= 2);
+    }
+
+}
+
+/******************************************************************************/
+
+void
+encoding::iso8601::
+date (std::string & out_, int64_t year_, int month_, int day_) {
+    if (year_ < 0) {
+        out_ += '-';
+    } else if (year_ > 9999) {
+        out_ += '+';
+    }
+
+    auto year = static_cast<uint64_t>(year_ < 0 ? -year_ : year_);
+    size_t width { 4 };
+
+    for (auto i = year / 10000 ; i ; i /= 10) {
+        ++width;
+    }
+
+    digits (out_, year, width);
+    out_ += '-';
+    digits (out_, month_, 2);
+    out_ += '-';
+    digits (out_, day_, 2);
+}
+
+/******************************************************************************/
+
+void
+encoding::iso8601::
+time (std::string & out_, int hour_, int minute_, int second_, int32_t nanos_) {
+    digits (out_, hour_, 2);
+    out_ += ':';
+    digits (out_, minute_, 2);
+
+    if (second_ > 0 || nanos_ > 0) {
+        out_ += ':';
+        digits (out_, second_, 2);
+        fraction (out_, nanos_);
+    }
+}
+
+/******************************************************************************/
+
+void
+encoding::iso8601::
+instant (std::string & out_, int64_t seconds_, int32_t nanos_) {
+    auto days = floorDiv (seconds_, 86400);
+    auto second = seconds_ - days * 86400;
+
+    int64_t year;
+    int month, day;
+    civil (days, year, month, day);
+
+    date (out_, year, month, day);
+    out_ += 'T';
+
+    digits (out_, second / 3600, 2);
+    out_ += ':';
+    digits (out_, second / 60 % 60, 2);
+    out_ += ':';
+    digits (out_, second % 60, 2);
+    fraction (out_, nanos_);
+
+    out_ += 'Z';
+}
+
+/******************************************************************************/
+
+void
+encoding::iso8601::
+millis (std::string & out_, int64_t millis_) {
+    auto seconds = floorDiv (millis_, 1000);
+
+    instant (out_, seconds, static_cast<int32_t>(millis_ - seconds * 1000) * 1000000);
+}
+
+/******************************************************************************/
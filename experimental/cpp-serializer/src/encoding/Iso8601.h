@@ -0,0 +1,46 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+
+/******************************************************************************/
+
+/**
+ * ISO-8601 text for the java.time values Corda serialises, printed as
+ * their [toString] would print them. Written digit by digit rather than
+ * through strftime, which wants a broken down time from the C library's
+ * own calendar first and knows nothing of nanoseconds.
+ *
+ * Fractions of a second are printed as Java prints them, not at all when
+ * there are none and otherwise in as many groups of three digits as they
+ * need. Years beyond four digits are signed.
+ */
+namespace encoding::iso8601 {
+
+    /**
+     * 2021-03-04
+     */
+    void date (std::string & out_, int64_t year_, int month_, int day_);
+
+    /**
+     * 05:06, 05:06:07 or 05:06:07.123, seconds being left off when they
+     * and the fraction are both zero
+     */
+    void time (std::string & out_, int hour_, int minute_, int second_, int32_t nanos_);
+
+    /**
+     * 2021-03-04T05:06:07.123Z, [seconds_] from the epoch and [nanos_]
+     * into that second
+     */
+    void instant (std::string & out_, int64_t seconds_, int32_t nanos_);
+
+    /**
+     * As [instant] for [millis_] from the epoch, an AMQP timestamp
+     */
+    void millis (std::string & out_, int64_t millis_);
+
+}
+
+/******************************************************************************/
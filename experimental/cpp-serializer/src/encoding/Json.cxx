@@ -0,0 +1,236 @@
+#include "Json.h"
+#include "Cpu.h"
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr unsigned char CLEAN = 0;
+
+    /**
+     * What each byte becomes inside a JSON string, CLEAN for those that are
+     * copied as is, the character following the backslash for those with a
+     * short escape and 'u' for the rest of the control characters. Bytes
+     * with the top bit set start (or continue) a multi byte UTF-8 sequence
+     * and are marked with 0x80.
+     */
+    constexpr std::array<unsigned char, 256>
+    makeTable() {
+        std::array<unsigned char, 256> table { };
+
+        for (int i { 0 } ; i < 0x20 ; ++i) table[i] = 'u';
+        for (int i { 0x80 } ; i < 0x100 ; ++i) table[i] = 0x80;
+
+        table['\b'] = 'b';
+        table['\f'] = 'f';
+        table['\n'] = 'n';
+        table['\r'] = 'r';
+        table['\t'] = 't';
+        table['"']  = '"';
+        table['\\'] = '\\';
+
+        return table;
+    }
+
+    constexpr std::array<unsigned char, 256> table = makeTable(); // NOLINT
+
+    [[noreturn]] void
+    badUtf8 (size_t idx_) {
+        std::stringstream ss;
+        ss << "Invalid UTF-8 sequence at offset " << idx_;
+        throw std::runtime_error (ss.str());
+    }
+
+    /**
+     * Length of the well formed UTF-8 sequence starting at [idx_], per the
+     * table in RFC 3629 section 4, so overlong encodings, surrogates and
+     * values beyond U+10FFFF are all rejected
+     */
+    size_t
+    sequence (const unsigned char * in_, size_t len_, size_t idx_) {
+        auto c = in_[idx_];
+        size_t n;
+        unsigned char lo { 0x80 }, hi { 0xBF };
+
+        if (c >= 0xC2 && c <= 0xDF) {
+            n = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            n = 3;
+            if (c == 0xE0) lo = 0xA0;
+            if (c == 0xED) hi = 0x9F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            n = 4;
+            if (c == 0xF0) lo = 0x90;
+            if (c == 0xF4) hi = 0x8F;
+        } else {
+            badUtf8 (idx_);
+        }
+
+        if (idx_ + n > len_) badUtf8 (idx_);
+
+        if (in_[idx_ + 1] < lo || in_[idx_ + 1] > hi) badUtf8 (idx_);
+
+        for (size_t i { 2 } ; i < n ; ++i) {
+            if ((in_[idx_ + i] & 0xC0) != 0x80) badUtf8 (idx_);
+        }
+
+        return n;
+    }
+
+    size_t
+    scalar (const char * in_, size_t len_) {
+        size_t i { 0 };
+
+        while (i < len_ && table[static_cast<unsigned char>(in_[i])] == CLEAN) {
+            ++i;
+        }
+
+        return i;
+    }
+
+#if defined(__x86_64__)
+
+    /*
+     * A byte needs attention if it's a control character, a quote, a
+     * backslash or, having its top bit set, part of a multi byte sequence.
+     * Control characters are those for which min (c, 0x1F) == c when
+     * compared unsigned, the top bit goes straight into the movemask.
+     */
+
+    __attribute__((target("sse4.1")))
+    size_t
+    sse41 (const char * in_, size_t len_) {
+        size_t i { 0 };
+
+        for ( ; i + 16 <= len_ ; i += 16) {
+            auto c = _mm_loadu_si128 ((const __m128i *)(in_ + i));
+
+            auto special = _mm_or_si128 (
+                    _mm_cmpeq_epi8 (_mm_min_epu8 (c, _mm_set1_epi8 (0x1F)), c),
+                    _mm_or_si128 (
+                        _mm_cmpeq_epi8 (c, _mm_set1_epi8 ('"')),
+                        _mm_cmpeq_epi8 (c, _mm_set1_epi8 ('\\'))));
+
+            auto mask = _mm_movemask_epi8 (_mm_or_si128 (special, c));
+
+            if (mask) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+
+        return i + scalar (in_ + i, len_ - i);
+    }
+
+    __attribute__((target("avx2")))
+    size_t
+    avx2 (const char * in_, size_t len_) {
+        size_t i { 0 };
+
+        for ( ; i + 32 <= len_ ; i += 32) {
+            auto c = _mm256_loadu_si256 ((const __m256i *)(in_ + i));
+
+            auto special = _mm256_or_si256 (
+                    _mm256_cmpeq_epi8 (_mm256_min_epu8 (c, _mm256_set1_epi8 (0x1F)), c),
+                    _mm256_or_si256 (
+                        _mm256_cmpeq_epi8 (c, _mm256_set1_epi8 ('"')),
+                        _mm256_cmpeq_epi8 (c, _mm256_set1_epi8 ('\\'))));
+
+            auto mask = static_cast<unsigned> (
+                    _mm256_movemask_epi8 (_mm256_or_si256 (special, c)));
+
+            if (mask) {
+                _mm256_zeroupper();
+                return i + __builtin_ctz (mask);
+            }
+        }
+
+        _mm256_zeroupper();
+
+        return i + sse41 (in_ + i, len_ - i);
+    }
+
+#endif
+
+}
+
+/******************************************************************************/
+
+size_t
+encoding::json::
+clean (const char * in_, size_t len_) {
+#if defined(__x86_64__)
+    switch (cpu::level()) {
+        case cpu::avx2_t  : return avx2 (in_, len_);
+        case cpu::sse41_t : return sse41 (in_, len_);
+        case cpu::scalar_t : break;
+    }
+#endif
+
+    return scalar (in_, len_);
+}
+
+/******************************************************************************/
+
+void
+encoding::json::
+quote (std::string & out_, std::string_view str_) {
+    static const char digits[] = "0123456789abcdef";
+
+    const auto * in = reinterpret_cast<const unsigned char *>(str_.data());
+    const auto len = str_.size();
+
+    out_.reserve (out_.size() + len + 2);
+    out_ += '"';
+
+    for (size_t i { 0 } ; i < len ; ) {
+        auto run = clean (str_.data() + i, len - i);
+        out_.append (str_.data() + i, run);
+        i += run;
+
+        if (i == len) break;
+
+        auto c = in[i];
+        auto esc = table[c];
+
+        if (esc == 0x80) {
+            auto n = sequence (in, len, i);
+            out_.append (str_.data() + i, n);
+            i += n;
+        } else {
+            out_ += '\\';
+            out_ += static_cast<char>(esc);
+
+            if (esc == 'u') {
+                out_ += "00";
+                out_ += digits[c >> 4];
+                out_ += digits[c & 0xF];
+            }
+
+            ++i;
+        }
+    }
+
+    out_ += '"';
+}
+
+/******************************************************************************/
+
+std::string
+encoding::json::
+quote (std::string_view str_) {
+    std::string rtn;
+
+    quote (rtn, str_);
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,89 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cmath>
+#include <string>
+#include <charconv>
+#include <type_traits>
+#include <string_view>
+
+/******************************************************************************/
+
+/**
+ * Production of JSON string literals (RFC 8259). Anything we print as a
+ * string, be it a value, a property name or a map key, goes through here
+ * so the output can always be fed to a JSON parser.
+ */
+namespace encoding::json {
+
+    /**
+     * Append the input to [out_] as a quoted and escaped JSON string. Quotes,
+     * backslashes and control characters are escaped, everything else is
+     * copied as is once checked to be well formed UTF-8. Throws on invalid
+     * UTF-8 rather than emit something a parser would reject.
+     *
+     * Runs of characters needing no attention are found 16 or 32 bytes at a
+     * time where [cpu::level] allows and copied in bulk.
+     */
+    void quote (std::string & out_, std::string_view);
+
+    std::string quote (std::string_view);
+
+    /**
+     * The length of the prefix of the input that can be copied into a JSON
+     * string unchanged, i.e. printable ASCII other than '"' and '\'
+     */
+    size_t clean (const char *, size_t);
+
+    /**
+     * Append [value_] to [out_] as a JSON number, an integer in full and a
+     * double in the fewest digits that read back as the same double, so
+     * 1e-09 rather than the 0.000000 of [std::to_string]. Written by
+     * [std::to_chars], so independent of the locale and with nothing
+     * allocated but what [out_] grows by.
+     *
+     * JSON has no NaN or infinity, so a double that isn't finite is
+     * written as null, as JavaScript's JSON.stringify writes it, rather
+     * than the nan or inf a parser would reject.
+     */
+    template<typename T>
+    void number (std::string & out_, T value_);
+
+    template<typename T>
+    std::string number (T value_);
+}
+
+/******************************************************************************/
+
+template<typename T>
+inline void
+encoding::json::
+number (std::string & out_, T value_) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (!std::isfinite (value_)) {
+            out_.append ("null");
+            return;
+        }
+    }
+
+    // the longest double, -2.2250738585072014e-308, is 24
+    char buffer[32];
+
+    auto end = std::to_chars (buffer, buffer + sizeof (buffer), value_).ptr;
+
+    out_.append (buffer, end - buffer);
+}
+
+template<typename T>
+inline std::string
+encoding::json::
+number (T value_) {
+    std::string rtn;
+    number (rtn, value_);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
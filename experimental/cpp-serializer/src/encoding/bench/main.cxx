@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "encoding/Cpu.h"
+#include "encoding/Hex.h"
+#include "encoding/Base64.h"
+
+/******************************************************************************/
+
+/**
+ * Decode throughput of each implementation on multi megabyte inputs, the
+ * scalar level being the plain table lookup decoder everything else falls
+ * back to. Run with --benchmark_counters_tabular=true for a readable
+ * comparison.
+ */
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    random (size_t len_) {
+        std::mt19937 gen { 42 };
+        std::string raw (len_, '\0');
+
+        for (auto & c : raw) c = static_cast<char>(gen());
+
+        return raw;
+    }
+
+    const std::string &
+    hexText (size_t len_) {
+        static std::string text;
+
+        if (text.size() != len_ * 2) {
+            static const char digits[] = "0123456789abcdef";
+            text.clear();
+
+            for (unsigned char c : random (len_)) {
+                text += digits[c >> 4];
+                text += digits[c & 0xF];
+            }
+        }
+
+        return text;
+    }
+
+    const std::string &
+    base64Text (size_t len_, bool wrap_) {
+        // one text per size and wrapping, encoded text isn't [len_] long
+        // so can't be matched to a size by its own
+        static std::map<std::pair<size_t, bool>, std::string> texts;
+
+        auto & text = texts[{ len_, wrap_ }];
+
+        if (text.empty()) {
+            static const char alphabet[] =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            auto raw = random (len_ - len_ % 3);
+
+            for (size_t i { 0 } ; i < raw.size() ; i += 3) {
+                uint32_t acc =
+                      (static_cast<unsigned char>(raw[i]) << 16)
+                    | (static_cast<unsigned char>(raw[i + 1]) << 8)
+                    | static_cast<unsigned char>(raw[i + 2]);
+
+                for (int j { 18 } ; j >= 0 ; j -= 6) text += alphabet[(acc >> j) & 0x3F];
+
+                if (wrap_ && (i / 3 + 1) % 19 == 0) text += "\r\n";
+            }
+        }
+
+        return text;
+    }
+
+    bool
+    setLevel (benchmark::State & state_) {
+        auto level = static_cast<encoding::cpu::Level>(state_.range (0));
+
+        if (level > encoding::cpu::detected()) {
+            state_.SkipWithError ("not supported on this machine");
+            return false;
+        }
+
+        encoding::cpu::limit (level);
+        state_.SetLabel (encoding::cpu::name (level));
+
+        return true;
+    }
+
+}
+
+/******************************************************************************/
+
+static void
+BM_Hex (benchmark::State & state_) {
+    if (!setLevel (state_)) return;
+
+    const auto & text = hexText (state_.range (1));
+    std::vector<char> out (encoding::hex::decodedSize (text.size()));
+
+    for (auto _ : state_) {
+        benchmark::DoNotOptimize (
+                encoding::hex::decode (text.data(), text.size(), out.data()));
+    }
+
+    state_.SetBytesProcessed (state_.iterations() * text.size());
+}
+
+/******************************************************************************/
+
+static void
+BM_Base64 (benchmark::State & state_) {
+    if (!setLevel (state_)) return;
+
+    const auto & text = base64Text (state_.range (1), false);
+    std::vector<char> out (encoding::base64::decodedSize (text.size()));
+
+    for (auto _ : state_) {
+        benchmark::DoNotOptimize (
+                encoding::base64::decode (text.data(), text.size(), out.data()));
+    }
+
+    state_.SetBytesProcessed (state_.iterations() * text.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Line wrapped input, as produced by most MIME and PEM style encoders
+ */
+static void
+BM_Base64Wrapped (benchmark::State & state_) {
+    if (!setLevel (state_)) return;
+
+    const auto & text = base64Text (state_.range (1), true);
+    std::vector<char> out (encoding::base64::decodedSize (text.size()));
+
+    for (auto _ : state_) {
+        benchmark::DoNotOptimize (
+                encoding::base64::decode (text.data(), text.size(), out.data()));
+    }
+
+    state_.SetBytesProcessed (state_.iterations() * text.size());
+}
+
+/******************************************************************************/
+
+#define LEVELS_AND_SIZES \
+    ArgsProduct ({ \
+        { encoding::cpu::scalar_t, encoding::cpu::sse41_t, encoding::cpu::avx2_t }, \
+        { 1 << 20, 8 << 20 } })
+
+BENCHMARK (BM_Hex)->LEVELS_AND_SIZES;
+BENCHMARK (BM_Base64)->LEVELS_AND_SIZES;
+BENCHMARK (BM_Base64Wrapped)->LEVELS_AND_SIZES;
+
+BENCHMARK_MAIN();
+
+/******************************************************************************/
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "encoding/Cpu.h"
+#include "encoding/Base64.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    decode (const std::string & in_) {
+        std::vector<char> out (encoding::base64::decodedSize (in_.size()));
+
+        auto len = encoding::base64::decode (in_.data(), in_.size(), out.data());
+
+        return std::string (out.data(), len);
+    }
+
+    /**
+     * MIME style, wrapped at 76 characters
+     */
+    std::string
+    encode (const std::string & in_) {
+        static const char alphabet[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+
+        for (size_t i { 0 } ; i < in_.size() ; i += 3) {
+            uint32_t acc { 0 };
+            size_t n = std::min<size_t> (3, in_.size() - i);
+
+            for (size_t j { 0 } ; j < 3 ; ++j) {
+                acc = (acc << 8) | (j < n ? static_cast<unsigned char>(in_[i + j]) : 0);
+            }
+
+            for (size_t j { 0 } ; j < 4 ; ++j) {
+                out += j <= n ? alphabet[(acc >> (18 - 6 * j)) & 0x3F] : '=';
+            }
+
+            if ((i / 3 + 1) % 19 == 0) out += "\r\n";
+        }
+
+        return out;
+    }
+
+    std::string
+    error (const std::string & in_) {
+        try {
+            decode (in_);
+        } catch (const std::runtime_error & e) {
+            return e.what();
+        }
+
+        return "";
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Base64, decode) { // NOLINT
+    EXPECT_EQ ("", decode (""));
+    EXPECT_EQ ("c", decode ("Yw=="));
+    EXPECT_EQ ("co", decode ("Y28="));
+    EXPECT_EQ ("cor", decode ("Y29y"));
+    EXPECT_EQ ("corda", decode ("Y29yZGE="));
+}
+
+/******************************************************************************/
+
+TEST (Base64, unpadded) { // NOLINT
+    EXPECT_EQ ("c", decode ("Yw"));
+    EXPECT_EQ ("corda", decode ("Y29yZGE"));
+}
+
+/******************************************************************************/
+
+TEST (Base64, whitespace) { // NOLINT
+    EXPECT_EQ ("corda", decode ("Y29y\nZGE=\n"));
+    EXPECT_EQ ("corda", decode ("Y29y\r\nZGE="));
+}
+
+/******************************************************************************/
+
+TEST (Base64, invalid) { // NOLINT
+    EXPECT_THROW (decode ("Y29y*GE="), std::runtime_error);
+    EXPECT_THROW (decode ("Y"), std::runtime_error);
+    EXPECT_THROW (decode ("Yw=a"), std::runtime_error);
+    EXPECT_THROW (decode ("Yw="), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/******************************************************************************/
+
+/**
+ * Every implementation the machine supports should agree with the scalar
+ * one, including on where they report the first bad character
+ */
+TEST (Base64, levels) { // NOLINT
+    std::mt19937 gen { 42 };
+    std::string raw;
+
+    for (int i { 0 } ; i < 1000 ; ++i) raw += static_cast<char>(gen());
+
+    auto wrapped = encode (raw);
+    std::string flat;
+    for (auto c : wrapped) if (c != '\r' && c != '\n') flat += c;
+
+    auto bad = flat;
+    bad[555] = '-';
+
+    for (int l { 0 } ; l <= encoding::cpu::detected() ; ++l) {
+        encoding::cpu::limit (static_cast<encoding::cpu::Level>(l));
+
+        EXPECT_EQ (raw, decode (flat));
+        EXPECT_EQ (raw, decode (wrapped));
+        EXPECT_EQ (raw.substr (0, 998), decode (encode (raw.substr (0, 998))));
+        EXPECT_EQ ("Invalid base64 character '-' at offset 555", error (bad));
+        EXPECT_EQ ("Base64 data found after padding",
+                error (encode ("co") + flat));
+    }
+
+    encoding::cpu::limit (encoding::cpu::avx2_t);
+}
+
+/******************************************************************************/
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "encoding/Cpu.h"
+#include "encoding/Hex.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    decode (const std::string & in_) {
+        auto skip = encoding::hex::prefix (in_.data(), in_.size());
+        std::vector<char> out (encoding::hex::decodedSize (in_.size() - skip));
+
+        auto len = encoding::hex::decode (
+                in_.data() + skip, in_.size() - skip, out.data());
+
+        return std::string (out.data(), len);
+    }
+
+    std::string
+    encode (const std::string & in_) {
+        static const char digits[] = "0123456789abcdef";
+        std::string out;
+
+        for (unsigned char c : in_) {
+            out += digits[c >> 4];
+            out += digits[c & 0xF];
+        }
+
+        return out;
+    }
+
+    std::string
+    error (const std::string & in_) {
+        try {
+            decode (in_);
+        } catch (const std::runtime_error & e) {
+            return e.what();
+        }
+
+        return "";
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Hex, decode) { // NOLINT
+    EXPECT_EQ ("corda", decode ("636f726461"));
+    EXPECT_EQ ("corda", decode ("636F726461"));
+    EXPECT_EQ ("", decode (""));
+}
+
+/******************************************************************************/
+
+TEST (Hex, prefix) { // NOLINT
+    EXPECT_EQ ("corda", decode ("\\x636f726461"));
+    EXPECT_EQ ("corda", decode ("0x636f726461"));
+}
+
+/******************************************************************************/
+
+TEST (Hex, binary) { // NOLINT
+    auto val = decode ("00ff7f80");
+
+    ASSERT_EQ (4, val.size());
+    EXPECT_EQ ('\x00', val[0]);
+    EXPECT_EQ ('\xff', val[1]);
+    EXPECT_EQ ('\x7f', val[2]);
+    EXPECT_EQ ('\x80', val[3]);
+}
+
+/******************************************************************************/
+
+TEST (Hex, encode) { // NOLINT
+    EXPECT_EQ ("00FF7F80", encoding::hex::encode ("\x00\xff\x7f\x80", 4));
+    EXPECT_EQ ("", encoding::hex::encode ("", 0));
+
+    std::string out { "0x" };
+    encoding::hex::encode (out, "corda", 5);
+
+    EXPECT_EQ ("0x636F726461", out);
+    EXPECT_EQ ("corda", decode (out));
+}
+
+/******************************************************************************/
+
+TEST (Hex, invalid) { // NOLINT
+    EXPECT_THROW (decode ("636"), std::runtime_error);
+    EXPECT_THROW (decode ("63 f"), std::runtime_error);
+    EXPECT_THROW (decode ("6g"), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/******************************************************************************/
+
+/**
+ * Every implementation the machine supports should agree with the scalar
+ * one, including on where they report the first bad digit
+ */
+TEST (Hex, levels) { // NOLINT
+    std::mt19937 gen { 42 };
+    std::string raw;
+
+    for (int i { 0 } ; i < 1000 ; ++i) raw += static_cast<char>(gen());
+
+    auto hex = encode (raw);
+    for (size_t i { 0 } ; i < hex.size() ; i += 3) hex[i] = toupper (hex[i]);
+
+    auto bad = hex;
+    bad[777] = 'g';
+
+    for (int l { 0 } ; l <= encoding::cpu::detected() ; ++l) {
+        encoding::cpu::limit (static_cast<encoding::cpu::Level>(l));
+
+        EXPECT_EQ (raw, decode (hex));
+        EXPECT_EQ (raw.substr (0, 37), decode (hex.substr (0, 74)));
+        EXPECT_EQ ("Invalid hex digit 'g' at offset 777", error (bad));
+    }
+
+    encoding::cpu::limit (encoding::cpu::avx2_t);
+}
+
+/******************************************************************************/
+
+/**
+ * As java.util.UUID prints them, at every level the machine supports
+ */
+TEST (Hex, uuid) { // NOLINT
+    std::mt19937 gen { 42 };
+
+    for (int l { 0 } ; l <= encoding::cpu::detected() ; ++l) {
+        encoding::cpu::limit (static_cast<encoding::cpu::Level>(l));
+
+        std::string out { "id " };
+        encoding::hex::uuid (out,
+            "\x12\x3e\x45\x67\xe8\x9b\x12\xd3\xa4\x56\x42\x66\x14\x17\x40\x00");
+
+        EXPECT_EQ ("id 123e4567-e89b-12d3-a456-426614174000", out);
+
+        for (int i { 0 } ; i < 100 ; ++i) {
+            std::string raw;
+            for (int j { 0 } ; j < 16 ; ++j) raw += static_cast<char>(gen());
+
+            auto hex = encode (raw);
+
+            std::string uuid;
+            encoding::hex::uuid (uuid, raw.data());
+
+            EXPECT_EQ (hex.substr (0, 8) + "-" + hex.substr (8, 4) + "-"
+                + hex.substr (12, 4) + "-" + hex.substr (16, 4) + "-"
+                + hex.substr (20), uuid);
+        }
+    }
+
+    encoding::cpu::limit (encoding::cpu::avx2_t);
+}
+
+/******************************************************************************/
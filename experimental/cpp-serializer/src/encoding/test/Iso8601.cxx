@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <random>
+#include <string>
+
+#include "encoding/Iso8601.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    instant (int64_t seconds_, int32_t nanos_) {
+        std::string rtn;
+        encoding::iso8601::instant (rtn, seconds_, nanos_);
+
+        return rtn;
+    }
+
+    std::string
+    millis (int64_t millis_) {
+        std::string rtn;
+        encoding::iso8601::millis (rtn, millis_);
+
+        return rtn;
+    }
+
+    std::string
+    date (int64_t year_, int month_, int day_) {
+        std::string rtn;
+        encoding::iso8601::date (rtn, year_, month_, day_);
+
+        return rtn;
+    }
+
+    std::string
+    time (int hour_, int minute_, int second_, int32_t nanos_) {
+        std::string rtn;
+        encoding::iso8601::time (rtn, hour_, minute_, second_, nanos_);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Iso8601, instant) { // NOLINT
+    EXPECT_EQ ("1970-01-01T00:00:00Z", instant (0, 0));
+    EXPECT_EQ ("2021-03-04T05:06:07Z", instant (1614834367, 0));
+    EXPECT_EQ ("2021-03-04T05:06:07.123Z", instant (1614834367, 123000000));
+    EXPECT_EQ ("2021-03-04T05:06:07.123400Z", instant (1614834367, 123400000));
+    EXPECT_EQ ("2021-03-04T05:06:07.000000001Z", instant (1614834367, 1));
+    EXPECT_EQ ("2000-02-29T00:00:00Z", instant (951782400, 0));
+    EXPECT_EQ ("1969-12-31T23:59:59.999999999Z", instant (-1, 999999999));
+    EXPECT_EQ ("+10000-01-01T00:00:00Z", instant (253402300800, 0));
+    EXPECT_EQ ("-0001-12-31T00:00:00Z", instant (-62167305600, 0));
+}
+
+/******************************************************************************/
+
+TEST (Iso8601, millis) { // NOLINT
+    EXPECT_EQ ("1970-01-01T00:00:00Z", millis (0));
+    EXPECT_EQ ("2021-03-04T05:06:07.123Z", millis (1614834367123));
+    EXPECT_EQ ("1969-12-31T23:59:59.999Z", millis (-1));
+}
+
+/******************************************************************************/
+
+TEST (Iso8601, dateAndTime) { // NOLINT
+    EXPECT_EQ ("2021-03-04", date (2021, 3, 4));
+    EXPECT_EQ ("0000-01-01", date (0, 1, 1));
+    EXPECT_EQ ("-0001-01-01", date (-1, 1, 1));
+    EXPECT_EQ ("+123456-12-31", date (123456, 12, 31));
+
+    EXPECT_EQ ("05:06", time (5, 6, 0, 0));
+    EXPECT_EQ ("05:06:07", time (5, 6, 7, 0));
+    EXPECT_EQ ("05:06:00.000001", time (5, 6, 0, 1000));
+    EXPECT_EQ ("23:59:59.999999999", time (23, 59, 59, 999999999));
+}
+
+/******************************************************************************/
+
+/**
+ * Against the C library's calendar wherever it has one
+ */
+TEST (Iso8601, gmtime) { // NOLINT
+    std::mt19937_64 gen { 42 };
+    std::uniform_int_distribution<int64_t> seconds {
+        -2208988800,    // 1900
+        253402300799    // 9999
+    };
+
+    for (int i { 0 } ; i < 10000 ; ++i) {
+        auto s = seconds (gen);
+        auto t = static_cast<time_t>(s);
+
+        std::tm tm { };
+        gmtime_r (&t, &tm);
+
+        char expected[32];
+        strftime (expected, sizeof (expected), "%Y-%m-%dT%H:%M:%SZ", &tm);
+
+        ASSERT_EQ (expected, instant (s, 0)) << s;
+    }
+}
+
+/******************************************************************************/
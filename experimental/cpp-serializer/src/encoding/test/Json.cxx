@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+#include "encoding/Cpu.h"
+#include "encoding/Json.h"
+
+/******************************************************************************/
+
+using encoding::json::quote;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    error (const std::string & in_) {
+        try {
+            quote (in_);
+        } catch (const std::runtime_error & e) {
+            return e.what();
+        }
+
+        return "";
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Json, plain) { // NOLINT
+    EXPECT_EQ (R"("")", quote (""));
+    EXPECT_EQ (R"("corda")", quote ("corda"));
+}
+
+/******************************************************************************/
+
+TEST (Json, escapes) { // NOLINT
+    EXPECT_EQ (R"("a \"b\" c")", quote ("a \"b\" c"));
+    EXPECT_EQ (R"("C:\\corda")", quote ("C:\\corda"));
+    EXPECT_EQ (R"("\b\f\n\r\t")", quote ("\b\f\n\r\t"));
+    EXPECT_EQ (R"("\u0000\u001f")", quote (std::string ("\0\x1f", 2)));
+    EXPECT_EQ ("\"/\x7f\"", quote ("/\x7f"));
+}
+
+/******************************************************************************/
+
+TEST (Json, utf8) { // NOLINT
+    EXPECT_EQ ("\"caf\xc3\xa9\"", quote ("caf\xc3\xa9"));
+    EXPECT_EQ ("\"\xe2\x82\xac\"", quote ("\xe2\x82\xac"));
+    EXPECT_EQ ("\"\xf0\x9f\x98\x80\"", quote ("\xf0\x9f\x98\x80"));
+
+    EXPECT_EQ ("Invalid UTF-8 sequence at offset 3", error ("caf\xe9"));
+    EXPECT_EQ ("Invalid UTF-8 sequence at offset 0", error ("\xc0\xaf"));
+    EXPECT_EQ ("Invalid UTF-8 sequence at offset 0", error ("\xed\xa0\x80"));
+    EXPECT_EQ ("Invalid UTF-8 sequence at offset 0", error ("\xf4\x90\x80\x80"));
+    EXPECT_EQ ("Invalid UTF-8 sequence at offset 1", error ("a\xe2\x82"));
+}
+
+/******************************************************************************/
+
+/**
+ * Long enough for the vector scans to have full blocks either side of the
+ * characters needing attention
+ */
+TEST (Json, levels) { // NOLINT
+    std::string in, expected { "\"" };
+
+    for (int i { 0 } ; i < 100 ; ++i) {
+        in += "abcdefghijklmnopqrstuvwxyz0123456789";
+        expected += "abcdefghijklmnopqrstuvwxyz0123456789";
+
+        switch (i % 4) {
+            case 0 : in += "\""; expected += "\\\""; break;
+            case 1 : in += "\n"; expected += "\\n"; break;
+            case 2 : in += "\xc3\xa9"; expected += "\xc3\xa9"; break;
+            case 3 : break;
+        }
+    }
+
+    expected += "\"";
+
+    for (int l { 0 } ; l <= encoding::cpu::detected() ; ++l) {
+        encoding::cpu::limit (static_cast<encoding::cpu::Level>(l));
+
+        EXPECT_EQ (expected, quote (in));
+        EXPECT_EQ (36, encoding::json::clean (in.data(), in.size()));
+        EXPECT_EQ ("Invalid UTF-8 sequence at offset " + std::to_string (in.size()),
+                error (in + "\xff"));
+    }
+
+    encoding::cpu::limit (encoding::cpu::avx2_t);
+}
+
+/******************************************************************************/
+
+TEST (Json, number) { // NOLINT
+    using encoding::json::number;
+
+    EXPECT_EQ ("0", number (0));
+    EXPECT_EQ ("-2147483648", number (std::numeric_limits<int32_t>::min()));
+    EXPECT_EQ ("9223372036854775807", number (std::numeric_limits<int64_t>::max()));
+
+    // the shortest digits that round trip, not six fixed decimals
+    EXPECT_EQ ("1e-09", number (1e-9));
+    EXPECT_EQ ("null", number (std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ ("null", number (std::numeric_limits<double>::infinity()));
+    EXPECT_EQ ("null", number (-std::numeric_limits<double>::infinity()));
+    EXPECT_EQ ("0.1", number (0.1));
+    EXPECT_EQ ("10", number (10.0));
+    EXPECT_EQ ("-2.5", number (-2.5));
+    EXPECT_EQ ("1.7976931348623157e+308", number (std::numeric_limits<double>::max()));
+    EXPECT_EQ (0.30000000000000004, std::stod (number (0.1 + 0.2)));
+
+    std::string out { "[ " };
+    number (out, 42L);
+
+    EXPECT_EQ ("[ 42", out);
+}
+
+/******************************************************************************/
@@ -0,0 +1,140 @@
+#include "Reader.h"
+
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "types.h"
+#include "Ring.h"
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    bool
+    probe() {
+        try {
+            io::internal::Ring ring (1, 4096);
+        } catch (const std::exception &) {
+            return false;
+        }
+
+        return true;
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+io::
+available (Backend backend_) {
+    static const bool ring = probe();
+
+    return backend_ == stream_t || ring;
+}
+
+/******************************************************************************/
+
+const char *
+io::
+name (Backend backend_) {
+    switch (backend_) {
+        case stream_t : return "ifstream";
+        case uring_t  : return "io_uring";
+    }
+
+    return "unknown";
+}
+
+/******************************************************************************/
+
+io::Backend
+io::
+read (
+    const std::vector<std::string> & files_,
+    Backend backend_,
+    const Sink & sink_
+) {
+    if (!available (backend_)) {
+        backend_ = stream_t;
+    }
+
+    if (files_.empty()) {
+        return backend_;
+    }
+
+    auto & pool = concurrency::ThreadPool::instance();
+
+    if (backend_ == uring_t) {
+        /*
+         * A participant sets up its ring the first time it joins, and
+         * takes chunks big enough to keep the ring's queue full
+         */
+        std::vector<uPtr<internal::Ring>> rings (pool.participants());
+
+        auto grain = std::clamp<size_t> (
+            files_.size() / (4 * pool.participants()),
+            internal::Ring::depth, 16 * 1024);
+
+        pool.parallelFor (files_.size(), grain,
+            [&](size_t participant_, size_t begin_, size_t end_) {
+                auto & ring = rings[participant_];
+
+                if (!ring) {
+                    ring = std::make_unique<internal::Ring>();
+                }
+
+                ring->read (files_, begin_, end_,
+                    [&](size_t index_, const char * bytes_, size_t size_) {
+                        sink_ (participant_, index_, bytes_, size_);
+                    });
+            });
+
+        return backend_;
+    }
+
+    std::vector<std::vector<char>> buffers (pool.participants());
+
+    auto grain = std::clamp<size_t> (
+        files_.size() / (4 * pool.participants()), 1, 1024);
+
+    pool.parallelFor (files_.size(), grain,
+        [&](size_t participant_, size_t begin_, size_t end_) {
+            auto & buffer = buffers[participant_];
+
+            for (auto i = begin_ ; i < end_ ; ++i) {
+                auto size = read (files_[i], buffer);
+
+                sink_ (participant_, i, size ? buffer.data() : nullptr, size);
+            }
+        });
+
+    return backend_;
+}
+
+/******************************************************************************/
+
+size_t
+io::
+read (const std::string & file_, std::vector<char> & buffer_) {
+    std::ifstream f { file_, std::ios::in | std::ios::binary | std::ios::ate };
+
+    if (!f) {
+        return 0;
+    }
+
+    auto size = static_cast<size_t>(f.tellg());
+
+    if (buffer_.size() < size) {
+        buffer_.resize (size);
+    }
+
+    f.seekg (0);
+    f.read (buffer_.data(), size);
+
+    return f ? size : 0;
+}
+
+/******************************************************************************/
@@ -0,0 +1,62 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <functional>
+
+/******************************************************************************/
+
+/**
+ * Reading corpora of many small files, where the time goes on the open,
+ * read and close of each file rather than on its bytes.
+ *
+ * The files are shared out across the thread pool and each participant
+ * reads its share with one of two backends. [stream_t] opens and reads
+ * each file in turn with an [std::ifstream], which works anywhere. On
+ * Linux [uring_t] gives each participant an io_uring of its own and keeps
+ * a queue of files in flight through it, each an open, read and close
+ * linked together and submitted with the rest in one system call, reading
+ * into buffers registered with the kernel up front. A file is handed on
+ * by the participant that read it as soon as it has been.
+ */
+namespace io {
+
+    enum Backend { stream_t, uring_t };
+
+    /**
+     * Called with the participant that read a file, as for
+     * [concurrency::ThreadPool::Body], the file's index in the list read
+     * and its contents, null if it couldn't be read or was empty. The
+     * contents are only valid for the duration of the call.
+     */
+    using Sink = std::function<void (size_t, size_t, const char *, size_t)>;
+
+    /**
+     * Whether [backend_] can be used here, for [uring_t] whether the
+     * kernel lets us set up a ring
+     */
+    bool available (Backend backend_);
+
+    const char * name (Backend);
+
+    /**
+     * Read the whole of each of [files_] across the shared thread pool,
+     * handing each to [sink_]. Reads with [backend_] if it's available
+     * and with [stream_t] if it isn't, returning which it was.
+     */
+    Backend read (
+        const std::vector<std::string> & files_,
+        Backend backend_,
+        const Sink & sink_);
+
+    /**
+     * Read the whole of [file_] into [buffer_], which is only ever grown,
+     * returning its size or 0 if it couldn't be read
+     */
+    size_t read (const std::string & file_, std::vector<char> & buffer_);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,437 @@
+#include "Ring.h"
+
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace {
+
+#if defined(__linux__)
+
+    /*
+     * Without liburing we make the three system calls ourselves
+     */
+    int
+    setup (unsigned entries_, io_uring_params * params_) {
+        return static_cast<int>(syscall (__NR_io_uring_setup, entries_, params_));
+    }
+
+    int
+    enter (int fd_, unsigned submit_, unsigned wait_, unsigned flags_) {
+        return static_cast<int>(syscall (
+            __NR_io_uring_enter, fd_, submit_, wait_, flags_, nullptr, 0));
+    }
+
+    int
+    enrol (int fd_, unsigned opcode_, const void * arg_, unsigned n_) {
+        return static_cast<int>(syscall (
+            __NR_io_uring_register, fd_, opcode_, arg_, n_));
+    }
+
+    [[noreturn]] void
+    fail (const std::string & call_) {
+        throw std::runtime_error (call_ + " failed: " + strerror (errno));
+    }
+
+    template<typename T>
+    T *
+    at (void * base_, unsigned offset_) {
+        return reinterpret_cast<T *>(static_cast<char *>(base_) + offset_);
+    }
+
+    /**
+     * Each completion's user data is the slot it's for and which of the
+     * slot's three operations it was
+     */
+    enum Op { open_e, read_e, close_e };
+
+    constexpr uint64_t
+    tag (size_t slot_, Op op_) {
+        return slot_ * 4 + op_;
+    }
+
+#endif
+
+}
+
+/******************************************************************************
+ *
+ * io::internal::Ring
+ *
+ ******************************************************************************/
+
+io::internal::
+Ring::Ring (size_t depth_, size_t buffer_)
+    : m_fd { -1 }
+    , m_depth { depth_ }
+    , m_buffer { buffer_ }
+    , m_sq { nullptr }
+    , m_sqSize { 0 }
+    , m_cq { nullptr }
+    , m_cqSize { 0 }
+    , m_sqes { nullptr }
+    , m_sqesSize { 0 }
+    , m_sqHead { nullptr }
+    , m_sqTail { nullptr }
+    , m_sqMask { nullptr }
+    , m_sqArray { nullptr }
+    , m_cqHead { nullptr }
+    , m_cqTail { nullptr }
+    , m_cqMask { nullptr }
+    , m_cqes { nullptr }
+    , m_fixed { false }
+{
+#if defined(__linux__)
+    try {
+        io_uring_params params { };
+
+        // three entries for each slot, so a full queue never waits for room
+        m_fd = setup (static_cast<unsigned>(3 * m_depth), &params);
+
+        if (m_fd < 0) {
+            fail ("io_uring_setup");
+        }
+
+        /*
+         * Opening into and closing a ring's own descriptors arrived in
+         * 5.15. There's no feature flag for that but there is for skipping
+         * completions, which came soon after.
+         */
+        if (!(params.features & IORING_FEAT_CQE_SKIP)) {
+            throw std::runtime_error ("io_uring lacks direct descriptors");
+        }
+
+        m_sqSize = params.sq_off.array + params.sq_entries * sizeof (unsigned);
+        m_cqSize = params.cq_off.cqes + params.cq_entries * sizeof (io_uring_cqe);
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            m_sqSize = m_cqSize = std::max (m_sqSize, m_cqSize);
+        }
+
+        auto map = [this](size_t size_, off_t offset_) {
+            auto rtn = mmap (nullptr, size_, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, m_fd, offset_);
+
+            if (rtn == MAP_FAILED) {
+                fail ("mmap");
+            }
+
+            return rtn;
+        };
+
+        m_sq = map (m_sqSize, IORING_OFF_SQ_RING);
+
+        m_cq = (params.features & IORING_FEAT_SINGLE_MMAP)
+            ? m_sq
+            : map (m_cqSize, IORING_OFF_CQ_RING);
+
+        m_sqesSize = params.sq_entries * sizeof (io_uring_sqe);
+        m_sqes = static_cast<io_uring_sqe *>(map (m_sqesSize, IORING_OFF_SQES));
+
+        m_sqHead = at<unsigned> (m_sq, params.sq_off.head);
+        m_sqTail = at<unsigned> (m_sq, params.sq_off.tail);
+        m_sqMask = at<unsigned> (m_sq, params.sq_off.ring_mask);
+        m_sqArray = at<unsigned> (m_sq, params.sq_off.array);
+
+        m_cqHead = at<unsigned> (m_cq, params.cq_off.head);
+        m_cqTail = at<unsigned> (m_cq, params.cq_off.tail);
+        m_cqMask = at<unsigned> (m_cq, params.cq_off.ring_mask);
+        m_cqes = at<io_uring_cqe> (m_cq, params.cq_off.cqes);
+
+        // a slot's descriptor is empty until its file is opened into it
+        std::vector<int> files (m_depth, -1);
+
+        if (enrol (m_fd, IORING_REGISTER_FILES, files.data(),
+                static_cast<unsigned>(m_depth)) < 0)
+        {
+            fail ("io_uring_register");
+        }
+
+        m_buffers.resize (m_depth * m_buffer);
+
+        std::vector<iovec> buffers (m_depth);
+
+        for (size_t i { 0 } ; i < m_depth ; ++i) {
+            buffers[i] = { m_buffers.data() + i * m_buffer, m_buffer };
+        }
+
+        /*
+         * Registering pins the buffers, which a low locked memory limit
+         * can refuse. Reading into them unregistered still works.
+         */
+        m_fixed = enrol (m_fd, IORING_REGISTER_BUFFERS, buffers.data(),
+                static_cast<unsigned>(m_depth)) >= 0;
+
+        m_slots.resize (m_depth);
+
+        for (size_t i { m_depth } ; i ; --i) {
+            m_free.push_back (i - 1);
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+#else
+    throw std::runtime_error ("io_uring is only available on Linux");
+#endif
+}
+
+/******************************************************************************/
+
+io::internal::
+Ring::~Ring() {
+    release();
+}
+
+/******************************************************************************/
+
+/**
+ * Closing the ring drops everything registered with it
+ */
+void
+io::internal::
+Ring::release() {
+#if defined(__linux__)
+    if (m_sqes) {
+        munmap (m_sqes, m_sqesSize);
+    }
+
+    if (m_cq && m_cq != m_sq) {
+        munmap (m_cq, m_cqSize);
+    }
+
+    if (m_sq) {
+        munmap (m_sq, m_sqSize);
+    }
+
+    if (m_fd >= 0) {
+        close (m_fd);
+    }
+#endif
+
+    m_sqes = nullptr;
+    m_sq = m_cq = nullptr;
+    m_fd = -1;
+}
+
+/******************************************************************************/
+
+#if defined(__linux__)
+
+/**
+ * The [n_]th free submission queue entry, cleared. Only we write the tail
+ * so it can be read plainly, and the queue is emptied by every [enter] so
+ * there's always room for a slot's worth.
+ */
+io_uring_sqe *
+io::internal::
+Ring::sqe (unsigned n_) {
+    auto index = (*m_sqTail + n_) & *m_sqMask;
+    auto rtn = &m_sqes[index];
+
+    memset (rtn, 0, sizeof (io_uring_sqe));
+    m_sqArray[index] = index;
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * The open, read and close of [file_] through [slot_]. Should the open
+ * fail the rest are cancelled. The read is hard linked to the close so
+ * a short read, which would otherwise break the chain, doesn't leave the
+ * descriptor open.
+ */
+void
+io::internal::
+Ring::queue (size_t slot_, const std::string & file_) {
+    auto open = sqe (0);
+
+    open->opcode = IORING_OP_OPENAT;
+    open->flags = IOSQE_IO_LINK;
+    open->fd = AT_FDCWD;
+    open->addr = reinterpret_cast<uintptr_t>(file_.c_str());
+    // a descriptor the ring keeps is never seen by an exec, and the
+    // kernel refuses O_CLOEXEC on one
+    open->open_flags = O_RDONLY;
+    open->file_index = static_cast<uint32_t>(slot_ + 1);
+    open->user_data = tag (slot_, open_e);
+
+    auto read = sqe (1);
+
+    read->opcode = m_fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    read->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+    read->fd = static_cast<int>(slot_);
+    read->addr = reinterpret_cast<uintptr_t>(m_buffers.data() + slot_ * m_buffer);
+    read->len = static_cast<uint32_t>(m_buffer);
+    read->off = 0;
+    read->buf_index = static_cast<uint16_t>(m_fixed ? slot_ : 0);
+    read->user_data = tag (slot_, read_e);
+
+    auto close = sqe (2);
+
+    close->opcode = IORING_OP_CLOSE;
+    close->file_index = static_cast<uint32_t>(slot_ + 1);
+    close->user_data = tag (slot_, close_e);
+
+    __atomic_store_n (m_sqTail, *m_sqTail + 3, __ATOMIC_RELEASE);
+}
+
+/******************************************************************************/
+
+/**
+ * Submit everything queued and wait for at least [wait_] completions
+ */
+void
+io::internal::
+Ring::enter (unsigned wait_) {
+    for (;;) {
+        auto submit = *m_sqTail - __atomic_load_n (m_sqHead, __ATOMIC_ACQUIRE);
+
+        if (::enter (m_fd, submit, wait_, wait_ ? IORING_ENTER_GETEVENTS : 0) >= 0) {
+            return;
+        }
+
+        if (errno != EINTR) {
+            fail ("io_uring_enter");
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Take every completion posted, noting the slots whose three operations
+ * have all completed
+ */
+void
+io::internal::
+Ring::reap() {
+    auto head = *m_cqHead;
+    auto tail = __atomic_load_n (m_cqTail, __ATOMIC_ACQUIRE);
+
+    for ( ; head != tail ; ++head) {
+        const auto & cqe = m_cqes[head & *m_cqMask];
+        auto & slot = m_slots[cqe.user_data / 4];
+
+        if (cqe.user_data % 4 == read_e) {
+            slot.result = cqe.res;
+        }
+
+        if (++slot.completed == 3) {
+            m_done.push_back (cqe.user_data / 4);
+        }
+    }
+
+    __atomic_store_n (m_cqHead, head, __ATOMIC_RELEASE);
+}
+
+#endif
+
+/******************************************************************************/
+
+void
+io::internal::
+Ring::deliver (
+    size_t slot_,
+    const std::vector<std::string> & files_,
+    const Sink & sink_
+) {
+    const auto & slot = m_slots[slot_];
+
+    if (slot.result <= 0) {
+        sink_ (slot.index, nullptr, 0);
+    } else if (static_cast<size_t>(slot.result) < m_buffer) {
+        sink_ (slot.index, m_buffers.data() + slot_ * m_buffer,
+            static_cast<size_t>(slot.result));
+    } else {
+        auto size = io::read (files_[slot.index], m_whole);
+
+        sink_ (slot.index, size ? m_whole.data() : nullptr, size);
+    }
+}
+
+/******************************************************************************/
+
+void
+io::internal::
+Ring::read (
+    const std::vector<std::string> & files_,
+    size_t begin_,
+    size_t end_,
+    const Sink & sink_
+) {
+#if defined(__linux__)
+    size_t inflight { 0 };
+
+    auto finished = [this, &inflight]() {
+        for (auto slot : m_done) {
+            m_free.push_back (slot);
+            --inflight;
+        }
+    };
+
+    try {
+        for (auto next = begin_ ; next < end_ || inflight ; ) {
+            for ( ; next < end_ && !m_free.empty() ; ++next) {
+                auto slot = m_free.back();
+                m_free.pop_back();
+
+                m_slots[slot] = { next, 0, 0 };
+                queue (slot, files_[next]);
+
+                ++inflight;
+            }
+
+            enter (1);
+            reap();
+
+            /*
+             * The slots are free again but not refilled until every file
+             * they hold has been handed on
+             */
+            finished();
+
+            for (auto slot : m_done) {
+                deliver (slot, files_, sink_);
+            }
+
+            m_done.clear();
+        }
+    } catch (...) {
+        /*
+         * The kernel mustn't be left reading into buffers, or opening
+         * paths, we're about to reuse or free
+         */
+        m_done.clear();
+
+        while (inflight) {
+            enter (1);
+            reap();
+            finished();
+            m_done.clear();
+        }
+
+        throw;
+    }
+#else
+    throw std::runtime_error ("io_uring is only available on Linux");
+#endif
+}
+
+/******************************************************************************/
@@ -0,0 +1,122 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+/******************************************************************************/
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+/******************************************************************************/
+
+namespace io::internal {
+
+    /**
+     * An io_uring reading whole files through a queue of [depth] slots,
+     * each a buffer registered with the kernel and a file descriptor
+     * the ring keeps to itself.
+     *
+     * Each file read takes a slot for an open into that slot's
+     * descriptor, a read of it into that slot's buffer and its close,
+     * submitted linked so the kernel runs them in turn without coming back
+     * to us in between. The slots are refilled and everything queued
+     * submitted in the same call that waits for the next completions. A
+     * file filling its buffer may have more to it and is read again whole
+     * with [io::read].
+     *
+     * Only works on Linux. Elsewhere, or where the kernel won't set up a
+     * ring or lacks the operations, construction throws.
+     */
+    class Ring {
+        public :
+            /**
+             * Called with the index of a file and its contents, null if
+             * it couldn't be read
+             */
+            using Sink = std::function<void (size_t, const char *, size_t)>;
+
+        private :
+            struct Slot {
+                size_t index;
+                int    result;
+                int    completed;
+            };
+
+            int m_fd;
+
+            size_t m_depth;
+            size_t m_buffer;
+
+            /**
+             * The submission and completion queues shared with the kernel
+             */
+            void * m_sq;
+            size_t m_sqSize;
+            void * m_cq;
+            size_t m_cqSize;
+
+            io_uring_sqe * m_sqes;
+            size_t         m_sqesSize;
+
+            unsigned * m_sqHead;
+            unsigned * m_sqTail;
+            unsigned * m_sqMask;
+            unsigned * m_sqArray;
+
+            unsigned *     m_cqHead;
+            unsigned *     m_cqTail;
+            unsigned *     m_cqMask;
+            io_uring_cqe * m_cqes;
+
+            /**
+             * Reads go into buffers registered with the kernel if it let
+             * us, otherwise into the same buffers unregistered
+             */
+            bool m_fixed;
+
+            std::vector<char>   m_buffers;
+            std::vector<Slot>   m_slots;
+            std::vector<size_t> m_free;
+            std::vector<size_t> m_done;
+
+            /**
+             * Files too big for a slot's buffer are read again into this
+             */
+            std::vector<char> m_whole;
+
+            io_uring_sqe * sqe (unsigned);
+            void queue (size_t slot_, const std::string & file_);
+            void enter (unsigned wait_);
+            void reap();
+            void deliver (size_t, const std::vector<std::string> &, const Sink &);
+            void release();
+
+        public :
+            static constexpr size_t depth = 64;
+            static constexpr size_t buffer = 64 * 1024;
+
+            explicit Ring (size_t depth_ = depth, size_t buffer_ = buffer);
+            ~Ring();
+
+            Ring (const Ring &) = delete;
+            Ring & operator = (const Ring &) = delete;
+
+            /**
+             * Read files [begin_, end_) of [files_], handing each to
+             * [sink_] as it completes, which won't be in order
+             */
+            void read (
+                const std::vector<std::string> & files_,
+                size_t begin_,
+                size_t end_,
+                const Sink & sink_);
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include "io/Ring.h"
+#include "io/Reader.h"
+#include "concurrency/ThreadPool.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * A directory of files of [sizes_] bytes, each filled with its own
+     * index, removed again at the end of the test
+     */
+    class Corpus {
+        private :
+            std::filesystem::path m_dir;
+
+        public :
+            std::vector<std::string> files;
+            std::vector<std::string> contents;
+
+            explicit Corpus (const std::vector<size_t> & sizes_)
+                : m_dir { std::filesystem::temp_directory_path() / (
+                    std::string ("io-test-") + ::testing::UnitTest::GetInstance()
+                        ->current_test_info()->name()) }
+            {
+                std::filesystem::create_directories (m_dir);
+
+                for (size_t i { 0 } ; i < sizes_.size() ; ++i) {
+                    std::string bytes (sizes_[i], '\0');
+
+                    for (size_t j { 0 } ; j < bytes.size() ; ++j) {
+                        bytes[j] = static_cast<char>('a' + (i + j) % 26);
+                    }
+
+                    files.push_back ((m_dir / std::to_string (i)).string());
+                    contents.push_back (bytes);
+
+                    std::ofstream (files.back(), std::ios::binary) << bytes;
+                }
+
+                // and one that isn't there
+                files.push_back ((m_dir / "missing").string());
+                contents.emplace_back();
+            }
+
+            ~Corpus() {
+                std::filesystem::remove_all (m_dir);
+            }
+    };
+
+    /**
+     * What was read of each file, empty where nothing was
+     */
+    std::vector<std::string>
+    readAll (const Corpus & corpus_, io::Backend backend_, io::Backend & used_) {
+        auto & pool = concurrency::ThreadPool::instance();
+
+        std::vector<std::string> rtn (corpus_.files.size());
+        std::vector<size_t> reads (corpus_.files.size(), 0);
+
+        used_ = io::read (corpus_.files, backend_,
+            [&](size_t participant_, size_t index_, const char * bytes_, size_t size_) {
+                EXPECT_LT (participant_, pool.participants());
+                EXPECT_EQ (bytes_ == nullptr, size_ == 0);
+
+                ++reads[index_];
+
+                if (bytes_) {
+                    rtn[index_].assign (bytes_, size_);
+                }
+            });
+
+        for (size_t i { 0 } ; i < reads.size() ; ++i) {
+            EXPECT_EQ (1, reads[i]) << i;
+        }
+
+        return rtn;
+    }
+
+    bool
+    skipped() {
+        return !io::available (io::uring_t);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Both backends read every file whole once, including files bigger than
+ * a ring's buffers, and give nothing for empty and missing files
+ */
+TEST (Reader, backends) { // NOLINT
+    concurrency::ThreadPool::resize (3);
+
+    std::vector<size_t> sizes;
+
+    for (size_t i { 0 } ; i < 500 ; ++i) {
+        sizes.push_back ((i * 37) % 2000);
+    }
+
+    sizes.push_back (io::internal::Ring::buffer - 1);
+    sizes.push_back (io::internal::Ring::buffer);
+    sizes.push_back (3 * io::internal::Ring::buffer + 7);
+
+    Corpus corpus (sizes);
+    io::Backend used;
+
+    EXPECT_EQ (corpus.contents, readAll (corpus, io::stream_t, used));
+    EXPECT_EQ (io::stream_t, used);
+
+    EXPECT_EQ (corpus.contents, readAll (corpus, io::uring_t, used));
+    EXPECT_EQ (skipped() ? io::stream_t : io::uring_t, used);
+}
+
+/******************************************************************************/
+
+/**
+ * With fewer slots than files and buffers smaller than most of them, slots
+ * are reused and files that fill a buffer are read again whole
+ */
+TEST (Ring, smallBuffers) { // NOLINT
+    if (skipped()) {
+        GTEST_SKIP();
+    }
+
+    Corpus corpus ({ 1, 15, 16, 17, 0, 40, 3, 16, 100, 2, 31, 32, 33 });
+    io::internal::Ring ring (4, 16);
+
+    std::vector<std::string> read (corpus.files.size());
+    std::vector<size_t> order;
+
+    ring.read (corpus.files, 0, corpus.files.size(),
+        [&](size_t index_, const char * bytes_, size_t size_) {
+            order.push_back (index_);
+
+            if (bytes_) {
+                read[index_].assign (bytes_, size_);
+            }
+        });
+
+    EXPECT_EQ (corpus.contents, read);
+    EXPECT_EQ (corpus.files.size(), order.size());
+
+    // and again for only some of them
+    order.clear();
+
+    ring.read (corpus.files, 3, 9, [&](size_t index_, const char *, size_t) {
+        order.push_back (index_);
+    });
+
+    std::sort (order.begin(), order.end());
+
+    EXPECT_EQ ((std::vector<size_t> { 3, 4, 5, 6, 7, 8 }), order);
+}
+
+/******************************************************************************/
+
+/**
+ * A sink throwing leaves nothing in flight and the ring usable
+ */
+TEST (Ring, sinkThrows) { // NOLINT
+    if (skipped()) {
+        GTEST_SKIP();
+    }
+
+    Corpus corpus (std::vector<size_t> (50, 100));
+    io::internal::Ring ring (8, 64);
+
+    EXPECT_THROW ( // NOLINT
+        ring.read (corpus.files, 0, corpus.files.size(),
+            [](size_t, const char *, size_t) {
+                throw std::runtime_error ("sink");
+            }),
+        std::runtime_error);
+
+    size_t n { 0 };
+
+    ring.read (corpus.files, 0, corpus.files.size(),
+        [&](size_t index_, const char * bytes_, size_t size_) {
+            ++n;
+            EXPECT_EQ (corpus.contents[index_], std::string (
+                bytes_ ? bytes_ : "", size_));
+        });
+
+    EXPECT_EQ (corpus.files.size(), n);
+}
+
+/******************************************************************************/
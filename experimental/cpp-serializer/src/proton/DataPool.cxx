@@ -0,0 +1,142 @@
+#include "DataPool.h"
+
+#include <utility>
+
+/******************************************************************************/
+
+proton::
+DataPool::DataPool()
+    : m_stats { }
+{
+}
+
+/******************************************************************************/
+
+proton::
+DataPool::~DataPool() {
+    for (auto data : m_free) {
+        pn_data_free (data);
+    }
+}
+
+/******************************************************************************/
+
+proton::DataPool &
+proton::
+DataPool::instance() {
+    static DataPool pool;
+
+    return pool;
+}
+
+/******************************************************************************/
+
+proton::DataPool::Lease
+proton::
+DataPool::acquire() {
+    pn_data_t * data { nullptr };
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+
+        ++m_stats.acquired;
+
+        if (++m_stats.outstanding > m_stats.highWater) {
+            m_stats.highWater = m_stats.outstanding;
+        }
+
+        if (!m_free.empty()) {
+            data = m_free.back();
+            m_free.pop_back();
+            ++m_stats.reused;
+        }
+    }
+
+    if (!data) {
+        data = pn_data (0);
+    }
+
+    return Lease (*this, data);
+}
+
+/******************************************************************************/
+
+void
+proton::
+DataPool::release (pn_data_t * data_) {
+    pn_data_clear (data_);
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    --m_stats.outstanding;
+    m_free.push_back (data_);
+}
+
+/******************************************************************************/
+
+proton::DataPool::Stats
+proton::
+DataPool::stats() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_stats;
+}
+
+/******************************************************************************
+ *
+ * proton::DataPool::Lease
+ *
+ ******************************************************************************/
+
+proton::
+DataPool::Lease::Lease()
+    : m_pool { nullptr }
+    , m_data { nullptr }
+{
+}
+
+/******************************************************************************/
+
+proton::
+DataPool::Lease::Lease (DataPool & pool_, pn_data_t * data_)
+    : m_pool { &pool_ }
+    , m_data { data_ }
+{
+}
+
+/******************************************************************************/
+
+proton::
+DataPool::Lease::~Lease() {
+    if (m_data) {
+        m_pool->release (m_data);
+    }
+}
+
+/******************************************************************************/
+
+proton::
+DataPool::Lease::Lease (Lease && lease_) noexcept
+    : m_pool { lease_.m_pool }
+    , m_data { std::exchange (lease_.m_data, nullptr) }
+{
+}
+
+/******************************************************************************/
+
+proton::DataPool::Lease &
+proton::
+DataPool::Lease::operator = (Lease && lease_) noexcept {
+    if (this != &lease_) {
+        if (m_data) {
+            m_pool->release (m_data);
+        }
+
+        m_pool = lease_.m_pool;
+        m_data = std::exchange (lease_.m_data, nullptr);
+    }
+
+    return *this;
+}
+
+/******************************************************************************/
@@ -0,0 +1,84 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <vector>
+
+#include <proton/codec.h>
+
+/******************************************************************************/
+
+namespace proton {
+
+    /**
+     * pn_data_t trees kept for reuse between decodes. A tree handed back
+     * is cleared, which keeps the nodes it had grown, so after the first
+     * few blobs decoding one needn't allocate. The pool holds on to as
+     * many trees as were ever out at once and no more.
+     */
+    class DataPool {
+        public :
+            class Lease;
+
+            struct Stats {
+                size_t acquired;
+                size_t reused;
+                size_t outstanding;
+                size_t highWater;
+            };
+
+        private :
+            mutable std::mutex       m_mutex;
+            std::vector<pn_data_t *> m_free;
+            Stats                    m_stats;
+
+            void release (pn_data_t *);
+
+        public :
+            DataPool();
+            ~DataPool();
+
+            DataPool (const DataPool &) = delete;
+            DataPool & operator = (const DataPool &) = delete;
+
+            static DataPool & instance();
+
+            /**
+             * An empty tree, returned here when the lease goes out of scope
+             */
+            Lease acquire();
+
+            Stats stats() const;
+    };
+
+    /**
+     * Sole ownership of a tree borrowed from a [DataPool]
+     */
+    class DataPool::Lease {
+        private :
+            DataPool *  m_pool;
+            pn_data_t * m_data;
+
+            Lease (DataPool &, pn_data_t *);
+
+            friend class DataPool;
+
+        public :
+            Lease();
+            ~Lease();
+
+            Lease (Lease &&) noexcept;
+            Lease & operator = (Lease &&) noexcept;
+
+            Lease (const Lease &) = delete;
+            Lease & operator = (const Lease &) = delete;
+
+            pn_data_t * get() const { return m_data; }
+
+            explicit operator bool() const { return m_data != nullptr; }
+    };
+
+}
+
+/******************************************************************************/
@@ -153,6 +153,17 @@ proton::get_symbol (pn_data_t * data_) {
     return pn_data_get_symbol(data_);
 }
 
+/**
+ * A view into the tree, living only as long as its contents do
+ */
+template<>
+std::string_view
+proton::get_symbol<std::string_view> (pn_data_t * data_) {
+    is_symbol (data_);
+    auto symbol = pn_data_get_symbol(data_);
+    return { symbol.start, symbol.size };
+}
+
 /******************************************************************************/
 
 bool
@@ -312,6 +323,60 @@ readAndNext<std::string> (
 
 /******************************************************************************/
 
+/**
+ * As for a std::string but without the copy, the view is into the tree
+ * and only lives as long as its contents do
+ */
+template<>
+std::string_view
+proton::
+readAndNext<std::string_view> (
+    pn_data_t * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    if (pn_data_type(data_) == PN_STRING) {
+        auto str = pn_data_get_string(data_);
+        return { str.start, str.size };
+    } else if (pn_data_type(data_) == PN_SYMBOL) {
+        auto symbol = pn_data_get_symbol(data_);
+        return { symbol.start, symbol.size };
+    } else  if (tolerateDeviance_ && pn_data_type(data_) == PN_NULL) {
+        return { };
+    }
+    std::stringstream ss;
+    ss << "Expected a String but found [" << data_ << "]";
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
+
+/**
+ * A binary's content, which like a string view lives only as long as the
+ * tree's contents do
+ */
+template<>
+pn_bytes_t
+proton::
+readAndNext<pn_bytes_t> (
+    pn_data_t * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    if (pn_data_type(data_) == PN_BINARY) {
+        return pn_data_get_binary(data_);
+    } else  if (tolerateDeviance_ && pn_data_type(data_) == PN_NULL) {
+        return { 0, nullptr };
+    }
+    std::stringstream ss;
+    ss << "Expected a Binary but found [" << data_ << "]";
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
+
 template<>
 bool
 proton::
@@ -366,3 +431,49 @@ readAndNext<u_long > (
 }
 
 /******************************************************************************/
+
+template<>
+pn_atom_t
+proton::
+readAndNext<pn_atom_t> (
+    pn_data_t * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    pn_atom_t rtn;
+    rtn.type = pn_data_type (data_);
+
+    switch (rtn.type) {
+        case PN_NULL :      break;
+        case PN_BOOL :      rtn.u.as_bool = pn_data_get_bool (data_); break;
+        case PN_UBYTE :     rtn.u.as_ubyte = pn_data_get_ubyte (data_); break;
+        case PN_BYTE :      rtn.u.as_byte = pn_data_get_byte (data_); break;
+        case PN_USHORT :    rtn.u.as_ushort = pn_data_get_ushort (data_); break;
+        case PN_SHORT :     rtn.u.as_short = pn_data_get_short (data_); break;
+        case PN_UINT :      rtn.u.as_uint = pn_data_get_uint (data_); break;
+        case PN_INT :       rtn.u.as_int = pn_data_get_int (data_); break;
+        case PN_CHAR :      rtn.u.as_char = pn_data_get_char (data_); break;
+        case PN_ULONG :     rtn.u.as_ulong = pn_data_get_ulong (data_); break;
+        case PN_LONG :      rtn.u.as_long = pn_data_get_long (data_); break;
+        case PN_TIMESTAMP : rtn.u.as_timestamp = pn_data_get_timestamp (data_); break;
+        case PN_FLOAT :     rtn.u.as_float = pn_data_get_float (data_); break;
+        case PN_DOUBLE :    rtn.u.as_double = pn_data_get_double (data_); break;
+        case PN_DECIMAL32 : rtn.u.as_decimal32 = pn_data_get_decimal32 (data_); break;
+        case PN_DECIMAL64 : rtn.u.as_decimal64 = pn_data_get_decimal64 (data_); break;
+        case PN_DECIMAL128 : rtn.u.as_decimal128 = pn_data_get_decimal128 (data_); break;
+        case PN_UUID :      rtn.u.as_uuid = pn_data_get_uuid (data_); break;
+        case PN_BINARY :    rtn.u.as_bytes = pn_data_get_binary (data_); break;
+        case PN_STRING :    rtn.u.as_bytes = pn_data_get_string (data_); break;
+        case PN_SYMBOL :    rtn.u.as_bytes = pn_data_get_symbol (data_); break;
+        default : {
+            std::stringstream ss;
+            ss << "Expected a scalar but found [" << data_ << "]";
+            throw std::runtime_error (ss.str());
+        }
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -4,6 +4,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 
 #include <proton/types.h>
 #include <proton/codec.h>
@@ -39,6 +40,10 @@ namespace proton {
         return T {};
     }
 
+    template<> std::string get_symbol<std::string> (pn_data_t *);
+    template<> pn_bytes_t get_symbol<pn_bytes_t> (pn_data_t *);
+    template<> std::string_view get_symbol<std::string_view> (pn_data_t *);
+
     std::string get_symbol (pn_data_t *);
 
     bool get_boolean (pn_data_t *);
@@ -104,6 +109,25 @@ namespace proton {
         return T{};
     }
 
+    /*
+     * The specialisations must be seen by every caller, otherwise an
+     * optimising build is free to inline the default above instead
+     */
+    template<> int32_t readAndNext<int32_t> (pn_data_t *, bool);
+    template<> std::string readAndNext<std::string> (pn_data_t *, bool);
+    template<> std::string_view readAndNext<std::string_view> (pn_data_t *, bool);
+    template<> pn_bytes_t readAndNext<pn_bytes_t> (pn_data_t *, bool);
+    template<> bool readAndNext<bool> (pn_data_t *, bool);
+    template<> double readAndNext<double> (pn_data_t *, bool);
+    template<> long readAndNext<long> (pn_data_t *, bool);
+    template<> u_long readAndNext<u_long> (pn_data_t *, bool);
+
+    /**
+     * Any scalar, tagged with its type. Its bytes, for a string, symbol or
+     * binary, live only as long as the tree's contents do.
+     */
+    template<> pn_atom_t readAndNext<pn_atom_t> (pn_data_t *, bool);
+
 }
 
 /******************************************************************************/
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "proton/DataPool.h"
+
+/******************************************************************************/
+
+TEST (DataPool, reuse) { // NOLINT
+    proton::DataPool pool;
+
+    pn_data_t * first;
+
+    {
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+
+        first = a.get();
+        pn_data_put_int (first, 69);
+
+        EXPECT_EQ (2, pool.stats().outstanding);
+    }
+
+    EXPECT_EQ (0, pool.stats().outstanding);
+    EXPECT_EQ (2, pool.stats().highWater);
+
+    for (int i { 0 } ; i < 10 ; ++i) {
+        auto c = pool.acquire();
+
+        // handed back cleared
+        EXPECT_EQ (0, pn_data_size (c.get()));
+    }
+
+    auto stats = pool.stats();
+
+    EXPECT_EQ (12, stats.acquired);
+    EXPECT_EQ (10, stats.reused);
+    EXPECT_EQ (2, stats.highWater);
+}
+
+/******************************************************************************/
+
+TEST (DataPool, move) { // NOLINT
+    proton::DataPool pool;
+
+    proton::DataPool::Lease outer;
+    EXPECT_FALSE (outer);
+
+    {
+        auto inner = pool.acquire();
+        outer = std::move (inner);
+        EXPECT_FALSE (inner); // NOLINT
+    }
+
+    EXPECT_TRUE (outer);
+    EXPECT_EQ (1, pool.stats().outstanding);
+
+    outer = proton::DataPool::Lease();
+
+    EXPECT_EQ (0, pool.stats().outstanding);
+}
+
+/******************************************************************************/